@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace everest::lib::API {
+
+/* @brief Publish behaviour of a single topic carrying state
+ *
+ * @details Unchanged payloads are never published twice in a row. Updates arriving faster than
+ * @p min_interval are coalesced and only the latest one is published when the interval has passed.
+ * The last payload is published again when nothing was published for @p max_staleness.
+ */
+struct PublishPolicy {
+    /// Minimum time between two publishes, zero disables rate limiting
+    std::chrono::milliseconds min_interval{0};
+    /// Maximum time without publish, zero disables republishing unchanged payloads
+    std::chrono::milliseconds max_staleness{0};
+};
+
+/* @brief Parse publish policies from a module configuration string
+ *
+ * @details The format is a comma separated list of @p <var>:<min_interval_ms>:<max_staleness_ms>,
+ * e.g. "powermeter:1000:60000,limits:0:0". Whitespace around entries is ignored.
+ * @param[in] config The configuration string
+ * @return The policies by var name
+ * @throws std::invalid_argument if the string is malformed
+ */
+std::map<std::string, PublishPolicy> parse_publish_policies(std::string const& config);
+
+/* @brief PublishPipeline is the publish stage between EVerest vars and external MQTT
+ *
+ * @details Topics without a policy are published immediately and unconditionally, which is
+ * what events and replies need. Topics with a policy are treated as state as described in
+ * @ref PublishPolicy. Coalesced and stale payloads are published from an internal thread.
+ * All functions are thread safe.
+ */
+class PublishPipeline {
+public:
+    using PublishFtor = std::function<void(std::string const& topic, std::string const& payload)>;
+
+    explicit PublishPipeline(PublishFtor const& publish);
+    ~PublishPipeline();
+
+    PublishPipeline(PublishPipeline const&) = delete;
+    PublishPipeline& operator=(PublishPipeline const&) = delete;
+
+    /**
+     * @brief Set the policy of a topic
+     * @param[in] topic The full topic
+     * @param[in] policy The policy
+     */
+    void set_policy(std::string const& topic, PublishPolicy const& policy);
+
+    /**
+     * @brief Publish a payload, subject to the policy of the topic
+     * @param[in] topic The full topic
+     * @param[in] payload The serialized payload
+     */
+    void publish(std::string const& topic, std::string const& payload);
+
+    /**
+     * @brief Publish a payload, subject to the policy of the topic
+     * @details Payloads are compared by @p fingerprint instead of the payload itself. This allows to ignore
+     * members like timestamps that change with every update.
+     * @param[in] topic The full topic
+     * @param[in] payload The serialized payload
+     * @param[in] fingerprint The part of the payload that is relevant for change detection
+     */
+    void publish(std::string const& topic, std::string const& payload, std::string const& fingerprint);
+
+    /**
+     * @brief Number of payloads that were not published because they were unchanged or superseded
+     * @return The number of dropped payloads
+     */
+    std::size_t dropped() const;
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Update {
+        std::string payload;
+        std::string fingerprint;
+        std::size_t hash{0};
+    };
+
+    struct TopicState {
+        PublishPolicy policy;
+        Update last;
+        std::optional<clock::time_point> last_publish;
+        std::optional<Update> pending;
+    };
+
+    bool is_unchanged(TopicState const& state, Update const& update) const;
+    void publish_locked(std::string const& topic, TopicState& state, Update&& update, clock::time_point now);
+    std::optional<clock::time_point> next_deadline() const;
+    void worker();
+
+    PublishFtor m_publish;
+    std::map<std::string, TopicState> m_topics;
+    std::size_t m_dropped{0};
+    bool m_stop{false};
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::thread m_worker;
+};
+
+} // namespace everest::lib::API
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
 
+#pragma once
+
 namespace everest::lib::API {
-static const int json_indent = 4;
+// Payloads go over the wire, -1 selects the compact representation
+static const int json_indent = -1;
 } // namespace everest::lib::API
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include "utilities/PublishPipeline.hpp"
+#include <sstream>
+#include <stdexcept>
+
+namespace everest::lib::API {
+
+namespace {
+
+std::string trim(std::string const& str) {
+    auto const first = str.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return {};
+    }
+    auto const last = str.find_last_not_of(" \t");
+    return str.substr(first, last - first + 1);
+}
+
+std::chrono::milliseconds parse_duration_ms(std::string const& str, std::string const& entry) {
+    try {
+        std::size_t pos = 0;
+        auto value = std::stoll(str, &pos);
+        if (pos != str.size() or value < 0) {
+            throw std::invalid_argument(str);
+        }
+        return std::chrono::milliseconds(value);
+    } catch (std::exception const&) {
+        throw std::invalid_argument("Invalid duration in publish policy '" + entry + "'");
+    }
+}
+
+} // namespace
+
+std::map<std::string, PublishPolicy> parse_publish_policies(std::string const& config) {
+    std::map<std::string, PublishPolicy> result;
+    std::stringstream entries(config);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        entry = trim(entry);
+        if (entry.empty()) {
+            continue;
+        }
+        std::stringstream fields(entry);
+        std::string var;
+        std::string min_interval;
+        std::string max_staleness;
+        std::string rest;
+        if (not std::getline(fields, var, ':') or not std::getline(fields, min_interval, ':') or
+            not std::getline(fields, max_staleness, ':') or std::getline(fields, rest) or trim(var).empty()) {
+            throw std::invalid_argument("Invalid publish policy '" + entry +
+                                        "', expected <var>:<min_interval_ms>:<max_staleness_ms>");
+        }
+        result[trim(var)] = {parse_duration_ms(trim(min_interval), entry),
+                             parse_duration_ms(trim(max_staleness), entry)};
+    }
+    return result;
+}
+
+PublishPipeline::PublishPipeline(PublishFtor const& publish) : m_publish(publish) {
+    m_worker = std::thread([this]() { worker(); });
+}
+
+PublishPipeline::~PublishPipeline() {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+void PublishPipeline::set_policy(std::string const& topic, PublishPolicy const& policy) {
+    {
+        std::scoped_lock lock(m_mutex);
+        m_topics[topic].policy = policy;
+    }
+    m_cv.notify_one();
+}
+
+void PublishPipeline::publish(std::string const& topic, std::string const& payload) {
+    publish(topic, payload, payload);
+}
+
+void PublishPipeline::publish(std::string const& topic, std::string const& payload, std::string const& fingerprint) {
+    std::unique_lock lock(m_mutex);
+    auto it = m_topics.find(topic);
+    if (it == m_topics.end()) {
+        lock.unlock();
+        m_publish(topic, payload);
+        return;
+    }
+
+    auto& state = it->second;
+    Update update{payload, fingerprint, std::hash<std::string>{}(fingerprint)};
+    auto const now = clock::now();
+
+    if (state.pending.has_value()) {
+        // A publish is already scheduled, the latest value wins
+        state.pending = std::move(update);
+        ++m_dropped;
+        return;
+    }
+    if (is_unchanged(state, update)) {
+        ++m_dropped;
+        return;
+    }
+    if (state.last_publish.has_value() and now - state.last_publish.value() < state.policy.min_interval) {
+        state.pending = std::move(update);
+        lock.unlock();
+        m_cv.notify_one();
+        return;
+    }
+    publish_locked(topic, state, std::move(update), now);
+}
+
+std::size_t PublishPipeline::dropped() const {
+    std::scoped_lock lock(m_mutex);
+    return m_dropped;
+}
+
+bool PublishPipeline::is_unchanged(TopicState const& state, Update const& update) const {
+    return state.last_publish.has_value() and state.last.hash == update.hash and
+           state.last.fingerprint == update.fingerprint;
+}
+
+void PublishPipeline::publish_locked(std::string const& topic, TopicState& state, Update&& update,
+                                     clock::time_point now) {
+    // Publishing while holding the lock keeps the order of payloads per topic
+    m_publish(topic, update.payload);
+    state.last = std::move(update);
+    state.last_publish = now;
+}
+
+std::optional<PublishPipeline::clock::time_point> PublishPipeline::next_deadline() const {
+    std::optional<clock::time_point> result;
+    auto update = [&result](clock::time_point deadline) {
+        if (not result.has_value() or deadline < result.value()) {
+            result = deadline;
+        }
+    };
+    for (auto const& [topic, state] : m_topics) {
+        if (not state.last_publish.has_value()) {
+            continue;
+        }
+        if (state.pending.has_value()) {
+            update(state.last_publish.value() + state.policy.min_interval);
+        } else if (state.policy.max_staleness.count() > 0) {
+            update(state.last_publish.value() + state.policy.max_staleness);
+        }
+    }
+    return result;
+}
+
+void PublishPipeline::worker() {
+    std::unique_lock lock(m_mutex);
+    while (not m_stop) {
+        auto deadline = next_deadline();
+        if (deadline.has_value()) {
+            m_cv.wait_until(lock, deadline.value());
+        } else {
+            m_cv.wait(lock);
+        }
+        if (m_stop) {
+            break;
+        }
+
+        auto const now = clock::now();
+        for (auto& [topic, state] : m_topics) {
+            if (not state.last_publish.has_value()) {
+                continue;
+            }
+            auto const since_publish = now - state.last_publish.value();
+            if (state.pending.has_value()) {
+                if (since_publish < state.policy.min_interval) {
+                    continue;
+                }
+                auto update = std::move(state.pending.value());
+                state.pending.reset();
+                if (is_unchanged(state, update)) {
+                    ++m_dropped;
+                    continue;
+                }
+                publish_locked(topic, state, std::move(update), now);
+            } else if (state.policy.max_staleness.count() > 0 and since_publish >= state.policy.max_staleness) {
+                m_publish(topic, state.last.payload);
+                state.last_publish = now;
+            }
+        }
+    }
+}
+
+} // namespace everest::lib::API
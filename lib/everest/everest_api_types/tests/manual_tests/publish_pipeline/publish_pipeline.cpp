@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include "everest_api_types/utilities/PublishPipeline.hpp"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace everest::lib::API;
+using namespace std::chrono_literals;
+
+namespace {
+
+class PublishPipelineTest : public ::testing::Test {
+protected:
+    PublishPipelineTest() :
+        pipeline([this](auto const& topic, auto const& payload) {
+            std::scoped_lock lock(mutex);
+            published.emplace_back(topic, payload);
+        }) {
+    }
+
+    std::vector<std::pair<std::string, std::string>> get_published() {
+        std::scoped_lock lock(mutex);
+        return published;
+    }
+
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::string>> published;
+    PublishPipeline pipeline;
+};
+
+} // namespace
+
+TEST_F(PublishPipelineTest, topics_without_policy_pass_through) {
+    pipeline.publish("event", "1");
+    pipeline.publish("event", "1");
+    EXPECT_EQ(get_published().size(), 2);
+    EXPECT_EQ(pipeline.dropped(), 0);
+}
+
+TEST_F(PublishPipelineTest, unchanged_payloads_are_suppressed) {
+    pipeline.set_policy("state", {});
+    pipeline.publish("state", "1");
+    pipeline.publish("state", "1");
+    pipeline.publish("state", "2");
+    pipeline.publish("state", "2");
+
+    auto result = get_published();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[0].second, "1");
+    EXPECT_EQ(result[1].second, "2");
+    EXPECT_EQ(pipeline.dropped(), 2);
+}
+
+TEST_F(PublishPipelineTest, changes_are_detected_by_fingerprint) {
+    pipeline.set_policy("state", {});
+    pipeline.publish("state", "{\"ts\":1,\"v\":1}", "1");
+    pipeline.publish("state", "{\"ts\":2,\"v\":1}", "1");
+    pipeline.publish("state", "{\"ts\":3,\"v\":2}", "2");
+
+    auto result = get_published();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[1].second, "{\"ts\":3,\"v\":2}");
+}
+
+TEST_F(PublishPipelineTest, updates_are_coalesced_to_the_latest_value) {
+    pipeline.set_policy("state", {100ms, 0ms});
+    pipeline.publish("state", "1");
+    pipeline.publish("state", "2");
+    pipeline.publish("state", "3");
+    EXPECT_EQ(get_published().size(), 1);
+
+    std::this_thread::sleep_for(250ms);
+    auto result = get_published();
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[1].second, "3");
+}
+
+TEST_F(PublishPipelineTest, stale_values_are_republished) {
+    pipeline.set_policy("state", {0ms, 50ms});
+    pipeline.publish("state", "1");
+    std::this_thread::sleep_for(180ms);
+    auto result = get_published();
+    EXPECT_GE(result.size(), 2);
+    for (auto const& [topic, payload] : result) {
+        EXPECT_EQ(payload, "1");
+    }
+}
+
+TEST(PublishPolicies, parse) {
+    auto policies = parse_publish_policies(" powermeter:1000:60000, limits:0:0,");
+    ASSERT_EQ(policies.size(), 2);
+    EXPECT_EQ(policies["powermeter"].min_interval, 1000ms);
+    EXPECT_EQ(policies["powermeter"].max_staleness, 60000ms);
+    EXPECT_EQ(policies["limits"].min_interval, 0ms);
+    EXPECT_TRUE(parse_publish_policies("").empty());
+}
+
+TEST(PublishPolicies, parse_rejects_malformed_input) {
+    EXPECT_THROW(parse_publish_policies("powermeter:1000"), std::invalid_argument);
+    EXPECT_THROW(parse_publish_policies("powermeter:1000:1:2"), std::invalid_argument);
+    EXPECT_THROW(parse_publish_policies("powermeter:fast:0"), std::invalid_argument);
+    EXPECT_THROW(parse_publish_policies("powermeter:-1:0"), std::invalid_argument);
+    EXPECT_THROW(parse_publish_policies(":1:0"), std::invalid_argument);
+}
@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef BENCHMARKS_LOCAL_BROKER_HPP
+#define BENCHMARKS_LOCAL_BROKER_HPP
+
+#include <filesystem>
+#include <string>
+
+#include <sys/types.h>
+
+namespace fs = std::filesystem;
+
+namespace Everest {
+namespace benchmarks {
+
+///
+/// \brief Provides a MQTT broker listening on a Unix Domain Socket for the duration of a benchmark run.
+///
+/// If the environment variable EVEREST_BENCHMARK_MQTT_SOCKET is set, the broker listening on this socket is used and
+/// nothing is spawned. Otherwise a private mosquitto instance is started in \p work_dir and stopped on destruction.
+///
+class LocalBroker {
+public:
+    explicit LocalBroker(const fs::path& work_dir);
+    ~LocalBroker();
+
+    LocalBroker(LocalBroker const&) = delete;
+    void operator=(LocalBroker const&) = delete;
+
+    /// \returns the path of the Unix Domain Socket the broker listens on
+    const std::string& get_socket_path() const;
+
+private:
+    std::string socket_path;
+    pid_t broker_pid{0};
+
+    void spawn_mosquitto(const fs::path& work_dir);
+};
+
+} // namespace benchmarks
+} // namespace Everest
+
+#endif // BENCHMARKS_LOCAL_BROKER_HPP
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef BENCHMARKS_SYNTHETIC_SITE_HPP
+#define BENCHMARKS_SYNTHETIC_SITE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <framework/everest.hpp>
+#include <framework/runtime.hpp>
+#include <utils/config.hpp>
+#include <utils/mqtt_abstraction.hpp>
+
+namespace fs = std::filesystem;
+
+namespace Everest {
+namespace benchmarks {
+
+constexpr auto BENCH_INTERFACE = "bench";
+constexpr auto BENCH_IMPL_ID = "main";
+constexpr auto BENCH_REQUIREMENT_ID = "provider";
+constexpr auto BENCH_CMD = "echo";
+constexpr auto BENCH_VAR = "sample";
+constexpr auto BENCH_ERROR_TYPE = "bench/Flapping";
+
+struct SiteOptions {
+    std::size_t consumers = 1;    ///< Number of consumer modules requiring the provider
+    bool validate_schema = false; ///< Enables schema validation of vars, cmd arguments and results
+};
+
+///
+/// \brief Writes a logging config that only lets errors through into \p dir
+/// \returns the path of the written logging config
+fs::path write_logging_config(const fs::path& dir);
+
+///
+/// \brief A synthetic EVerest setup with one provider module and a configurable number of consumer modules, all
+/// running in-process on individual MQTT connections.
+///
+/// The manifests, interface, error definitions and config are generated into \p work_dir. The manager is replaced by
+/// a stand-in that serializes the module configs directly from a ManagerConfig and publishes the global ready signal
+/// once every module has signalled ready, so the measured paths are exactly the ones used by real modules.
+///
+class SyntheticSite {
+public:
+    SyntheticSite(const fs::path& work_dir, const std::string& broker_socket_path, const SiteOptions& options);
+    ~SyntheticSite();
+
+    SyntheticSite(SyntheticSite const&) = delete;
+    void operator=(SyntheticSite const&) = delete;
+
+    ///
+    /// \brief Signals ready for all modules and blocks until every module has processed the global ready signal.
+    /// Handlers (cmds, var subscriptions, error subscriptions) have to be registered before calling this
+    void start();
+
+    /// \returns the provider module
+    Everest& get_provider();
+
+    /// \returns the consumer module with the given \p index
+    Everest& get_consumer(std::size_t index);
+
+    /// \returns the number of consumer modules
+    std::size_t get_consumer_count() const;
+
+    /// \returns the requirement consumers use to reach the provider
+    static Requirement get_provider_requirement();
+
+private:
+    struct SyntheticModule {
+        std::string module_id;
+        std::shared_ptr<MQTTAbstraction> mqtt;
+        std::unique_ptr<Everest> everest;
+    };
+
+    fs::path prefix;
+    MQTTSettings mqtt_settings;
+    std::unique_ptr<ManagerSettings> manager_settings;
+    std::unique_ptr<ManagerConfig> manager_config;
+    std::shared_ptr<MQTTAbstraction> manager_mqtt;
+    std::vector<std::shared_ptr<TypedHandler>> module_ready_tokens;
+    std::vector<SyntheticModule> modules; // provider first, followed by the consumers
+
+    std::mutex ready_mutex;
+    std::condition_variable ready_cv;
+    std::size_t modules_signalled_ready{0};
+    std::size_t modules_processed_ready{0};
+
+    void generate_prefix(const std::string& broker_socket_path, const SiteOptions& options);
+    nlohmann::json get_serialized_config(const std::string& module_id) const;
+    void add_module(const std::string& module_id);
+    void on_module_ready();
+};
+
+} // namespace benchmarks
+} // namespace Everest
+
+#endif // BENCHMARKS_SYNTHETIC_SITE_HPP
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <benchmarks/local_broker.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+
+namespace Everest {
+namespace benchmarks {
+
+namespace {
+constexpr auto BROKER_SOCKET_ENV = "EVEREST_BENCHMARK_MQTT_SOCKET";
+constexpr auto BROKER_STARTUP_TIMEOUT = std::chrono::seconds(5);
+constexpr auto BROKER_STARTUP_POLL_INTERVAL = std::chrono::milliseconds(10);
+} // namespace
+
+LocalBroker::LocalBroker(const fs::path& work_dir) {
+    const auto* const external_socket = std::getenv(BROKER_SOCKET_ENV);
+    if (external_socket != nullptr) {
+        this->socket_path = external_socket;
+        return;
+    }
+
+    spawn_mosquitto(work_dir);
+}
+
+LocalBroker::~LocalBroker() {
+    if (this->broker_pid <= 0) {
+        return;
+    }
+    kill(this->broker_pid, SIGTERM);
+    waitpid(this->broker_pid, nullptr, 0);
+    std::error_code ec;
+    fs::remove(this->socket_path, ec);
+}
+
+const std::string& LocalBroker::get_socket_path() const {
+    return this->socket_path;
+}
+
+void LocalBroker::spawn_mosquitto(const fs::path& work_dir) {
+    const std::string mosquitto = EVEREST_BENCHMARK_MOSQUITTO_EXECUTABLE;
+    if (mosquitto.empty()) {
+        throw std::runtime_error(fmt::format("mosquitto was not found at build time, please provide a running broker "
+                                             "via the {} environment variable",
+                                             BROKER_SOCKET_ENV));
+    }
+
+    this->socket_path = (work_dir / "mosquitto.sock").string();
+    const auto config_path = work_dir / "mosquitto.conf";
+    {
+        std::ofstream config(config_path);
+        config << "listener 0 " << this->socket_path << "\n";
+        config << "allow_anonymous true\n";
+        config << "persistence false\n";
+        config << "log_dest none\n";
+    }
+
+    const auto pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("Could not fork mosquitto process");
+    }
+    if (pid == 0) {
+        execl(mosquitto.c_str(), mosquitto.c_str(), "-c", config_path.c_str(), nullptr);
+        _exit(EXIT_FAILURE);
+    }
+    this->broker_pid = pid;
+
+    const auto deadline = std::chrono::steady_clock::now() + BROKER_STARTUP_TIMEOUT;
+    while (!fs::exists(this->socket_path)) {
+        if (std::chrono::steady_clock::now() > deadline or waitpid(this->broker_pid, nullptr, WNOHANG) != 0) {
+            throw std::runtime_error(fmt::format("mosquitto did not come up on socket {}", this->socket_path));
+        }
+        std::this_thread::sleep_for(BROKER_STARTUP_POLL_INTERVAL);
+    }
+}
+
+} // namespace benchmarks
+} // namespace Everest
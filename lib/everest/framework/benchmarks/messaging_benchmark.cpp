@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/core.h>
+
+#include <everest/logging.hpp>
+
+#include <benchmarks/local_broker.hpp>
+#include <benchmarks/synthetic_site.hpp>
+#include <utils/error.hpp>
+#include <utils/error/error_factory.hpp>
+#include <utils/error/error_manager_impl.hpp>
+#include <utils/error/error_manager_req.hpp>
+
+namespace {
+using namespace Everest::benchmarks;
+using json = nlohmann::json;
+using clock_type = std::chrono::steady_clock;
+
+constexpr auto DELIVERY_TIMEOUT = std::chrono::seconds(10);
+constexpr benchmark::IterationCount MAX_RESERVED_SAMPLES = 1 << 20;
+
+fs::path get_work_dir() {
+    static const auto work_dir = []() {
+        auto dir = fs::temp_directory_path() / fmt::format("everest-framework-benchmarks-{}", getpid());
+        fs::create_directories(dir);
+        return dir;
+    }();
+    return work_dir;
+}
+
+LocalBroker& get_broker() {
+    static LocalBroker broker(get_work_dir());
+    return broker;
+}
+
+std::unique_ptr<SyntheticSite> create_site(std::size_t consumers, bool validate_schema) {
+    return std::make_unique<SyntheticSite>(get_work_dir(), get_broker().get_socket_path(),
+                                           SiteOptions{consumers, validate_schema});
+}
+
+json make_payload() {
+    return json{{"power_W", 11000.0}, {"current_A", {16.0, 16.0, 16.0}}, {"phase_seq_ok", true}};
+}
+
+///
+/// \brief Collects per-iteration latencies and reports them as p50/p99 counters next to the message rate
+///
+class LatencyRecorder {
+public:
+    explicit LatencyRecorder(benchmark::State& state) : state(state) {
+        samples.reserve(
+            static_cast<std::size_t>(std::min<benchmark::IterationCount>(state.max_iterations, MAX_RESERVED_SAMPLES)));
+    }
+
+    void add(clock_type::duration latency) {
+        samples.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    void report(std::size_t messages_per_iteration) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * messages_per_iteration));
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        state.counters["p50_us"] = percentile(0.50);
+        state.counters["p99_us"] = percentile(0.99);
+        state.counters["max_us"] = samples.back();
+    }
+
+private:
+    benchmark::State& state;
+    std::vector<double> samples;
+
+    double percentile(double p) const {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+        return samples.at(index);
+    }
+};
+
+///
+/// \brief Counts deliveries from other threads and lets the benchmark thread wait for an expected count
+///
+class DeliveryCounter {
+public:
+    void delivered() {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            ++count;
+        }
+        cv.notify_all();
+    }
+
+    bool wait_for(std::size_t expected) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, DELIVERY_TIMEOUT, [this, expected]() { return count >= expected; });
+    }
+
+    void reset() {
+        const std::lock_guard<std::mutex> lock(mutex);
+        count = 0;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t count{0};
+};
+
+void BM_CallCmdRoundTrip(benchmark::State& state) {
+    const auto validate_schema = state.range(0) != 0;
+    auto site = create_site(1, validate_schema);
+    site->get_provider().provide_cmd(BENCH_IMPL_ID, BENCH_CMD, [](json args) { return args.at("payload"); });
+    site->start();
+
+    auto& consumer = site->get_consumer(0);
+    const auto req = SyntheticSite::get_provider_requirement();
+    const json args{{"payload", make_payload()}};
+
+    LatencyRecorder recorder(state);
+    for (auto _ : state) {
+        const auto start = clock_type::now();
+        auto result = consumer.call_cmd(req, BENCH_CMD, args);
+        recorder.add(clock_type::now() - start);
+        benchmark::DoNotOptimize(result);
+    }
+    recorder.report(1);
+}
+
+void BM_PublishVarFanOut(benchmark::State& state) {
+    const auto validate_schema = state.range(0) != 0;
+    const auto subscribers = static_cast<std::size_t>(state.range(1));
+    auto site = create_site(subscribers, validate_schema);
+
+    DeliveryCounter deliveries;
+    for (std::size_t i = 0; i < site->get_consumer_count(); ++i) {
+        site->get_consumer(i).subscribe_var(SyntheticSite::get_provider_requirement(), BENCH_VAR,
+                                            [&deliveries](json) { deliveries.delivered(); });
+    }
+    site->start();
+
+    auto& provider = site->get_provider();
+    const auto payload = make_payload();
+
+    LatencyRecorder recorder(state);
+    for (auto _ : state) {
+        deliveries.reset();
+        const auto start = clock_type::now();
+        provider.publish_var(BENCH_IMPL_ID, BENCH_VAR, payload);
+        if (!deliveries.wait_for(subscribers)) {
+            state.SkipWithError("Timeout while waiting for var delivery to all subscribers");
+            break;
+        }
+        recorder.add(clock_type::now() - start);
+    }
+    recorder.report(subscribers);
+}
+
+void BM_ErrorRaiseClear(benchmark::State& state) {
+    const auto validate_schema = state.range(0) != 0;
+    auto site = create_site(1, validate_schema);
+
+    DeliveryCounter deliveries;
+    site->get_consumer(0)
+        .get_error_manager_req(SyntheticSite::get_provider_requirement())
+        ->subscribe_error(
+            BENCH_ERROR_TYPE, [&deliveries](Everest::error::Error) { deliveries.delivered(); },
+            [&deliveries](Everest::error::Error) { deliveries.delivered(); });
+    site->start();
+
+    auto error_manager = site->get_provider().get_error_manager_impl(BENCH_IMPL_ID);
+    const auto error = site->get_provider().get_error_factory(BENCH_IMPL_ID)->create_error(
+        BENCH_ERROR_TYPE, "", "benchmark error", Everest::error::Severity::Low);
+
+    LatencyRecorder recorder(state);
+    for (auto _ : state) {
+        deliveries.reset();
+        const auto start = clock_type::now();
+        error_manager->raise_error(error);
+        error_manager->clear_error(BENCH_ERROR_TYPE);
+        if (!deliveries.wait_for(2)) {
+            state.SkipWithError("Timeout while waiting for error raise/clear delivery");
+            break;
+        }
+        recorder.add(clock_type::now() - start);
+    }
+    recorder.report(2);
+}
+
+void BM_StartupToGlobalReady(benchmark::State& state) {
+    const auto validate_schema = state.range(0) != 0;
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+
+    LatencyRecorder recorder(state);
+    for (auto _ : state) {
+        const auto start = clock_type::now();
+        auto site = create_site(consumers, validate_schema);
+        site->start();
+        recorder.add(clock_type::now() - start);
+
+        state.PauseTiming();
+        site.reset();
+        state.ResumeTiming();
+    }
+    recorder.report(consumers + 1);
+}
+} // namespace
+
+BENCHMARK(BM_CallCmdRoundTrip)->ArgName("validate")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(BM_PublishVarFanOut)
+    ->ArgNames({"validate", "subscribers"})
+    ->ArgsProduct({{0, 1}, {1, 8, 32}})
+    ->UseRealTime();
+BENCHMARK(BM_ErrorRaiseClear)->ArgName("validate")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(BM_StartupToGlobalReady)
+    ->ArgNames({"validate", "consumers"})
+    ->ArgsProduct({{0, 1}, {1, 16}})
+    ->Iterations(5)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return EXIT_FAILURE;
+    }
+
+    const auto work_dir = get_work_dir();
+    Everest::Logging::init(write_logging_config(work_dir).string(), "benchmarks");
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    fs::remove_all(work_dir);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <benchmarks/synthetic_site.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+#include <fmt/core.h>
+
+#include <everest/logging.hpp>
+
+namespace Everest {
+namespace benchmarks {
+
+namespace {
+constexpr auto STARTUP_TIMEOUT = std::chrono::seconds(30);
+constexpr auto PROVIDER_MODULE_ID = "provider";
+constexpr auto PROVIDER_MODULE_NAME = "BENCHProvider";
+constexpr auto CONSUMER_MODULE_NAME = "BENCHConsumer";
+
+void write_file(const fs::path& path, const std::string& content) {
+    fs::create_directories(path.parent_path());
+    std::ofstream file(path);
+    file << content;
+}
+
+std::string consumer_module_id(std::size_t index) {
+    return fmt::format("consumer_{}", index);
+}
+
+const std::string BENCH_INTERFACE_YAML = R"(description: Synthetic interface used by the framework benchmarks
+cmds:
+  echo:
+    description: Returns the given payload unchanged
+    arguments:
+      payload:
+        description: Arbitrary payload
+        type: object
+    result:
+      description: The unchanged payload
+      type: object
+vars:
+  sample:
+    description: A periodically published sample
+    type: object
+errors:
+  - reference: /errors/bench
+)";
+
+const std::string BENCH_ERRORS_YAML = R"(description: Errors of the synthetic benchmark interface
+errors:
+  - name: Flapping
+    description: An error that is raised and cleared in rapid succession
+)";
+
+const std::string PROVIDER_MANIFEST_YAML = R"(description: Synthetic provider module for the framework benchmarks
+provides:
+  main:
+    description: Implementation of the synthetic benchmark interface
+    interface: bench
+metadata:
+  license: https://opensource.org/licenses/Apache-2.0
+  authors:
+    - EVerest contributors
+)";
+
+const std::string CONSUMER_MANIFEST_YAML = R"(description: Synthetic consumer module for the framework benchmarks
+provides:
+  main:
+    description: Unused implementation, every module has to provide at least one
+    interface: bench
+requires:
+  provider:
+    interface: bench
+    min_connections: 1
+    max_connections: 1
+metadata:
+  license: https://opensource.org/licenses/Apache-2.0
+  authors:
+    - EVerest contributors
+)";
+
+const std::string LOGGING_INI = R"([Core]
+DisableLogging=false
+Filter="%Severity% >= ERRO"
+
+[Sinks.Console]
+Destination=Console
+Format="%TimeStamp% [%Severity%] %Process% %Message%"
+Asynchronous=false
+AutoFlush=true
+)";
+} // namespace
+
+fs::path write_logging_config(const fs::path& dir) {
+    const auto path = dir / "logging.ini";
+    write_file(path, LOGGING_INI);
+    return path;
+}
+
+SyntheticSite::SyntheticSite(const fs::path& work_dir, const std::string& broker_socket_path,
+                             const SiteOptions& options) :
+    prefix(work_dir / "prefix") {
+    generate_prefix(broker_socket_path, options);
+
+    this->manager_settings =
+        std::make_unique<ManagerSettings>(this->prefix.string(), (this->prefix / "config.yaml").string());
+    this->manager_config = std::make_unique<ManagerConfig>(*this->manager_settings);
+    this->mqtt_settings = this->manager_settings->mqtt_settings;
+
+    // stand-in for the manager, collects the module ready signals and publishes the global ready signal
+    this->manager_mqtt = std::make_shared<MQTTAbstraction>(this->mqtt_settings);
+    if (!this->manager_mqtt->connect()) {
+        throw std::runtime_error(fmt::format("Cannot connect to MQTT broker socket at {}", broker_socket_path));
+    }
+    this->manager_mqtt->spawn_main_loop_thread();
+
+    add_module(PROVIDER_MODULE_ID);
+    for (std::size_t i = 0; i < options.consumers; ++i) {
+        add_module(consumer_module_id(i));
+    }
+}
+
+SyntheticSite::~SyntheticSite() {
+    for (auto& module : this->modules) {
+        module.mqtt->disconnect();
+        module.mqtt->get_main_loop_future().wait();
+    }
+    this->manager_mqtt->disconnect();
+    this->manager_mqtt->get_main_loop_future().wait();
+}
+
+void SyntheticSite::start() {
+    for (auto& module : this->modules) {
+        module.everest->signal_ready();
+    }
+
+    std::unique_lock<std::mutex> lock(this->ready_mutex);
+    const auto all_ready = this->ready_cv.wait_for(
+        lock, STARTUP_TIMEOUT, [this]() { return this->modules_processed_ready == this->modules.size(); });
+    if (!all_ready) {
+        throw std::runtime_error("Timeout while waiting for the synthetic modules to become ready");
+    }
+}
+
+Everest& SyntheticSite::get_provider() {
+    return *this->modules.front().everest;
+}
+
+Everest& SyntheticSite::get_consumer(std::size_t index) {
+    return *this->modules.at(index + 1).everest;
+}
+
+std::size_t SyntheticSite::get_consumer_count() const {
+    return this->modules.size() - 1;
+}
+
+Requirement SyntheticSite::get_provider_requirement() {
+    return Requirement{BENCH_REQUIREMENT_ID, 0};
+}
+
+void SyntheticSite::generate_prefix(const std::string& broker_socket_path, const SiteOptions& options) {
+    fs::remove_all(this->prefix);
+
+    // same layout as the framework unit test directories
+    for (const auto* dir : {"etc/everest", "share/everest", "types", "www"}) {
+        fs::create_directories(this->prefix / dir);
+    }
+    const fs::path schemas_source_dir = EVEREST_BENCHMARK_SCHEMAS_DIR;
+    fs::copy(schemas_source_dir, this->prefix / "schemas", fs::copy_options::recursive);
+    fs::copy(schemas_source_dir / "migrations", this->prefix / "share/everest/migrations", fs::copy_options::recursive);
+
+    write_file(this->prefix / "interfaces" / "bench.yaml", BENCH_INTERFACE_YAML);
+    write_file(this->prefix / "errors" / "bench.yaml", BENCH_ERRORS_YAML);
+    write_file(this->prefix / "modules" / PROVIDER_MODULE_NAME / "manifest.yaml", PROVIDER_MANIFEST_YAML);
+    write_file(this->prefix / "modules" / CONSUMER_MODULE_NAME / "manifest.yaml", CONSUMER_MANIFEST_YAML);
+    write_logging_config(this->prefix);
+
+    std::string config = "active_modules:\n";
+    config += fmt::format("  {}:\n    module: {}\n", PROVIDER_MODULE_ID, PROVIDER_MODULE_NAME);
+    for (std::size_t i = 0; i < options.consumers; ++i) {
+        config += fmt::format("  {}:\n    module: {}\n", consumer_module_id(i), CONSUMER_MODULE_NAME);
+        config += fmt::format("    connections:\n      {}:\n        - module_id: {}\n          implementation_id: {}\n",
+                              BENCH_REQUIREMENT_ID, PROVIDER_MODULE_ID, BENCH_IMPL_ID);
+    }
+    config += "settings:\n";
+    config += "  interfaces_dir: \"interfaces\"\n";
+    config += "  modules_dir: \"modules\"\n";
+    config += "  types_dir: \"types\"\n";
+    config += "  errors_dir: \"errors\"\n";
+    config += "  schemas_dir: \"schemas\"\n";
+    config += "  www_dir: \"www\"\n";
+    config += "  logging_config_file: \"logging.ini\"\n";
+    config += fmt::format("  mqtt_broker_socket_path: \"{}\"\n", broker_socket_path);
+    config += fmt::format("  validate_schema: {}\n", options.validate_schema);
+    write_file(this->prefix / "config.yaml", config);
+}
+
+nlohmann::json SyntheticSite::get_serialized_config(const std::string& module_id) const {
+    // mirrors what a module assembles in get_module_config() from the retained topics published by the manager
+    const auto& config = *this->manager_config;
+    auto result = get_serialized_module_config(module_id, config.get_module_configurations());
+    result["interface_definitions"] = config.get_interface_definitions();
+    result["types"] = config.get_types();
+    result["settings"] = config.get_settings();
+    if (this->manager_settings->runtime_settings.validate_schema) {
+        result["schemas"] = config.get_schemas();
+    }
+    result["module_names"] = config.get_module_names();
+    auto manifests = config.get_manifests();
+    for (auto& manifest : manifests) {
+        manifest.erase("config");
+    }
+    result["manifests"] = manifests;
+    return result;
+}
+
+void SyntheticSite::add_module(const std::string& module_id) {
+    const auto& rs = this->manager_settings->runtime_settings;
+
+    auto mqtt = std::make_shared<MQTTAbstraction>(this->mqtt_settings);
+    if (!mqtt->connect()) {
+        throw std::runtime_error(fmt::format("Module {} cannot connect to the MQTT broker", module_id));
+    }
+    mqtt->spawn_main_loop_thread();
+
+    const auto config = Config(this->mqtt_settings, get_serialized_config(module_id));
+    auto everest = std::make_unique<Everest>(module_id, config, rs.validate_schema, mqtt, rs.telemetry_prefix,
+                                             rs.telemetry_enabled, rs.forward_exceptions);
+    everest->register_on_ready_handler([this]() { this->on_module_ready(); });
+
+    const Handler module_ready_handler = [this](const std::string&, const nlohmann::json&) {
+        std::size_t signalled_ready = 0;
+        {
+            const std::lock_guard<std::mutex> lock(this->ready_mutex);
+            signalled_ready = ++this->modules_signalled_ready;
+        }
+        if (signalled_ready == this->modules.size()) {
+            MqttMessagePayload payload{MqttMessageType::GlobalReady, nlohmann::json(true)};
+            this->manager_mqtt->publish(fmt::format("{}ready", this->mqtt_settings.everest_prefix), payload);
+        }
+    };
+    auto ready_token =
+        std::make_shared<TypedHandler>(HandlerType::ModuleReady, std::make_shared<Handler>(module_ready_handler));
+    this->manager_mqtt->register_handler(fmt::format("{}/ready", config.mqtt_module_prefix(module_id)), ready_token,
+                                         QOS::QOS2);
+    this->module_ready_tokens.push_back(ready_token);
+
+    this->modules.push_back({module_id, std::move(mqtt), std::move(everest)});
+}
+
+void SyntheticSite::on_module_ready() {
+    {
+        const std::lock_guard<std::mutex> lock(this->ready_mutex);
+        ++this->modules_processed_ready;
+    }
+    this->ready_cv.notify_all();
+}
+
+} // namespace benchmarks
+} // namespace Everest
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef UTILS_LOCAL_TRANSPORT_HPP
+#define UTILS_LOCAL_TRANSPORT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Everest {
+// forward declaration
+class ManagerConfig;
+
+/// \brief Name of the environment variable used to hand the local transport over to a module, contains
+/// "<module_id>:<routes fd>"
+inline constexpr auto EV_LOCAL_TRANSPORT = "EV_LOCAL_TRANSPORT";
+
+/// \brief Default size of the data area of a module inbox in bytes
+inline constexpr std::size_t LOCAL_TRANSPORT_INBOX_SIZE = 1024 * std::size_t{1024};
+
+/// \brief Maps an exact MQTT topic to the ids of the modules that receive it
+using LocalTransportRoutes = std::map<std::string, std::vector<std::string>>;
+
+///
+/// \brief Multi producer, single consumer ring buffer of topic/payload frames in a shared memory segment.
+///
+/// Producers from different processes are serialized by a robust, process-shared mutex in the segment header, the
+/// consumer reads without locking. Every successful write signals the doorbell eventfd of the ring.
+///
+class ShmRing {
+public:
+    ///
+    /// \brief Creates a new ring with a data area of \p capacity bytes (rounded up to a power of two)
+    static std::shared_ptr<ShmRing> create(const std::string& name, std::size_t capacity);
+
+    ///
+    /// \brief Maps an existing ring from its memory \p fd and doorbell \p doorbell_fd, takes ownership of both
+    static std::shared_ptr<ShmRing> attach(int fd, int doorbell_fd);
+
+    ~ShmRing();
+    ShmRing(ShmRing const&) = delete;
+    void operator=(ShmRing const&) = delete;
+
+    ///
+    /// \brief Appends a frame with the given \p topic and \p payload
+    /// \returns false if the frame does not fit into the free space of the ring
+    bool write(const std::string& topic, const std::string& payload);
+
+    ///
+    /// \brief Appends a frame with the given \p topic and \p payload to all \p rings or to none of them. The producer
+    /// locks are taken in the order of \p rings, all producers have to use the same order for the same rings.
+    /// \returns false if the frame does not fit into the free space of one of the rings
+    static bool write_all(const std::vector<std::shared_ptr<ShmRing>>& rings, const std::string& topic,
+                          const std::string& payload);
+
+    ///
+    /// \brief Removes all available frames from the ring and passes them to \p handler, only to be called by the
+    /// single consumer of the ring
+    /// \returns the number of frames read
+    std::size_t read(const std::function<void(std::string topic, std::string payload)>& handler);
+
+    ///
+    /// \brief Resets the doorbell, should be called before read() when woken up by the doorbell
+    void acknowledge() const;
+
+    /// \returns the fd of the shared memory segment
+    int get_fd() const;
+
+    /// \returns the doorbell eventfd that becomes readable when new frames are available
+    int get_doorbell_fd() const;
+
+private:
+    struct Header;
+
+    ShmRing(int fd, int doorbell_fd, void* mapping, std::size_t mapping_size);
+
+    int fd;
+    int doorbell_fd;
+    void* mapping;
+    std::size_t mapping_size;
+    Header* header;
+    std::uint8_t* data;
+
+    void lock_producers();
+    void unlock_producers();
+    bool has_space(std::size_t frame_size) const;
+    void append(std::size_t frame_size, const std::string& topic, const std::string& payload);
+    void copy_in(std::uint64_t position, const void* src, std::size_t size);
+    void copy_out(std::uint64_t position, void* dst, std::size_t size) const;
+};
+
+///
+/// \brief Set up by the manager: allocates one inbox per local module and computes which topics can be delivered
+/// between local modules without going through the MQTT broker
+///
+class LocalTransportHost {
+public:
+    ///
+    /// \brief Creates inboxes for all \p local_modules of the given \p config
+    LocalTransportHost(ManagerConfig& config, const std::set<std::string>& local_modules);
+    ~LocalTransportHost();
+
+    LocalTransportHost(LocalTransportHost const&) = delete;
+    void operator=(LocalTransportHost const&) = delete;
+
+    ///
+    /// \brief Prepares the environment of a forked child process for \p module_id before it calls exec, makes all
+    /// inboxes and the routing table inheritable
+    void prepare_child(const std::string& module_id) const;
+
+    /// \returns the number of topics that are routed between local modules
+    std::size_t get_route_count() const;
+
+    ///
+    /// \brief Computes the var, cmd and cmd response topics exchanged between modules in \p config. Topics that have
+    /// a receiver outside of \p local_modules are left out, they keep using the MQTT broker.
+    static LocalTransportRoutes compute_routes(ManagerConfig& config, const std::set<std::string>& local_modules);
+
+private:
+    std::map<std::string, std::shared_ptr<ShmRing>> inboxes;
+    LocalTransportRoutes routes;
+    int routes_fd{-1};
+};
+
+///
+/// \brief Module side of the local transport, delivers published messages directly into the inboxes of local
+/// receivers and collects messages from the own inbox
+///
+class LocalTransport {
+public:
+    ///
+    /// \brief Attaches to the local transport handed over by the manager in the EV_LOCAL_TRANSPORT environment
+    /// variable
+    /// \returns nullptr if the module has not been started with a local transport
+    static std::unique_ptr<LocalTransport> from_environment();
+
+    ///
+    /// \brief Delivers \p data to all local receivers of \p topic. Nothing is delivered if it does not fit into the
+    /// inbox of one of the receivers, the caller does not wait for full inboxes to drain.
+    /// \returns false if \p topic is not routed locally or could not be delivered and has to be published via MQTT
+    bool publish(const std::string& topic, const std::string& data);
+
+    ///
+    /// \brief Passes all messages waiting in the own inbox to \p handler
+    void receive(const std::function<void(std::string topic, std::string payload)>& handler);
+
+    /// \returns a fd that becomes readable when messages are waiting in the own inbox
+    int get_notification_fd() const;
+
+    /// \returns the number of locally routed messages that were handed back to MQTT because an inbox was full or the
+    /// message was larger than an inbox
+    std::uint64_t get_fallback_count() const;
+
+private:
+    LocalTransport() = default;
+
+    std::shared_ptr<ShmRing> inbox;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<ShmRing>>> routes;
+    std::atomic<std::uint64_t> fallbacks{0};
+};
+
+} // namespace Everest
+
+#endif // UTILS_LOCAL_TRANSPORT_HPP
@@ -15,6 +15,7 @@
 #include <mqtt.h>
 #include <nlohmann/json.hpp>
 
+#include <utils/local_transport.hpp>
 #include <utils/message_handler.hpp>
 #include <utils/message_queue.hpp>
 #include <utils/types.hpp>
@@ -163,6 +164,7 @@ private:
     struct mqtt_client mqtt_client;
     std::array<uint8_t, MQTT_BUF_SIZE> sendbuf;
     std::array<uint8_t, MQTT_BUF_SIZE> recvbuf;
+    std::unique_ptr<LocalTransport> local_transport; ///< set if the manager co-located this module with its peers
 
     static int open_nb_socket(const char* addr, const char* port);
     bool connectBroker(std::string& socket_path);
@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <utils/local_transport.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include <everest/exceptions.hpp>
+#include <everest/logging.hpp>
+
+#include <utils/config.hpp>
+
+namespace Everest {
+using json = nlohmann::json;
+
+namespace {
+constexpr std::uint32_t RING_MAGIC = 0x45564c54; // "EVLT"
+constexpr std::uint32_t RING_VERSION = 1;
+constexpr std::size_t FRAME_HEADER_SIZE = 2 * sizeof(std::uint32_t);
+constexpr std::size_t FRAME_ALIGNMENT = 8;
+
+std::size_t align_frame(std::size_t size) {
+    return (size + FRAME_ALIGNMENT - 1) & ~(FRAME_ALIGNMENT - 1);
+}
+
+std::size_t next_power_of_two(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void set_inheritable(int fd) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg): We have no good alternative to fcntl
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) & ~FD_CLOEXEC);
+}
+
+std::string read_fd_contents(int fd) {
+    struct stat st {};
+    if (fstat(fd, &st) != 0) {
+        throw EverestInternalError(fmt::format("Could not stat local transport routes: {}", strerror(errno)));
+    }
+    std::string contents(static_cast<std::size_t>(st.st_size), '\0');
+    if (pread(fd, contents.data(), contents.size(), 0) != static_cast<ssize_t>(contents.size())) {
+        throw EverestInternalError(fmt::format("Could not read local transport routes: {}", strerror(errno)));
+    }
+    return contents;
+}
+} // namespace
+
+struct ShmRing::Header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t capacity;
+    pthread_mutex_t producer_mutex;
+    alignas(64) std::atomic<std::uint64_t> head; // written by producers
+    alignas(64) std::atomic<std::uint64_t> tail; // written by the consumer
+};
+
+ShmRing::ShmRing(int fd, int doorbell_fd, void* mapping, std::size_t mapping_size) :
+    fd(fd),
+    doorbell_fd(doorbell_fd),
+    mapping(mapping),
+    mapping_size(mapping_size),
+    header(static_cast<Header*>(mapping)),
+    data(static_cast<std::uint8_t*>(mapping) + sizeof(Header)) {
+}
+
+ShmRing::~ShmRing() {
+    munmap(this->mapping, this->mapping_size);
+    close(this->fd);
+    close(this->doorbell_fd);
+}
+
+std::shared_ptr<ShmRing> ShmRing::create(const std::string& name, std::size_t capacity) {
+    capacity = next_power_of_two(capacity);
+    const auto mapping_size = sizeof(Header) + capacity;
+
+    const int fd = memfd_create(name.c_str(), MFD_CLOEXEC);
+    if (fd == -1) {
+        throw EverestInternalError(fmt::format("Could not create shared memory for {}: {}", name, strerror(errno)));
+    }
+    if (ftruncate(fd, static_cast<off_t>(mapping_size)) != 0) {
+        close(fd);
+        throw EverestInternalError(fmt::format("Could not size shared memory for {}: {}", name, strerror(errno)));
+    }
+    auto* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close(fd);
+        throw EverestInternalError(fmt::format("Could not map shared memory for {}: {}", name, strerror(errno)));
+    }
+    const int doorbell_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (doorbell_fd == -1) {
+        munmap(mapping, mapping_size);
+        close(fd);
+        throw EverestInternalError(fmt::format("Could not create doorbell for {}: {}", name, strerror(errno)));
+    }
+
+    auto* header = new (mapping) Header{}; // NOLINT(cppcoreguidelines-owning-memory): lives in the shared mapping
+    header->magic = RING_MAGIC;
+    header->version = RING_VERSION;
+    header->capacity = capacity;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&header->producer_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+    header->head.store(0);
+    header->tail.store(0);
+
+    return std::shared_ptr<ShmRing>(new ShmRing(fd, doorbell_fd, mapping, mapping_size));
+}
+
+std::shared_ptr<ShmRing> ShmRing::attach(int fd, int doorbell_fd) {
+    // make sure the fds do not leak into processes spawned by the module
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg): We have no good alternative to fcntl
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg): We have no good alternative to fcntl
+    fcntl(doorbell_fd, F_SETFD, fcntl(doorbell_fd, F_GETFD) | FD_CLOEXEC);
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 or static_cast<std::size_t>(st.st_size) <= sizeof(Header)) {
+        throw EverestInternalError("Invalid local transport shared memory segment");
+    }
+    const auto mapping_size = static_cast<std::size_t>(st.st_size);
+    auto* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        throw EverestInternalError(fmt::format("Could not map local transport shared memory: {}", strerror(errno)));
+    }
+    auto ring = std::shared_ptr<ShmRing>(new ShmRing(fd, doorbell_fd, mapping, mapping_size));
+    if (ring->header->magic != RING_MAGIC or ring->header->version != RING_VERSION or
+        ring->header->capacity + sizeof(Header) != mapping_size) {
+        throw EverestInternalError("Local transport shared memory segment has an unexpected layout");
+    }
+    return ring;
+}
+
+void ShmRing::copy_in(std::uint64_t position, const void* src, std::size_t size) {
+    const auto capacity = this->header->capacity;
+    const auto offset = static_cast<std::size_t>(position & (capacity - 1));
+    const auto first = std::min<std::size_t>(size, capacity - offset);
+    std::memcpy(this->data + offset, src, first);
+    std::memcpy(this->data, static_cast<const std::uint8_t*>(src) + first, size - first);
+}
+
+void ShmRing::copy_out(std::uint64_t position, void* dst, std::size_t size) const {
+    const auto capacity = this->header->capacity;
+    const auto offset = static_cast<std::size_t>(position & (capacity - 1));
+    const auto first = std::min<std::size_t>(size, capacity - offset);
+    std::memcpy(dst, this->data + offset, first);
+    std::memcpy(static_cast<std::uint8_t*>(dst) + first, this->data, size - first);
+}
+
+void ShmRing::lock_producers() {
+    if (pthread_mutex_lock(&this->header->producer_mutex) == EOWNERDEAD) {
+        // a producer died while holding the lock, head has not been published by it so the ring is consistent
+        pthread_mutex_consistent(&this->header->producer_mutex);
+    }
+}
+
+void ShmRing::unlock_producers() {
+    pthread_mutex_unlock(&this->header->producer_mutex);
+}
+
+bool ShmRing::has_space(std::size_t frame_size) const {
+    const auto head = this->header->head.load(std::memory_order_relaxed);
+    const auto tail = this->header->tail.load(std::memory_order_acquire);
+    return this->header->capacity - (head - tail) >= frame_size;
+}
+
+void ShmRing::append(std::size_t frame_size, const std::string& topic, const std::string& payload) {
+    const auto head = this->header->head.load(std::memory_order_relaxed);
+    const std::array<std::uint32_t, 2> sizes = {static_cast<std::uint32_t>(topic.size()),
+                                                static_cast<std::uint32_t>(payload.size())};
+    copy_in(head, sizes.data(), FRAME_HEADER_SIZE);
+    copy_in(head + FRAME_HEADER_SIZE, topic.data(), topic.size());
+    copy_in(head + FRAME_HEADER_SIZE + topic.size(), payload.data(), payload.size());
+    this->header->head.store(head + frame_size, std::memory_order_release);
+}
+
+bool ShmRing::write(const std::string& topic, const std::string& payload) {
+    const auto frame_size = align_frame(FRAME_HEADER_SIZE + topic.size() + payload.size());
+    if (frame_size > this->header->capacity) {
+        return false;
+    }
+
+    lock_producers();
+    const auto fits = has_space(frame_size);
+    if (fits) {
+        append(frame_size, topic, payload);
+    }
+    unlock_producers();
+
+    if (fits) {
+        eventfd_write(this->doorbell_fd, 1);
+    }
+    return fits;
+}
+
+bool ShmRing::write_all(const std::vector<std::shared_ptr<ShmRing>>& rings, const std::string& topic,
+                        const std::string& payload) {
+    const auto frame_size = align_frame(FRAME_HEADER_SIZE + topic.size() + payload.size());
+    for (const auto& ring : rings) {
+        if (frame_size > ring->header->capacity) {
+            return false;
+        }
+    }
+
+    for (const auto& ring : rings) {
+        ring->lock_producers();
+    }
+    const auto fits = std::all_of(rings.begin(), rings.end(),
+                                  [frame_size](const auto& ring) { return ring->has_space(frame_size); });
+    if (fits) {
+        for (const auto& ring : rings) {
+            ring->append(frame_size, topic, payload);
+        }
+    }
+    for (auto ring = rings.rbegin(); ring != rings.rend(); ++ring) {
+        (*ring)->unlock_producers();
+    }
+
+    if (fits) {
+        for (const auto& ring : rings) {
+            eventfd_write(ring->doorbell_fd, 1);
+        }
+    }
+    return fits;
+}
+
+std::size_t ShmRing::read(const std::function<void(std::string topic, std::string payload)>& handler) {
+    auto tail = this->header->tail.load(std::memory_order_relaxed);
+    const auto head = this->header->head.load(std::memory_order_acquire);
+
+    std::size_t frames = 0;
+    while (tail != head) {
+        std::array<std::uint32_t, 2> sizes{};
+        copy_out(tail, sizes.data(), FRAME_HEADER_SIZE);
+        std::string topic(sizes[0], '\0');
+        std::string payload(sizes[1], '\0');
+        copy_out(tail + FRAME_HEADER_SIZE, topic.data(), topic.size());
+        copy_out(tail + FRAME_HEADER_SIZE + topic.size(), payload.data(), payload.size());
+
+        tail += align_frame(FRAME_HEADER_SIZE + topic.size() + payload.size());
+        // release the space before dispatching, so producers are not blocked by slow handlers
+        this->header->tail.store(tail, std::memory_order_release);
+
+        handler(std::move(topic), std::move(payload));
+        ++frames;
+    }
+    return frames;
+}
+
+void ShmRing::acknowledge() const {
+    eventfd_t value = 0;
+    eventfd_read(this->doorbell_fd, &value);
+}
+
+int ShmRing::get_fd() const {
+    return this->fd;
+}
+
+int ShmRing::get_doorbell_fd() const {
+    return this->doorbell_fd;
+}
+
+LocalTransportHost::LocalTransportHost(ManagerConfig& config, const std::set<std::string>& local_modules) :
+    routes(compute_routes(config, local_modules)) {
+    BOOST_LOG_FUNCTION();
+
+    json routing_table = json::object();
+    routing_table["routes"] = this->routes;
+    routing_table["inboxes"] = json::object();
+    for (const auto& module_id : local_modules) {
+        auto inbox = ShmRing::create(fmt::format("everest-inbox-{}", module_id), LOCAL_TRANSPORT_INBOX_SIZE);
+        routing_table["inboxes"][module_id] = {inbox->get_fd(), inbox->get_doorbell_fd()};
+        this->inboxes.emplace(module_id, std::move(inbox));
+    }
+
+    const auto serialized = routing_table.dump();
+    this->routes_fd = memfd_create("everest-local-routes", MFD_CLOEXEC);
+    if (this->routes_fd == -1 or
+        ::write(this->routes_fd, serialized.data(), serialized.size()) != static_cast<ssize_t>(serialized.size())) {
+        throw EverestInternalError(fmt::format("Could not write local transport routes: {}", strerror(errno)));
+    }
+
+    EVLOG_info << fmt::format("Local transport set up for {} modules with {} locally routed topics",
+                              local_modules.size(), this->routes.size());
+}
+
+LocalTransportHost::~LocalTransportHost() {
+    if (this->routes_fd != -1) {
+        close(this->routes_fd);
+    }
+}
+
+void LocalTransportHost::prepare_child(const std::string& module_id) const {
+    if (this->inboxes.find(module_id) == this->inboxes.end()) {
+        return;
+    }
+    for (const auto& [id, inbox] : this->inboxes) {
+        set_inheritable(inbox->get_fd());
+        set_inheritable(inbox->get_doorbell_fd());
+    }
+    set_inheritable(this->routes_fd);
+    setenv(EV_LOCAL_TRANSPORT, fmt::format("{}:{}", module_id, this->routes_fd).c_str(), 1);
+}
+
+std::size_t LocalTransportHost::get_route_count() const {
+    return this->routes.size();
+}
+
+LocalTransportRoutes LocalTransportHost::compute_routes(ManagerConfig& config,
+                                                        const std::set<std::string>& local_modules) {
+    std::map<std::string, std::set<std::string>> receivers;
+    const auto& interface_definitions = config.get_interface_definitions();
+    const auto& manifests = config.get_manifests();
+
+    for (const auto& [module_id, module_config] : config.get_module_configurations()) {
+        for (const auto& [requirement_id, fulfillments] : module_config.connections) {
+            for (const auto& fulfillment : fulfillments) {
+                const auto& provider_name = config.get_module_name(fulfillment.module_id);
+                const auto& interface_name = manifests.at(provider_name)
+                                                 .at("provides")
+                                                 .at(fulfillment.implementation_id)
+                                                 .at("interface")
+                                                 .get<std::string>();
+                const auto& interface_definition = interface_definitions.at(interface_name);
+                const auto impl_prefix = config.mqtt_prefix(fulfillment.module_id, fulfillment.implementation_id);
+
+                // vars travel from the provider to every requiring module
+                for (const auto& var : interface_definition.value("vars", json::object()).items()) {
+                    receivers[fmt::format("{}/var/{}", impl_prefix, var.key())].insert(module_id);
+                }
+                // cmds travel to the provider, their results back to the caller
+                for (const auto& cmd : interface_definition.value("cmds", json::object()).items()) {
+                    const auto cmd_topic = fmt::format("{}/cmd/{}", impl_prefix, cmd.key());
+                    receivers[cmd_topic].insert(fulfillment.module_id);
+                    receivers[fmt::format("{}/response/{}", cmd_topic, module_id)].insert(module_id);
+                }
+            }
+        }
+    }
+
+    LocalTransportRoutes routes;
+    for (const auto& [topic, topic_receivers] : receivers) {
+        const auto all_local = std::all_of(topic_receivers.begin(), topic_receivers.end(),
+                                           [&local_modules](const auto& id) { return local_modules.count(id) != 0; });
+        if (all_local) {
+            routes.emplace(topic, std::vector<std::string>(topic_receivers.begin(), topic_receivers.end()));
+        }
+    }
+    return routes;
+}
+
+std::unique_ptr<LocalTransport> LocalTransport::from_environment() {
+    const auto* const env = std::getenv(EV_LOCAL_TRANSPORT);
+    if (env == nullptr) {
+        return nullptr;
+    }
+    const std::string value = env;
+    // do not hand the transport down to processes spawned by this module
+    unsetenv(EV_LOCAL_TRANSPORT);
+
+    const auto separator = value.rfind(':');
+    if (separator == std::string::npos) {
+        EVLOG_error << fmt::format("Ignoring malformed {}: {}", EV_LOCAL_TRANSPORT, value);
+        return nullptr;
+    }
+    const auto module_id = value.substr(0, separator);
+    const int routes_fd = std::stoi(value.substr(separator + 1));
+
+    const auto routing_table = json::parse(read_fd_contents(routes_fd));
+    close(routes_fd);
+
+    auto transport = std::unique_ptr<LocalTransport>(new LocalTransport());
+    std::map<std::string, std::shared_ptr<ShmRing>> inboxes;
+    for (const auto& inbox : routing_table.at("inboxes").items()) {
+        const auto& fds = inbox.value();
+        inboxes[inbox.key()] = ShmRing::attach(fds.at(0).get<int>(), fds.at(1).get<int>());
+    }
+    transport->inbox = inboxes.at(module_id);
+
+    // the receivers of a route are sorted by module id, so all modules lock the inboxes in the same order
+    for (const auto& route : routing_table.at("routes").items()) {
+        auto& rings = transport->routes[route.key()];
+        for (const auto& receiver : route.value()) {
+            rings.push_back(inboxes.at(receiver.get<std::string>()));
+        }
+    }
+
+    EVLOG_debug << fmt::format("Using local transport for {} topics", transport->routes.size());
+    return transport;
+}
+
+bool LocalTransport::publish(const std::string& topic, const std::string& data) {
+    const auto route = this->routes.find(topic);
+    if (route == this->routes.end()) {
+        return false;
+    }
+
+    // all receivers still subscribe via MQTT, so the message has to reach either all or none of the inboxes
+    if (not ShmRing::write_all(route->second, topic, data)) {
+        this->fallbacks++;
+        EVLOG_warning << fmt::format("Local transport inbox full, publishing message on topic {} via MQTT", topic);
+        return false;
+    }
+    return true;
+}
+
+void LocalTransport::receive(const std::function<void(std::string topic, std::string payload)>& handler) {
+    this->inbox->acknowledge();
+    this->inbox->read(handler);
+}
+
+int LocalTransport::get_notification_fd() const {
+    return this->inbox->get_doorbell_fd();
+}
+
+std::uint64_t LocalTransport::get_fallback_count() const {
+    return this->fallbacks.load();
+}
+
+} // namespace Everest
@@ -56,6 +56,8 @@ MQTTAbstractionImpl::MQTTAbstractionImpl(const std::string& mqtt_server_address,
     if (this->disconnect_event_fd == -1) {
         throw EverestInternalError("Could not setup eventfd for disconnect event");
     }
+
+    this->local_transport = LocalTransport::from_environment();
 }
 
 MQTTAbstractionImpl::MQTTAbstractionImpl(const std::string& mqtt_server_socket_path,
@@ -80,6 +82,8 @@ MQTTAbstractionImpl::MQTTAbstractionImpl(const std::string& mqtt_server_socket_p
     if (this->disconnect_event_fd == -1) {
         throw EverestInternalError("Could not setup eventfd for disconnect event");
     }
+
+    this->local_transport = LocalTransport::from_environment();
 }
 
 MQTTAbstractionImpl::~MQTTAbstractionImpl() {
@@ -137,6 +141,11 @@ void MQTTAbstractionImpl::publish(const std::string& topic, const std::string& d
 void MQTTAbstractionImpl::publish(const std::string& topic, const std::string& data, QOS qos, bool retain) {
     BOOST_LOG_FUNCTION();
 
+    // topics exchanged between co-located modules bypass the broker, retained topics always need the broker
+    if (not retain and this->local_transport != nullptr and this->local_transport->publish(topic, data)) {
+        return;
+    }
+
     auto publish_flags = 0;
     switch (qos) {
     case QOS::QOS0:
@@ -337,9 +346,12 @@ std::shared_future<void> MQTTAbstractionImpl::spawn_main_loop_thread() {
         try {
             while (this->mqtt_is_connected) {
                 eventfd_t eventfd_buffer; // NOLINT(cppcoreguidelines-init-variables) initialized by eventfd_read
-                std::array<struct pollfd, 3> pollfds = {{{this->mqtt_socket_fd, POLLIN, 0},
+                const auto local_fd =
+                    this->local_transport != nullptr ? this->local_transport->get_notification_fd() : -1;
+                std::array<struct pollfd, 4> pollfds = {{{this->mqtt_socket_fd, POLLIN, 0},
                                                          {this->event_fd, POLLIN, 0},
-                                                         {this->disconnect_event_fd, POLLIN, 0}}};
+                                                         {this->disconnect_event_fd, POLLIN, 0},
+                                                         {local_fd, POLLIN, 0}}};
                 auto retval = ::poll(pollfds.data(), pollfds.size(), mqtt_poll_timeout_ms);
 
                 if (retval >= 0) {
@@ -354,6 +366,13 @@ std::shared_future<void> MQTTAbstractionImpl::spawn_main_loop_thread() {
                             // FIXME (aw): check for failure
                             eventfd_read(this->event_fd, &eventfd_buffer);
                         }
+                        // messages from co-located modules are queued like the ones received from the broker
+                        if (pollfds[3].revents & POLLIN) {
+                            this->local_transport->receive([this](std::string topic, std::string payload) {
+                                this->message_queue.add(
+                                    std::unique_ptr<Message>(new Message{std::move(topic), std::move(payload)}));
+                            });
+                        }
                     }
 
                     if (retval == 0) {
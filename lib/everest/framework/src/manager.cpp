@@ -28,6 +28,7 @@
 #include <framework/everest.hpp>
 #include <framework/runtime.hpp>
 #include <utils/config.hpp>
+#include <utils/local_transport.hpp>
 #include <utils/mqtt_abstraction.hpp>
 #include <utils/status_fifo.hpp>
 
@@ -234,7 +235,8 @@ void exec_module(const RuntimeSettings& rs, const MQTTSettings& mqtt_settings, c
     }
 }
 
-std::map<pid_t, std::string> spawn_modules(const std::vector<ModuleStartInfo>& modules, const ManagerSettings& ms) {
+std::map<pid_t, std::string> spawn_modules(const std::vector<ModuleStartInfo>& modules, const ManagerSettings& ms,
+                                           const LocalTransportHost* local_transport) {
     std::map<pid_t, std::string> started_modules;
 
     const auto& rs = ms.runtime_settings;
@@ -247,6 +249,9 @@ std::map<pid_t, std::string> spawn_modules(const std::vector<ModuleStartInfo>& m
             // first, check if we need any capabilities
 
             try {
+                if (local_transport != nullptr) {
+                    local_transport->prepare_child(module.name);
+                }
                 exec_module(rs, ms.mqtt_settings, module, proc_handle);
             } catch (const std::exception& err) {
                 proc_handle.send_error_and_exit(err.what());
@@ -281,7 +286,8 @@ std::mutex modules_ready_mutex; // NOLINT(cppcoreguidelines-avoid-non-const-glob
 std::map<pid_t, std::string> start_modules(ManagerConfig& config, MQTTAbstraction& mqtt_abstraction,
                                            const std::vector<std::string>& ignored_modules,
                                            const std::vector<std::string>& standalone_modules,
-                                           const ManagerSettings& ms, StatusFifo& status_fifo, bool retain_topics) {
+                                           const ManagerSettings& ms, StatusFifo& status_fifo, bool retain_topics,
+                                           bool use_local_transport) {
     BOOST_LOG_FUNCTION();
 
     std::vector<ModuleStartInfo> modules_to_spawn;
@@ -488,7 +494,19 @@ std::map<pid_t, std::string> start_modules(ManagerConfig& config, MQTTAbstractio
         }
     }
 
-    return spawn_modules(modules_to_spawn, ms);
+    // the inboxes only have to outlive the fork of the modules, every module keeps its own references afterwards
+    std::unique_ptr<LocalTransportHost> local_transport;
+    if (use_local_transport) {
+        std::set<std::string> local_modules;
+        for (const auto& module : modules_to_spawn) {
+            if (module.language == ModuleStartInfo::Language::cpp) {
+                local_modules.insert(module.name);
+            }
+        }
+        local_transport = std::make_unique<LocalTransportHost>(config, local_modules);
+    }
+
+    return spawn_modules(modules_to_spawn, ms, local_transport.get());
 }
 
 void shutdown_modules(const std::map<pid_t, std::string>& modules, ManagerConfig& config,
@@ -703,6 +721,7 @@ int boot(const po::variables_map& vm) {
     }
 
     const bool retain_topics = (vm.count("retain-topics") != 0);
+    const bool use_local_transport = (vm.count("local-transport") != 0);
 
     const auto start_time = std::chrono::system_clock::now();
     std::shared_ptr<ManagerConfig> config; // TODO: maybe this can stay unique when we re-work start_modules()
@@ -797,7 +816,8 @@ int boot(const po::variables_map& vm) {
     auto config_service = std::make_unique<config::ConfigService>(mqtt_abstraction, config);
 
     auto module_handles =
-        start_modules(*config, mqtt_abstraction, ignored_modules, standalone_modules, ms, status_fifo, retain_topics);
+        start_modules(*config, mqtt_abstraction, ignored_modules, standalone_modules, ms, status_fifo, retain_topics,
+                      use_local_transport);
     bool modules_started = true;
     bool restart_modules = false;
 
@@ -864,7 +884,7 @@ int boot(const po::variables_map& vm) {
 #ifdef ENABLE_ADMIN_PANEL
         if (module_handles.size() == 0 && restart_modules) {
             module_handles = start_modules(*config, mqtt_abstraction, ignored_modules, standalone_modules, ms,
-                                           status_fifo, retain_topics);
+                                           status_fifo, retain_topics, use_local_transport);
             restart_modules = false;
             modules_started = true;
         }
@@ -934,6 +954,8 @@ int main(int argc, char* argv[]) {
                        "Path to a named pipe, that shall be used for status updates from the manager");
     desc.add_options()("retain-topics", "Retain configuration MQTT topics setup by manager for inspection, by default "
                                         "these will be cleared after startup");
+    desc.add_options()("local-transport", "Exchange vars and cmds between C++ modules started by this manager via "
+                                          "shared memory instead of the MQTT broker");
 
     po::variables_map vm;
 
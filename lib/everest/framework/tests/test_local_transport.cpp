@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/core.h>
+
+#include <tests/helpers.hpp>
+#include <utils/config.hpp>
+#include <utils/local_transport.hpp>
+
+namespace {
+std::vector<std::pair<std::string, std::string>> read_all(Everest::ShmRing& ring) {
+    std::vector<std::pair<std::string, std::string>> frames;
+    ring.read([&frames](std::string topic, std::string payload) {
+        frames.emplace_back(std::move(topic), std::move(payload));
+    });
+    return frames;
+}
+} // namespace
+
+SCENARIO("ShmRing passes frames from producers to the consumer", "[local_transport]") {
+    GIVEN("A small ring") {
+        auto ring = Everest::ShmRing::create("test-ring", 100);
+
+        THEN("Frames are read in the order they were written") {
+            CHECK(ring->write("a/topic", "{\"value\":1}"));
+            CHECK(ring->write("another/topic", ""));
+            const auto frames = read_all(*ring);
+            REQUIRE(frames.size() == 2);
+            CHECK(frames.at(0).first == "a/topic");
+            CHECK(frames.at(0).second == "{\"value\":1}");
+            CHECK(frames.at(1).first == "another/topic");
+            CHECK(frames.at(1).second.empty());
+            CHECK(read_all(*ring).empty());
+        }
+
+        THEN("Writing into a full ring fails until the consumer has read") {
+            const std::string payload(40, 'x');
+            CHECK(ring->write("t", payload));
+            CHECK(ring->write("t", payload));
+            CHECK_FALSE(ring->write("t", payload));
+            CHECK(read_all(*ring).size() == 2);
+            CHECK(ring->write("t", payload));
+        }
+
+        THEN("Frames that wrap around the end of the ring are read back unchanged") {
+            for (int i = 0; i < 20; i++) {
+                const auto payload = fmt::format("payload {}", std::string(static_cast<std::size_t>(i), '#'));
+                REQUIRE(ring->write("wrap", payload));
+                const auto frames = read_all(*ring);
+                REQUIRE(frames.size() == 1);
+                CHECK(frames.at(0).second == payload);
+            }
+        }
+
+        THEN("Frames larger than the ring are rejected") {
+            CHECK_FALSE(ring->write("t", std::string(200, 'x')));
+        }
+    }
+
+    GIVEN("A ring attached from the fds of another ring") {
+        auto ring = Everest::ShmRing::create("test-ring", 1024);
+        auto attached = Everest::ShmRing::attach(dup(ring->get_fd()), dup(ring->get_doorbell_fd()));
+
+        THEN("Frames written to one mapping are read from the other") {
+            CHECK(attached->write("shared", "data"));
+            const auto frames = read_all(*ring);
+            REQUIRE(frames.size() == 1);
+            CHECK(frames.at(0).first == "shared");
+            CHECK(frames.at(0).second == "data");
+        }
+    }
+}
+
+SCENARIO("ShmRing writes a frame to several rings or to none of them", "[local_transport]") {
+    GIVEN("A large and a small ring") {
+        auto large = Everest::ShmRing::create("test-ring-large", 1024);
+        auto small = Everest::ShmRing::create("test-ring-small", 100);
+        const std::vector<std::shared_ptr<Everest::ShmRing>> rings = {large, small};
+        const std::string payload(40, 'x');
+
+        THEN("A frame that fits into both rings is written to both") {
+            CHECK(Everest::ShmRing::write_all(rings, "t", payload));
+            CHECK(read_all(*large).size() == 1);
+            CHECK(read_all(*small).size() == 1);
+        }
+
+        THEN("A frame is not written to any ring if one of them is full") {
+            CHECK(Everest::ShmRing::write_all(rings, "t", payload));
+            CHECK(Everest::ShmRing::write_all(rings, "t", payload));
+            CHECK_FALSE(Everest::ShmRing::write_all(rings, "t", payload));
+            CHECK(read_all(*large).size() == 2);
+            CHECK(read_all(*small).size() == 2);
+            CHECK(Everest::ShmRing::write_all(rings, "t", payload));
+        }
+
+        THEN("A frame larger than one of the rings is rejected without writing it to the other") {
+            CHECK_FALSE(Everest::ShmRing::write_all(rings, "t", std::string(200, 'x')));
+            CHECK(read_all(*large).empty());
+        }
+    }
+}
+
+SCENARIO("LocalTransportHost computes the topics exchanged between local modules", "[local_transport]") {
+    auto bin_dir = Everest::tests::get_bin_dir().string() + "/";
+    auto ms = Everest::ManagerSettings(bin_dir + "two_module_test/", bin_dir + "two_module_test/config.yaml");
+    auto mc = Everest::ManagerConfig(ms);
+    const auto impl_prefix = fmt::format("{}modules/module_b/impl/impl1", ms.mqtt_settings.everest_prefix);
+
+    GIVEN("Both modules are local") {
+        const auto routes = Everest::LocalTransportHost::compute_routes(mc, {"module_a", "module_b"});
+
+        THEN("Vars, cmds and cmd responses are routed to their receivers") {
+            CHECK(routes.size() == 3);
+            CHECK(routes.at(impl_prefix + "/var/a_var") == std::vector<std::string>{"module_a"});
+            CHECK(routes.at(impl_prefix + "/cmd/a_cmd") == std::vector<std::string>{"module_b"});
+            CHECK(routes.at(impl_prefix + "/cmd/a_cmd/response/module_a") == std::vector<std::string>{"module_a"});
+        }
+    }
+
+    GIVEN("Only the providing module is local") {
+        const auto routes = Everest::LocalTransportHost::compute_routes(mc, {"module_b"});
+
+        THEN("Only the cmd topic is routed, everything received by the remote module stays on MQTT") {
+            CHECK(routes.size() == 1);
+            CHECK(routes.count(impl_prefix + "/cmd/a_cmd") == 1);
+        }
+    }
+}
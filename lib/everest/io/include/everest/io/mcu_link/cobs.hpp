@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+/** \file */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace everest::lib::io::mcu_link {
+
+/**
+ * @brief Upper bound of the encoded size of a frame, including the trailing delimiter
+ * @param[in] size Size of the unencoded data
+ * @return Maximum size of the encoded frame
+ */
+constexpr std::size_t cobs_max_encoded_size(std::size_t size) {
+    return size + size / 254 + 2;
+}
+
+/**
+ * @brief Encode data with
+ * <a href="https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing">COBS</a>
+ * @details The encoded frame including the trailing 0x00 delimiter is appended to \p out. Runs of non zero bytes are
+ * located with \p memchr and copied as a block instead of byte by byte.
+ * @param[in] data Pointer to the data
+ * @param[in] size Size of the data
+ * @param[in,out] out The encoded frame is appended to this buffer
+ */
+void cobs_encode(std::uint8_t const* data, std::size_t size, std::vector<std::uint8_t>& out);
+
+/**
+ * @brief Decode a single COBS frame in place
+ * @details The frame must not contain the trailing 0x00 delimiter. The decoded data starts at \p buffer and is
+ * never longer than the encoded data.
+ * @param[in,out] buffer The encoded frame. Is overwritten with the decoded data
+ * @param[in] size Size of the encoded frame
+ * @return Size of the decoded data. \p std::nullopt if the frame is malformed
+ */
+std::optional<std::size_t> cobs_decode(std::uint8_t* buffer, std::size_t size);
+
+/**
+ * cobs_decoder reassembles COBS frames from a stream of arbitrarily chunked data, e.g. as read from a serial port.
+ * Frame delimiters are searched in whole chunks, each complete frame is decoded in place and handed to the
+ * frame handler. Malformed and oversized frames are dropped and counted.
+ */
+class cobs_decoder {
+public:
+    /**
+     * @var cb_frame
+     * @brief Prototype of the handler for decoded frames. The data is valid for the duration of the call only.
+     */
+    using cb_frame = std::function<void(std::uint8_t* data, std::size_t size)>;
+
+    /**
+     * @brief Construct the decoder
+     * @param[in] max_frame_size Maximum size of a decoded frame. Bigger frames are dropped.
+     */
+    explicit cobs_decoder(std::size_t max_frame_size);
+
+    /**
+     * @brief Set the handler for decoded frames
+     * @param[in] handler The handler
+     */
+    void set_frame_handler(cb_frame const& handler);
+
+    /**
+     * @brief Feed received data into the decoder
+     * @details The frame handler is called for each complete frame in the data. Incomplete frames are buffered until
+     * the next call. Empty frames, i.e. consecutive delimiters, are skipped silently.
+     * @param[in] data Pointer to the data
+     * @param[in] size Size of the data
+     */
+    void feed(std::uint8_t const* data, std::size_t size);
+
+    /**
+     * @brief Drop any partially received frame
+     */
+    void reset();
+
+    /**
+     * @brief Number of frames that could not be decoded
+     * @return The number of malformed frames
+     */
+    std::uint64_t framing_errors() const;
+
+    /**
+     * @brief Number of frames that exceeded the maximum frame size
+     * @return The number of dropped oversized frames
+     */
+    std::uint64_t oversized_frames() const;
+
+private:
+    void commit_frame();
+
+    std::vector<std::uint8_t> m_buffer;
+    std::size_t m_max_encoded_size;
+    cb_frame m_handler;
+    bool m_dropping{false};
+    std::uint64_t m_framing_errors{0};
+    std::uint64_t m_oversized_frames{0};
+};
+
+} // namespace everest::lib::io::mcu_link
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+/** \file */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace everest::lib::io::mcu_link {
+
+/**
+ * @brief Calculate the CRC-32/JAMCRC of the data
+ * @details Reflected polynomial 0xEDB88320, initial value 0xFFFFFFFF and no final XOR.
+ * This is the checksum used by the COBS/protobuf links of the EVerest board support MCUs.
+ * @param[in] data Pointer to the data
+ * @param[in] size Size of the data
+ * @return The checksum
+ */
+std::uint32_t crc32_jamcrc(std::uint8_t const* data, std::size_t size);
+
+/**
+ * @brief Append the CRC-32/JAMCRC of the data in little endian byte order
+ * @param[in,out] data The data. The four bytes of the checksum are appended.
+ */
+void append_crc32(std::vector<std::uint8_t>& data);
+
+/**
+ * @brief Check data that ends with its little endian CRC-32/JAMCRC
+ * @details The CRC over data and checksum is zero for valid data.
+ * @param[in] data Pointer to the data including the checksum
+ * @param[in] size Size of the data including the checksum
+ * @return True if the checksum matches, false otherwise
+ */
+bool check_crc32(std::uint8_t const* data, std::size_t size);
+
+} // namespace everest::lib::io::mcu_link
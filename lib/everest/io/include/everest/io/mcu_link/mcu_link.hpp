@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+/** \file */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <everest/io/event/fd_event_handler.hpp>
+#include <everest/io/event/fd_event_sync_interface.hpp>
+#include <everest/io/event/timer_fd.hpp>
+#include <everest/io/mcu_link/cobs.hpp>
+#include <everest/io/serial/event_serial.hpp>
+#include <everest/util/async/monitor.hpp>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace everest::lib::io::mcu_link {
+
+/**
+ * @brief Build a frame for transmission
+ * @details Appends the CRC-32/JAMCRC to the payload and encodes the result with COBS, including the trailing
+ * delimiter.
+ * @param[in] data Pointer to the payload
+ * @param[in] size Size of the payload
+ * @param[out] out The encoded frame. Previous content is discarded.
+ */
+void encode_frame(std::uint8_t const* data, std::size_t size, std::vector<std::uint8_t>& out);
+
+/**
+ * @struct link_statistics
+ * Health information of a \ref mcu_link
+ */
+struct link_statistics {
+    /** bytes read from the serial port */
+    std::uint64_t rx_bytes{0};
+    /** bytes queued for transmission on the serial port */
+    std::uint64_t tx_bytes{0};
+    /** frames received with valid checksum */
+    std::uint64_t rx_frames{0};
+    /** frames queued for transmission on the serial port */
+    std::uint64_t tx_frames{0};
+    /** frames received with invalid checksum */
+    std::uint64_t crc_errors{0};
+    /** frames that could not be COBS decoded */
+    std::uint64_t framing_errors{0};
+    /** frames dropped for exceeding the maximum frame size */
+    std::uint64_t oversized_frames{0};
+    /** requests that did not receive a response in time */
+    std::uint64_t request_timeouts{0};
+    /** times the link timeout handler was called */
+    std::uint64_t link_timeouts{0};
+};
+
+/**
+ * mcu_link implements the framed serial link used by board support packages to talk to their MCU. Frames are
+ * protected by CRC-32/JAMCRC and delimited with COBS. The payload is opaque to the link, typically it is a nanopb
+ * encoded message. <br>
+ * All I/O, timeouts and periodic actions are handled by a single event loop, which is driven either via \ref run or
+ * by registering the link with an external \ref event::fd_event_handler. All callbacks are called from this
+ * event loop. All public functions are thread safe.
+ */
+class mcu_link : public event::fd_event_sync_interface {
+public:
+    /**
+     * @var payload
+     * @brief Type of the payload of a frame
+     */
+    using payload = std::vector<std::uint8_t>;
+
+    /**
+     * @var cb_frame
+     * @brief Prototype of the handler for received frames
+     */
+    using cb_frame = std::function<void(payload const& frame)>;
+
+    /**
+     * @var response_matcher
+     * @brief Prototype of a function deciding whether a received frame is the response to a request
+     */
+    using response_matcher = std::function<bool(payload const& frame)>;
+
+    /**
+     * @var cb_response
+     * @brief Prototype of the handler for responses. Called with \p std::nullopt if the request timed out.
+     */
+    using cb_response = std::function<void(std::optional<payload> const& response)>;
+
+    /**
+     * @var cb_error
+     * @brief Prototype of the error handler
+     */
+    using cb_error = serial::event_serial::cb_error;
+
+    /**
+     * @var cb_action
+     * @brief Prototype for link timeout handlers and periodic actions
+     */
+    using cb_action = std::function<void()>;
+
+    /**
+     * @var clock
+     * @brief Clock used for all timeouts
+     */
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct the link
+     * @param[in] max_frame_size Maximum size of a frame including the checksum. Bigger frames are dropped.
+     */
+    explicit mcu_link(std::size_t max_frame_size = 2048);
+    ~mcu_link();
+
+    /**
+     * @brief Open the serial port
+     * @details May be called again to reopen the port. Any partially received frame is dropped.
+     * @param[in] device Path of the device, e.g. /dev/ttyUSB0
+     * @param[in] baud The baud rate
+     * @return True on success, false otherwise
+     */
+    bool open(std::string const& device, int baud);
+
+    /**
+     * @brief Check if the serial port is open
+     * @return True if open, false otherwise
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Send a frame
+     * @details Encoding happens in the calling thread, the frame is queued for transmission by the event loop.
+     * @param[in] data The payload
+     * @return False if the link is not open or the payload is too big. True otherwise
+     */
+    bool send(payload const& data);
+
+    /**
+     * @brief Send a request and wait asynchronously for the response
+     * @details Every received frame is offered to the pending requests in the order they were sent. The first
+     * request whose \p matcher accepts the frame consumes it, the frame is not passed to the frame handler.
+     * The \p handler is called exactly once, with the response or with \p std::nullopt after \p timeout.
+     * @param[in] data The payload of the request
+     * @param[in] matcher Function identifying the response
+     * @param[in] timeout Maximum time to wait for the response
+     * @param[in] handler Callback for the response
+     * @return False if the request could not be sent. The handler is not called in this case.
+     */
+    template <class Rep, class Period>
+    bool request(payload const& data, response_matcher const& matcher, std::chrono::duration<Rep, Period> timeout,
+                 cb_response const& handler) {
+        return request_impl(data, matcher, std::chrono::duration_cast<clock::duration>(timeout), handler);
+    }
+
+    /**
+     * @brief Set the handler for received frames
+     * @details The checksum is already removed from the frame
+     * @param[in] handler The handler
+     */
+    void set_frame_handler(cb_frame const& handler);
+
+    /**
+     * @brief Set the error handler
+     * @details The error handler is called when an error on the serial port occurs or is cleared
+     * @param[in] handler The handler
+     */
+    void set_error_handler(cb_error const& handler);
+
+    /**
+     * @brief Monitor the link for silence
+     * @details The \p handler is called when no valid frame has been received for \p timeout and then again
+     * every \p timeout for as long as the link stays silent.
+     * @param[in] timeout Maximum time between two valid frames
+     * @param[in] handler The handler
+     */
+    template <class Rep, class Period>
+    void set_link_timeout(std::chrono::duration<Rep, Period> timeout, cb_action const& handler) {
+        set_link_timeout_impl(std::chrono::duration_cast<clock::duration>(timeout), handler);
+    }
+
+    /**
+     * @brief Call a function periodically from the event loop, e.g. to send keep alive frames
+     * @param[in] interval The interval
+     * @param[in] action The function
+     */
+    template <class Rep, class Period>
+    void add_periodic_action(std::chrono::duration<Rep, Period> interval, cb_action const& action) {
+        add_periodic_action_impl(std::chrono::duration_cast<clock::duration>(interval), action);
+    }
+
+    /**
+     * @brief Drop any partially received frame, e.g. after a reset of the MCU
+     */
+    void reset_decoder();
+
+    /**
+     * @brief Discard all data received but not read and written but not transmitted
+     */
+    void flush();
+
+    /**
+     * @brief Get the health information of the link
+     * @return Copy of the current statistics
+     */
+    link_statistics get_statistics();
+
+    /**
+     * @brief Run the event loop
+     * @details Blocks until \p online is false. Call \ref interrupt after resetting \p online to return
+     * immediately.
+     * @param[in] online Flag to control the event loop
+     */
+    void run(std::atomic_bool& online);
+
+    /**
+     * @brief Wake up the event loop
+     */
+    void interrupt();
+
+    /**
+     * @brief Access to the internal event handler
+     * @details Call \ref sync on read (POLLIN/EPOLLIN).
+     * @return The file descriptor of the internal event handler
+     */
+    int get_poll_fd() override;
+
+    /**
+     * @brief Sync the internal event handler
+     * @details Blocks until an event occurs. May not be called in any registered callback.
+     * @return Result of sync operation
+     */
+    event::sync_status sync() override;
+
+private:
+    struct pending_request {
+        response_matcher matcher;
+        cb_response handler;
+        clock::time_point deadline;
+    };
+
+    struct periodic_action {
+        event::timer_fd timer;
+        cb_action action;
+    };
+
+    bool request_impl(payload const& data, response_matcher const& matcher, clock::duration timeout,
+                      cb_response const& handler);
+    void set_link_timeout_impl(clock::duration timeout, cb_action const& handler);
+    void add_periodic_action_impl(clock::duration interval, cb_action const& action);
+
+    void handle_rx(payload const& data);
+    void handle_frame(std::uint8_t* data, std::size_t size);
+    void handle_request_timer();
+    void handle_link_timer();
+    void transmit(payload const& frame);
+    void arm_request_timer();
+    void update_decoder_statistics();
+
+    static void arm_timer(event::timer_fd& timer, clock::duration timeout);
+
+    event::fd_event_handler m_handler;
+    event::timer_fd m_request_timer;
+    event::timer_fd m_link_timer;
+
+    std::shared_ptr<serial::event_serial> m_serial;
+    bool m_serial_ready{false};
+    std::vector<payload> m_tx_backlog;
+    std::atomic_bool m_open{false};
+    std::size_t m_max_frame_size;
+
+    cobs_decoder m_decoder;
+    payload m_frame;
+    cb_frame m_frame_handler;
+    cb_error m_error_handler;
+
+    std::list<pending_request> m_pending_requests;
+
+    cb_action m_link_timeout_handler;
+    clock::duration m_link_timeout{};
+    clock::time_point m_last_rx;
+
+    std::list<periodic_action> m_periodic_actions;
+
+    util::monitor<link_statistics> m_statistics;
+};
+
+} // namespace everest::lib::io::mcu_link
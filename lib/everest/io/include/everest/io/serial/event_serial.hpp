@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+/** \file */
+
+#pragma once
+
+#include <everest/io/event/fd_event_client.hpp>
+#include <everest/io/serial/serial_port_handler.hpp>
+
+namespace everest::lib::io::serial {
+
+/**
+ * @var event_serial
+ * @brief Client for serial ports implemented in terms of \ref event::fd_event_client
+ * and \ref serial::serial_port_handler
+ */
+using event_serial = event::fd_event_client<serial_port_handler>::type;
+
+} // namespace everest::lib::io::serial
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+/** \file */
+
+#pragma once
+#include <cstdint>
+#include <everest/io/event/unique_fd.hpp>
+#include <optional>
+#include <string>
+#include <termios.h>
+#include <vector>
+
+namespace everest::lib::io::serial {
+
+/**
+ * @brief Map a baud rate to the corresponding termios speed constant
+ * @param[in] baud The baud rate, e.g. 115200
+ * @return The speed constant, e.g. B115200. \p std::nullopt if the baud rate is not supported
+ */
+std::optional<speed_t> to_termios_speed(int baud);
+
+/**
+ * @brief Configure a serial port for raw 8N1 binary transfers
+ * @details Refer to <a href="https://man7.org/linux/man-pages/man3/termios.3.html">termios</a>
+ * The port is set to raw mode via \p cfmakeraw, with 8 data bits, no parity, 1 stop bit, no hardware or software flow
+ * control and modem control lines ignored.
+ * @param[in] fd The file descriptor of the serial port
+ * @param[in] speed The termios speed constant
+ * @return True on success, false otherwise
+ */
+bool set_raw_serial_attributes(int fd, speed_t speed);
+
+/**
+ * serial_port_handler bundles basic functionality for serial ports like UARTs or the slave side of a
+ * <a href="https://man7.org/linux/man-pages/man7/pty.7.html">PTY</a>. This includes lifetime management,
+ * reading, writing and fundamental error checking. <br>
+ * Although this class can be used on its own, the main purpose is to implement the
+ * \p ClientPolicy of \ref event::fd_event_client
+ */
+class serial_port_handler {
+public:
+    /**
+     * @var PayloadT
+     * @brief Type of the payload for tX and RX operations
+     */
+    using PayloadT = std::vector<uint8_t>;
+
+    /**
+     * @brief The class is default constructed
+     */
+    serial_port_handler() = default;
+    ~serial_port_handler() = default;
+
+    /**
+     * @brief Write a dataset to the serial port
+     * @details Implementation for \p ClientPolicy
+     * @param[in] data Payload
+     * @return True on success, False on failure and partial writes.
+     */
+    bool tx(PayloadT& data);
+
+    /**
+     * @brief Read a dataset from the serial port
+     * @details Implementation for \p ClientPolicy
+     * @param[in] data Payload
+     * @return True on success, False otherwise.
+     */
+    bool rx(PayloadT& data);
+
+    /**
+     * @brief Open the serial port in non blocking mode and configure it via \ref set_raw_serial_attributes
+     * @details Implementation for \p ClientPolicy
+     * @param[in] device Path of the device, e.g. /dev/ttyUSB0
+     * @param[in] baud The baud rate
+     * @return True on success, false otherwise.
+     */
+    bool open(std::string const& device, int baud);
+
+    /**
+     * @brief Discard all data received but not read and written but not transmitted
+     * @return True on success, false otherwise.
+     */
+    bool flush();
+
+    /**
+     * @brief Get the file descriptor
+     * @details Implementation for ClientPolicy
+     * @return file descriptor
+     */
+    int get_fd() const;
+
+    /**
+     * @brief Get the current error
+     * @details Implementation for \p ClientPolicy
+     * @return The last errno. Zero if there is no error.
+     */
+    int get_error() const;
+
+private:
+    event::unique_fd m_fd;
+    int error_id{0};
+    static constexpr size_t buffer_size_limit = 2048;
+};
+
+} // namespace everest::lib::io::serial
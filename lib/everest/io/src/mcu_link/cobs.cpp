@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <algorithm>
+#include <cstring>
+#include <everest/io/mcu_link/cobs.hpp>
+
+namespace everest::lib::io::mcu_link {
+
+namespace {
+// Longest run of non zero bytes in a single COBS block
+constexpr std::size_t max_run = 254;
+} // namespace
+
+void cobs_encode(std::uint8_t const* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    out.reserve(out.size() + cobs_max_encoded_size(size));
+    auto ptr = data;
+    auto const end = data + size;
+    while (true) {
+        auto const window = std::min<std::size_t>(end - ptr, max_run);
+        auto const zero = static_cast<std::uint8_t const*>(std::memchr(ptr, 0, window));
+        auto const run = zero ? static_cast<std::size_t>(zero - ptr) : window;
+        out.push_back(static_cast<std::uint8_t>(run + 1));
+        out.insert(out.end(), ptr, ptr + run);
+        ptr += run;
+        if (zero) {
+            // The zero is encoded implicitly by the code of this block
+            ++ptr;
+            continue;
+        }
+        if (ptr == end) {
+            break;
+        }
+        // A full block without zero. The next block follows without an implicit zero.
+    }
+    out.push_back(0x00);
+}
+
+std::optional<std::size_t> cobs_decode(std::uint8_t* buffer, std::size_t size) {
+    std::size_t read = 0;
+    std::size_t write = 0;
+    while (read < size) {
+        auto const code = buffer[read];
+        if (code == 0 or read + code > size) {
+            return std::nullopt;
+        }
+        auto const run = static_cast<std::size_t>(code - 1);
+        std::memmove(buffer + write, buffer + read + 1, run);
+        write += run;
+        read += code;
+        if (code != max_run + 1 and read < size) {
+            buffer[write++] = 0x00;
+        }
+    }
+    return write;
+}
+
+cobs_decoder::cobs_decoder(std::size_t max_frame_size) :
+    m_max_encoded_size(cobs_max_encoded_size(max_frame_size) - 1) {
+    m_buffer.reserve(m_max_encoded_size);
+}
+
+void cobs_decoder::set_frame_handler(cb_frame const& handler) {
+    m_handler = handler;
+}
+
+void cobs_decoder::feed(std::uint8_t const* data, std::size_t size) {
+    while (size > 0) {
+        auto const delimiter = static_cast<std::uint8_t const*>(std::memchr(data, 0, size));
+        auto const chunk = delimiter ? static_cast<std::size_t>(delimiter - data) : size;
+
+        if (not m_dropping) {
+            if (m_buffer.size() + chunk > m_max_encoded_size) {
+                // Skip everything up to the next delimiter
+                m_dropping = true;
+                m_buffer.clear();
+                ++m_oversized_frames;
+            } else {
+                m_buffer.insert(m_buffer.end(), data, data + chunk);
+            }
+        }
+
+        if (not delimiter) {
+            return;
+        }
+
+        if (m_dropping) {
+            m_dropping = false;
+        } else {
+            commit_frame();
+        }
+        m_buffer.clear();
+        data += chunk + 1;
+        size -= chunk + 1;
+    }
+}
+
+void cobs_decoder::reset() {
+    m_buffer.clear();
+    m_dropping = false;
+}
+
+std::uint64_t cobs_decoder::framing_errors() const {
+    return m_framing_errors;
+}
+
+std::uint64_t cobs_decoder::oversized_frames() const {
+    return m_oversized_frames;
+}
+
+void cobs_decoder::commit_frame() {
+    if (m_buffer.empty()) {
+        return;
+    }
+    auto decoded_size = cobs_decode(m_buffer.data(), m_buffer.size());
+    if (not decoded_size.has_value()) {
+        ++m_framing_errors;
+        return;
+    }
+    if (m_handler) {
+        m_handler(m_buffer.data(), decoded_size.value());
+    }
+}
+
+} // namespace everest::lib::io::mcu_link
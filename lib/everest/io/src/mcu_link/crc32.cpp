@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <array>
+#include <everest/io/mcu_link/crc32.hpp>
+
+namespace everest::lib::io::mcu_link {
+
+namespace {
+
+constexpr std::uint32_t polynomial = 0xEDB88320;
+
+constexpr std::array<std::uint32_t, 256> make_table() {
+    std::array<std::uint32_t, 256> table{};
+    for (std::uint32_t i = 0; i < table.size(); ++i) {
+        auto crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr auto table = make_table();
+
+} // namespace
+
+std::uint32_t crc32_jamcrc(std::uint8_t const* data, std::size_t size) {
+    std::uint32_t crc = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+void append_crc32(std::vector<std::uint8_t>& data) {
+    auto crc = crc32_jamcrc(data.data(), data.size());
+    for (int i = 0; i < 4; ++i) {
+        data.push_back(static_cast<std::uint8_t>(crc & 0xFF));
+        crc >>= 8;
+    }
+}
+
+bool check_crc32(std::uint8_t const* data, std::size_t size) {
+    return size >= 4 and crc32_jamcrc(data, size) == 0;
+}
+
+} // namespace everest::lib::io::mcu_link
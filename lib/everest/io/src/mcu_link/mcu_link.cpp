@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <algorithm>
+#include <everest/io/mcu_link/crc32.hpp>
+#include <everest/io/mcu_link/mcu_link.hpp>
+
+namespace everest::lib::io::mcu_link {
+
+namespace {
+// Size of the CRC-32 appended to each frame
+constexpr std::size_t crc_size = 4;
+// Frames queued while the serial port is not ready yet
+constexpr std::size_t max_tx_backlog = 32;
+} // namespace
+
+void encode_frame(std::uint8_t const* data, std::size_t size, std::vector<std::uint8_t>& out) {
+    std::vector<std::uint8_t> raw;
+    raw.reserve(size + crc_size);
+    raw.assign(data, data + size);
+    append_crc32(raw);
+    out.clear();
+    cobs_encode(raw.data(), raw.size(), out);
+}
+
+mcu_link::mcu_link(std::size_t max_frame_size) : m_max_frame_size(max_frame_size), m_decoder(max_frame_size) {
+    m_frame.reserve(max_frame_size);
+    m_decoder.set_frame_handler([this](auto data, auto size) { handle_frame(data, size); });
+    m_handler.register_event_handler(&m_request_timer, [this](auto const&) { handle_request_timer(); });
+    m_handler.register_event_handler(&m_link_timer, [this](auto const&) { handle_link_timer(); });
+}
+
+mcu_link::~mcu_link() = default;
+
+bool mcu_link::open(std::string const& device, int baud) {
+    auto client = std::make_shared<serial::event_serial>(device, baud);
+    auto const& raw = client->get_raw_handler();
+    if (not raw or raw->get_fd() == -1) {
+        m_open = false;
+        return false;
+    }
+
+    client->set_rx_handler([this](auto const& data, auto&) { handle_rx(data); });
+    // The client is only ready for transmission after the first sync. Both callbacks are called from the event loop.
+    client->set_on_ready_action([this]() {
+        m_serial_ready = true;
+        for (auto const& frame : m_tx_backlog) {
+            transmit(frame);
+        }
+        m_tx_backlog.clear();
+    });
+    client->set_error_handler([this](int error, std::string const& msg) {
+        if (error != 0) {
+            m_serial_ready = false;
+        }
+        if (m_error_handler) {
+            m_error_handler(error, msg);
+        }
+    });
+
+    m_handler.add_action([this, client]() {
+        if (m_serial) {
+            m_handler.unregister_event_handler(m_serial.get());
+        }
+        m_serial = client;
+        m_serial_ready = false;
+        m_handler.register_event_handler(m_serial.get());
+        m_decoder.reset();
+        m_last_rx = clock::now();
+    });
+    m_open = true;
+    return true;
+}
+
+bool mcu_link::is_open() const {
+    return m_open;
+}
+
+bool mcu_link::send(payload const& data) {
+    if (not m_open or data.size() + crc_size > m_max_frame_size) {
+        return false;
+    }
+    payload frame;
+    encode_frame(data.data(), data.size(), frame);
+    m_handler.add_action([this, frame = std::move(frame)]() { transmit(frame); });
+    return true;
+}
+
+bool mcu_link::request_impl(payload const& data, response_matcher const& matcher, clock::duration timeout,
+                            cb_response const& handler) {
+    if (not m_open or data.size() + crc_size > m_max_frame_size) {
+        return false;
+    }
+    payload frame;
+    encode_frame(data.data(), data.size(), frame);
+    m_handler.add_action([this, frame = std::move(frame), matcher, timeout, handler]() {
+        m_pending_requests.push_back({matcher, handler, clock::now() + timeout});
+        transmit(frame);
+        arm_request_timer();
+    });
+    return true;
+}
+
+void mcu_link::set_frame_handler(cb_frame const& handler) {
+    m_handler.add_action([this, handler]() { m_frame_handler = handler; });
+}
+
+void mcu_link::set_error_handler(cb_error const& handler) {
+    m_handler.add_action([this, handler]() { m_error_handler = handler; });
+}
+
+void mcu_link::set_link_timeout_impl(clock::duration timeout, cb_action const& handler) {
+    m_handler.add_action([this, timeout, handler]() {
+        m_link_timeout = timeout;
+        m_link_timeout_handler = handler;
+        m_last_rx = clock::now();
+        if (handler) {
+            arm_timer(m_link_timer, timeout);
+        } else {
+            m_link_timer.set_timeout_ns(0);
+        }
+    });
+}
+
+void mcu_link::add_periodic_action_impl(clock::duration interval, cb_action const& action) {
+    m_handler.add_action([this, interval, action]() {
+        auto& item = m_periodic_actions.emplace_back();
+        item.action = action;
+        arm_timer(item.timer, interval);
+        m_handler.register_event_handler(&item.timer, [&item](auto const&) { item.action(); });
+    });
+}
+
+void mcu_link::reset_decoder() {
+    m_handler.add_action([this]() { m_decoder.reset(); });
+}
+
+void mcu_link::flush() {
+    m_handler.add_action([this]() {
+        if (m_serial and m_serial->get_raw_handler()) {
+            m_serial->get_raw_handler()->flush();
+        }
+        m_decoder.reset();
+    });
+}
+
+link_statistics mcu_link::get_statistics() {
+    return *m_statistics.handle();
+}
+
+void mcu_link::run(std::atomic_bool& online) {
+    m_handler.run(online);
+}
+
+void mcu_link::interrupt() {
+    m_handler.add_action([]() {});
+}
+
+int mcu_link::get_poll_fd() {
+    return m_handler.get_poll_fd();
+}
+
+event::sync_status mcu_link::sync() {
+    m_handler.run_once();
+    return event::sync_status::ok;
+}
+
+void mcu_link::handle_rx(payload const& data) {
+    m_statistics.handle()->rx_bytes += data.size();
+    m_decoder.feed(data.data(), data.size());
+    update_decoder_statistics();
+}
+
+void mcu_link::handle_frame(std::uint8_t* data, std::size_t size) {
+    if (not check_crc32(data, size)) {
+        m_statistics.handle()->crc_errors++;
+        return;
+    }
+    m_statistics.handle()->rx_frames++;
+    m_last_rx = clock::now();
+    m_frame.assign(data, data + size - crc_size);
+
+    for (auto it = m_pending_requests.begin(); it != m_pending_requests.end(); ++it) {
+        if (it->matcher(m_frame)) {
+            auto handler = std::move(it->handler);
+            m_pending_requests.erase(it);
+            arm_request_timer();
+            handler(m_frame);
+            return;
+        }
+    }
+
+    if (m_frame_handler) {
+        m_frame_handler(m_frame);
+    }
+}
+
+void mcu_link::handle_request_timer() {
+    auto const now = clock::now();
+    std::vector<cb_response> expired;
+    for (auto it = m_pending_requests.begin(); it != m_pending_requests.end();) {
+        if (it->deadline <= now) {
+            expired.push_back(std::move(it->handler));
+            it = m_pending_requests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    arm_request_timer();
+
+    if (not expired.empty()) {
+        m_statistics.handle()->request_timeouts += expired.size();
+    }
+    for (auto& handler : expired) {
+        handler(std::nullopt);
+    }
+}
+
+void mcu_link::handle_link_timer() {
+    if (not m_link_timeout_handler) {
+        return;
+    }
+    auto const silence = clock::now() - m_last_rx;
+    if (silence < m_link_timeout) {
+        arm_timer(m_link_timer, m_link_timeout - silence);
+        return;
+    }
+    arm_timer(m_link_timer, m_link_timeout);
+    m_statistics.handle()->link_timeouts++;
+    m_link_timeout_handler();
+}
+
+void mcu_link::transmit(payload const& frame) {
+    if (not m_serial) {
+        return;
+    }
+    if (not m_serial_ready) {
+        if (m_tx_backlog.size() < max_tx_backlog) {
+            m_tx_backlog.push_back(frame);
+        }
+        return;
+    }
+    if (m_serial->tx(frame)) {
+        auto statistics = m_statistics.handle();
+        statistics->tx_frames++;
+        statistics->tx_bytes += frame.size();
+    }
+}
+
+void mcu_link::arm_request_timer() {
+    if (m_pending_requests.empty()) {
+        m_request_timer.set_timeout_ns(0);
+        return;
+    }
+    auto next = std::min_element(m_pending_requests.begin(), m_pending_requests.end(),
+                                 [](auto const& lhs, auto const& rhs) { return lhs.deadline < rhs.deadline; });
+    arm_timer(m_request_timer, next->deadline - clock::now());
+}
+
+void mcu_link::update_decoder_statistics() {
+    auto statistics = m_statistics.handle();
+    statistics->framing_errors = m_decoder.framing_errors();
+    statistics->oversized_frames = m_decoder.oversized_frames();
+}
+
+void mcu_link::arm_timer(event::timer_fd& timer, clock::duration timeout) {
+    // A timeout of zero would disarm the timer, an expired deadline has to fire as soon as possible instead
+    timer.set_timeout(std::max(timeout, clock::duration{std::chrono::microseconds(1)}));
+}
+
+} // namespace everest::lib::io::mcu_link
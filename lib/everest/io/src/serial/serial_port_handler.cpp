@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <cerrno>
+#include <everest/io/serial/serial_port_handler.hpp>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace everest::lib::io::serial {
+
+std::optional<speed_t> to_termios_speed(int baud) {
+    switch (baud) {
+    case 9600:
+        return B9600;
+    case 19200:
+        return B19200;
+    case 38400:
+        return B38400;
+    case 57600:
+        return B57600;
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    default:
+        return std::nullopt;
+    }
+}
+
+bool set_raw_serial_attributes(int fd, speed_t speed) {
+    struct termios tty;
+    if (tcgetattr(fd, &tty) != 0) {
+        return false;
+    }
+
+    cfmakeraw(&tty);
+    cfsetospeed(&tty, speed);
+    cfsetispeed(&tty, speed);
+
+    tty.c_cflag |= (CLOCAL | CREAD);
+    tty.c_cflag &= ~(PARENB | PARODD | CSTOPB | CRTSCTS);
+    tty.c_iflag &= ~(IXON | IXOFF | IXANY);
+    // The descriptor is non blocking and driven by an event loop, reads return whatever is available
+    tty.c_cc[VMIN] = 0;
+    tty.c_cc[VTIME] = 0;
+
+    return tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+bool serial_port_handler::tx(PayloadT& data) {
+    auto status = ::write(m_fd, data.data(), data.size());
+    if (status == -1) {
+        if (errno == EAGAIN) {
+            // The kernel buffer is full, try again when the port is writable
+            return false;
+        }
+        error_id = errno;
+        return false;
+    }
+    if (status < static_cast<ssize_t>(data.size())) {
+        // We have a reference to the current data. Replace it with what is left to be written
+        // and return false. This signals the current block cannot be removed from the buffer.
+        data = {data.begin() + status, data.end()};
+        return false;
+    }
+    error_id = 0;
+    return true;
+}
+
+bool serial_port_handler::rx(PayloadT& data) {
+    // This should not be expensive, since capacity is only touched once, since
+    // data is expected to stay the same object during the livetime of this instance
+    data.resize(buffer_size_limit);
+    auto n_bytes = ::read(m_fd, data.data(), data.size());
+    if (n_bytes == -1) {
+        error_id = errno;
+        data.clear();
+        return false;
+    }
+    data.resize(n_bytes);
+    error_id = 0;
+    return true;
+}
+
+bool serial_port_handler::open(std::string const& device, int baud) {
+    auto speed = to_termios_speed(baud);
+    if (not speed.has_value()) {
+        error_id = EINVAL;
+        return false;
+    }
+
+    event::unique_fd fd(::open(device.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC));
+    if (not fd.is_fd()) {
+        error_id = errno;
+        return false;
+    }
+
+    if (not set_raw_serial_attributes(fd, speed.value())) {
+        error_id = errno;
+        return false;
+    }
+
+    m_fd = std::move(fd);
+    error_id = 0;
+    return true;
+}
+
+bool serial_port_handler::flush() {
+    if (tcflush(m_fd, TCIOFLUSH) == -1) {
+        error_id = errno;
+        return false;
+    }
+    return true;
+}
+
+int serial_port_handler::get_fd() const {
+    return m_fd;
+}
+
+int serial_port_handler::get_error() const {
+    return error_id;
+}
+
+} // namespace everest::lib::io::serial
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <everest/io/mcu_link/cobs.hpp>
+#include <everest/io/mcu_link/crc32.hpp>
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace everest::lib::io::mcu_link;
+
+namespace {
+
+using bytes = std::vector<std::uint8_t>;
+
+bytes encode(bytes const& data) {
+    bytes result;
+    cobs_encode(data.data(), data.size(), result);
+    return result;
+}
+
+// Straight forward byte wise reference implementation as used by the board support drivers so far
+bytes reference_encode(bytes const& data) {
+    bytes buffer(cobs_max_encoded_size(data.size()));
+    auto encode = buffer.data();
+    auto codep = encode++;
+    std::uint8_t code = 1;
+    auto length = data.size();
+    for (auto byte = data.data(); length--; ++byte) {
+        if (*byte) {
+            *encode++ = *byte, ++code;
+        }
+        if (!*byte || code == 0xff) {
+            *codep = code, code = 1, codep = encode;
+            if (!*byte || length) {
+                ++encode;
+            }
+        }
+    }
+    *codep = code;
+    *encode++ = 0x00;
+    buffer.resize(encode - buffer.data());
+    return buffer;
+}
+
+bytes pattern(std::size_t size, std::size_t zero_every) {
+    bytes result(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        result[i] = zero_every and (i % zero_every == 0) ? 0 : static_cast<std::uint8_t>(i % 251 + 1);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(cobs, encode_known_vectors) {
+    EXPECT_EQ(encode({}), (bytes{0x01, 0x00}));
+    EXPECT_EQ(encode({0x00}), (bytes{0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x00, 0x00}), (bytes{0x01, 0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x22, 0x00, 0x33}), (bytes{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x00, 0x00, 0x00}), (bytes{0x02, 0x11, 0x01, 0x01, 0x01, 0x00}));
+}
+
+TEST(cobs, encode_matches_reference) {
+    for (auto size : {1, 2, 253, 254, 255, 508, 509, 1000}) {
+        for (auto zero_every : {0, 1, 7, 254, 300}) {
+            auto data = pattern(size, zero_every);
+            EXPECT_EQ(encode(data), reference_encode(data)) << "size " << size << " zero every " << zero_every;
+        }
+    }
+}
+
+TEST(cobs, round_trip) {
+    for (auto size : {0, 1, 253, 254, 255, 1000}) {
+        for (auto zero_every : {0, 1, 7, 254}) {
+            auto data = pattern(size, zero_every);
+            auto encoded = encode(data);
+            ASSERT_EQ(encoded.back(), 0x00);
+            encoded.pop_back();
+            auto decoded_size = cobs_decode(encoded.data(), encoded.size());
+            ASSERT_TRUE(decoded_size.has_value());
+            encoded.resize(decoded_size.value());
+            EXPECT_EQ(encoded, data) << "size " << size << " zero every " << zero_every;
+        }
+    }
+}
+
+TEST(cobs, decode_rejects_truncated_block) {
+    bytes frame{0x05, 0x11, 0x22};
+    EXPECT_FALSE(cobs_decode(frame.data(), frame.size()).has_value());
+}
+
+TEST(cobs_decoder, reassembles_chunked_stream) {
+    cobs_decoder decoder(2048);
+    std::vector<bytes> frames;
+    decoder.set_frame_handler([&frames](auto data, auto size) { frames.emplace_back(data, data + size); });
+
+    auto first = pattern(300, 7);
+    auto second = pattern(10, 0);
+    auto stream = encode(first);
+    auto encoded_second = encode(second);
+    stream.insert(stream.end(), encoded_second.begin(), encoded_second.end());
+
+    // feed in uneven chunks, including leading and repeated delimiters
+    decoder.feed(bytes{0x00, 0x00}.data(), 2);
+    for (std::size_t pos = 0; pos < stream.size(); pos += 13) {
+        decoder.feed(stream.data() + pos, std::min<std::size_t>(13, stream.size() - pos));
+    }
+
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(frames[0], first);
+    EXPECT_EQ(frames[1], second);
+    EXPECT_EQ(decoder.framing_errors(), 0);
+}
+
+TEST(cobs_decoder, drops_oversized_and_malformed_frames) {
+    cobs_decoder decoder(16);
+    std::vector<bytes> frames;
+    decoder.set_frame_handler([&frames](auto data, auto size) { frames.emplace_back(data, data + size); });
+
+    auto oversized = encode(pattern(100, 0));
+    decoder.feed(oversized.data(), oversized.size());
+    bytes malformed{0x05, 0x11, 0x00};
+    decoder.feed(malformed.data(), malformed.size());
+    auto valid = encode({0x01, 0x02});
+    decoder.feed(valid.data(), valid.size());
+
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames[0], (bytes{0x01, 0x02}));
+    EXPECT_EQ(decoder.oversized_frames(), 1);
+    EXPECT_EQ(decoder.framing_errors(), 1);
+}
+
+TEST(crc32, jamcrc_check_value) {
+    bytes data{'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(crc32_jamcrc(data.data(), data.size()), 0x340BC6D9);
+}
+
+TEST(crc32, appended_checksum_validates) {
+    auto data = pattern(100, 7);
+    append_crc32(data);
+    EXPECT_EQ(data.size(), 104);
+    EXPECT_TRUE(check_crc32(data.data(), data.size()));
+    data[10] ^= 0x01;
+    EXPECT_FALSE(check_crc32(data.data(), data.size()));
+    EXPECT_FALSE(check_crc32(data.data(), 3));
+}
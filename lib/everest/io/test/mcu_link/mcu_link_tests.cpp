@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+
+#include <everest/io/event/fd_event_handler.hpp>
+#include <everest/io/mcu_link/cobs.hpp>
+#include <everest/io/mcu_link/crc32.hpp>
+#include <everest/io/mcu_link/mcu_link.hpp>
+#include <everest/io/serial/event_pty.hpp>
+#include <gtest/gtest.h>
+
+using namespace everest::lib::io;
+using namespace std::chrono_literals;
+
+namespace {
+
+using bytes = std::vector<std::uint8_t>;
+
+// Loopback of an mcu_link to a PTY. The master side of the PTY plays the MCU.
+class mcu_link_loopback : public ::testing::Test {
+protected:
+    mcu_link_loopback() : mcu_decoder(2048) {
+        mcu_decoder.set_frame_handler([this](auto data, auto size) {
+            if (mcu_link::check_crc32(data, size)) {
+                mcu_frames.emplace_back(data, data + size - 4);
+            }
+        });
+        mcu.set_data_handler([this](auto const& data, auto&) { mcu_decoder.feed(data.data(), data.size()); });
+        handler.register_event_handler(&mcu);
+        handler.register_event_handler(&link);
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(link.open(mcu.get_slave_path(), 115200));
+    }
+
+    template <class Predicate> bool run_until(Predicate const& done, std::chrono::milliseconds timeout = 1s) {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        while (not done()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            handler.poll(10ms);
+            handler.run_actions();
+        }
+        return true;
+    }
+
+    void run_for(std::chrono::milliseconds duration) {
+        run_until([]() { return false; }, duration);
+    }
+
+    void mcu_send(bytes const& data) {
+        bytes frame;
+        mcu_link::encode_frame(data.data(), data.size(), frame);
+        mcu_send_raw(frame);
+    }
+
+    void mcu_send_raw(bytes const& data) {
+        mcu.tx(data);
+    }
+
+    event::fd_event_handler handler;
+    serial::event_pty mcu;
+    mcu_link::cobs_decoder mcu_decoder;
+    std::vector<bytes> mcu_frames;
+    mcu_link::mcu_link link;
+};
+
+} // namespace
+
+TEST_F(mcu_link_loopback, frames_are_sent_to_the_mcu) {
+    ASSERT_TRUE(link.send({0x01, 0x00, 0x02}));
+    ASSERT_TRUE(link.send({}));
+
+    ASSERT_TRUE(run_until([this]() { return mcu_frames.size() == 2; }));
+    EXPECT_EQ(mcu_frames[0], (bytes{0x01, 0x00, 0x02}));
+    EXPECT_EQ(mcu_frames[1], bytes{});
+    EXPECT_EQ(link.get_statistics().tx_frames, 2);
+}
+
+TEST_F(mcu_link_loopback, frames_are_received_from_the_mcu) {
+    std::vector<bytes> frames;
+    link.set_frame_handler([&frames](auto const& frame) { frames.push_back(frame); });
+
+    // two frames in one write, preceded by line noise
+    bytes stream{0x17, 0x42, 0x00};
+    for (auto const& data : {bytes{0x10, 0x00, 0x20}, bytes{0x30}}) {
+        bytes frame;
+        mcu_link::encode_frame(data.data(), data.size(), frame);
+        stream.insert(stream.end(), frame.begin(), frame.end());
+    }
+    // give the link time to set up its serial port before the MCU starts talking
+    run_for(50ms);
+    mcu_send_raw(stream);
+
+    ASSERT_TRUE(run_until([&frames]() { return frames.size() == 2; }));
+    EXPECT_EQ(frames[0], (bytes{0x10, 0x00, 0x20}));
+    EXPECT_EQ(frames[1], (bytes{0x30}));
+
+    auto statistics = link.get_statistics();
+    EXPECT_EQ(statistics.rx_frames, 2);
+    EXPECT_EQ(statistics.crc_errors + statistics.framing_errors, 1);
+}
+
+TEST_F(mcu_link_loopback, corrupted_frames_are_dropped) {
+    std::vector<bytes> frames;
+    link.set_frame_handler([&frames](auto const& frame) { frames.push_back(frame); });
+
+    bytes data{0x01, 0x02, 0x03, 0x04};
+    mcu_link::append_crc32(data);
+    data[1] ^= 0xFF;
+    bytes frame;
+    mcu_link::cobs_encode(data.data(), data.size(), frame);
+    run_for(50ms);
+    mcu_send_raw(frame);
+
+    ASSERT_TRUE(run_until([this]() { return link.get_statistics().crc_errors == 1; }));
+    EXPECT_TRUE(frames.empty());
+}
+
+TEST_F(mcu_link_loopback, requests_are_matched_with_responses) {
+    std::vector<bytes> frames;
+    link.set_frame_handler([&frames](auto const& frame) { frames.push_back(frame); });
+
+    std::optional<bytes> response;
+    auto called = false;
+    ASSERT_TRUE(link.request(
+        {0x07}, [](auto const& frame) { return not frame.empty() and frame[0] == 0x87; }, 1s,
+        [&](auto const& result) {
+            called = true;
+            response = result;
+        }));
+
+    ASSERT_TRUE(run_until([this]() { return mcu_frames.size() == 1; }));
+    mcu_send({0x01});
+    mcu_send({0x87, 0x55});
+
+    ASSERT_TRUE(run_until([&called]() { return called; }));
+    ASSERT_TRUE(response.has_value());
+    EXPECT_EQ(response.value(), (bytes{0x87, 0x55}));
+    ASSERT_TRUE(run_until([&frames]() { return frames.size() == 1; }));
+    EXPECT_EQ(frames[0], (bytes{0x01}));
+    EXPECT_EQ(link.get_statistics().request_timeouts, 0);
+}
+
+TEST_F(mcu_link_loopback, requests_time_out) {
+    std::vector<bool> results;
+    auto matcher = [](auto const&) { return true; };
+    auto on_response = [&results](auto const& result) { results.push_back(result.has_value()); };
+    ASSERT_TRUE(link.request({0x01}, matcher, 100ms, on_response));
+    ASSERT_TRUE(link.request({0x02}, matcher, 20ms, on_response));
+
+    ASSERT_TRUE(run_until([&results]() { return results.size() == 2; }));
+    EXPECT_EQ(results, (std::vector<bool>{false, false}));
+    EXPECT_EQ(link.get_statistics().request_timeouts, 2);
+}
+
+TEST_F(mcu_link_loopback, link_timeout_while_silent) {
+    auto timeouts = 0;
+    link.set_link_timeout(50ms, [&timeouts]() { ++timeouts; });
+
+    ASSERT_TRUE(run_until([&timeouts]() { return timeouts == 2; }));
+    EXPECT_EQ(link.get_statistics().link_timeouts, 2);
+}
+
+TEST_F(mcu_link_loopback, no_link_timeout_while_frames_arrive) {
+    auto timeouts = 0;
+    link.set_link_timeout(100ms, [&timeouts]() { ++timeouts; });
+    for (int i = 0; i < 8; ++i) {
+        mcu_send({0x01});
+        run_for(25ms);
+    }
+    EXPECT_EQ(timeouts, 0);
+}
+
+TEST_F(mcu_link_loopback, periodic_actions) {
+    link.add_periodic_action(20ms, [this]() { link.send({0x4B}); });
+
+    ASSERT_TRUE(run_until([this]() { return mcu_frames.size() >= 3; }));
+    EXPECT_EQ(mcu_frames[0], (bytes{0x4B}));
+}
+
+TEST(mcu_link, open_fails_for_missing_device) {
+    mcu_link::mcu_link link;
+    EXPECT_FALSE(link.open("/dev/does_not_exist", 115200));
+    EXPECT_FALSE(link.is_open());
+    EXPECT_FALSE(link.send({0x01}));
+}
@@ -2,13 +2,13 @@
 // Copyright 2023 Pionix GmbH and Contributors to EVerest
 #pragma once
 
-#include <any>
 #include <memory>
 #include <optional>
 #include <string>
 #include <tuple>
 
 #include <iso15118/d20/timeout.hpp>
+#include <iso15118/message/arena.hpp>
 #include <iso15118/message/payload_type.hpp>
 #include <iso15118/message/variant.hpp>
 #include <iso15118/session/feedback.hpp>
@@ -29,16 +29,19 @@ class MessageExchange {
 public:
     MessageExchange(io::StreamOutputView);
 
-    void set_request(std::unique_ptr<message_20::Variant> new_request);
-    std::unique_ptr<message_20::Variant> pull_request();
+    void set_request(message_20::VariantPointer new_request);
+    // decodes the request inside of the arena
+    void set_request(io::v2gtp::PayloadType, const io::StreamInputView&);
+    message_20::VariantPointer pull_request();
     message_20::Type peek_request_type() const;
 
     template <typename MessageType> void set_response(const MessageType& msg) {
+        const message_20::ArenaScope scope(arena);
         response_size = message_20::serialize(msg, response);
         response_available = true;
         payload_type = message_20::PayloadTypeTrait<MessageType>::type;
         response_type = message_20::TypeTrait<MessageType>::type;
-        response_message = msg;
+        arena.store_response(msg);
     }
 
     template <typename Msg> std::optional<Msg> get_response() {
@@ -46,18 +49,24 @@ public:
         if (message_20::TypeTrait<Msg>::type != response_type) {
             return std::nullopt;
         }
-        try {
-            return std::any_cast<Msg>(response_message);
-        } catch (const std::bad_any_cast& ex) {
-            return std::nullopt;
+        if (const auto* msg = arena.get_response<Msg>()) {
+            return *msg;
         }
+        return std::nullopt;
     }
 
     std::tuple<bool, size_t, io::v2gtp::PayloadType, message_20::Type> check_and_clear_response();
 
+    const message_20::ArenaStatistics& get_arena_statistics() const {
+        return arena.get_statistics();
+    }
+
 private:
+    // storage for decoding, encoding and the messages of the current cycle
+    message_20::Arena arena;
+
     // input
-    std::unique_ptr<message_20::Variant> request{nullptr};
+    message_20::VariantPointer request{nullptr};
 
     // output
     const io::StreamOutputView response;
@@ -65,7 +74,6 @@ private:
     bool response_available{false};
     io::v2gtp::PayloadType payload_type;
     message_20::Type response_type;
-    std::any response_message;
 };
 
 std::unique_ptr<MessageExchange> create_message_exchange(uint8_t* buf, const size_t len);
@@ -83,7 +91,7 @@ public:
         return std::make_unique<StateType>(*this, std::forward<Args>(args)...);
     }
 
-    std::unique_ptr<message_20::Variant> pull_request();
+    message_20::VariantPointer pull_request();
     message_20::Type peek_request_type() const;
 
     template <typename MessageType> void respond(const MessageType& msg) {
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <iso15118/message/arena.hpp>
+
+#include <cbv2g/app_handshake/appHand_Datatypes.h>
+#include <cbv2g/iso_20/iso20_AC_Datatypes.h>
+#include <cbv2g/iso_20/iso20_CommonMessages_Datatypes.h>
+#include <cbv2g/iso_20/iso20_DC_Datatypes.h>
+
+namespace iso15118::message_20 {
+
+// NOTE (aw): decoding and encoding never overlap within one cycle, so a single document of the largest type is enough
+union ExiDocumentScratch {
+    appHand_exiDocument app_hand;
+    iso20_exiDocument common;
+    iso20_dc_exiDocument dc;
+    iso20_ac_exiDocument ac;
+};
+
+// Returns the scratch document of the arena that is active on this thread (see ArenaScope).  Without an active arena,
+// a fallback document allocated on first use per thread is used, so that the stack never has to hold a whole document.
+ExiDocumentScratch& get_exi_scratch();
+
+template <typename DocumentType> DocumentType& get_exi_document();
+
+template <> inline appHand_exiDocument& get_exi_document() {
+    return get_exi_scratch().app_hand;
+}
+
+template <> inline iso20_exiDocument& get_exi_document() {
+    return get_exi_scratch().common;
+}
+
+template <> inline iso20_dc_exiDocument& get_exi_document() {
+    return get_exi_scratch().dc;
+}
+
+template <> inline iso20_ac_exiDocument& get_exi_document() {
+    return get_exi_scratch().ac;
+}
+
+} // namespace iso15118::message_20
@@ -3,7 +3,9 @@
 #pragma once
 
 #include <cassert>
+#include <tuple>
 
+#include <iso15118/message/arena.hpp>
 #include <iso15118/message/variant.hpp>
 
 #include "cb_exi.hpp"
@@ -20,12 +22,19 @@ struct VariantAccess {
     iso15118::message_20::Variant::CustomDeleter& custom_deleter;
     std::string& error;
 
+    // optional, the message is placed into this arena if set
+    Arena* arena{nullptr};
+
     template <typename MessageType, typename CbExiMessageType> void insert_type(const CbExiMessageType& in) {
         assert(data == nullptr);
 
-        data = new MessageType;
+        if (arena) {
+            std::tie(data, custom_deleter) = arena->create_message<MessageType>();
+        } else {
+            data = new MessageType;
+            custom_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
+        }
         type = iso15118::message_20::TypeTrait<MessageType>::type;
-        custom_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
 
         convert(in, *static_cast<MessageType*>(data));
     };
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 Pionix GmbH and Contributors to EVerest
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <iso15118/io/sdp.hpp>
+#include <iso15118/io/stream_view.hpp>
+
+#include "type.hpp"
+#include "variant.hpp"
+
+namespace iso15118::message_20 {
+
+// forward declare, defined in iso15118/detail/exi_scratch.hpp
+union ExiDocumentScratch;
+
+struct ArenaStatistics {
+    std::size_t cycles{0};            // finished request/response cycles
+    std::size_t arena_allocations{0}; // objects constructed inside the arena
+    std::size_t heap_allocations{0};  // objects that did not fit into the arena and went to the heap
+};
+
+// Per session storage for everything that is needed to handle one request/response cycle: the scratch document used
+// by the cbv2g decoders/encoders, the decoded request and a copy of the last response.  All storage is allocated once
+// when the arena is created, so that steady state message handling does not need to touch the heap.
+class Arena {
+public:
+    // size of the request and response message slots, large enough for all messages but the ScheduleExchangeRes,
+    // which is only sent once per session
+    static constexpr std::size_t MESSAGE_SLOT_SIZE = 1024;
+
+    Arena();
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ExiDocumentScratch& get_exi_scratch();
+
+    // Decodes a request into the variant slot of the arena
+    VariantPointer decode_request(io::v2gtp::PayloadType, const io::StreamInputView&);
+
+    // Constructs a request message in the message slot.  If the slot is still in use or the message does not fit, it
+    // is allocated on the heap instead.  The returned deleter has to be used to destroy the message.
+    template <typename MessageType> std::pair<MessageType*, Variant::CustomDeleter> create_message() {
+        if constexpr (sizeof(MessageType) <= MESSAGE_SLOT_SIZE) {
+            if (not message_slot_in_use) {
+                message_slot_in_use = true;
+                statistics.arena_allocations++;
+                return {new (message_slot.data) MessageType,
+                        [](void* ptr) { static_cast<MessageType*>(ptr)->~MessageType(); }};
+            }
+        }
+
+        statistics.heap_allocations++;
+        return {new MessageType, [](void* ptr) { delete static_cast<MessageType*>(ptr); }};
+    }
+
+    // Has to be called after a message or variant constructed by the arena has been destroyed
+    void release(const void* ptr);
+
+    // Keeps a copy of the last response, replacing the previous one
+    template <typename MessageType> void store_response(const MessageType& msg) {
+        clear_response();
+
+        if constexpr (sizeof(MessageType) <= MESSAGE_SLOT_SIZE) {
+            response = new (response_slot.data) MessageType(msg);
+            response_deleter = [](void* ptr) { static_cast<MessageType*>(ptr)->~MessageType(); };
+            statistics.arena_allocations++;
+        } else {
+            response = new MessageType(msg);
+            response_deleter = [](void* ptr) { delete static_cast<MessageType*>(ptr); };
+            statistics.heap_allocations++;
+        }
+        response_type = TypeTrait<MessageType>::type;
+    }
+
+    template <typename MessageType> MessageType const* get_response() const {
+        if (response == nullptr or TypeTrait<MessageType>::type != response_type) {
+            return nullptr;
+        }
+        return static_cast<MessageType*>(response);
+    }
+
+    void clear_response();
+
+    // Marks the end of a request/response cycle
+    void finish_cycle() {
+        statistics.cycles++;
+    }
+
+    const ArenaStatistics& get_statistics() const {
+        return statistics;
+    }
+
+private:
+    template <std::size_t Size> struct alignas(std::max_align_t) Slot {
+        std::byte data[Size];
+    };
+
+    std::unique_ptr<ExiDocumentScratch> exi_scratch;
+
+    Slot<sizeof(Variant)> variant_slot;
+    bool variant_slot_in_use{false};
+
+    Slot<MESSAGE_SLOT_SIZE> message_slot;
+    bool message_slot_in_use{false};
+
+    Slot<MESSAGE_SLOT_SIZE> response_slot;
+    void* response{nullptr};
+    Variant::CustomDeleter response_deleter{nullptr};
+    Type response_type{Type::None};
+
+    ArenaStatistics statistics;
+};
+
+// Makes an arena the source of the scratch documents used for decoding and serializing on the current thread
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena&);
+    ~ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena* previous;
+};
+
+} // namespace iso15118::message_20
@@ -16,10 +16,15 @@
 
 namespace iso15118::message_20 {
 
+// forward declare
+class Arena;
+
 class Variant {
 public:
     using CustomDeleter = void (*)(void*);
     Variant(io::v2gtp::PayloadType, const io::StreamInputView&);
+    // decodes using the scratch document of the arena and places the message inside of it
+    Variant(io::v2gtp::PayloadType, const io::StreamInputView&, Arena&);
     template <typename MessageType> Variant(const MessageType& in) {
         static_assert(TypeTrait<MessageType>::type != Type::None, "Unhandled type!");
 
@@ -53,9 +58,27 @@ public:
     }
 
 private:
+    void decode(io::v2gtp::PayloadType, const io::StreamInputView&);
+
     CustomDeleter custom_deleter{nullptr};
     void* data{nullptr};
     Type type{Type::None};
     std::string error;
+    Arena* arena{nullptr};
 };
+
+// Destroys variants that have either been allocated on the heap or inside of an arena
+struct VariantDeleter {
+    VariantDeleter() = default;
+    VariantDeleter(std::default_delete<Variant>) {
+    }
+    explicit VariantDeleter(Arena* arena_) : arena(arena_) {
+    }
+
+    void operator()(Variant*) const;
+
+    Arena* arena{nullptr};
+};
+
+using VariantPointer = std::unique_ptr<Variant, VariantDeleter>;
 } // namespace iso15118::message_20
@@ -46,6 +46,11 @@ public:
 
     void close();
 
+    // allocation counters of the message arena, used for decoding and encoding
+    const message_20::ArenaStatistics& get_message_statistics() const {
+        return message_exchange.get_arena_statistics();
+    }
+
 private:
     std::unique_ptr<io::IConnection> connection;
     session::SessionLogger log;
@@ -16,7 +16,7 @@ std::unique_ptr<MessageExchange> create_message_exchange(uint8_t* buf, const siz
 MessageExchange::MessageExchange(io::StreamOutputView output_) : response(std::move(output_)) {
 }
 
-void MessageExchange::set_request(std::unique_ptr<message_20::Variant> new_request) {
+void MessageExchange::set_request(message_20::VariantPointer new_request) {
     if (request) {
         // FIXME (aw): we might want to have a stack here?
         throw std::runtime_error("Previous V2G message has not been handled yet");
@@ -25,7 +25,15 @@ void MessageExchange::set_request(std::unique_ptr<message_20::Variant> new_reque
     request = std::move(new_request);
 }
 
-std::unique_ptr<message_20::Variant> MessageExchange::pull_request() {
+void MessageExchange::set_request(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view) {
+    if (request) {
+        throw std::runtime_error("Previous V2G message has not been handled yet");
+    }
+
+    request = arena.decode_request(payload_type, buffer_view);
+}
+
+message_20::VariantPointer MessageExchange::pull_request() {
     if (not request) {
         throw std::runtime_error("Tried to access V2G message, but there is none");
     }
@@ -36,6 +44,10 @@ std::unique_ptr<message_20::Variant> MessageExchange::pull_request() {
 std::tuple<bool, size_t, io::v2gtp::PayloadType, message_20::Type> MessageExchange::check_and_clear_response() {
     auto retval = std::make_tuple(response_available, response_size, payload_type, response_type);
 
+    if (response_available) {
+        arena.finish_cycle();
+    }
+
     response_available = false;
     response_size = 0;
     response_type = message_20::Type::None;
@@ -64,7 +76,7 @@ Context::Context(session::feedback::Callbacks feedback_callbacks, session::Sessi
     timeouts(timeouts_) {
 }
 
-std::unique_ptr<message_20::Variant> Context::pull_request() {
+message_20::VariantPointer Context::pull_request() {
     return message_exchange.pull_request();
 }
 
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_AC_Decoder.h>
@@ -393,7 +394,7 @@ template <> void convert(const AC_ChargeLoopResponse& in, struct iso20_ac_AC_Cha
 }
 
 template <> int serialize_to_exi(const AC_ChargeLoopResponse& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+    auto& doc = get_exi_document<iso20_ac_exiDocument>();
     init_iso20_ac_exiDocument(&doc);
 
     CB_SET_USED(doc.AC_ChargeLoopRes);
@@ -527,7 +528,7 @@ template <> void convert(const AC_ChargeLoopRequest& in, struct iso20_ac_AC_Char
 }
 
 template <> int serialize_to_exi(const AC_ChargeLoopRequest& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+    auto& doc = get_exi_document<iso20_ac_exiDocument>();
     init_iso20_ac_exiDocument(&doc);
 
     CB_SET_USED(doc.AC_ChargeLoopReq);
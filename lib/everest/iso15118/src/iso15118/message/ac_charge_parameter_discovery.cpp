@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_AC_Decoder.h>
@@ -158,7 +159,7 @@ void convert(const AC_ChargeParameterDiscoveryResponse& in, struct iso20_ac_AC_C
 }
 
 template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+    auto& doc = get_exi_document<iso20_ac_exiDocument>();
 
     init_iso20_ac_exiDocument(&doc);
 
@@ -222,7 +223,7 @@ void convert(const AC_ChargeParameterDiscoveryRequest& in, struct iso20_ac_AC_Ch
 }
 
 template <> int serialize_to_exi(const AC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out) {
-    iso20_ac_exiDocument doc;
+    auto& doc = get_exi_document<iso20_ac_exiDocument>();
 
     init_iso20_ac_exiDocument(&doc);
 
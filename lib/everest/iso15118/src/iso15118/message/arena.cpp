@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 Pionix GmbH and Contributors to EVerest
+#include <iso15118/message/arena.hpp>
+
+#include <iso15118/detail/exi_scratch.hpp>
+
+namespace iso15118::message_20 {
+
+static thread_local Arena* active_arena{nullptr};
+
+ExiDocumentScratch& get_exi_scratch() {
+    if (active_arena) {
+        return active_arena->get_exi_scratch();
+    }
+
+    // only allocated by threads that actually de-/encode without an arena, the document is too large for the TLS block
+    static thread_local std::unique_ptr<ExiDocumentScratch> fallback_scratch;
+    if (not fallback_scratch) {
+        fallback_scratch = std::make_unique<ExiDocumentScratch>();
+    }
+    return *fallback_scratch;
+}
+
+Arena::Arena() : exi_scratch(std::make_unique<ExiDocumentScratch>()) {
+}
+
+Arena::~Arena() {
+    clear_response();
+}
+
+ExiDocumentScratch& Arena::get_exi_scratch() {
+    return *exi_scratch;
+}
+
+VariantPointer Arena::decode_request(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view) {
+    if (variant_slot_in_use) {
+        statistics.heap_allocations++;
+        return VariantPointer(new Variant(payload_type, buffer_view, *this));
+    }
+
+    variant_slot_in_use = true;
+    statistics.arena_allocations++;
+
+    try {
+        return VariantPointer(new (variant_slot.data) Variant(payload_type, buffer_view, *this), VariantDeleter(this));
+    } catch (...) {
+        variant_slot_in_use = false;
+        throw;
+    }
+}
+
+void Arena::release(const void* ptr) {
+    if (ptr == variant_slot.data) {
+        variant_slot_in_use = false;
+    } else if (ptr == message_slot.data) {
+        message_slot_in_use = false;
+    }
+}
+
+void Arena::clear_response() {
+    if (response) {
+        response_deleter(response);
+    }
+    response = nullptr;
+    response_deleter = nullptr;
+    response_type = Type::None;
+}
+
+ArenaScope::ArenaScope(Arena& arena) : previous(active_arena) {
+    active_arena = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+    active_arena = previous;
+}
+
+} // namespace iso15118::message_20
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -89,7 +90,7 @@ template <> void insert_type(VariantAccess& va, const struct iso20_Authorization
 };
 
 template <> int serialize_to_exi(const AuthorizationSetupResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.AuthorizationSetupRes);
@@ -100,7 +101,7 @@ template <> int serialize_to_exi(const AuthorizationSetupResponse& in, exi_bitst
 }
 
 template <> int serialize_to_exi(const AuthorizationSetupRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.AuthorizationSetupReq);
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -33,7 +34,7 @@ template <> void convert(const DC_CableCheckResponse& in, struct iso20_dc_DC_Cab
 }
 
 template <> int serialize_to_exi(const DC_CableCheckResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_CableCheckRes);
@@ -57,7 +58,7 @@ template <> void convert(const DC_CableCheckRequest& in, iso20_dc_DC_CableCheckR
 }
 
 template <> int serialize_to_exi(const DC_CableCheckRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_CableCheckReq);
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Decoder.h>
@@ -358,7 +359,7 @@ template <> void convert(const DC_ChargeLoopResponse& in, struct iso20_dc_DC_Cha
 }
 
 template <> int serialize_to_exi(const DC_ChargeLoopResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeLoopRes);
@@ -496,7 +497,7 @@ template <> void convert(const DC_ChargeLoopRequest& in, iso20_dc_DC_ChargeLoopR
 }
 
 template <> int serialize_to_exi(const DC_ChargeLoopRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeLoopReq);
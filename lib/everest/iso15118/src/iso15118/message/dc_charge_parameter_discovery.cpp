@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -138,7 +139,7 @@ void convert(const DC_ChargeParameterDiscoveryResponse& in, struct iso20_dc_DC_C
 }
 
 template <> int serialize_to_exi(const DC_ChargeParameterDiscoveryResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_ChargeParameterDiscoveryRes);
@@ -205,7 +206,7 @@ template <> void insert_type(VariantAccess& va, const struct iso20_dc_DC_ChargeP
 }
 
 template <> int serialize_to_exi(const DC_ChargeParameterDiscoveryRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
     CB_SET_USED(doc.DC_ChargeParameterDiscoveryReq);
     convert(in, doc.DC_ChargeParameterDiscoveryReq);
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -39,7 +40,7 @@ template <> void convert(const DC_PreChargeResponse& in, struct iso20_dc_DC_PreC
 }
 
 template <> int serialize_to_exi(const DC_PreChargeResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_PreChargeRes);
@@ -67,7 +68,7 @@ template <> void convert(const DC_PreChargeRequest& in, iso20_dc_DC_PreChargeReq
 }
 
 template <> int serialize_to_exi(const DC_PreChargeRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_PreChargeReq);
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_DC_Decoder.h>
@@ -42,7 +43,7 @@ template <> void convert(const DC_WeldingDetectionResponse& in, struct iso20_dc_
 }
 
 template <> int serialize_to_exi(const DC_WeldingDetectionResponse& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_WeldingDetectionRes);
@@ -65,7 +66,7 @@ template <> void convert(const DC_WeldingDetectionRequest& in, iso20_dc_DC_Weldi
 }
 
 template <> int serialize_to_exi(const DC_WeldingDetectionRequest& in, exi_bitstream_t& out) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
     init_iso20_dc_exiDocument(&doc);
 
     CB_SET_USED(doc.DC_WeldingDetectionReq);
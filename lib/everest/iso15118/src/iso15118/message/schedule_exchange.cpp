@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include <iso15118/detail/cb_exi.hpp>
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Decoder.h>
@@ -552,7 +553,7 @@ template <> void insert_type(VariantAccess& va, const struct iso20_ScheduleExcha
 };
 
 template <> int serialize_to_exi(const ScheduleExchangeResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ScheduleExchangeRes);
@@ -669,7 +670,7 @@ template <> void convert(const ScheduleExchangeRequest& in, iso20_ScheduleExchan
 }
 
 template <> int serialize_to_exi(const ScheduleExchangeRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ScheduleExchangeReq);
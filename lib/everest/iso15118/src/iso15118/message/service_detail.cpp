@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -297,7 +298,7 @@ template <> void insert_type(VariantAccess& va, const struct iso20_ServiceDetail
 };
 
 template <> int serialize_to_exi(const ServiceDetailResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceDetailRes);
@@ -308,7 +309,7 @@ template <> int serialize_to_exi(const ServiceDetailResponse& in, exi_bitstream_
 }
 
 template <> int serialize_to_exi(const ServiceDetailRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.ServiceDetailReq);
@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Datatypes.h>
@@ -51,7 +52,7 @@ template <> void insert_type(VariantAccess& va, const struct iso20_SessionSetupR
 };
 
 template <> int serialize_to_exi(const SessionSetupResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
     CB_SET_USED(doc.SessionSetupRes);
 
@@ -61,7 +62,7 @@ template <> int serialize_to_exi(const SessionSetupResponse& in, exi_bitstream_t
 }
 
 template <> int serialize_to_exi(const SessionSetupRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
     CB_SET_USED(doc.SessionSetupReq);
 
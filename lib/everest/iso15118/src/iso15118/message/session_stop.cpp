@@ -4,6 +4,7 @@
 
 #include <type_traits>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/iso_20/iso20_CommonMessages_Encoder.h>
@@ -54,7 +55,7 @@ template <> void convert(const SessionStopResponse& in, struct iso20_SessionStop
 }
 
 template <> int serialize_to_exi(const SessionStopResponse& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.SessionStopRes);
@@ -65,7 +66,7 @@ template <> int serialize_to_exi(const SessionStopResponse& in, exi_bitstream_t&
 }
 
 template <> int serialize_to_exi(const SessionStopRequest& in, exi_bitstream_t& out) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
     init_iso20_exiDocument(&doc);
 
     CB_SET_USED(doc.SessionStopReq);
@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include <iso15118/detail/cb_exi.hpp>
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
 #include <cbv2g/app_handshake/appHand_Encoder.h>
@@ -62,7 +63,7 @@ template <> void insert_type(VariantAccess& va, const struct appHand_supportedAp
 };
 
 template <> int serialize_to_exi(const SupportedAppProtocolResponse& in, exi_bitstream_t& out) {
-    appHand_exiDocument doc;
+    auto& doc = get_exi_document<appHand_exiDocument>();
     init_appHand_exiDocument(&doc);
 
     convert(in, doc.supportedAppProtocolRes);
@@ -73,7 +74,7 @@ template <> int serialize_to_exi(const SupportedAppProtocolResponse& in, exi_bit
 }
 
 template <> int serialize_to_exi(const SupportedAppProtocolRequest& in, exi_bitstream_t& out) {
-    appHand_exiDocument doc;
+    auto& doc = get_exi_document<appHand_exiDocument>();
     init_appHand_exiDocument(&doc);
 
     convert(in, doc.supportedAppProtocolReq);
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <string>
 
+#include <iso15118/detail/exi_scratch.hpp>
 #include <iso15118/detail/helper.hpp>
 #include <iso15118/detail/variant_access.hpp>
 
@@ -18,7 +19,7 @@ using PayloadType = iso15118::io::v2gtp::PayloadType;
 namespace iso15118::message_20 {
 
 static void handle_sap(VariantAccess& va) {
-    appHand_exiDocument doc;
+    auto& doc = get_exi_document<appHand_exiDocument>();
 
     const auto decode_status = decode_appHand_exiDocument(&va.input_stream, &doc);
 
@@ -35,7 +36,7 @@ static void handle_sap(VariantAccess& va) {
 }
 
 static void handle_main(VariantAccess& va) {
-    iso20_exiDocument doc;
+    auto& doc = get_exi_document<iso20_exiDocument>();
 
     const auto decode_status = decode_iso20_exiDocument(&va.input_stream, &doc);
 
@@ -86,7 +87,7 @@ static void handle_main(VariantAccess& va) {
 }
 
 static void handle_dc(VariantAccess& va) {
-    iso20_dc_exiDocument doc;
+    auto& doc = get_exi_document<iso20_dc_exiDocument>();
 
     const auto decode_status = decode_iso20_dc_exiDocument(&va.input_stream, &doc);
 
@@ -121,7 +122,7 @@ static void handle_dc(VariantAccess& va) {
 }
 
 static void handle_ac(VariantAccess& va) {
-    iso20_ac_exiDocument doc;
+    auto& doc = get_exi_document<iso20_ac_exiDocument>();
 
     const auto decode_status = decode_iso20_ac_exiDocument(&va.input_stream, &doc);
 
@@ -144,9 +145,27 @@ static void handle_ac(VariantAccess& va) {
 }
 
 Variant::Variant(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view) {
+    decode(payload_type, buffer_view);
+}
 
+Variant::Variant(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view, Arena& arena_) :
+    arena(&arena_) {
+    const ArenaScope scope(arena_);
+
+    try {
+        decode(payload_type, buffer_view);
+    } catch (...) {
+        if (data) {
+            custom_deleter(data);
+            arena->release(data);
+        }
+        throw;
+    }
+}
+
+void Variant::decode(io::v2gtp::PayloadType payload_type, const io::StreamInputView& buffer_view) {
     VariantAccess va{
-        get_exi_input_stream(buffer_view), this->data, this->type, this->custom_deleter, this->error,
+        get_exi_input_stream(buffer_view), this->data, this->type, this->custom_deleter, this->error, this->arena,
     };
 
     if (payload_type == PayloadType::SAP) {
@@ -173,6 +192,10 @@ Variant::Variant(io::v2gtp::PayloadType payload_type, const io::StreamInputView&
 Variant::~Variant() {
     if (data) {
         custom_deleter(data);
+
+        if (arena) {
+            arena->release(data);
+        }
     }
 }
 
@@ -184,4 +207,13 @@ const std::string& Variant::get_error() const {
     return error;
 }
 
+void VariantDeleter::operator()(Variant* variant) const {
+    if (arena) {
+        variant->~Variant();
+        arena->release(variant);
+    } else {
+        delete variant;
+    }
+}
+
 } // namespace iso15118::message_20
@@ -34,11 +34,6 @@ static void log_packet_from_car(const iso15118::io::SdpPacket& packet, session::
                packet.get_payload_length(), session::logging::ExiMessageDirection::FROM_EV);
 }
 
-static std::unique_ptr<message_20::Variant> make_variant_from_packet(const iso15118::io::SdpPacket& packet) {
-    return std::make_unique<message_20::Variant>(
-        packet.get_payload_type(), io::StreamInputView{packet.get_payload_buffer(), packet.get_payload_length()});
-}
-
 void raise_invalid_packet_state(const io::SdpPacket& sdp_packet) {
     using PacketState = io::SdpPacket::State;
 
@@ -206,7 +201,8 @@ TimePoint const& Session::poll() {
         // FIXME (aw): this event loop only acts on new packets, seems to be enough for now ...
         log_packet_from_car(packet, log);
 
-        message_exchange.set_request(make_variant_from_packet(packet));
+        message_exchange.set_request(packet.get_payload_type(),
+                                     io::StreamInputView{packet.get_payload_buffer(), packet.get_payload_length()});
 
         packet = {}; // reset the packet
 
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 Pionix GmbH and Contributors to EVerest
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <iso15118/d20/context.hpp>
+#include <iso15118/message/dc_charge_loop.hpp>
+#include <iso15118/message/dc_pre_charge.hpp>
+#include <iso15118/message/schedule_exchange.hpp>
+
+using namespace iso15118;
+
+static std::atomic<std::size_t> heap_allocations{0};
+
+void* operator new(std::size_t size) {
+    heap_allocations++;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// DC_ChargeLoopReq, scheduled mode
+static uint8_t dc_charge_loop_req[] = {0x80, 0x34, 0x04, 0x1e, 0xa6, 0x5f, 0xc9, 0x9b, 0xa7, 0x6c,
+                                       0x4d, 0x8c, 0xdb, 0xfe, 0x1b, 0x60, 0x62, 0x81, 0x00, 0x12,
+                                       0x00, 0x64, 0x64, 0x00, 0x0a, 0x02, 0x00, 0x24, 0x00, 0xca};
+
+static bool handle_charge_loop_cycle(d20::MessageExchange& message_exchange) {
+    message_exchange.set_request(io::v2gtp::PayloadType::Part20DC,
+                                 io::StreamInputView{dc_charge_loop_req, sizeof(dc_charge_loop_req)});
+
+    const auto variant = message_exchange.pull_request();
+    const auto req = variant->get_if<message_20::DC_ChargeLoopRequest>();
+    if (req == nullptr) {
+        return false;
+    }
+
+    message_20::DC_ChargeLoopResponse res;
+    res.header = req->header;
+    res.response_code = message_20::datatypes::ResponseCode::OK;
+    res.present_current = {20, 0};
+    res.present_voltage = req->present_voltage;
+    message_exchange.set_response(res);
+
+    return std::get<0>(message_exchange.check_and_clear_response());
+}
+
+SCENARIO("Message exchange with arena") {
+    std::array<uint8_t, 1024> output_buffer{};
+    d20::MessageExchange message_exchange{{output_buffer.data(), output_buffer.size()}};
+
+    GIVEN("Repeated dc charge loop cycles") {
+        constexpr auto CYCLES = 10;
+
+        // the first cycle is allowed to allocate, e.g. for lazily initialized logging
+        REQUIRE(handle_charge_loop_cycle(message_exchange));
+
+        const auto allocations_before = heap_allocations.load();
+        auto all_cycles_handled = true;
+        for (auto i = 0; i < CYCLES; ++i) {
+            all_cycles_handled = handle_charge_loop_cycle(message_exchange) and all_cycles_handled;
+        }
+        const auto allocations = heap_allocations.load() - allocations_before;
+
+        THEN("No heap allocation happens and all messages are placed inside of the arena") {
+            REQUIRE(all_cycles_handled);
+            REQUIRE(allocations == 0);
+
+            const auto& statistics = message_exchange.get_arena_statistics();
+            REQUIRE(statistics.cycles == CYCLES + 1);
+            REQUIRE(statistics.heap_allocations == 0);
+            // request variant, request message and the stored response for every cycle
+            REQUIRE(statistics.arena_allocations == 3 * (CYCLES + 1));
+        }
+
+        THEN("The last response is still available") {
+            message_exchange.set_response(message_20::DC_ChargeLoopResponse{});
+            const auto response = message_exchange.get_response<message_20::DC_ChargeLoopResponse>();
+            REQUIRE(response.has_value());
+            REQUIRE(message_exchange.get_response<message_20::DC_PreChargeResponse>() == std::nullopt);
+        }
+    }
+
+    GIVEN("A request that has not been pulled yet") {
+        message_exchange.set_request(io::v2gtp::PayloadType::Part20DC,
+                                     io::StreamInputView{dc_charge_loop_req, sizeof(dc_charge_loop_req)});
+
+        THEN("A second request is rejected") {
+            REQUIRE_THROWS(message_exchange.set_request(
+                io::v2gtp::PayloadType::Part20DC,
+                io::StreamInputView{dc_charge_loop_req, sizeof(dc_charge_loop_req)}));
+        }
+    }
+
+    GIVEN("A request that is kept alive while the next one is decoded") {
+        message_exchange.set_request(io::v2gtp::PayloadType::Part20DC,
+                                     io::StreamInputView{dc_charge_loop_req, sizeof(dc_charge_loop_req)});
+        const auto first = message_exchange.pull_request();
+
+        message_exchange.set_request(io::v2gtp::PayloadType::Part20DC,
+                                     io::StreamInputView{dc_charge_loop_req, sizeof(dc_charge_loop_req)});
+        const auto second = message_exchange.pull_request();
+
+        THEN("The second request falls back to the heap") {
+            REQUIRE(first->get_type() == message_20::Type::DC_ChargeLoopReq);
+            REQUIRE(second->get_type() == message_20::Type::DC_ChargeLoopReq);
+            REQUIRE(message_exchange.get_arena_statistics().heap_allocations == 2);
+        }
+    }
+
+    GIVEN("A response that does not fit into the arena") {
+        message_exchange.set_response(message_20::ScheduleExchangeResponse{});
+
+        THEN("It is kept on the heap") {
+            REQUIRE(message_exchange.get_arena_statistics().heap_allocations == 1);
+            REQUIRE(message_exchange.get_response<message_20::ScheduleExchangeResponse>().has_value());
+        }
+    }
+}
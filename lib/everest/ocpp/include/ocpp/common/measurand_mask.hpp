@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace ocpp {
+
+/// \brief Set of measurands stored as a bitmask. Configured measurand lists are compiled into a MeasurandMask when the
+/// configuration changes, so that filtering meter values does not need to parse or search any lists.
+/// \tparam MeasurandT the measurand enum of the respective OCPP version, all of its values must be smaller than 64
+template <typename MeasurandT> class MeasurandMask {
+    static_assert(std::is_enum_v<MeasurandT>, "MeasurandMask requires an enum type");
+
+public:
+    MeasurandMask() = default;
+
+    /// \brief Adds the given \p measurand to the mask
+    void set(MeasurandT measurand) {
+        this->bits |= bit(measurand);
+    }
+
+    /// \brief Checks if the given \p measurand is part of the mask
+    bool contains(MeasurandT measurand) const {
+        return (this->bits & bit(measurand)) != 0;
+    }
+
+    /// \brief Checks if no measurand is part of the mask
+    bool empty() const {
+        return this->bits == 0;
+    }
+
+    bool operator==(const MeasurandMask& other) const {
+        return this->bits == other.bits;
+    }
+
+    bool operator!=(const MeasurandMask& other) const {
+        return this->bits != other.bits;
+    }
+
+private:
+    static std::uint64_t bit(MeasurandT measurand) {
+        return std::uint64_t{1} << static_cast<std::uint64_t>(measurand);
+    }
+
+    std::uint64_t bits{0};
+};
+
+} // namespace ocpp
@@ -3,6 +3,7 @@
 #ifndef OCPP_COMMON_LOGGING_HPP
 #define OCPP_COMMON_LOGGING_HPP
 
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -11,6 +12,7 @@
 #include <mutex>
 #include <ocpp/common/types.hpp>
 #include <thread>
+#include <vector>
 
 namespace ocpp {
 
@@ -47,9 +49,36 @@ enum class LogType {
     System
 };
 
+/// Counters of the background writer of the message logging
+struct MessageLoggingStatistics {
+    std::uint64_t queued{0};  ///< Number of log entries handed over to the background writer
+    std::uint64_t written{0}; ///< Number of log entries written to the log files
+    std::uint64_t dropped{0}; ///< Number of log entries dropped because the write queue was full
+    std::uint64_t batches{0}; ///< Number of batches written by the background writer
+};
+
 /// \brief contains a ocpp message logging abstraction
+///
+/// Log files are written by a background thread, so disk latency does not delay the sending and receiving of OCPP
+/// messages. Entries are queued up to a maximum size and dropped when the writer cannot keep up, security log entries
+/// are never dropped.
 class MessageLogging {
 private:
+    /// \brief The files a log entry can be written to
+    enum class LogTarget {
+        Log,
+        RawLog,
+        Html,
+        RawHtml,
+        Security
+    };
+
+    /// \brief A formatted log entry waiting to be written by the background writer
+    struct PendingLogEntry {
+        LogTarget target;
+        std::string text;
+    };
+
     bool log_messages;
     std::string message_log_path; // FIXME: use fs::path here
     std::string output_file_name;
@@ -70,7 +99,15 @@ private:
     std::ofstream html_raw_log_os;
     std::filesystem::path security_log_file;
     std::ofstream security_log_os;
-    std::mutex output_file_mutex;
+    std::map<LogTarget, std::uintmax_t> log_file_sizes; // only accessed by the background writer after initialize()
+    std::mutex output_file_mutex;                       // protects the write queue and statistics
+    std::condition_variable write_queue_cv;
+    std::vector<PendingLogEntry> write_queue;
+    std::size_t write_queue_bytes{0};
+    std::uint64_t dropped_since_last_batch{0};
+    bool stop_writer{false};
+    MessageLoggingStatistics statistics;
+    std::thread writer_thread;
     std::function<void(const std::string& message, MessageDirection direction)> message_callback;
     std::function<void(LogRotationStatus status)> status_callback;
     std::map<std::string, std::string> lookup_map;
@@ -88,6 +125,16 @@ private:
     /// \brief Output log message to the configured targets
     void log_output(LogType typ, const std::string& message_type, const std::string& json_str, bool raw = false);
 
+    /// \brief Hands the formatted \p text over to the background writer
+    /// \returns false if the entry was dropped because the write queue is full
+    bool enqueue(LogTarget target, std::string&& text);
+
+    /// \brief Writes queued entries in batches until the logging is destroyed
+    void run_writer();
+
+    /// \brief Writes a single \p entry, rotating its log file if needed
+    void write_entry(const PendingLogEntry& entry);
+
     /// \brief Format the given \p json_str with the given \p message_type
     FormattedMessageWithType format_message(const std::string& message_type, const std::string& json_str);
 
@@ -95,12 +142,16 @@ private:
     /// than the maximum
     LogRotationStatus rotate_log(const std::string& file_basename);
 
-    /// \brief Rotates the log at the given \p path if needed based on the config, closing the stream \p os before
-    LogRotationStatus rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os);
+    /// \brief Rotates the log at the given \p path if needed based on the config, closing the stream \p os before.
+    /// \p file_size is the current size of the log file and is updated after a rotation
+    LogRotationStatus rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os,
+                                           std::uintmax_t& file_size);
 
     /// \brief Rotates the log at the given \p path if needed based on the config, calling \p before_close_of_os before
-    /// closing the stream \p os and calling \p after_open_of_os afterwards
+    /// closing the stream \p os and calling \p after_open_of_os afterwards.
+    /// \p file_size is the current size of the log file and is updated after a rotation
     LogRotationStatus rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os,
+                                           std::uintmax_t& file_size,
                                            std::function<void(std::ofstream& os)> before_close_of_os,
                                            std::function<void(std::ofstream& os)> after_open_of_os);
 
@@ -147,6 +198,9 @@ public:
 
     /// \returns If session logging is active
     bool session_logging_active() const;
+
+    /// \returns the counters of the background writer
+    MessageLoggingStatistics get_statistics();
 };
 
 } // namespace ocpp
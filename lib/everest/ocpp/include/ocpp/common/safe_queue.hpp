@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 namespace ocpp {
 
@@ -20,6 +22,12 @@ public:
         return queue.empty();
     }
 
+    /// \return The number of elements in the queue
+    std::size_t size() const {
+        const std::lock_guard lock(mutex);
+        return queue.size();
+    }
+
     /// \brief We return a copy here, since while might be accessing the
     /// reference while another thread uses pop and makes the reference stale
     T front() {
@@ -27,12 +35,19 @@ public:
         return queue.front();
     }
 
+    /// \brief Returns copies of up to \p count elements from the front of the queue, in queue order
+    std::vector<T> front_elements(std::size_t count) {
+        const std::lock_guard lock(mutex);
+        const auto end = queue.begin() + static_cast<std::ptrdiff_t>(std::min(count, queue.size()));
+        return std::vector<T>(queue.begin(), end);
+    }
+
     /// \return retrieves and removes the first element in the queue. Undefined behavior if the queue is empty
     T pop() {
         std::unique_lock<std::mutex> lock(mutex);
 
         T front = std::move(queue.front());
-        queue.pop();
+        queue.pop_front();
 
         // Unlock here and notify
         lock.unlock();
@@ -46,7 +61,7 @@ public:
     void push(T&& value) {
         {
             const std::lock_guard<std::mutex> lock(mutex);
-            queue.push(std::move(value));
+            queue.push_back(std::move(value));
         }
 
         notify_waiting_thread();
@@ -56,7 +71,7 @@ public:
     void push(const T& value) {
         {
             const std::lock_guard<std::mutex> lock(mutex);
-            queue.push(value);
+            queue.push_back(value);
         }
 
         notify_waiting_thread();
@@ -67,7 +82,7 @@ public:
         {
             const std::lock_guard<std::mutex> lock(mutex);
 
-            std::queue<T> empty;
+            std::deque<T> empty;
             empty.swap(queue);
         }
 
@@ -112,7 +127,7 @@ public:
     }
 
 private:
-    std::queue<T> queue;
+    std::deque<T> queue;
 
     mutable std::mutex mutex;
     std::condition_variable cv;
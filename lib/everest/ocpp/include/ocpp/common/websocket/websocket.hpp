@@ -70,6 +70,9 @@ public:
 
     /// \brief set the \p authorization_key of the connection_options
     void set_authorization_key(const std::string& authorization_key);
+
+    /// \brief Returns the outgoing traffic counters of the websocket
+    WebsocketTrafficCounters get_traffic_counters() const;
 };
 
 } // namespace ocpp
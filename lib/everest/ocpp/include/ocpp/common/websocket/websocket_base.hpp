@@ -3,6 +3,8 @@
 #ifndef OCPP_WEBSOCKET_BASE_HPP
 #define OCPP_WEBSOCKET_BASE_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -38,8 +40,22 @@ struct WebsocketConnectionOptions {
     std::optional<std::string> iface; // Optional interface where the socket is created. Only usable for libwebsocket
     bool enable_tls_keylog = false;   ///< If set to true enables logging of TLS secrets to the keylog_file
     std::optional<std::filesystem::path> keylog_file; ///< Optional path to a keylog file
+    bool enable_permessage_deflate = false; ///< If set to true offers the RFC 7692 permessage-deflate extension
+    int permessage_deflate_max_window_bits = 15; ///< LZ77 window bits (9..15) offered for both directions
+    bool permessage_deflate_no_context_takeover = false; ///< Offers to reset the compression context per message
 };
 
+/// \brief Outgoing traffic counters of a websocket, accumulated over all connections
+struct WebsocketTrafficCounters {
+    std::uint64_t messages_sent = 0;      ///< Messages handed to the websocket library
+    std::uint64_t payload_bytes = 0;      ///< Payload bytes of these messages before compression
+    std::uint64_t wire_payload_bytes = 0; ///< Payload bytes after permessage-deflate, payload_bytes if not negotiated
+    std::uint64_t write_cycles = 0;       ///< Write cycles used, several small messages can share one cycle
+};
+
+/// \brief Builds the RFC 7692 permessage-deflate extension offer for the \p options
+std::string permessage_deflate_offer(const WebsocketConnectionOptions& options);
+
 ///
 /// \brief contains a websocket abstraction
 ///
@@ -62,6 +78,10 @@ protected:
     std::atomic_int reconnect_backoff_ms;
     std::atomic_int connection_attempts;
     std::atomic_bool shutting_down;
+    std::atomic<std::uint64_t> sent_messages{0};
+    std::atomic<std::uint64_t> sent_payload_bytes{0};
+    std::atomic<std::uint64_t> sent_wire_payload_bytes{0};
+    std::atomic<std::uint64_t> write_cycles{0};
 
     /// \brief Indicates if the required callbacks are registered
     /// \returns true if the websocket is properly initialized
@@ -87,6 +107,13 @@ protected:
     /// \brief Called when a websocket pong timeout is received
     void on_pong_timeout(std::string msg);
 
+    /// \brief Accounts a write cycle, several messages may be written in one cycle
+    void on_write_cycle();
+
+    /// \brief Accounts a message with \p payload_length bytes handed to the websocket library. \p wire_payload_length
+    /// is the payload size after permessage-deflate, std::nullopt if the message was not compressed
+    void on_message_written(std::size_t payload_length, std::optional<std::size_t> wire_payload_length);
+
 public:
     /// \brief Creates a new WebsocketBase object. The `connection_options` must be initialised with
     /// `set_connection_options()`
@@ -140,6 +167,9 @@ public:
 
     /// \brief set the \p authorization_key of the connection_options
     void set_authorization_key(const std::string& authorization_key);
+
+    /// \brief Returns the outgoing traffic counters
+    WebsocketTrafficCounters get_traffic_counters() const;
 };
 
 } // namespace ocpp
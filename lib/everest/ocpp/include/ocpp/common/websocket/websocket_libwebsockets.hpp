@@ -46,6 +46,9 @@ public:
 
     int process_callback(void* wsi_ptr, int callback_reason, void* user, void* in, size_t len);
 
+    /// \brief Called from the permessage-deflate extension with the compressed size \p len of outgoing payload
+    void on_compressed_payload(std::size_t len);
+
 private:
     bool is_trying_to_connect_internal();
     void close_internal(const WebsocketCloseReason code, const std::string& reason);
@@ -105,6 +108,8 @@ private:
 
     // Queue of outgoing messages, notify thread only when we remove messages
     SafeQueue<std::shared_ptr<WebsocketMessage>> message_queue;
+    // Compressed size of the message currently written, only accessed on the websocket client thread
+    std::optional<std::size_t> compressed_payload_length;
 
     std::unique_ptr<std::thread> recv_message_thread;
     SafeQueue<std::string> recv_message_queue;
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#ifndef OCPP_WEBSOCKET_WRITE_COALESCING_HPP
+#define OCPP_WEBSOCKET_WRITE_COALESCING_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace ocpp {
+
+/// \brief Maximum number of queued messages written in a single write cycle
+inline constexpr std::size_t MAX_COALESCED_MESSAGES = 16;
+
+/// \brief Only messages up to this size are coalesced with following ones. Larger messages fill TCP segments on their
+/// own and might need several write cycles when they are compressed
+inline constexpr std::size_t MAX_COALESCED_MESSAGE_SIZE = 512;
+
+/// \brief Writes the queued \p messages of one write cycle in order with \p write. Following messages are coalesced
+/// into the cycle until MAX_COALESCED_MESSAGES were written, a message larger than MAX_COALESCED_MESSAGE_SIZE was
+/// written, \p choked reports that the connection does not accept more data or \p write fails
+/// \returns the number of messages written
+template <typename MessagePtr, typename WriteFunction, typename ChokedFunction>
+std::size_t write_coalesced(const std::vector<MessagePtr>& messages, WriteFunction&& write, ChokedFunction&& choked) {
+    std::size_t written = 0;
+    for (const auto& message : messages) {
+        if (written >= MAX_COALESCED_MESSAGES or !write(message)) {
+            break;
+        }
+        written++;
+
+        if (message->payload.length() > MAX_COALESCED_MESSAGE_SIZE or choked()) {
+            break;
+        }
+    }
+    return written;
+}
+
+} // namespace ocpp
+
+#endif // OCPP_WEBSOCKET_WRITE_COALESCING_HPP
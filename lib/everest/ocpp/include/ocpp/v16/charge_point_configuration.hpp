@@ -3,10 +3,14 @@
 #ifndef OCPP_V16_CHARGE_POINT_CONFIGURATION_HPP
 #define OCPP_V16_CHARGE_POINT_CONFIGURATION_HPP
 
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <set>
 
+#include <everest/timer.hpp>
+
+#include <ocpp/common/measurand_mask.hpp>
 #include <ocpp/common/support_older_cpp_versions.hpp>
 #include <ocpp/v16/ocpp_types.hpp>
 #include <ocpp/v16/types.hpp>
@@ -17,12 +21,34 @@ namespace v16 {
 /// \brief contains the configuration of the charge point
 class ChargePointConfiguration {
 private:
+    /// \brief Typed copies of configuration values that are read on hot paths like meter value sampling. They are
+    /// derived from the json configuration once and updated by the respective setters, so their getters do not need to
+    /// look up or parse anything
+    struct TypedValues {
+        std::int32_t clock_aligned_data_interval{0};
+        std::int32_t heartbeat_interval{0};
+        std::int32_t meter_value_sample_interval{0};
+        std::vector<MeasurandWithPhase> meter_values_aligned_data;
+        std::vector<MeasurandWithPhase> meter_values_sampled_data;
+        MeasurandMask<Measurand> stop_txn_aligned_data;
+        MeasurandMask<Measurand> stop_txn_sampled_data;
+        std::vector<ChargingRateUnit> charging_schedule_allowed_charging_rate_units;
+    };
+
     json config;
+    TypedValues typed;
     json custom_schema;
     json internal_schema;
     bool core_schema_unlock_connector_on_ev_side_disconnect_ro_value;
     fs::path user_config_path;
 
+    /// \brief In memory copy of the user config file. Changes are collected and written to disk after
+    /// USER_CONFIG_FLUSH_DELAY, so that a series of ChangeConfiguration requests results in a single write
+    json user_config;
+    bool user_config_dirty{false};
+    std::mutex user_config_mutex;
+    std::unique_ptr<Everest::SteadyTimer> user_config_flush_timer;
+
     std::set<SupportedFeatureProfiles> supported_feature_profiles;
     std::map<Measurand, std::vector<Phase>> supported_measurands;
     std::map<SupportedFeatureProfiles, std::set<MessageType>> supported_message_types_from_charge_point;
@@ -32,10 +58,13 @@ private:
     std::recursive_mutex configuration_mutex;
 
     std::vector<MeasurandWithPhase> csv_to_measurand_with_phase_vector(std::string csv);
+    MeasurandMask<Measurand> csv_to_measurand_mask(const std::string& csv);
+    std::vector<ChargingRateUnit> parse_charging_schedule_allowed_charging_rate_units(const std::string& csv);
     bool validate_measurands(const json& config);
     bool measurands_supported(std::string csv);
     json get_user_config();
     void setInUserConfig(std::string profile, std::string key, json value);
+    void write_user_config(const json& user_config);
     void init_supported_measurands();
 
     bool isConnectorPhaseRotationValid(std::string str);
@@ -46,6 +75,11 @@ private:
 public:
     ChargePointConfiguration(const std::string& config, const fs::path& ocpp_main_path,
                              const fs::path& user_config_path);
+    ~ChargePointConfiguration();
+
+    /// \brief Writes pending changes of the user config to disk immediately
+    void flushUserConfig();
+
     void setChargepointInformation(const std::string& chargePointVendor, const std::string& chargePointModel,
                                    const std::optional<std::string>& chargePointSerialNumber,
                                    const std::optional<std::string>& chargeBoxSerialNumber,
@@ -136,6 +170,10 @@ public:
     bool getEnableTLSKeylog();
     std::string getTLSKeylogFile();
 
+    bool getWebsocketPerMessageDeflate();
+    int getWebsocketPerMessageDeflateMaxWindowBits();
+    bool getWebsocketPerMessageDeflateNoContextTakeover();
+
     bool getStopTransactionIfUnlockNotSupported();
     void setStopTransactionIfUnlockNotSupported(bool stop_transaction_if_unlock_not_supported);
     KeyValue getStopTransactionIfUnlockNotSupportedKeyValue();
@@ -300,6 +338,7 @@ public:
     std::string getStopTxnAlignedData();
     bool setStopTxnAlignedData(std::string stop_txn_aligned_data);
     KeyValue getStopTxnAlignedDataKeyValue();
+    MeasurandMask<Measurand> getStopTxnAlignedDataMask();
 
     // Core Profile - optional
     std::optional<std::int32_t> getStopTxnAlignedDataMaxLength();
@@ -309,6 +348,7 @@ public:
     std::string getStopTxnSampledData();
     bool setStopTxnSampledData(std::string stop_txn_sampled_data);
     KeyValue getStopTxnSampledDataKeyValue();
+    MeasurandMask<Measurand> getStopTxnSampledDataMask();
 
     // Core Profile - optional
     std::optional<std::int32_t> getStopTxnSampledDataMaxLength();
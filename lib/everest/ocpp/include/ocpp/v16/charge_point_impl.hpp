@@ -26,6 +26,7 @@
 #include <ocpp/v16/connector.hpp>
 #include <ocpp/v16/database_handler.hpp>
 #include <ocpp/v16/message_dispatcher.hpp>
+#include <ocpp/v16/meter_values_sampler.hpp>
 #include <ocpp/v16/messages/Authorize.hpp>
 #include <ocpp/v16/messages/BootNotification.hpp>
 #include <ocpp/v16/messages/CancelReservation.hpp>
@@ -116,6 +117,7 @@ private:
     std::unique_ptr<Everest::SteadyTimer> boot_notification_timer;
     std::unique_ptr<Everest::SteadyTimer> heartbeat_timer;
     std::unique_ptr<ClockAlignedTimer> clock_aligned_meter_values_timer;
+    std::unique_ptr<MeterValuesSampler> meter_values_sampler;
     std::vector<std::unique_ptr<Everest::SteadyTimer>> status_notification_timers;
     std::unique_ptr<Everest::SteadyTimer> ocsp_request_timer;
     std::unique_ptr<Everest::SteadyTimer> client_certificate_timer;
@@ -221,11 +223,12 @@ private:
     void heartbeat(bool initiated_by_trigger_message = false);
     void boot_notification(bool initiated_by_trigger_message = false);
     void clock_aligned_meter_values_sample();
+    void sampled_meter_values_sample(const std::vector<std::int32_t>& connectors);
     void update_heartbeat_interval();
     void update_meter_values_sample_interval();
     void update_clock_aligned_meter_values_interval();
     std::optional<MeterValue> get_latest_meter_value(std::int32_t connector,
-                                                     std::vector<MeasurandWithPhase> values_of_interest,
+                                                     const std::vector<MeasurandWithPhase>& values_of_interest,
                                                      ReadingContext context);
     void send_meter_value(std::int32_t connector, MeterValue meter_value, bool initiated_by_trigger_message = false);
     void send_meter_value_on_pricing_trigger(const std::int32_t connector_number, std::shared_ptr<Connector> connector,
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef OCPP_V16_METER_VALUES_SAMPLER_HPP
+#define OCPP_V16_METER_VALUES_SAMPLER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <everest/timer.hpp>
+
+namespace ocpp {
+namespace v16 {
+
+/// \brief Connectors whose sample deadlines lie within this window are sampled in the same pass
+constexpr std::chrono::milliseconds METER_VALUES_SAMPLE_COALESCING_WINDOW = std::chrono::seconds(1);
+
+/// \brief Samples the meter values of all connectors with a running transaction from a single timer. Every connector
+/// keeps its own deadline, connectors with coinciding deadlines are handed to the callback together so that their
+/// MeterValues can be built in one pass
+class MeterValuesSampler {
+public:
+    using SampleCallback = std::function<void(const std::vector<std::int32_t>& connectors)>;
+
+    /// \brief Creates a new MeterValuesSampler that runs its timer on the provided \p io_context and calls
+    /// \p callback with all connectors that are due
+    MeterValuesSampler(boost::asio::io_context* io_context, const SampleCallback& callback);
+
+    /// \brief Starts sampling the provided \p connector, the first sample is taken one interval from now
+    void add_connector(std::int32_t connector);
+
+    /// \brief Stops sampling the provided \p connector
+    void remove_connector(std::int32_t connector);
+
+    /// \brief Changes the sample \p interval of all connectors and restarts their intervals from now. An \p interval
+    /// of 0 disables sampling
+    void set_interval(std::chrono::seconds interval);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    void arm();
+    void on_timer();
+
+    SampleCallback callback;
+    std::mutex mutex;
+    std::chrono::seconds interval{0};
+    std::map<std::int32_t, clock::time_point> deadlines;
+    Everest::SteadyTimer timer;
+};
+
+} // namespace v16
+} // namespace ocpp
+
+#endif // OCPP_V16_METER_VALUES_SAMPLER_HPP
@@ -4,9 +4,9 @@
 #define OCPP_V16_TRANSACTION_HPP
 
 #include <memory>
+#include <mutex>
 #include <random>
 
-#include <everest/timer.hpp>
 #include <ocpp/v16/ocpp_types.hpp>
 #include <ocpp/v16/types.hpp>
 
@@ -35,7 +35,6 @@ private:
     bool active;
     bool finished;
     bool has_signed_meter_values;
-    std::unique_ptr<Everest::SteadyTimer> meter_values_sample_timer;
     std::string start_transaction_message_id;
     std::string stop_transaction_message_id;
     std::shared_ptr<StampedEnergyWh> stop_energy_wh;
@@ -43,11 +42,10 @@ private:
     std::vector<MeterValue> meter_values;
 
 public:
-    /// \brief Creates a new Transaction object, taking ownership of the provided \p meter_values_sample_timer
-    /// on the provided \p connector
+    /// \brief Creates a new Transaction object on the provided \p connector
     Transaction(const std::int32_t transaction_id, const std::int32_t& connector, const std::string& session_id,
                 const CiString<20>& id_token, const double meter_start, std::optional<std::int32_t> reservation_id,
-                const ocpp::DateTime& timestamp, std::unique_ptr<Everest::SteadyTimer> meter_values_sample_timer);
+                const ocpp::DateTime& timestamp);
 
     /// \brief Provides the energy in Wh at the start of the transaction
     /// \returns the energy in Wh combined with a timestamp
@@ -80,10 +78,6 @@ public:
     /// \returns a vector of powermeter values
     std::vector<MeterValue> get_meter_values();
 
-    /// \brief Changes the sample \p interval of the powermeter values sampling timer
-    /// \returns true if successful
-    bool change_meter_values_sample_interval(std::int32_t interval);
-
     /// \brief Adds the provided \p meter_value to a chronological list of clock aligned powermeter values
     void add_clock_aligned_meter_value(MeterValue meter_value);
 
@@ -198,10 +192,6 @@ public:
     /// \brief Adds a clock aligned \p meter_value to the transaction on the provided \p connector
     void add_meter_value(std::int32_t connector, const MeterValue& meter_value);
 
-    /// \brief Modifies the sample interval of the meter values sample timer on all connectors. The
-    /// provided \p interval is expected to be given in seconds.
-    void change_meter_values_sample_intervals(std::int32_t interval);
-
     // \brief Provides the IdTag that was associated with the transaction with the provided
     /// \p stop_transaction_message_id
     /// \returns the IdTag if it is available, std::nullopt otherwise
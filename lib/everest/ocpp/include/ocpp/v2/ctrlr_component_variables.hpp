@@ -135,6 +135,9 @@ extern const ComponentVariable VerifyCsmsAllowWildcards;
 extern const ComponentVariable IFace;
 extern const ComponentVariable EnableTLSKeylog;
 extern const ComponentVariable TLSKeylogFile;
+extern const ComponentVariable WebsocketPerMessageDeflate;
+extern const ComponentVariable WebsocketPerMessageDeflateMaxWindowBits;
+extern const ComponentVariable WebsocketPerMessageDeflateNoContextTakeover;
 extern const ComponentVariable OcspRequestInterval;
 extern const ComponentVariable WebsocketPingPayload;
 extern const ComponentVariable WebsocketPongTimeout;
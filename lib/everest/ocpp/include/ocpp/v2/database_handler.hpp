@@ -5,6 +5,7 @@
 
 #include "ocpp/v2/types.hpp"
 #include "sqlite3.h"
+#include <map>
 #include <memory>
 #include <ocpp/common/support_older_cpp_versions.hpp>
 
@@ -36,42 +37,32 @@ public:
     virtual void authorization_cache_insert_entry(const std::string& id_token_hash,
                                                   const IdTokenInfo& id_token_info) = 0;
 
-    /// \brief Updates the last_used field in the entry
+    /// \brief Updates the last_used field of the given entries in a single transaction
     ///
-    /// \param id_token_hash
-    /// \retval true if entry was updated
-    virtual void authorization_cache_update_last_used(const std::string& id_token_hash) = 0;
+    /// \param last_used_by_id_token_hash Map of id token hashes to the time the entry was last used
+    virtual void
+    authorization_cache_update_last_used(const std::map<std::string, DateTime>& last_used_by_id_token_hash) = 0;
 
     /// \brief Gets cache entry for given \p id_token_hash if present
     /// \param id_token_hash
     /// \return
     virtual std::optional<AuthorizationCacheEntry> authorization_cache_get_entry(const std::string& id_token_hash) = 0;
 
+    /// \brief Gets all cache entries
+    /// \return Map of id token hashes to their cache entry
+    virtual std::map<std::string, AuthorizationCacheEntry> authorization_cache_get_all_entries() = 0;
+
     /// \brief Deletes the cache entry for the given \p id_token_hash
     /// \param id_token_hash
     virtual void authorization_cache_delete_entry(const std::string& id_token_hash) = 0;
 
-    /// \brief Removes up to \p nr_to_remove items from the cache starting from the least recently used
-    ///
-    /// \param nr_to_remove Number of items to remove from the database
-    /// \retval True if succeeded
-    virtual void authorization_cache_delete_nr_of_oldest_entries(size_t nr_to_remove) = 0;
-
-    /// \brief Removes all entries from the cache that have passed their expiry date or auth cache lifetime
-    ///
-    /// \param auth_cache_lifetime The maximum time tokens can stay in the cache without being used
-    /// \retval True if succeeded
-    virtual void
-    authorization_cache_delete_expired_entries(std::optional<std::chrono::seconds> auth_cache_lifetime) = 0;
+    /// \brief Deletes the cache entries for the given \p id_token_hashes in a single transaction
+    /// \param id_token_hashes
+    virtual void authorization_cache_delete_entries(const std::vector<std::string>& id_token_hashes) = 0;
 
     /// \brief Deletes all entries of the AUTH_CACHE table. Returns true if the operation was successful, else false
     virtual void authorization_cache_clear() = 0;
 
-    /// \brief Get the binary size of the authorization cache table
-    ///
-    /// \retval The size of the authorization cache table in bytes
-    virtual size_t authorization_cache_get_binary_size() = 0;
-
     // Availability
 
     /// \brief Persist operational settings for the charging station
@@ -104,9 +95,17 @@ public:
                                                                  const IdTokenInfo& id_token_info) = 0;
 
     /// \brief Inserts or updates a local authorization list entries \p local_authorization_list to the AUTH_LIST table.
+    /// Entries without IdTokenInfo are deleted. All entries are applied in a single transaction, so either all or none
+    /// of them are applied.
     virtual void
     insert_or_update_local_authorization_list(const std::vector<v2::AuthorizationData>& local_authorization_list) = 0;
 
+    /// \brief Replaces all entries of the AUTH_LIST table with \p local_authorization_list.
+    /// The entries are first written to a staging table and then swapped into the AUTH_LIST table in the same
+    /// transaction, so lookups see the old list until the new list is complete. On failure the old list is kept.
+    virtual void
+    replace_local_authorization_list(const std::vector<v2::AuthorizationData>& local_authorization_list) = 0;
+
     /// \brief Deletes the authorization list entry with the given \p id_tag
     virtual void delete_local_authorization_list_entry(const IdToken& id_token) = 0;
 
@@ -218,19 +217,25 @@ private:
                              bool replace);
     OperationalStatusEnum get_availability(std::int32_t evse_id, std::int32_t connector_id);
 
+    // Local authorization list management (internal helpers)
+    // Writes \p local_authorization_list to \p table_name reusing one statement per operation, must be called within a
+    // transaction
+    void write_local_authorization_list_entries(const std::string& table_name,
+                                                const std::vector<v2::AuthorizationData>& local_authorization_list);
+
 public:
     DatabaseHandler(std::unique_ptr<everest::db::sqlite::ConnectionInterface> database,
                     const fs::path& sql_migration_files_path);
 
     // Authorization cache management
     void authorization_cache_insert_entry(const std::string& id_token_hash, const IdTokenInfo& id_token_info) override;
-    void authorization_cache_update_last_used(const std::string& id_token_hash) override;
+    void
+    authorization_cache_update_last_used(const std::map<std::string, DateTime>& last_used_by_id_token_hash) override;
     std::optional<AuthorizationCacheEntry> authorization_cache_get_entry(const std::string& id_token_hash) override;
+    std::map<std::string, AuthorizationCacheEntry> authorization_cache_get_all_entries() override;
     void authorization_cache_delete_entry(const std::string& id_token_hash) override;
-    void authorization_cache_delete_nr_of_oldest_entries(size_t nr_to_remove) override;
-    void authorization_cache_delete_expired_entries(std::optional<std::chrono::seconds> auth_cache_lifetime) override;
+    void authorization_cache_delete_entries(const std::vector<std::string>& id_token_hashes) override;
     void authorization_cache_clear() override;
-    size_t authorization_cache_get_binary_size() override;
 
     // Availability
     void insert_cs_availability(OperationalStatusEnum operational_status, bool replace) override;
@@ -249,6 +254,7 @@ public:
                                                          const IdTokenInfo& id_token_info) override;
     void insert_or_update_local_authorization_list(
         const std::vector<v2::AuthorizationData>& local_authorization_list) override;
+    void replace_local_authorization_list(const std::vector<v2::AuthorizationData>& local_authorization_list) override;
     void delete_local_authorization_list_entry(const IdToken& id_token) override;
     std::optional<v2::IdTokenInfo> get_local_authorization_list_entry(const IdToken& id_token) override;
     void clear_local_authorization_list() override;
@@ -115,6 +115,9 @@ public:
 
     std::vector<ReportData> get_base_report_data(const ReportBaseEnum& report_base) override;
 
+    void for_each_base_report_data(const ReportBaseEnum& report_base,
+                                   const std::function<void(const ReportData&)>& handler) override;
+
     std::vector<ReportData> get_custom_report_data(
         const std::optional<std::vector<ComponentVariable>>& component_variables = std::nullopt,
         const std::optional<std::vector<ComponentCriterionEnum>>& component_criteria = std::nullopt) override;
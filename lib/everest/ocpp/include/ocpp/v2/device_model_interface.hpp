@@ -4,6 +4,7 @@
 #ifndef DEVICE_MODEL_INTERFACE_HPP
 #define DEVICE_MODEL_INTERFACE_HPP
 
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -123,6 +124,13 @@ public:
     /// \return Vector of ReportData
     virtual std::vector<ReportData> get_base_report_data(const ReportBaseEnum& report_base) = 0;
 
+    /// \brief Calls \p handler for every ReportData of the specified report base, without collecting the whole
+    /// report in memory
+    /// \param report_base The report base filter
+    /// \param handler Called once for every ReportData of the report
+    virtual void for_each_base_report_data(const ReportBaseEnum& report_base,
+                                           const std::function<void(const ReportData&)>& handler) = 0;
+
     /// \brief Gets the ReportData for the specified filters
     /// \param component_variables Optional component variables filter
     /// \param component_criteria Optional component criteria filter
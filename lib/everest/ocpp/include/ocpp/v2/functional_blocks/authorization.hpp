@@ -5,6 +5,10 @@
 
 #include <ocpp/v2/message_handler.hpp>
 
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace ocpp::v2 {
 struct FunctionalBlockContext;
 struct AuthorizationCacheEntry;
@@ -52,6 +56,26 @@ private: // Members
     std::thread auth_cache_cleanup_thread;
     std::atomic_bool auth_cache_cleanup_handler_running;
 
+    /// \brief In-memory front of the AUTH_CACHE table
+    ///
+    /// The entries are loaded from the database on first use. Lookups, the last used time and the size of the cache
+    /// are served from memory. Inserts and deletes are written through to the database, updates of the last used time
+    /// are written back by the cleanup thread.
+    struct AuthCacheItem {
+        IdTokenInfo id_token_info;
+        DateTime last_used;
+        size_t binary_size;
+        std::list<std::string>::iterator lru_position;
+    };
+    std::mutex auth_cache_mutex;
+    bool auth_cache_loaded;
+    std::unordered_map<std::string, AuthCacheItem> auth_cache;
+    // id token hashes, least recently used first
+    std::list<std::string> auth_cache_lru;
+    // id token hashes of which the last used time has not been written back yet
+    std::unordered_set<std::string> auth_cache_last_used_dirty;
+    size_t auth_cache_binary_size;
+
 public:
     explicit Authorization(const FunctionalBlockContext& context);
     ~Authorization() override;
@@ -81,6 +105,13 @@ private: // Functions
     void handle_clear_cache_req(Call<ClearCacheRequest> call);
     void cache_cleanup_handler();
 
+    // In-memory authorization cache, all of these require auth_cache_mutex to be held
+    void auth_cache_load();
+    void auth_cache_put(const std::string& id_token_hash, const IdTokenInfo& id_token_info, const DateTime& last_used);
+    void auth_cache_erase(const std::string& id_token_hash);
+    void auth_cache_mark_used(const std::string& id_token_hash);
+    void auth_cache_write_last_used();
+
     // Functional Block D: Local authorization list management
     void handle_send_local_authorization_list_req(Call<SendLocalListRequest> call);
     void handle_get_local_authorization_list_version_req(Call<GetLocalListVersionRequest> call);
@@ -7,6 +7,9 @@
 
 #include <ocpp/common/aligned_timer.hpp>
 #include <ocpp/v2/average_meter_values.hpp>
+#include <ocpp/v2/utils.hpp>
+
+#include <mutex>
 
 namespace ocpp::v2 {
 struct FunctionalBlockContext;
@@ -22,6 +25,11 @@ public:
     virtual void on_meter_value(const std::int32_t evse_id, const MeterValue& meter_value) = 0;
     virtual MeterValue get_latest_meter_value_filtered(const MeterValue& meter_value, ReadingContextEnum context,
                                                        const RequiredComponentVariable& component_variable) = 0;
+    /// \brief Get the measurands configured in the given \p component_variable compiled into a mask. The mask is cached
+    /// until invalidate_measurands_mask is called for the component variable.
+    virtual utils::MeasurandEnumMask get_measurands_mask(const RequiredComponentVariable& component_variable) = 0;
+    /// \brief Drops the cached mask of the given \p component_variable, must be called when its value changed
+    virtual void invalidate_measurands_mask(const ComponentVariable& component_variable) = 0;
     // Functional Block J: MeterValues
     virtual void meter_values_req(const std::int32_t evse_id, const std::vector<MeterValue>& meter_values,
                                   const bool initiated_by_trigger_message = false) = 0;
@@ -36,6 +44,8 @@ public:
     void on_meter_value(const std::int32_t evse_id, const MeterValue& meter_value) override;
     MeterValue get_latest_meter_value_filtered(const MeterValue& meter_value, ReadingContextEnum context,
                                                const RequiredComponentVariable& component_variable) override;
+    utils::MeasurandEnumMask get_measurands_mask(const RequiredComponentVariable& component_variable) override;
+    void invalidate_measurands_mask(const ComponentVariable& component_variable) override;
 
     void meter_values_req(const std::int32_t evse_id, const std::vector<MeterValue>& meter_values,
                           const bool initiated_by_trigger_message = false) override;
@@ -45,5 +55,10 @@ private: // Members
 
     ClockAlignedTimer aligned_meter_values_timer;
     AverageMeterValues aligned_data_evse0; // represents evseId = 0 meter value
+
+    // compiled measurand masks by component variable, there are only a handful of measurand variables so a linear
+    // search is cheaper than any map
+    std::vector<std::pair<ComponentVariable, utils::MeasurandEnumMask>> measurands_masks;
+    std::mutex measurands_masks_mutex;
 };
 } // namespace ocpp::v2
@@ -110,6 +110,11 @@ private:
     /* OCPP message requests */
 
     void notify_report_req(const int request_id, const std::vector<ReportData>& report_data);
+    /// \brief Sends the NotifyReport.req pages of the ReportData that \p generate_report_data passes to the provided
+    /// handler. Pages are sent as soon as they are full, so the report does not need to be held in memory
+    void notify_report_req(
+        const int request_id,
+        const std::function<void(const std::function<void(const ReportData&)>&)>& generate_report_data);
 
     /* OCPP message handlers */
 
@@ -4,6 +4,9 @@
 #ifndef OCPP_NOTIFY_REPORT_REQUESTS_SPLITTER_HPP
 #define OCPP_NOTIFY_REPORT_REQUESTS_SPLITTER_HPP
 
+#include <ostream>
+#include <streambuf>
+
 #include "ocpp/common/call_types.hpp"
 #include "ocpp/v2/messages/NotifyReport.hpp"
 #include "ocpp/v2/types.hpp"
@@ -11,20 +14,78 @@
 namespace ocpp {
 namespace v2 {
 
-/// \brief Utility class that is used to split NotifyReportRequest into several ones in case ReportData is too big.
-class NotifyReportRequestsSplitter {
+/// \brief Builds NotifyReportRequest call payloads from a stream of ReportData. Every ReportData is converted and
+/// measured exactly once, pages are handed to the payload callback as soon as the next ReportData does not fit anymore.
+/// Only the page that is currently filled is kept in memory.
+class NotifyReportStreamer {
 
 private:
+    /// \brief Stream buffer that only counts the characters written to it
+    class SizeCounter : public std::streambuf {
+    public:
+        size_t size = 0;
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* s, std::streamsize count) override;
+    };
+
     // cppcheck-suppress unusedStructMember
     static const std::string MESSAGE_TYPE; // NotifyReport
-    const NotifyReportRequest& original_request;
     // cppcheck-suppress unusedStructMember
     size_t max_size;
     const std::function<MessageId()> message_id_generator_callback;
+    const std::function<void(json&&)> payload_callback;
     json request_json_template; // json that is used  as template for request json
     // cppcheck-suppress unusedStructMember
-    const size_t json_skeleton_size; // size of the json skeleton for a call json object which includes everything
-                                     // except the requests' reportData and the messageId
+    size_t json_skeleton_size; // size of the json skeleton for a call json object which includes everything
+                               // except the requests' reportData and the messageId
+    SizeCounter size_counter;
+    std::ostream size_stream;
+
+    std::string message_id;       // message id of the page that is currently filled
+    json page_report_data;        // reportData of the page that is currently filled
+    size_t page_report_data_size; // serialized size of page_report_data
+    size_t page_remaining_size;   // size available for the reportData of the page that is currently filled
+    int seq_no;
+
+public:
+    /// \brief Creates a new NotifyReportStreamer for the given \p request_id and \p generated_at timestamp. Call
+    /// payloads that do not exceed \p max_size are passed to \p payload_callback, unless a single ReportData already
+    /// exceeds it.
+    NotifyReportStreamer(std::int32_t request_id, const ocpp::DateTime& generated_at, size_t max_size,
+                         std::function<MessageId()>&& message_id_generator_callback,
+                         std::function<void(json&&)>&& payload_callback);
+    NotifyReportStreamer() = delete;
+    NotifyReportStreamer(const NotifyReportStreamer&) = delete;
+    NotifyReportStreamer& operator=(const NotifyReportStreamer&) = delete;
+
+    /// \brief Adds the given \p report_data to the report, this emits the current page if \p report_data does not
+    /// fit into it anymore
+    void add(const ReportData& report_data);
+
+    /// \brief Emits the last page of the report. Must be called exactly once after all ReportData has been added
+    void finish();
+
+    /// \brief Provides the number of payloads that have been emitted
+    int get_number_of_payloads() const;
+
+private:
+    size_t serialized_size(const json& value);
+    void start_page();
+    void emit_page(bool tbc);
+};
+
+/// \brief Utility class that is used to split NotifyReportRequest into several ones in case ReportData is too big.
+class NotifyReportRequestsSplitter {
+
+private:
+    // cppcheck-suppress unusedStructMember
+    static const std::string MESSAGE_TYPE; // NotifyReport
+    const NotifyReportRequest& original_request;
+    // cppcheck-suppress unusedStructMember
+    size_t max_size;
+    std::function<MessageId()> message_id_generator_callback;
 
 public:
     NotifyReportRequestsSplitter(const NotifyReportRequest& originalRequest, size_t max_size,
@@ -34,19 +95,6 @@ public:
     /// \brief Splits the provided NotifyReportRequest into (potentially) several Call payloads
     /// \returns the json messages that serialize the resulting Call<NotifyReportRequest> objects
     std::vector<json> create_call_payloads();
-
-private:
-    size_t create_request_template_json_and_return_skeleton_size();
-
-    // Create next call payload (with as many reportData items as possible)
-    json create_next_payload(const int& seq_no, std::vector<ocpp::v2::ReportData>::const_iterator& report_data_iterator,
-                             const std::vector<ocpp::v2::ReportData>::const_iterator& report_data_end,
-                             const std::string& message_id);
-
-    // Create next request payload (with as many reportData items as possible) to be contained in next call payload
-    static json create_next_report_data_json(std::vector<ocpp::v2::ReportData>::const_iterator& report_data_iterator,
-                                             const std::vector<ocpp::v2::ReportData>::const_iterator& report_data_end,
-                                             const size_t& remaining_size);
 };
 
 } // namespace v2
@@ -3,6 +3,7 @@
 #ifndef V2_UTILS_HPP
 #define V2_UTILS_HPP
 
+#include <ocpp/common/measurand_mask.hpp>
 #include <ocpp/v2/device_model_abstract.hpp>
 #include <ocpp/v2/ocpp_types.hpp>
 #include <ocpp/v2/types.hpp>
@@ -10,13 +11,22 @@ namespace ocpp {
 namespace v2 {
 namespace utils {
 
+using MeasurandEnumMask = MeasurandMask<MeasurandEnum>;
+
 /// \brief This function returns the configured Measurand as an std::vector
 /// \brief std::vector<MeasurandEnum> of the configured AlignedDataMeasurands
 std::vector<MeasurandEnum> get_measurands_vec(const std::string& measurands_csv);
 
+/// \brief Compiles the given comma separated \p measurands_csv into a mask. Unknown measurands are ignored
+MeasurandEnumMask get_measurands_mask(const std::string& measurands_csv);
+
+/// \brief Compiles the given \p measurands into a mask
+MeasurandEnumMask get_measurands_mask(const std::vector<MeasurandEnum>& measurands);
+
 /// \brief This function determines if any of the \p measurands is present in the \p _meter_value at all
 /// \return True if any measurand is found, false otherwise
 bool meter_value_has_any_measurand(const MeterValue& _meter_value, const std::vector<MeasurandEnum>& measurands);
+bool meter_value_has_any_measurand(const MeterValue& _meter_value, const MeasurandEnumMask& measurands);
 
 /// \brief Applies the given \p measurands to the given \p _meter_value . The returned meter value will only contain
 /// SampledValues which measurand is listed in the given \param measurands . If no measurand is set for the
@@ -28,6 +38,8 @@ bool meter_value_has_any_measurand(const MeterValue& _meter_value, const std::ve
 MeterValue get_meter_value_with_measurands_applied(const MeterValue& _meter_value,
                                                    const std::vector<MeasurandEnum>& measurands,
                                                    bool include_signed = true);
+MeterValue get_meter_value_with_measurands_applied(const MeterValue& _meter_value, const MeasurandEnumMask& measurands,
+                                                   bool include_signed = true);
 
 /// \brief Applies the given measurands to \p meter_values based on their ReadingContext.
 /// Transaction_Begin, Interruption_Begin, Transaction_End, Interruption_End and Sample_Periodic will be filtered using
@@ -41,6 +53,10 @@ std::vector<MeterValue> get_meter_values_with_measurands_applied(
     const std::vector<MeterValue>& meter_values, const std::vector<MeasurandEnum>& sampled_tx_ended_measurands,
     const std::vector<MeasurandEnum>& aligned_tx_ended_measurands, ocpp::DateTime max_timestamp,
     bool include_sampled_signed = true, bool include_aligned_signed = true);
+std::vector<MeterValue> get_meter_values_with_measurands_applied(
+    const std::vector<MeterValue>& meter_values, const MeasurandEnumMask& sampled_tx_ended_measurands,
+    const MeasurandEnumMask& aligned_tx_ended_measurands, ocpp::DateTime max_timestamp,
+    bool include_sampled_signed = true, bool include_aligned_signed = true);
 
 ///
 /// \brief Set reading context of metervalue sampled values.
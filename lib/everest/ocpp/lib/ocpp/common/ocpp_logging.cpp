@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright Pionix GmbH and Contributors to EVerest
 #include <algorithm>
+#include <sstream>
 
 #include <everest/logging.hpp>
 
@@ -14,6 +15,9 @@ using json = nlohmann::json;
 
 namespace ocpp {
 namespace {
+/// Maximum number of bytes waiting for the background writer before further log entries are dropped
+constexpr std::size_t MAXIMUM_QUEUED_BYTES = 4 * 1024 * 1024;
+
 /// \brief Add opening html tags to the given stream \p os
 void open_html_tags(std::ofstream& os);
 
@@ -93,13 +97,17 @@ void MessageLogging::initialize() {
                 EVLOG_info << "Logging raw OCPP messages to log file: " << raw_output_file_path;
                 this->log_raw_file = std::filesystem::path(raw_output_file_path);
                 this->log_raw_os.open(raw_output_file_path, std::ofstream::app);
-                this->rotate_log_if_needed(this->log_raw_file, this->log_raw_os);
+                auto& file_size = this->log_file_sizes[LogTarget::RawLog];
+                file_size = safe_file_size(this->log_raw_file);
+                this->rotate_log_if_needed(this->log_raw_file, this->log_raw_os, file_size);
             }
             output_file_path += +".log";
             EVLOG_info << "Logging OCPP messages to log file: " << output_file_path;
             this->log_file = std::filesystem::path(output_file_path);
             this->log_os.open(output_file_path, std::ofstream::app);
-            this->rotate_log_if_needed(this->log_file, this->log_os);
+            auto& file_size = this->log_file_sizes[LogTarget::Log];
+            file_size = safe_file_size(this->log_file);
+            this->rotate_log_if_needed(this->log_file, this->log_os, file_size);
         }
 
         if (this->log_to_html) {
@@ -110,8 +118,11 @@ void MessageLogging::initialize() {
                 EVLOG_info << "Logging raw OCPP messages to html file: " << raw_html_file_path;
                 this->html_raw_log_file = std::filesystem::path(raw_html_file_path);
                 this->html_raw_log_os.open(html_raw_log_file, std::ofstream::app);
+                auto& file_size = this->log_file_sizes[LogTarget::RawHtml];
+                file_size = safe_file_size(this->html_raw_log_file);
                 this->rotate_log_if_needed(
-                    this->html_raw_log_file, this->html_raw_log_os, [this](std::ofstream& os) { close_html_tags(os); },
+                    this->html_raw_log_file, this->html_raw_log_os, file_size,
+                    [this](std::ofstream& os) { close_html_tags(os); },
                     [this](std::ofstream& os) { open_html_tags(os); });
 
                 if (safe_file_size(this->html_raw_log_file) > 0) {
@@ -119,13 +130,16 @@ void MessageLogging::initialize() {
                 } else {
                     open_html_tags(this->html_raw_log_os);
                 }
+                file_size = safe_file_size(this->html_raw_log_file);
             }
             html_file_path += ".html";
             EVLOG_info << "Logging OCPP messages to html file: " << html_file_path;
             this->html_log_file = std::filesystem::path(html_file_path);
             this->html_log_os.open(html_log_file, std::ofstream::app);
+            auto& file_size = this->log_file_sizes[LogTarget::Html];
+            file_size = safe_file_size(this->html_log_file);
             this->rotate_log_if_needed(
-                this->html_log_file, this->html_log_os, [this](std::ofstream& os) { close_html_tags(os); },
+                this->html_log_file, this->html_log_os, file_size, [this](std::ofstream& os) { close_html_tags(os); },
                 [this](std::ofstream& os) { open_html_tags(os); });
 
             if (safe_file_size(this->html_log_file) > 0) {
@@ -133,6 +147,7 @@ void MessageLogging::initialize() {
             } else {
                 open_html_tags(this->html_log_os);
             }
+            file_size = safe_file_size(this->html_log_file);
         }
         if (this->log_security) {
             auto security_file_path = message_log_path + "/";
@@ -141,7 +156,12 @@ void MessageLogging::initialize() {
             EVLOG_info << "Logging SecurityEvents to file: " << security_file_path;
             this->security_log_file = std::filesystem::path(security_file_path);
             this->security_log_os.open(security_log_file, std::ofstream::app);
-            this->rotate_log_if_needed(this->security_log_file, this->security_log_os);
+            auto& file_size = this->log_file_sizes[LogTarget::Security];
+            file_size = safe_file_size(this->security_log_file);
+            this->rotate_log_if_needed(this->security_log_file, this->security_log_os, file_size);
+        }
+        if (this->log_to_file or this->log_to_html or this->log_security) {
+            this->writer_thread = std::thread(&MessageLogging::run_writer, this);
         }
         sys("Session logging started.");
     }
@@ -262,11 +282,13 @@ LogRotationStatus MessageLogging::rotate_log(const std::string& file_basename) {
     return status;
 }
 
-LogRotationStatus MessageLogging::rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os) {
-    return rotate_log_if_needed(path, os, nullptr, nullptr);
+LogRotationStatus MessageLogging::rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os,
+                                                       std::uintmax_t& file_size) {
+    return rotate_log_if_needed(path, os, file_size, nullptr, nullptr);
 }
 
 LogRotationStatus MessageLogging::rotate_log_if_needed(const std::filesystem::path& path, std::ofstream& os,
+                                                       std::uintmax_t& file_size,
                                                        std::function<void(std::ofstream& os)> before_close_of_os,
                                                        std::function<void(std::ofstream& os)> after_open_of_os) {
     LogRotationStatus status = LogRotationStatus::NotRotated;
@@ -278,9 +300,9 @@ LogRotationStatus MessageLogging::rotate_log_if_needed(const std::filesystem::pa
         // do nothing if no maximum file size is set
         return LogRotationStatus::NotRotated;
     }
-    auto log_file_size = safe_file_size(path);
-    if (log_file_size >= maximum_file_size_bytes) {
-        EVLOG_info << "Logfile: " << path.filename().string() << " file size (" << log_file_size << " bytes) >= ("
+    // the size is tracked while writing, so the file system does not need to be asked for every entry
+    if (file_size >= maximum_file_size_bytes) {
+        EVLOG_info << "Logfile: " << path.filename().string() << " file size (" << file_size << " bytes) >= ("
                    << maximum_file_size_bytes << " bytes) rotating log.";
         if (before_close_of_os != nullptr) {
             before_close_of_os(os);
@@ -292,11 +314,22 @@ LogRotationStatus MessageLogging::rotate_log_if_needed(const std::filesystem::pa
         if (after_open_of_os != nullptr) {
             after_open_of_os(os);
         }
+        file_size = safe_file_size(path);
     }
     return status;
 }
 
 MessageLogging::~MessageLogging() {
+    if (this->writer_thread.joinable()) {
+        {
+            const std::lock_guard<std::mutex> lock(this->output_file_mutex);
+            this->stop_writer = true;
+        }
+        this->write_queue_cv.notify_one();
+        // the writer drains the queue before it exits
+        this->writer_thread.join();
+    }
+
     if (this->log_messages) {
         if (this->log_to_file) {
             this->log_os.close();
@@ -352,13 +385,10 @@ void MessageLogging::sys(const std::string& msg) {
 }
 
 void MessageLogging::security(const std::string& msg) {
-    const std::lock_guard<std::mutex> lock(this->output_file_mutex);
-    auto status = this->rotate_log_if_needed(this->security_log_file, this->security_log_os);
-    if (status_callback != nullptr) {
-        status_callback(status);
+    if (not this->log_messages or not this->log_security) {
+        return;
     }
-    this->security_log_os << msg << "\n";
-    this->security_log_os.flush();
+    this->enqueue(LogTarget::Security, msg + "\n");
 }
 
 void MessageLogging::raw(const std::string& msg, LogType log_type) {
@@ -381,29 +411,30 @@ std::string html_encode(const std::string& msg) {
     return out;
 }
 
-void write_log_to_file(std::ofstream& log_os, LogType typ, const std::string& ts, const std::string& origin,
-                       const std::string& target, const std::string& message_type, const std::string& json_str) {
+std::string format_log_entry(LogType typ, const std::string& ts, const std::string& origin, const std::string& target,
+                             const std::string& message_type, const std::string& json_str) {
+    std::ostringstream log_os;
     log_os << ts << ": " << origin + ">" + target << " "
            << (typ == LogType::ChargePoint || typ == LogType::System ? message_type : "") << " "
            << (typ == LogType::CentralSystem ? message_type : "") << "\n"
            << json_str << "\n\n";
-    log_os.flush();
+    return log_os.str();
 }
 
-void write_html_log_to_file(std::ofstream& html_log_os, LogType typ, const std::string& ts, const std::string& origin,
-                            const std::string& target, const std::string& message_type, const std::string& json_str) {
+std::string format_html_log_entry(LogType typ, const std::string& ts, const std::string& origin,
+                                  const std::string& target, const std::string& message_type,
+                                  const std::string& json_str) {
+    std::ostringstream html_log_os;
     html_log_os << "<tr class=\"" << origin << "\"> <td>" << ts << "</td> <td>" << origin + "&gt;" + target
                 << "</td> <td><b>" << (typ == LogType::ChargePoint || typ == LogType::System ? message_type : "")
                 << "</b></td><td><b>" << (typ == LogType::CentralSystem ? message_type : "")
                 << "</b></td> <td><pre lang=\"json\">" << html_encode(json_str) << "</pre></td> </tr>\n";
-    html_log_os.flush();
+    return html_log_os.str();
 }
 } // namespace
 
 void MessageLogging::log_output(LogType typ, const std::string& message_type, const std::string& json_str, bool raw) {
     if (this->log_messages) {
-        const std::lock_guard<std::mutex> lock(this->output_file_mutex);
-
         const std::string ts = DateTime().to_rfc3339();
 
         std::string origin;
@@ -435,30 +466,114 @@ void MessageLogging::log_output(LogType typ, const std::string& message_type, co
         }
 
         if (this->log_to_file) {
-            if (raw and this->log_raw) {
-                this->rotate_log_if_needed(this->log_raw_file, this->log_raw_os);
-                write_log_to_file(this->log_raw_os, typ, ts, origin, target, message_type, json_str);
-            } else {
-                this->rotate_log_if_needed(this->log_file, this->log_os);
-                write_log_to_file(this->log_os, typ, ts, origin, target, message_type, json_str);
-            }
+            this->enqueue(raw and this->log_raw ? LogTarget::RawLog : LogTarget::Log,
+                          format_log_entry(typ, ts, origin, target, message_type, json_str));
         }
         if (this->log_to_html) {
-            if (raw and this->log_raw) {
-                this->rotate_log_if_needed(
-                    this->html_raw_log_file, this->html_raw_log_os, [this](std::ofstream& os) { close_html_tags(os); },
-                    [this](std::ofstream& os) { open_html_tags(os); });
-                write_html_log_to_file(this->html_raw_log_os, typ, ts, origin, target, message_type, json_str);
-            } else {
-                this->rotate_log_if_needed(
-                    this->html_log_file, this->html_log_os, [this](std::ofstream& os) { close_html_tags(os); },
-                    [this](std::ofstream& os) { open_html_tags(os); });
-                write_html_log_to_file(this->html_log_os, typ, ts, origin, target, message_type, json_str);
+            this->enqueue(raw and this->log_raw ? LogTarget::RawHtml : LogTarget::Html,
+                          format_html_log_entry(typ, ts, origin, target, message_type, json_str));
+        }
+    }
+}
+
+bool MessageLogging::enqueue(LogTarget target, std::string&& text) {
+    {
+        const std::lock_guard<std::mutex> lock(this->output_file_mutex);
+        if (not this->writer_thread.joinable()) {
+            return false;
+        }
+        if (target != LogTarget::Security and this->write_queue_bytes + text.size() > MAXIMUM_QUEUED_BYTES) {
+            this->statistics.dropped++;
+            this->dropped_since_last_batch++;
+            return false;
+        }
+        this->write_queue_bytes += text.size();
+        this->write_queue.push_back({target, std::move(text)});
+        this->statistics.queued++;
+    }
+    this->write_queue_cv.notify_one();
+    return true;
+}
+
+void MessageLogging::run_writer() {
+    std::vector<PendingLogEntry> batch;
+    for (;;) {
+        std::uint64_t dropped = 0;
+        {
+            std::unique_lock<std::mutex> lock(this->output_file_mutex);
+            this->write_queue_cv.wait(lock, [this]() { return this->stop_writer or not this->write_queue.empty(); });
+            if (this->write_queue.empty()) {
+                // stop requested and everything written
+                return;
             }
+            batch.swap(this->write_queue);
+            this->write_queue_bytes = 0;
+            dropped = this->dropped_since_last_batch;
+            this->dropped_since_last_batch = 0;
+        }
+
+        if (dropped > 0) {
+            EVLOG_warning << "OCPP message logging could not keep up, dropped " << dropped << " log entries";
+        }
+
+        for (const auto& entry : batch) {
+            this->write_entry(entry);
+        }
+        // flush once per batch instead of once per entry
+        for (auto* os : {&this->log_os, &this->log_raw_os, &this->html_log_os, &this->html_raw_log_os,
+                         &this->security_log_os}) {
+            if (os->is_open()) {
+                os->flush();
+            }
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(this->output_file_mutex);
+            this->statistics.written += batch.size();
+            this->statistics.batches++;
         }
+        batch.clear();
     }
 }
 
+void MessageLogging::write_entry(const PendingLogEntry& entry) {
+    auto& file_size = this->log_file_sizes[entry.target];
+    const auto close_html = [](std::ofstream& os) { close_html_tags(os); };
+    const auto open_html = [](std::ofstream& os) { open_html_tags(os); };
+
+    std::ofstream* os = nullptr;
+    switch (entry.target) {
+    case LogTarget::Log:
+        this->rotate_log_if_needed(this->log_file, this->log_os, file_size);
+        os = &this->log_os;
+        break;
+    case LogTarget::RawLog:
+        this->rotate_log_if_needed(this->log_raw_file, this->log_raw_os, file_size);
+        os = &this->log_raw_os;
+        break;
+    case LogTarget::Html:
+        this->rotate_log_if_needed(this->html_log_file, this->html_log_os, file_size, close_html, open_html);
+        os = &this->html_log_os;
+        break;
+    case LogTarget::RawHtml:
+        this->rotate_log_if_needed(this->html_raw_log_file, this->html_raw_log_os, file_size, close_html, open_html);
+        os = &this->html_raw_log_os;
+        break;
+    case LogTarget::Security: {
+        const auto status = this->rotate_log_if_needed(this->security_log_file, this->security_log_os, file_size);
+        if (this->status_callback != nullptr) {
+            // called from the writer thread, the callback may log again but must not wait for the logging
+            this->status_callback(status);
+        }
+        os = &this->security_log_os;
+        break;
+    }
+    }
+
+    *os << entry.text;
+    file_size += entry.text.size();
+}
+
 FormattedMessageWithType MessageLogging::format_message(const std::string& message_type, const std::string& json_str) {
     auto extracted_message_type = message_type;
     auto formatted_message = json_str;
@@ -492,8 +607,9 @@ void MessageLogging::stop_session_logging(const std::string& session_id) {
         auto old_file_path =
             this->session_id_logging.at(session_id)->get_message_log_path() + "/" + "incomplete-ocpp.html";
         auto new_file_path = this->session_id_logging.at(session_id)->get_message_log_path() + "/" + "ocpp.html";
-        std::rename(old_file_path.c_str(), new_file_path.c_str());
+        // destroying the session logging writes all pending entries before the file is renamed
         this->session_id_logging.erase(session_id);
+        std::rename(old_file_path.c_str(), new_file_path.c_str());
     }
 }
 
@@ -505,4 +621,9 @@ bool MessageLogging::session_logging_active() const {
     return this->session_logging;
 }
 
+MessageLoggingStatistics MessageLogging::get_statistics() {
+    const std::lock_guard<std::mutex> lock(this->output_file_mutex);
+    return this->statistics;
+}
+
 } // namespace ocpp
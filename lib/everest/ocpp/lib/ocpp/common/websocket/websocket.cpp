@@ -92,4 +92,8 @@ void Websocket::set_authorization_key(const std::string& authorization_key) {
     this->websocket->set_authorization_key(authorization_key);
 }
 
+WebsocketTrafficCounters Websocket::get_traffic_counters() const {
+    return this->websocket->get_traffic_counters();
+}
+
 } // namespace ocpp
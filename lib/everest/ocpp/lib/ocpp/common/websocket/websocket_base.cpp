@@ -222,6 +222,39 @@ void WebsocketBase::set_authorization_key(const std::string& authorization_key)
     this->connection_options.authorization_key = authorization_key;
 }
 
+void WebsocketBase::on_write_cycle() {
+    this->write_cycles++;
+}
+
+void WebsocketBase::on_message_written(std::size_t payload_length, std::optional<std::size_t> wire_payload_length) {
+    this->sent_messages++;
+    this->sent_payload_bytes += payload_length;
+    this->sent_wire_payload_bytes += wire_payload_length.value_or(payload_length);
+}
+
+WebsocketTrafficCounters WebsocketBase::get_traffic_counters() const {
+    WebsocketTrafficCounters counters;
+    counters.messages_sent = this->sent_messages;
+    counters.payload_bytes = this->sent_payload_bytes;
+    counters.wire_payload_bytes = this->sent_wire_payload_bytes;
+    counters.write_cycles = this->write_cycles;
+    return counters;
+}
+
+std::string permessage_deflate_offer(const WebsocketConnectionOptions& options) {
+    std::string offer = "permessage-deflate";
+    if (options.permessage_deflate_max_window_bits < 15) {
+        const auto bits = std::to_string(options.permessage_deflate_max_window_bits);
+        offer += "; client_max_window_bits=" + bits + "; server_max_window_bits=" + bits;
+    } else {
+        offer += "; client_max_window_bits";
+    }
+    if (options.permessage_deflate_no_context_takeover) {
+        offer += "; client_no_context_takeover; server_no_context_takeover";
+    }
+    return offer;
+}
+
 void WebsocketBase::on_pong_timeout(std::string msg) {
     EVLOG_info << "Reconnecting because of a pong timeout after " << this->connection_options.pong_timeout_s << "s"
                << " and with reason: " << msg;
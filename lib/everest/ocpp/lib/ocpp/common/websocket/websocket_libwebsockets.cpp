@@ -2,11 +2,14 @@
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
 #include <evse_security/crypto/openssl/openssl_provider.hpp>
 #include <ocpp/common/websocket/websocket_libwebsockets.hpp>
+#include <ocpp/common/websocket/websocket_write_coalescing.hpp>
 
 #include <everest/logging.hpp>
 
 #include <libwebsockets.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -16,6 +19,10 @@
 #include <stdexcept>
 #include <string>
 
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
 #include <openssl/opensslv.h>
 #include <openssl/ssl.h>
 #include <openssl/x509v3.h>
@@ -230,6 +237,9 @@ public:
     }
 
 private:
+    // permessage-deflate offer and extension list, referenced by lws_ctx so they must outlive it
+    std::string deflate_offer;
+    std::array<lws_extension, 2> extensions{};
     // Openssl context, must be destroyed in this order
     std::unique_ptr<SSL_CTX> sec_context;
     // libwebsockets state
@@ -408,6 +418,14 @@ void WebsocketLibwebsockets::set_connection_options(const WebsocketConnectionOpt
 
     set_connection_options_base(connection_options);
 
+    if (connection_options.enable_permessage_deflate and
+        (connection_options.permessage_deflate_max_window_bits < 9 or
+         connection_options.permessage_deflate_max_window_bits > 15)) {
+        EVLOG_warning << "permessage-deflate window bits of " << connection_options.permessage_deflate_max_window_bits
+                      << " are out of range 9..15, using 15";
+        this->connection_options.permessage_deflate_max_window_bits = 15;
+    }
+
     // Set secure URI only if it is in TLS mode
     if (connection_options.security_profile >
         security::SecurityProfile::UNSECURED_TRANSPORT_WITH_BASIC_AUTHENTICATION) {
@@ -434,6 +452,39 @@ int callback_minimal(struct lws* wsi, enum lws_callback_reasons reason, void* us
     return 0;
 }
 
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+int callback_permessage_deflate(struct lws_context* context, const struct lws_extension* ext, struct lws* wsi,
+                                enum lws_extension_callback_reasons reason, void* user, void* in, size_t len) {
+    const int result = lws_extension_callback_pm_deflate(context, ext, wsi, reason, user, in, len);
+
+    // Account the compressed size of outgoing payload
+    if (reason == LWS_EXT_CB_PAYLOAD_TX and result >= 0 and in != nullptr and wsi != nullptr) {
+        const auto* pmdrx = static_cast<const lws_ext_pm_deflate_rx_ebufs*>(in);
+        if (auto* data = static_cast<ConnectionData*>(lws_wsi_user(wsi))) {
+            if (auto* owner = data->get_owner()) {
+                owner->on_compressed_payload(static_cast<std::size_t>(std::max(pmdrx->eb_out.len, 0)));
+            }
+        }
+    }
+
+    return result;
+}
+#endif
+
+/// \brief While corked the kernel only sends full TCP segments, uncorking flushes what is left
+void set_tcp_cork(lws* wsi, bool cork) {
+#ifdef TCP_CORK
+    const auto fd = lws_get_socket_fd(wsi);
+    if (fd < 0) {
+        return;
+    }
+    const int value = cork ? 1 : 0;
+    if (setsockopt(fd, IPPROTO_TCP, TCP_CORK, &value, sizeof(value)) != 0) {
+        EVLOG_debug << "Could not " << (cork ? "cork" : "uncork") << " websocket connection";
+    }
+#endif
+}
+
 int private_key_callback(char* buf, int size, int /*rwflag*/, void* userdata) {
     const auto* password = static_cast<const std::string*>(userdata);
     const std::size_t max_pass_len = (size - 1); // we exclude the endline
@@ -616,6 +667,19 @@ bool WebsocketLibwebsockets::initialize_connection_options(std::shared_ptr<Conne
     info.port = CONTEXT_PORT_NO_LISTEN; /* we do not run any server */
     info.protocols = protocols.data();
 
+    if (this->connection_options.enable_permessage_deflate) {
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+        new_connection_data->deflate_offer = permessage_deflate_offer(this->connection_options);
+        new_connection_data->extensions[0] = {"permessage-deflate", callback_permessage_deflate,
+                                              new_connection_data->deflate_offer.c_str()};
+        new_connection_data->extensions[1] = {nullptr, nullptr, nullptr};
+        info.extensions = new_connection_data->extensions.data();
+        EVLOG_info << "Offering websocket extension: " << new_connection_data->deflate_offer;
+#else
+        EVLOG_warning << "permessage-deflate is enabled but libwebsockets was built without extension support";
+#endif
+    }
+
     if (this->connection_options.iface.has_value()) {
         EVLOG_info << "Using network iface: " << this->connection_options.iface.value().c_str();
 
@@ -1671,33 +1735,59 @@ void WebsocketLibwebsockets::on_conn_writable() {
         }
     }
 
-    // If we still have message ONLY poll a single one that can be processed in the invoke of the function
-    // libwebsockets is designed so that when a message is sent to the wire from the internal buffer it
-    // will invoke 'on_conn_writable' again and we can execute the code above
-    if (!message_queue.empty()) {
-        // Poll a single message
-        EVLOG_debug << "Client writable, sending message part!";
+    // libwebsockets is designed so that when the messages are sent to the wire from the internal buffer it
+    // will invoke 'on_conn_writable' again and we can execute the code above. Small messages are coalesced
+    // into this write cycle as long as the connection accepts more data, the socket is corked meanwhile so
+    // that they end up in as few TCP segments as possible. Larger messages are written alone
+    const auto pending = message_queue.front_elements(MAX_COALESCED_MESSAGES);
+    if (pending.empty()) {
+        return;
+    }
 
-        auto message = message_queue.front();
+    EVLOG_debug << "Client writable, sending up to " << pending.size() << " messages!";
 
-        if (message == nullptr) {
-            EVLOG_AND_THROW(std::runtime_error("Null message in queue, fatal error!"));
-        }
+    lws* wsi = local_data->get_conn();
+    const bool cork = pending.size() > 1;
+    if (cork) {
+        set_tcp_cork(wsi, true);
+    }
+    this->on_write_cycle();
 
-        if (message->sent_bytes >= message->payload.length()) {
-            EVLOG_AND_THROW(std::runtime_error("Already polled message should be handled above, fatal error!"));
-        }
+    write_coalesced(
+        pending,
+        [this, wsi](const std::shared_ptr<WebsocketMessage>& message) {
+            if (message == nullptr) {
+                EVLOG_AND_THROW(std::runtime_error("Null message in queue, fatal error!"));
+            }
 
-        // Continue sending message part, for a single message only
-        const bool sent = send_internal(local_data->get_conn(), message.get());
+            if (message->sent_bytes >= message->payload.length()) {
+                EVLOG_AND_THROW(std::runtime_error("Already polled message should be handled above, fatal error!"));
+            }
 
-        // If we failed, attempt again later
-        if (!sent) {
-            message->sent_bytes = 0;
-        }
+            this->compressed_payload_length.reset();
+            const bool sent = send_internal(wsi, message.get());
+
+            // If we failed, attempt again later
+            if (!sent) {
+                message->sent_bytes = 0;
+                return false;
+            }
+
+            // Not compressed if permessage-deflate was not negotiated
+            this->on_message_written(message->payload.length(), this->compressed_payload_length);
+            return true;
+        },
+        [wsi]() { return lws_send_pipe_choked(wsi) != 0; });
+
+    if (cork) {
+        set_tcp_cork(wsi, false);
     }
 }
 
+void WebsocketLibwebsockets::on_compressed_payload(std::size_t len) {
+    this->compressed_payload_length = this->compressed_payload_length.value_or(0) + len;
+}
+
 void WebsocketLibwebsockets::push_deferred_callback(const std::function<void()>& callback) {
     if (!callback) {
         EVLOG_error << "Attempting to push stale callback in deferred queue!";
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright Pionix GmbH and Contributors to EVerest
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <future>
@@ -25,6 +26,7 @@ const size_t SECC_LEAF_SUBJECT_COMMON_NAME_MIN_LENGTH = 7;
 const size_t SECC_LEAF_SUBJECT_COMMON_NAME_MAX_LENGTH = 64;
 const size_t AUTHORIZATION_KEY_MIN_LENGTH = 8;
 const std::int32_t MAX_WAIT_FOR_SET_USER_PRICE_TIMEOUT_MS = 30000;
+const std::chrono::milliseconds USER_CONFIG_FLUSH_DELAY(1000);
 
 ChargePointConfiguration::ChargePointConfiguration(const std::string& config, const fs::path& ocpp_main_path,
                                                    const fs::path& user_config_path) :
@@ -34,6 +36,13 @@ ChargePointConfiguration::ChargePointConfiguration(const std::string& config, co
         EVLOG_critical << "User config file does not exist";
         throw std::runtime_error("User config file does not exist");
     }
+    try {
+        this->user_config = this->get_user_config();
+    } catch (const json::parse_error& e) {
+        EVLOG_error << "Error while parsing user config file.";
+        EVLOG_AND_THROW(e);
+    }
+    this->user_config_flush_timer = std::make_unique<Everest::SteadyTimer>([this]() { this->flushUserConfig(); });
 
     // validate config entries
     const auto schemas_path = ocpp_main_path / "profile_schemas";
@@ -148,6 +157,19 @@ ChargePointConfiguration::ChargePointConfiguration(const std::string& config, co
                                            "Measurands configured in SupportedMeasurands"));
     }
 
+    this->typed.clock_aligned_data_interval = this->config["Core"]["ClockAlignedDataInterval"];
+    this->typed.heartbeat_interval = this->config["Core"]["HeartbeatInterval"];
+    this->typed.meter_value_sample_interval = this->config["Core"]["MeterValueSampleInterval"];
+    this->typed.meter_values_aligned_data = this->csv_to_measurand_with_phase_vector(this->getMeterValuesAlignedData());
+    this->typed.meter_values_sampled_data = this->csv_to_measurand_with_phase_vector(this->getMeterValuesSampledData());
+    this->typed.stop_txn_aligned_data = this->csv_to_measurand_mask(this->getStopTxnAlignedData());
+    this->typed.stop_txn_sampled_data = this->csv_to_measurand_mask(this->getStopTxnSampledData());
+    if (this->config.contains("SmartCharging")) {
+        this->typed.charging_schedule_allowed_charging_rate_units =
+            this->parse_charging_schedule_allowed_charging_rate_units(
+                this->getChargingScheduleAllowedChargingRateUnit());
+    }
+
     this->supported_message_types_from_charge_point = {
         {SupportedFeatureProfiles::Core,
          {MessageType::Authorize, MessageType::BootNotification, MessageType::ChangeAvailabilityResponse,
@@ -227,7 +249,13 @@ json ChargePointConfiguration::get_user_config() {
     return json({}, true);
 }
 
-void ChargePointConfiguration::setInUserConfig(std::string profile, std::string key, const json value) {
+ChargePointConfiguration::~ChargePointConfiguration() {
+    // stop the timer before writing the last changes, so both cannot run concurrently
+    this->user_config_flush_timer.reset();
+    this->flushUserConfig();
+}
+
+void ChargePointConfiguration::write_user_config(const json& user_config) {
     // write to a separate file to minimise corruption and data loss; then rename
     namespace fs = std::filesystem;
 
@@ -235,8 +263,6 @@ void ChargePointConfiguration::setInUserConfig(std::string profile, std::string
         const auto tmp_file = user_config_path.string() + '$';
         fs::remove(tmp_file);
 
-        json user_config = get_user_config();
-        user_config[profile][key] = value;
         std::ofstream ofs(tmp_file);
         ofs << user_config << std::endl;
         ofs.close();
@@ -247,6 +273,26 @@ void ChargePointConfiguration::setInUserConfig(std::string profile, std::string
     }
 }
 
+void ChargePointConfiguration::setInUserConfig(std::string profile, std::string key, const json value) {
+    std::lock_guard<std::mutex> lock(this->user_config_mutex);
+    this->user_config[profile][key] = value;
+    if (!this->user_config_dirty) {
+        // the first change schedules the write, later changes are included in it
+        this->user_config_dirty = true;
+        if (this->user_config_flush_timer != nullptr) {
+            this->user_config_flush_timer->timeout(USER_CONFIG_FLUSH_DELAY);
+        }
+    }
+}
+
+void ChargePointConfiguration::flushUserConfig() {
+    std::lock_guard<std::mutex> lock(this->user_config_mutex);
+    if (this->user_config_dirty) {
+        this->write_user_config(this->user_config);
+        this->user_config_dirty = false;
+    }
+}
+
 namespace {
 std::string to_csl(const std::vector<std::string>& vec) {
     std::string csl;
@@ -317,8 +363,7 @@ void ChargePointConfiguration::setChargepointInformation(const std::string& char
                                                          const std::optional<std::string>& chargePointSerialNumber,
                                                          const std::optional<std::string>& chargeBoxSerialNumber,
                                                          const std::optional<std::string>& firmwareVersion) {
-    // load current persistent configuration from disk
-    json user_config = this->get_user_config();
+    std::lock_guard<std::mutex> lock(this->user_config_mutex);
 
     this->config["Internal"]["ChargePointVendor"] = chargePointVendor;
     user_config["Internal"]["ChargePointVendor"] = chargePointVendor;
@@ -330,37 +375,32 @@ void ChargePointConfiguration::setChargepointInformation(const std::string& char
     setChargepointInformationProperty(user_config, "ChargeBoxSerialNumber", chargeBoxSerialNumber);
     setChargepointInformationProperty(user_config, "FirmwareVersion", firmwareVersion);
 
-    // save the changes back
-    std::ofstream ofs(this->user_config_path.c_str());
-    ofs << user_config << std::endl;
-    ofs.close();
+    // save the changes back, including changes that are not written yet
+    this->write_user_config(this->user_config);
+    this->user_config_dirty = false;
 }
 
 void ChargePointConfiguration::setChargepointModemInformation(const std::optional<std::string>& ICCID,
                                                               const std::optional<std::string>& IMSI) {
-    // load current persistent configuration from disk
-    json user_config = this->get_user_config();
+    std::lock_guard<std::mutex> lock(this->user_config_mutex);
 
     setChargepointInformationProperty(user_config, "ICCID", ICCID);
     setChargepointInformationProperty(user_config, "IMSI", IMSI);
 
-    // save the changes back
-    std::ofstream ofs(this->user_config_path.c_str());
-    ofs << user_config << std::endl;
-    ofs.close();
+    // save the changes back, including changes that are not written yet
+    this->write_user_config(this->user_config);
+    this->user_config_dirty = false;
 }
 void ChargePointConfiguration::setChargepointMeterInformation(const std::optional<std::string>& meterSerialNumber,
                                                               const std::optional<std::string>& meterType) {
-    // load current persistent configuration from disk
-    json user_config = this->get_user_config();
+    std::lock_guard<std::mutex> lock(this->user_config_mutex);
 
     setChargepointInformationProperty(user_config, "MeterSerialNumber", meterSerialNumber);
     setChargepointInformationProperty(user_config, "MeterType", meterType);
 
-    // save the changes back
-    std::ofstream ofs(this->user_config_path.c_str());
-    ofs << user_config << std::endl;
-    ofs.close();
+    // save the changes back, including changes that are not written yet
+    this->write_user_config(this->user_config);
+    this->user_config_dirty = false;
 }
 
 // Internal config options
@@ -937,6 +977,18 @@ std::string ChargePointConfiguration::getTLSKeylogFile() {
     return this->config["Internal"]["TLSKeylogFile"];
 }
 
+bool ChargePointConfiguration::getWebsocketPerMessageDeflate() {
+    return this->config["Internal"]["WebsocketPerMessageDeflate"];
+}
+
+int ChargePointConfiguration::getWebsocketPerMessageDeflateMaxWindowBits() {
+    return this->config["Internal"]["WebsocketPerMessageDeflateMaxWindowBits"];
+}
+
+bool ChargePointConfiguration::getWebsocketPerMessageDeflateNoContextTakeover() {
+    return this->config["Internal"]["WebsocketPerMessageDeflateNoContextTakeover"];
+}
+
 bool ChargePointConfiguration::getStopTransactionIfUnlockNotSupported() {
     return this->config["Internal"]["StopTransactionIfUnlockNotSupported"];
 }
@@ -1066,6 +1118,23 @@ std::vector<MeasurandWithPhase> ChargePointConfiguration::csv_to_measurand_with_
     return measurand_with_phase_vector;
 }
 
+static_assert(static_cast<int>(Measurand::RPM) < 64, "Measurand does not fit into a mask");
+
+MeasurandMask<Measurand> ChargePointConfiguration::csv_to_measurand_mask(const std::string& csv) {
+    MeasurandMask<Measurand> measurands;
+    if (csv.empty()) {
+        return measurands;
+    }
+    for (const auto& component : split_string(csv, ',')) {
+        try {
+            measurands.set(conversions::string_to_measurand(component));
+        } catch (const StringToEnumException& e) {
+            EVLOG_warning << "Could not convert string: " << component << " to MeasurandEnum";
+        }
+    }
+    return measurands;
+}
+
 bool ChargePointConfiguration::validate_measurands(const json& config) {
     std::vector<std::string> measurands_vector;
 
@@ -1332,10 +1401,11 @@ std::optional<KeyValue> ChargePointConfiguration::getBlinkRepeatKeyValue() {
 
 // Core Profile
 std::int32_t ChargePointConfiguration::getClockAlignedDataInterval() {
-    return this->config["Core"]["ClockAlignedDataInterval"];
+    return this->typed.clock_aligned_data_interval;
 }
 void ChargePointConfiguration::setClockAlignedDataInterval(std::int32_t interval) {
     this->config["Core"]["ClockAlignedDataInterval"] = interval;
+    this->typed.clock_aligned_data_interval = interval;
     this->setInUserConfig("Core", "ClockAlignedDataInterval", interval);
 }
 KeyValue ChargePointConfiguration::getClockAlignedDataIntervalKeyValue() {
@@ -1413,10 +1483,11 @@ KeyValue ChargePointConfiguration::getGetConfigurationMaxKeysKeyValue() {
 
 // Core Profile
 std::int32_t ChargePointConfiguration::getHeartbeatInterval() {
-    return this->config["Core"]["HeartbeatInterval"];
+    return this->typed.heartbeat_interval;
 }
 void ChargePointConfiguration::setHeartbeatInterval(std::int32_t interval) {
     this->config["Core"]["HeartbeatInterval"] = interval;
+    this->typed.heartbeat_interval = interval;
     this->setInUserConfig("Core", "HeartbeatInterval", interval);
 }
 KeyValue ChargePointConfiguration::getHeartbeatIntervalKeyValue() {
@@ -1522,6 +1593,7 @@ bool ChargePointConfiguration::setMeterValuesAlignedData(std::string meter_value
         return false;
     }
     this->config["Core"]["MeterValuesAlignedData"] = meter_values_aligned_data;
+    this->typed.meter_values_aligned_data = this->csv_to_measurand_with_phase_vector(meter_values_aligned_data);
     this->setInUserConfig("Core", "MeterValuesAlignedData", meter_values_aligned_data);
     return true;
 }
@@ -1533,7 +1605,7 @@ KeyValue ChargePointConfiguration::getMeterValuesAlignedDataKeyValue() {
     return kv;
 }
 std::vector<MeasurandWithPhase> ChargePointConfiguration::getMeterValuesAlignedDataVector() {
-    return this->csv_to_measurand_with_phase_vector(this->getMeterValuesAlignedData());
+    return this->typed.meter_values_aligned_data;
 }
 
 // Core Profile - optional
@@ -1566,6 +1638,7 @@ bool ChargePointConfiguration::setMeterValuesSampledData(std::string meter_value
         return false;
     }
     this->config["Core"]["MeterValuesSampledData"] = meter_values_sampled_data;
+    this->typed.meter_values_sampled_data = this->csv_to_measurand_with_phase_vector(meter_values_sampled_data);
     this->setInUserConfig("Core", "MeterValuesSampledData", meter_values_sampled_data);
     return true;
 }
@@ -1577,7 +1650,7 @@ KeyValue ChargePointConfiguration::getMeterValuesSampledDataKeyValue() {
     return kv;
 }
 std::vector<MeasurandWithPhase> ChargePointConfiguration::getMeterValuesSampledDataVector() {
-    return this->csv_to_measurand_with_phase_vector(this->getMeterValuesSampledData());
+    return this->typed.meter_values_sampled_data;
 }
 
 // Core Profile - optional
@@ -1603,10 +1676,11 @@ std::optional<KeyValue> ChargePointConfiguration::getMeterValuesSampledDataMaxLe
 
 // Core Profile
 std::int32_t ChargePointConfiguration::getMeterValueSampleInterval() {
-    return this->config["Core"]["MeterValueSampleInterval"];
+    return this->typed.meter_value_sample_interval;
 }
 void ChargePointConfiguration::setMeterValueSampleInterval(std::int32_t interval) {
     this->config["Core"]["MeterValueSampleInterval"] = interval;
+    this->typed.meter_value_sample_interval = interval;
     this->setInUserConfig("Core", "MeterValueSampleInterval", interval);
 }
 KeyValue ChargePointConfiguration::getMeterValueSampleIntervalKeyValue() {
@@ -1741,6 +1815,7 @@ bool ChargePointConfiguration::setStopTxnAlignedData(std::string stop_txn_aligne
         return false;
     }
     this->config["Core"]["StopTxnAlignedData"] = stop_txn_aligned_data;
+    this->typed.stop_txn_aligned_data = this->csv_to_measurand_mask(stop_txn_aligned_data);
     this->setInUserConfig("Core", "StopTxnAlignedData", stop_txn_aligned_data);
     return true;
 }
@@ -1751,6 +1826,9 @@ KeyValue ChargePointConfiguration::getStopTxnAlignedDataKeyValue() {
     kv.value.emplace(this->getStopTxnAlignedData());
     return kv;
 }
+MeasurandMask<Measurand> ChargePointConfiguration::getStopTxnAlignedDataMask() {
+    return this->typed.stop_txn_aligned_data;
+}
 
 // Core Profile - optional
 std::optional<std::int32_t> ChargePointConfiguration::getStopTxnAlignedDataMaxLength() {
@@ -1782,6 +1860,7 @@ bool ChargePointConfiguration::setStopTxnSampledData(std::string stop_txn_sample
         return false;
     }
     this->config["Core"]["StopTxnSampledData"] = stop_txn_sampled_data;
+    this->typed.stop_txn_sampled_data = this->csv_to_measurand_mask(stop_txn_sampled_data);
     this->setInUserConfig("Core", "StopTxnSampledData", stop_txn_sampled_data);
 
     return true;
@@ -1793,6 +1872,9 @@ KeyValue ChargePointConfiguration::getStopTxnSampledDataKeyValue() {
     kv.value.emplace(this->getStopTxnSampledData());
     return kv;
 }
+MeasurandMask<Measurand> ChargePointConfiguration::getStopTxnSampledDataMask() {
+    return this->typed.stop_txn_sampled_data;
+}
 
 // Core Profile - optional
 std::optional<std::int32_t> ChargePointConfiguration::getStopTxnSampledDataMaxLength() {
@@ -2000,8 +2082,12 @@ KeyValue ChargePointConfiguration::getChargingScheduleAllowedChargingRateUnitKey
     return kv;
 }
 std::vector<ChargingRateUnit> ChargePointConfiguration::getChargingScheduleAllowedChargingRateUnitVector() {
+    return this->typed.charging_schedule_allowed_charging_rate_units;
+}
+
+std::vector<ChargingRateUnit>
+ChargePointConfiguration::parse_charging_schedule_allowed_charging_rate_units(const std::string& csv) {
     std::vector<std::string> components;
-    auto csv = this->getChargingScheduleAllowedChargingRateUnit();
     boost::split(components, csv, boost::is_any_of(","));
     std::vector<ChargingRateUnit> charging_rate_unit_vector;
     for (const auto& component : components) {
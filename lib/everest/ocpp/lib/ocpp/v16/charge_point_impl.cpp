@@ -106,6 +106,11 @@ ChargePointImpl::ChargePointImpl(const std::string& config, const fs::path& shar
     this->clock_aligned_meter_values_timer =
         std::make_unique<ClockAlignedTimer>(&this->io_context, [this]() { this->clock_aligned_meter_values_sample(); });
 
+    this->meter_values_sampler = std::make_unique<MeterValuesSampler>(
+        &this->io_context,
+        [this](const std::vector<std::int32_t>& connectors) { this->sampled_meter_values_sample(connectors); });
+    this->meter_values_sampler->set_interval(std::chrono::seconds(this->configuration->getMeterValueSampleInterval()));
+
     this->client_certificate_timer = std::make_unique<Everest::SteadyTimer>(&this->io_context, [this]() {
         EVLOG_info << "Checking if CSMS client certificate has expired";
         const int expiry_days_count = this->evse_security->get_leaf_expiry_days_count(
@@ -421,7 +426,10 @@ WebsocketConnectionOptions ChargePointImpl::get_ws_connection_options() {
                                                   this->configuration->getVerifyCsmsAllowWildcards(),
                                                   this->configuration->getIFace(),
                                                   this->configuration->getEnableTLSKeylog(),
-                                                  this->configuration->getTLSKeylogFile()};
+                                                  this->configuration->getTLSKeylogFile(),
+                                                  this->configuration->getWebsocketPerMessageDeflate(),
+                                                  this->configuration->getWebsocketPerMessageDeflateMaxWindowBits(),
+                                                  this->configuration->getWebsocketPerMessageDeflateNoContextTakeover()};
     return connection_options;
 }
 
@@ -485,6 +493,46 @@ void ChargePointImpl::clock_aligned_meter_values_sample() {
     }
 }
 
+void ChargePointImpl::sampled_meter_values_sample(const std::vector<std::int32_t>& connectors) {
+    // all connectors that are due in this pass share the parsed measurand configuration
+    const auto values_of_interest = this->configuration->getMeterValuesSampledDataVector();
+    for (const auto connector : connectors) {
+        const auto transaction = this->transaction_handler->get_transaction(connector);
+        if (transaction == nullptr or not transaction->is_active()) {
+            continue;
+        }
+
+        const auto meter_value =
+            this->get_latest_meter_value(connector, values_of_interest, ReadingContext::Sample_Periodic);
+        if (!meter_value.has_value()) {
+            EVLOG_warning
+                << "Could not send and add meter value to transaction for uninitialized measurement at connector#"
+                << connector;
+            continue;
+        }
+
+        transaction->add_meter_value(meter_value.value());
+        this->send_meter_value(connector, meter_value.value());
+
+        // this updates the last meter value in the database
+        for (const auto& entry : meter_value.value().sampledValue) {
+            if (entry.measurand == Measurand::Energy_Active_Import_Register and !entry.phase.has_value()) {
+                // this is the entry for Energy.Active.Import.Register total
+                try {
+                    this->database_handler->update_transaction_meter_value(transaction->get_session_id(),
+                                                                           std::stoi(entry.value),
+                                                                           meter_value.value().timestamp.to_rfc3339());
+                } catch (const std::invalid_argument& e) {
+                    EVLOG_warning << "Processed invalid meter value: " << entry.value << " while updating database";
+                } catch (const QueryExecutionException& e) {
+                    EVLOG_warning << "Could not update meter value of transaction with session_id "
+                                  << transaction->get_session_id() << " in the database: " << e.what();
+                }
+            }
+        }
+    }
+}
+
 void ChargePointImpl::update_heartbeat_interval() {
     this->heartbeat_timer->interval(std::chrono::seconds(this->configuration->getHeartbeatInterval()));
 }
@@ -492,7 +540,7 @@ void ChargePointImpl::update_heartbeat_interval() {
 void ChargePointImpl::update_meter_values_sample_interval() {
     // TODO(kai): should we update the meter values for continuous monitoring here too?
     const std::int32_t interval = this->configuration->getMeterValueSampleInterval();
-    this->transaction_handler->change_meter_values_sample_intervals(interval);
+    this->meter_values_sampler->set_interval(std::chrono::seconds(interval));
 }
 
 void ChargePointImpl::update_clock_aligned_meter_values_interval() {
@@ -519,7 +567,7 @@ void ChargePointImpl::try_resume_transactions(const std::set<std::string>& resum
         const std::shared_ptr<Transaction> transaction = std::make_shared<Transaction>(
             this->transaction_handler->get_negative_random_transaction_id(), transaction_entry.connector,
             transaction_entry.session_id, CiString<20>(transaction_entry.id_tag_start), transaction_entry.meter_start,
-            transaction_entry.reservation_id, ocpp::DateTime(transaction_entry.time_start), nullptr);
+            transaction_entry.reservation_id, ocpp::DateTime(transaction_entry.time_start));
         ocpp::DateTime timestamp;
         int meter_stop = 0;
         if (transaction_entry.time_end.has_value() and transaction_entry.meter_stop.has_value()) {
@@ -603,21 +651,22 @@ void ChargePointImpl::load_charging_profiles() {
     }
 }
 
-std::optional<MeterValue> ChargePointImpl::get_latest_meter_value(std::int32_t connector,
-                                                                  std::vector<MeasurandWithPhase> values_of_interest,
-                                                                  ReadingContext context) {
+std::optional<MeterValue>
+ChargePointImpl::get_latest_meter_value(std::int32_t connector,
+                                        const std::vector<MeasurandWithPhase>& values_of_interest,
+                                        ReadingContext context) {
     const std::lock_guard<std::mutex> lock(measurement_mutex);
     std::optional<MeterValue> filtered_meter_value_opt;
     // TODO(kai): also support readings from the charge point measurement at "connector 0"
     if (this->connectors.find(connector) != this->connectors.end() &&
         this->connectors.at(connector)->measurement.has_value()) {
         MeterValue filtered_meter_value;
-        const auto measurement = this->connectors.at(connector)->measurement.value();
-        const auto power_meter = measurement.power_meter;
+        const auto& measurement = this->connectors.at(connector)->measurement.value();
+        const auto& power_meter = measurement.power_meter;
         const auto timestamp = power_meter.timestamp;
         filtered_meter_value.timestamp = ocpp::DateTime(timestamp);
         EVLOG_debug << "Measurement value for connector: " << connector << ": " << measurement;
-        for (auto configured_measurand : values_of_interest) {
+        for (const auto& configured_measurand : values_of_interest) {
             EVLOG_debug << "Value of interest: " << conversions::measurand_to_string(configured_measurand.measurand);
             // constructing sampled value
             SampledValue sample;
@@ -1295,6 +1344,7 @@ bool ChargePointImpl::stop() {
         this->database_handler->close_connection();
         this->websocket->disconnect(WebsocketCloseReason::Normal);
         this->message_queue->stop();
+        this->configuration->flushUserConfig();
 
         this->stopped = true;
         this->initialized = false;
@@ -2330,6 +2380,7 @@ void ChargePointImpl::handleResetRequest(ocpp::Call<ResetRequest> call) {
                 });
             // this is executed after all transactions have been stopped
             // it is expected that the user properly shuts down the software, including calling stop()
+            this->configuration->flushUserConfig();
             this->reset_callback(reset_type);
         });
         if (call.msg.type == ResetType::Soft) {
@@ -4323,7 +4374,7 @@ void ChargePointImpl::start_transaction(std::shared_ptr<Transaction> transaction
     call.msg.reservationId = reservation_id;
 
     transaction->set_start_transaction_message_id(message_id.get());
-    transaction->change_meter_values_sample_interval(this->configuration->getMeterValueSampleInterval());
+    this->meter_values_sampler->add_connector(transaction->get_connector());
 
     this->message_dispatcher->dispatch_call(call);
 
@@ -4373,43 +4424,9 @@ void ChargePointImpl::on_transaction_started(const std::int32_t& connector, cons
         this->status->submit_event(connector, FSMEvent::UsageInitiated, ocpp::DateTime());
     }
 
-    auto meter_values_sample_timer = std::make_unique<Everest::SteadyTimer>(&this->io_context, [this, connector]() {
-        const auto meter_value = this->get_latest_meter_value(
-            connector, this->configuration->getMeterValuesSampledDataVector(), ReadingContext::Sample_Periodic);
-        if (meter_value.has_value()) {
-            this->transaction_handler->add_meter_value(connector, meter_value.value());
-            this->send_meter_value(connector, meter_value.value());
-
-            // this updates the last meter value in the database
-            const auto transaction = this->transaction_handler->get_transaction(connector);
-            if (transaction != nullptr) {
-                for (const auto& entry : meter_value.value().sampledValue) {
-                    if (entry.measurand == Measurand::Energy_Active_Import_Register and !entry.phase.has_value()) {
-                        // this is the entry for Energy.Active.Import.Register total
-                        try {
-                            this->database_handler->update_transaction_meter_value(
-                                transaction->get_session_id(), std::stoi(entry.value),
-                                meter_value.value().timestamp.to_rfc3339());
-                        } catch (const std::invalid_argument& e) {
-                            EVLOG_warning << "Processed invalid meter value: " << entry.value
-                                          << " while updating database";
-                        } catch (const QueryExecutionException& e) {
-                            EVLOG_warning << "Could not update meter value of transaction with session_id "
-                                          << transaction->get_session_id() << " in the database: " << e.what();
-                        }
-                    }
-                }
-            }
-        } else {
-            EVLOG_warning
-                << "Could not send and add meter value to transaction for uninitialized measurement at connector#"
-                << connector;
-        }
-    });
-    meter_values_sample_timer->interval(std::chrono::seconds(this->configuration->getMeterValueSampleInterval()));
     const std::shared_ptr<Transaction> transaction = std::make_shared<Transaction>(
         this->transaction_handler->get_negative_random_transaction_id(), connector, session_id, CiString<20>(id_token),
-        meter_start, reservation_id, timestamp, std::move(meter_values_sample_timer));
+        meter_start, reservation_id, timestamp);
     if (signed_meter_value) {
         const auto meter_value =
             get_signed_meter_value(signed_meter_value.value(), ReadingContext::Transaction_Begin, timestamp);
@@ -4440,6 +4457,7 @@ void ChargePointImpl::on_transaction_stopped(const std::int32_t connector, const
     }
     const auto stop_energy_wh = std::make_shared<StampedEnergyWh>(timestamp, energy_wh_import);
     transaction->add_stop_energy_wh(stop_energy_wh);
+    this->meter_values_sampler->remove_connector(connector);
 
     this->stop_transaction(connector, reason, id_tag_end);
 
@@ -4519,29 +4537,10 @@ void ChargePointImpl::stop_transaction(std::int32_t connector, Reason reason, st
     }
 }
 
-namespace {
-/// \brief Converts the given \p measurands_csv to a vector of Measurands
-/// \param measurands_csv
-/// \return
-std::vector<Measurand> get_measurands_vec(const std::string& measurands_csv) {
-    std::vector<Measurand> measurands;
-    const std::vector<std::string> measurands_strings = ocpp::split_string(measurands_csv, ',');
-
-    for (const auto& measurand_string : measurands_strings) {
-        try {
-            measurands.push_back(conversions::string_to_measurand(measurand_string));
-        } catch (const StringToEnumException& e) {
-            EVLOG_warning << "Could not convert string: " << measurand_string << " to MeasurandEnum";
-        }
-    }
-    return measurands;
-}
-} // namespace
-
 std::vector<TransactionData>
 ChargePointImpl::get_filtered_transaction_data(const std::shared_ptr<Transaction>& transaction) {
-    const auto stop_txn_sampled_data_measurands = get_measurands_vec(this->configuration->getStopTxnSampledData());
-    const auto stop_txn_aligned_data_measurands = get_measurands_vec(this->configuration->getStopTxnAlignedData());
+    const auto stop_txn_sampled_data_measurands = this->configuration->getStopTxnSampledDataMask();
+    const auto stop_txn_aligned_data_measurands = this->configuration->getStopTxnAlignedDataMask();
 
     std::vector<TransactionData> filtered_transaction_data_vec;
 
@@ -4554,16 +4553,14 @@ ChargePointImpl::get_filtered_transaction_data(const std::shared_ptr<Transaction
                 if (meter_value.measurand.has_value()) {
                     // if Sample.Clock use StopTxnAlignedData
                     if (meter_value.context.has_value() and meter_value.context == ReadingContext::Sample_Clock) {
-                        if (std::find(stop_txn_aligned_data_measurands.begin(), stop_txn_aligned_data_measurands.end(),
-                                      meter_value.measurand.value()) != stop_txn_aligned_data_measurands.end()) {
+                        if (stop_txn_aligned_data_measurands.contains(meter_value.measurand.value())) {
                             sampled_values.push_back(meter_value);
                             continue;
                         }
                     } else {
                         // else use StopTxnSampledData although spec is unclear about how to filter other
                         // ReadingContext values like Transaction.Begin , Trigger , etc.
-                        if (std::find(stop_txn_sampled_data_measurands.begin(), stop_txn_sampled_data_measurands.end(),
-                                      meter_value.measurand.value()) != stop_txn_sampled_data_measurands.end()) {
+                        if (stop_txn_sampled_data_measurands.contains(meter_value.measurand.value())) {
                             sampled_values.push_back(meter_value);
                             continue;
                         }
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <algorithm>
+
+#include <ocpp/v16/meter_values_sampler.hpp>
+
+namespace ocpp {
+namespace v16 {
+
+MeterValuesSampler::MeterValuesSampler(boost::asio::io_context* io_context, const SampleCallback& callback) :
+    callback(callback), timer(io_context, [this]() { this->on_timer(); }) {
+}
+
+void MeterValuesSampler::add_connector(std::int32_t connector) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->deadlines[connector] = clock::now() + this->interval;
+    this->arm();
+}
+
+void MeterValuesSampler::remove_connector(std::int32_t connector) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->deadlines.erase(connector);
+    this->arm();
+}
+
+void MeterValuesSampler::set_interval(std::chrono::seconds interval) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->interval = interval;
+    const auto deadline = clock::now() + interval;
+    for (auto& [connector, connector_deadline] : this->deadlines) {
+        connector_deadline = deadline;
+    }
+    this->arm();
+}
+
+void MeterValuesSampler::arm() {
+    if (this->deadlines.empty() or this->interval.count() <= 0) {
+        this->timer.stop();
+        return;
+    }
+
+    const auto next = std::min_element(this->deadlines.begin(), this->deadlines.end(),
+                                       [](const auto& lhs, const auto& rhs) { return lhs.second < rhs.second; });
+    this->timer.timeout(std::max(next->second - clock::now(), clock::duration::zero()));
+}
+
+void MeterValuesSampler::on_timer() {
+    std::vector<std::int32_t> due_connectors;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        if (this->interval.count() <= 0) {
+            return;
+        }
+
+        const auto now = clock::now();
+        const auto batch_end = now + METER_VALUES_SAMPLE_COALESCING_WINDOW;
+        for (auto& [connector, deadline] : this->deadlines) {
+            if (deadline > batch_end) {
+                continue;
+            }
+            due_connectors.push_back(connector);
+            // advance from the deadline and not from now so that batched connectors do not drift apart
+            deadline += this->interval;
+            if (deadline <= now) {
+                deadline = now + this->interval;
+            }
+        }
+        this->arm();
+    }
+
+    if (not due_connectors.empty()) {
+        this->callback(due_connectors);
+    }
+}
+
+} // namespace v16
+} // namespace ocpp
@@ -11,8 +11,7 @@ namespace v16 {
 
 Transaction::Transaction(const std::int32_t internal_transaction_id, const std::int32_t& connector,
                          const std::string& session_id, const CiString<20>& id_token, const double meter_start,
-                         std::optional<std::int32_t> reservation_id, const ocpp::DateTime& timestamp,
-                         std::unique_ptr<Everest::SteadyTimer> meter_values_sample_timer) :
+                         std::optional<std::int32_t> reservation_id, const ocpp::DateTime& timestamp) :
     internal_transaction_id(internal_transaction_id),
     connector(connector),
     session_id(session_id),
@@ -21,8 +20,7 @@ Transaction::Transaction(const std::int32_t internal_transaction_id, const std::
     reservation_id(reservation_id),
     active(true),
     finished(false),
-    has_signed_meter_values(false),
-    meter_values_sample_timer(std::move(meter_values_sample_timer)) {
+    has_signed_meter_values(false) {
 }
 
 std::int32_t Transaction::get_connector() const {
@@ -52,11 +50,6 @@ std::vector<MeterValue> Transaction::get_meter_values() {
     return this->meter_values;
 }
 
-bool Transaction::change_meter_values_sample_interval(std::int32_t interval) {
-    this->meter_values_sample_timer->interval(std::chrono::seconds(interval));
-    return true;
-}
-
 std::optional<std::int32_t> Transaction::get_transaction_id() {
     return this->transaction_id;
 }
@@ -101,9 +94,6 @@ std::vector<TransactionData> Transaction::get_transaction_data() {
 }
 
 void Transaction::stop() {
-    if (this->meter_values_sample_timer != nullptr) {
-        this->meter_values_sample_timer->stop();
-    }
     this->active = false;
 }
 
@@ -250,15 +240,6 @@ void TransactionHandler::add_meter_value(std::int32_t connector, const MeterValu
     this->active_transactions.at(connector)->add_meter_value(meter_value);
 }
 
-void TransactionHandler::change_meter_values_sample_intervals(std::int32_t interval) {
-    const std::lock_guard<std::mutex> lock(this->active_transactions_mutex);
-    for (auto& transaction : this->active_transactions) {
-        if (transaction != nullptr && transaction->is_active()) {
-            transaction->change_meter_values_sample_interval(interval);
-        }
-    }
-}
-
 std::optional<CiString<20>> TransactionHandler::get_authorized_id_tag(const std::string& stop_transaction_message_id) {
     for (const auto& transaction : this->stopped_transactions) {
         if (transaction->get_stop_transaction_message_id() == stop_transaction_message_id) {
@@ -457,11 +457,11 @@ void ChargePoint::initialize(const std::map<std::int32_t, std::int32_t>& evse_co
             return;
         }
 
-        const auto filter_vec = utils::get_measurands_vec(this->device_model->get_value<std::string>(
+        const auto filter_mask = this->meter_values->get_measurands_mask(
             type == ReadingContextEnum::Sample_Clock ? ControllerComponentVariables::AlignedDataMeasurands
-                                                     : ControllerComponentVariables::SampledDataTxUpdatedMeasurands));
+                                                     : ControllerComponentVariables::SampledDataTxUpdatedMeasurands);
 
-        const auto filtered_meter_value = utils::get_meter_value_with_measurands_applied(_meter_value, filter_vec);
+        const auto filtered_meter_value = utils::get_meter_value_with_measurands_applied(_meter_value, filter_mask);
 
         if (!filtered_meter_value.sampledValue.empty()) {
             const auto trigger = type == ReadingContextEnum::Sample_Clock ? TriggerReasonEnum::MeterValueClock
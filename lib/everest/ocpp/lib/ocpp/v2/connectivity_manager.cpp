@@ -368,7 +368,15 @@ ConnectivityManager::get_ws_connection_options(const std::int32_t configuration_
                 .value_or(false),
             this->device_model.get_optional_value<std::string>(ControllerComponentVariables::IFace),
             this->device_model.get_optional_value<bool>(ControllerComponentVariables::EnableTLSKeylog).value_or(false),
-            this->device_model.get_optional_value<std::string>(ControllerComponentVariables::TLSKeylogFile)};
+            this->device_model.get_optional_value<std::string>(ControllerComponentVariables::TLSKeylogFile),
+            this->device_model.get_optional_value<bool>(ControllerComponentVariables::WebsocketPerMessageDeflate)
+                .value_or(false),
+            this->device_model
+                .get_optional_value<int>(ControllerComponentVariables::WebsocketPerMessageDeflateMaxWindowBits)
+                .value_or(15),
+            this->device_model
+                .get_optional_value<bool>(ControllerComponentVariables::WebsocketPerMessageDeflateNoContextTakeover)
+                .value_or(false)};
 
         return connection_options;
 
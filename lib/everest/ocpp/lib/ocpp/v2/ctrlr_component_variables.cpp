@@ -253,6 +253,24 @@ const ComponentVariable TLSKeylogFile = {
         "TLSKeylogFile",
     }),
 };
+const ComponentVariable WebsocketPerMessageDeflate = {
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPerMessageDeflate",
+    }),
+};
+const ComponentVariable WebsocketPerMessageDeflateMaxWindowBits = {
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPerMessageDeflateMaxWindowBits",
+    }),
+};
+const ComponentVariable WebsocketPerMessageDeflateNoContextTakeover = {
+    ControllerComponents::InternalCtrlr,
+    std::optional<Variable>({
+        "WebsocketPerMessageDeflateNoContextTakeover",
+    }),
+};
 const ComponentVariable OcspRequestInterval = {
     ControllerComponents::InternalCtrlr,
     std::optional<Variable>({
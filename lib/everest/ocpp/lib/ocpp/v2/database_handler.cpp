@@ -130,16 +130,29 @@ void DatabaseHandler::authorization_cache_insert_entry(const std::string& id_tok
     }
 }
 
-void DatabaseHandler::authorization_cache_update_last_used(const std::string& id_token_hash) {
+void DatabaseHandler::authorization_cache_update_last_used(
+    const std::map<std::string, DateTime>& last_used_by_id_token_hash) {
+    if (last_used_by_id_token_hash.empty()) {
+        return;
+    }
+
+    auto transaction = this->database->begin_transaction();
+
     const std::string sql = "UPDATE AUTH_CACHE SET LAST_USED = @last_used WHERE ID_TOKEN_HASH = @id_token_hash";
-    auto insert_stmt = this->database->new_statement(sql);
+    auto update_stmt = this->database->new_statement(sql);
 
-    insert_stmt->bind_int64("@last_used", to_unix_milliseconds(DateTime()));
-    insert_stmt->bind_text("@id_token_hash", id_token_hash);
+    for (const auto& [id_token_hash, last_used] : last_used_by_id_token_hash) {
+        update_stmt->bind_int64("@last_used", to_unix_milliseconds(last_used));
+        update_stmt->bind_text("@id_token_hash", id_token_hash);
 
-    if (insert_stmt->step() != SQLITE_DONE) {
-        throw QueryExecutionException(this->database->get_error_message());
+        if (update_stmt->step() != SQLITE_DONE) {
+            throw QueryExecutionException(this->database->get_error_message());
+        }
+
+        (*update_stmt).reset();
     }
+
+    transaction->commit();
 }
 
 std::optional<AuthorizationCacheEntry>
@@ -163,48 +176,57 @@ DatabaseHandler::authorization_cache_get_entry(const std::string& id_token_hash)
     throw QueryExecutionException(this->database->get_error_message());
 }
 
-void DatabaseHandler::authorization_cache_delete_entry(const std::string& id_token_hash) {
-    const std::string sql = "DELETE FROM AUTH_CACHE WHERE ID_TOKEN_HASH = @id_token_hash";
-    auto delete_stmt = this->database->new_statement(sql);
+std::map<std::string, AuthorizationCacheEntry> DatabaseHandler::authorization_cache_get_all_entries() {
+    const std::string sql = "SELECT ID_TOKEN_HASH, ID_TOKEN_INFO, LAST_USED FROM AUTH_CACHE";
+    auto select_stmt = this->database->new_statement(sql);
 
-    delete_stmt->bind_text("@id_token_hash", id_token_hash);
+    std::map<std::string, AuthorizationCacheEntry> entries;
+    int status = SQLITE_ERROR;
+    while ((status = select_stmt->step()) == SQLITE_ROW) {
+        entries.emplace(select_stmt->column_text(0),
+                        AuthorizationCacheEntry{json::parse(select_stmt->column_text(1)),
+                                                from_unix_milliseconds(select_stmt->column_int64(2))});
+    }
 
-    if (delete_stmt->step() != SQLITE_DONE) {
+    if (status != SQLITE_DONE) {
         throw QueryExecutionException(this->database->get_error_message());
     }
+
+    return entries;
 }
 
-void DatabaseHandler::authorization_cache_delete_nr_of_oldest_entries(size_t nr_to_remove) {
-    const std::string sql = "DELETE FROM AUTH_CACHE WHERE ID_TOKEN_HASH IN (SELECT ID_TOKEN_HASH FROM AUTH_CACHE ORDER "
-                            "BY LAST_USED ASC LIMIT @nr_to_remove)";
+void DatabaseHandler::authorization_cache_delete_entry(const std::string& id_token_hash) {
+    const std::string sql = "DELETE FROM AUTH_CACHE WHERE ID_TOKEN_HASH = @id_token_hash";
     auto delete_stmt = this->database->new_statement(sql);
 
-    delete_stmt->bind_int("@nr_to_remove", clamp_to<int>(nr_to_remove));
+    delete_stmt->bind_text("@id_token_hash", id_token_hash);
 
     if (delete_stmt->step() != SQLITE_DONE) {
         throw QueryExecutionException(this->database->get_error_message());
     }
 }
 
-void DatabaseHandler::authorization_cache_delete_expired_entries(
-    std::optional<std::chrono::seconds> auth_cache_lifetime) {
+void DatabaseHandler::authorization_cache_delete_entries(const std::vector<std::string>& id_token_hashes) {
+    if (id_token_hashes.empty()) {
+        return;
+    }
+
+    auto transaction = this->database->begin_transaction();
 
-    const std::string sql = "DELETE FROM AUTH_CACHE WHERE ID_TOKEN_HASH IN (SELECT ID_TOKEN_HASH FROM AUTH_CACHE WHERE "
-                            "EXPIRY_DATE < @before_date OR LAST_USED < @before_last_used)";
+    const std::string sql = "DELETE FROM AUTH_CACHE WHERE ID_TOKEN_HASH = @id_token_hash";
     auto delete_stmt = this->database->new_statement(sql);
 
-    const DateTime now;
-    delete_stmt->bind_int64("@before_date", to_unix_milliseconds(now));
-    if (auth_cache_lifetime.has_value()) {
-        delete_stmt->bind_int64("@before_last_used",
-                                to_unix_milliseconds(DateTime(now.to_time_point() - auth_cache_lifetime.value())));
-    } else {
-        delete_stmt->bind_null("@before_last_used");
-    }
+    for (const auto& id_token_hash : id_token_hashes) {
+        delete_stmt->bind_text("@id_token_hash", id_token_hash);
 
-    if (delete_stmt->step() != SQLITE_DONE) {
-        throw QueryExecutionException(this->database->get_error_message());
+        if (delete_stmt->step() != SQLITE_DONE) {
+            throw QueryExecutionException(this->database->get_error_message());
+        }
+
+        (*delete_stmt).reset();
     }
+
+    transaction->commit();
 }
 
 void DatabaseHandler::authorization_cache_clear() {
@@ -213,17 +235,6 @@ void DatabaseHandler::authorization_cache_clear() {
     }
 }
 
-size_t DatabaseHandler::authorization_cache_get_binary_size() {
-    const std::string sql = "SELECT SUM(\"payload\") FROM \"dbstat\" WHERE name='AUTH_CACHE';";
-    auto stmt = this->database->new_statement(sql);
-
-    if (stmt->step() != SQLITE_ROW) {
-        throw QueryExecutionException(this->database->get_error_message());
-    }
-
-    return stmt->column_int(0);
-}
-
 void DatabaseHandler::insert_availability(std::int32_t evse_id, std::int32_t connector_id,
                                           OperationalStatusEnum operational_status, bool replace) {
     std::string sql;
@@ -308,26 +319,60 @@ void DatabaseHandler::insert_or_update_local_authorization_list_entry(const IdTo
     }
 }
 
-void DatabaseHandler::insert_or_update_local_authorization_list(
-    const std::vector<AuthorizationData>& local_authorization_list) {
-    bool success = true; // indicates if all database operations succeeded
+void DatabaseHandler::write_local_authorization_list_entries(
+    const std::string& table_name, const std::vector<AuthorizationData>& local_authorization_list) {
+    // one statement per operation, prepared once and reset for every entry
+    auto insert_stmt = this->database->new_statement("INSERT OR REPLACE INTO " + table_name +
+                                                     " (ID_TOKEN_HASH, ID_TOKEN_INFO) "
+                                                     "VALUES (@id_token_hash, @id_token_info)");
+    auto delete_stmt =
+        this->database->new_statement("DELETE FROM " + table_name + " WHERE ID_TOKEN_HASH = @id_token_hash;");
+
     for (const auto& authorization_data : local_authorization_list) {
-        try {
-            if (authorization_data.idTokenInfo.has_value()) {
-                this->insert_or_update_local_authorization_list_entry(authorization_data.idToken,
-                                                                      authorization_data.idTokenInfo.value());
-            } else {
-                this->delete_local_authorization_list_entry(authorization_data.idToken);
-            }
-        } catch (const QueryExecutionException& e) {
-            // catch but continue with remaining entries
-            success = false;
+        const auto id_token_hash = utils::generate_token_hash(authorization_data.idToken);
+        auto& stmt = authorization_data.idTokenInfo.has_value() ? insert_stmt : delete_stmt;
+
+        stmt->bind_text("@id_token_hash", id_token_hash, SQLiteString::Transient);
+        if (authorization_data.idTokenInfo.has_value()) {
+            stmt->bind_text("@id_token_info", json(authorization_data.idTokenInfo.value()).dump(),
+                            SQLiteString::Transient);
         }
+
+        if (stmt->step() != SQLITE_DONE) {
+            throw QueryExecutionException(this->database->get_error_message());
+        }
+        (*stmt).reset();
+    }
+}
+
+void DatabaseHandler::insert_or_update_local_authorization_list(
+    const std::vector<AuthorizationData>& local_authorization_list) {
+    auto transaction = this->database->begin_transaction();
+    this->write_local_authorization_list_entries("AUTH_LIST", local_authorization_list);
+    transaction->commit();
+}
+
+void DatabaseHandler::replace_local_authorization_list(const std::vector<AuthorizationData>& local_authorization_list) {
+    auto transaction = this->database->begin_transaction();
+
+    // The new list is staged in a temporary table, AUTH_LIST is only touched by the swap at the end
+    if (!this->database->execute_statement("CREATE TEMP TABLE IF NOT EXISTS AUTH_LIST_STAGING ("
+                                           "ID_TOKEN_HASH TEXT PRIMARY KEY NOT NULL, "
+                                           "ID_TOKEN_INFO TEXT NOT NULL);") or
+        !this->database->execute_statement("DELETE FROM temp.AUTH_LIST_STAGING;")) {
+        throw QueryExecutionException(this->database->get_error_message());
     }
 
-    if (!success) {
-        throw QueryExecutionException("At least one insertion or deletion of local authorization list entries failed");
+    this->write_local_authorization_list_entries("temp.AUTH_LIST_STAGING", local_authorization_list);
+
+    if (!this->database->execute_statement("DELETE FROM AUTH_LIST;") or
+        !this->database->execute_statement("INSERT INTO AUTH_LIST (ID_TOKEN_HASH, ID_TOKEN_INFO) "
+                                           "SELECT ID_TOKEN_HASH, ID_TOKEN_INFO FROM temp.AUTH_LIST_STAGING;") or
+        !this->database->execute_statement("DELETE FROM temp.AUTH_LIST_STAGING;")) {
+        throw QueryExecutionException(this->database->get_error_message());
     }
+
+    transaction->commit();
 }
 
 void DatabaseHandler::delete_local_authorization_list_entry(const IdToken& id_token) {
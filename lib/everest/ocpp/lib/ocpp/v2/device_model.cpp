@@ -417,7 +417,13 @@ std::optional<VariableMetaData> DeviceModel::get_variable_meta_data(const Compon
 
 std::vector<ReportData> DeviceModel::get_base_report_data(const ReportBaseEnum& report_base) {
     std::vector<ReportData> report_data_vec;
+    this->for_each_base_report_data(
+        report_base, [&report_data_vec](const ReportData& report_data) { report_data_vec.push_back(report_data); });
+    return report_data_vec;
+}
 
+void DeviceModel::for_each_base_report_data(const ReportBaseEnum& report_base,
+                                            const std::function<void(const ReportData&)>& handler) {
     for (const auto& [component, variable_map] : this->device_model_map) {
         for (const auto& [variable, variable_meta_data] : variable_map) {
 
@@ -451,11 +457,10 @@ std::vector<ReportData> DeviceModel::get_base_report_data(const ReportBaseEnum&
                 }
             }
             if (!report_data.variableAttribute.empty()) {
-                report_data_vec.push_back(report_data);
+                handler(report_data);
             }
         }
     }
-    return report_data_vec;
 }
 
 std::vector<ReportData>
@@ -25,14 +25,38 @@ namespace {
 ///
 bool has_duplicate_in_list(const std::vector<ocpp::v2::AuthorizationData>& list);
 bool has_no_token_info(const ocpp::v2::AuthorizationData& item);
+
+///
+/// \brief Estimate the number of bytes an authorization cache entry takes in the database.
+/// \param id_token_hash Hash of the id token.
+/// \param id_token_info Cached id token info.
+/// \return Size of the hash and the serialized info plus the two timestamps.
+///
+size_t estimate_auth_cache_entry_size(const std::string& id_token_hash, const ocpp::v2::IdTokenInfo& id_token_info);
+
+///
+/// \brief Check if an authorization cache entry passed its expiry date or the authorization cache lifetime.
+///
+bool is_auth_cache_entry_expired(const ocpp::v2::IdTokenInfo& id_token_info, const ocpp::DateTime& last_used,
+                                 const ocpp::DateTime& now, const std::optional<int>& lifetime);
 } // namespace
 
 ocpp::v2::Authorization::Authorization(const FunctionalBlockContext& context) :
-    context(context), auth_cache_cleanup_handler_running(false) {
+    context(context),
+    auth_cache_cleanup_handler_running(false),
+    auth_cache_loaded(false),
+    auth_cache_binary_size(0) {
 }
 
 ocpp::v2::Authorization::~Authorization() {
     stop_auth_cache_cleanup_thread();
+
+    try {
+        const std::scoped_lock lk(this->auth_cache_mutex);
+        this->auth_cache_write_last_used();
+    } catch (const std::exception& e) {
+        EVLOG_warning << "Could not write last used time of authorization cache entries to database: " << e.what();
+    }
 }
 
 void ocpp::v2::Authorization::start_auth_cache_cleanup_thread() {
@@ -116,7 +140,9 @@ void ocpp::v2::Authorization::update_authorization_cache_size() {
     auto& auth_cache_size = ControllerComponentVariables::AuthCacheStorage;
     if (auth_cache_size.variable.has_value()) {
         try {
-            auto size = this->context.database_handler.authorization_cache_get_binary_size();
+            const std::scoped_lock lk(this->auth_cache_mutex);
+            this->auth_cache_load();
+            const auto size = this->auth_cache_binary_size;
             this->context.device_model.set_read_only_value(auth_cache_size.component, auth_cache_size.variable.value(),
                                                            AttributeEnum::Actual, std::to_string(size),
                                                            VARIABLE_ATTRIBUTE_VALUE_SOURCE_INTERNAL);
@@ -135,16 +161,30 @@ bool ocpp::v2::Authorization::is_auth_cache_ctrlr_enabled() {
 
 void ocpp::v2::Authorization::authorization_cache_insert_entry(const std::string& id_token_hash,
                                                                const IdTokenInfo& id_token_info) {
+    const std::scoped_lock lk(this->auth_cache_mutex);
     this->context.database_handler.authorization_cache_insert_entry(id_token_hash, id_token_info);
+    // Not loaded yet means the entry is picked up from the database when loading
+    if (this->auth_cache_loaded) {
+        this->auth_cache_put(id_token_hash, id_token_info, DateTime());
+    }
+    this->auth_cache_last_used_dirty.erase(id_token_hash);
 }
 
 std::optional<ocpp::v2::AuthorizationCacheEntry>
 ocpp::v2::Authorization::authorization_cache_get_entry(const std::string& id_token_hash) {
-    return this->context.database_handler.authorization_cache_get_entry(id_token_hash);
+    const std::scoped_lock lk(this->auth_cache_mutex);
+    this->auth_cache_load();
+    const auto it = this->auth_cache.find(id_token_hash);
+    if (it == this->auth_cache.end()) {
+        return std::nullopt;
+    }
+    return AuthorizationCacheEntry{it->second.id_token_info, it->second.last_used};
 }
 
 void ocpp::v2::Authorization::authorization_cache_delete_entry(const std::string& id_token_hash) {
+    const std::scoped_lock lk(this->auth_cache_mutex);
     this->context.database_handler.authorization_cache_delete_entry(id_token_hash);
+    this->auth_cache_erase(id_token_hash);
 }
 
 ocpp::v2::AuthorizeResponse
@@ -349,7 +389,10 @@ ocpp::v2::Authorization::validate_token(const IdToken id_token, const std::optio
                     this->update_authorization_cache_size();
                 } else if (id_token_info.status == AuthorizationStatusEnum::Accepted) {
                     EVLOG_info << "Found valid entry in AuthCache";
-                    this->context.database_handler.authorization_cache_update_last_used(hashed_id_token);
+                    {
+                        const std::scoped_lock lk(this->auth_cache_mutex);
+                        this->auth_cache_mark_used(hashed_id_token);
+                    }
                     response.idTokenInfo = id_token_info;
                     return response;
                 } else if (this->context.device_model
@@ -423,7 +466,15 @@ void ocpp::v2::Authorization::handle_clear_cache_req(Call<ClearCacheRequest> cal
 
     if (this->is_auth_cache_ctrlr_enabled()) {
         try {
-            this->context.database_handler.authorization_cache_clear();
+            {
+                const std::scoped_lock lk(this->auth_cache_mutex);
+                this->context.database_handler.authorization_cache_clear();
+                this->auth_cache.clear();
+                this->auth_cache_lru.clear();
+                this->auth_cache_last_used_dirty.clear();
+                this->auth_cache_binary_size = 0;
+                this->auth_cache_loaded = true;
+            }
             this->update_authorization_cache_size();
             response.status = ClearCacheStatusEnum::Accepted;
         } catch (const everest::db::Exception& e) {
@@ -460,26 +511,48 @@ void ocpp::v2::Authorization::cache_cleanup_handler() {
             break;
         }
 
-        auto lifetime =
+        const auto lifetime =
             this->context.device_model.get_optional_value<int>(ControllerComponentVariables::AuthCacheLifeTime);
         try {
-            this->context.database_handler.authorization_cache_delete_expired_entries(
-                lifetime.has_value() ? std::optional<std::chrono::seconds>(*lifetime) : std::nullopt);
-
-            std::optional<VariableMetaData> meta_data;
+            std::optional<size_t> max_storage;
             if (ControllerComponentVariables::AuthCacheStorage.variable.has_value()) {
-                meta_data = this->context.device_model.get_variable_meta_data(
+                const auto meta_data = this->context.device_model.get_variable_meta_data(
                     ControllerComponentVariables::AuthCacheStorage.component,
                     ControllerComponentVariables::AuthCacheStorage.variable.value());
+                if (meta_data.has_value() and meta_data.value().characteristics.maxLimit.has_value()) {
+                    max_storage = convert_to_positive_size_t(meta_data.value().characteristics.maxLimit.value());
+                }
             }
 
-            if (meta_data.has_value()) {
-                auto max_storage = meta_data.value().characteristics.maxLimit;
-                if (max_storage.has_value()) {
-                    while (this->context.database_handler.authorization_cache_get_binary_size() >
-                           convert_to_positive_size_t(max_storage.value())) {
-                        this->context.database_handler.authorization_cache_delete_nr_of_oldest_entries(1);
-                    }
+            const std::scoped_lock lk(this->auth_cache_mutex);
+            this->auth_cache_load();
+            this->auth_cache_write_last_used();
+
+            // Remove expired entries first, then evict the least recently used entries until the cache fits
+            const DateTime now;
+            std::vector<std::string> id_token_hashes_to_delete;
+            size_t remaining_size = this->auth_cache_binary_size;
+            for (const auto& id_token_hash : this->auth_cache_lru) {
+                const auto& item = this->auth_cache.at(id_token_hash);
+                if (is_auth_cache_entry_expired(item.id_token_info, item.last_used, now, lifetime)) {
+                    id_token_hashes_to_delete.push_back(id_token_hash);
+                    remaining_size -= item.binary_size;
+                }
+            }
+            for (auto it = this->auth_cache_lru.begin();
+                 max_storage.has_value() and remaining_size > max_storage.value() and it != this->auth_cache_lru.end();
+                 ++it) {
+                const auto& item = this->auth_cache.at(*it);
+                if (!is_auth_cache_entry_expired(item.id_token_info, item.last_used, now, lifetime)) {
+                    id_token_hashes_to_delete.push_back(*it);
+                    remaining_size -= item.binary_size;
+                }
+            }
+
+            if (!id_token_hashes_to_delete.empty()) {
+                this->context.database_handler.authorization_cache_delete_entries(id_token_hashes_to_delete);
+                for (const auto& id_token_hash : id_token_hashes_to_delete) {
+                    this->auth_cache_erase(id_token_hash);
                 }
             }
         } catch (const everest::db::Exception& e) {
@@ -492,6 +565,70 @@ void ocpp::v2::Authorization::cache_cleanup_handler() {
     }
 }
 
+void ocpp::v2::Authorization::auth_cache_load() {
+    if (this->auth_cache_loaded) {
+        return;
+    }
+
+    auto entries = this->context.database_handler.authorization_cache_get_all_entries();
+    std::vector<std::pair<std::string, AuthorizationCacheEntry>> sorted_entries(
+        std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+    std::sort(sorted_entries.begin(), sorted_entries.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.last_used.to_time_point() < rhs.second.last_used.to_time_point();
+    });
+
+    for (const auto& [id_token_hash, entry] : sorted_entries) {
+        this->auth_cache_put(id_token_hash, entry.id_token_info, entry.last_used);
+    }
+    this->auth_cache_loaded = true;
+}
+
+void ocpp::v2::Authorization::auth_cache_put(const std::string& id_token_hash, const IdTokenInfo& id_token_info,
+                                             const DateTime& last_used) {
+    this->auth_cache_erase(id_token_hash);
+
+    const auto binary_size = estimate_auth_cache_entry_size(id_token_hash, id_token_info);
+    const auto lru_position = this->auth_cache_lru.insert(this->auth_cache_lru.end(), id_token_hash);
+    this->auth_cache.emplace(id_token_hash, AuthCacheItem{id_token_info, last_used, binary_size, lru_position});
+    this->auth_cache_binary_size += binary_size;
+}
+
+void ocpp::v2::Authorization::auth_cache_erase(const std::string& id_token_hash) {
+    const auto it = this->auth_cache.find(id_token_hash);
+    if (it == this->auth_cache.end()) {
+        return;
+    }
+
+    this->auth_cache_binary_size -= it->second.binary_size;
+    this->auth_cache_lru.erase(it->second.lru_position);
+    this->auth_cache.erase(it);
+    this->auth_cache_last_used_dirty.erase(id_token_hash);
+}
+
+void ocpp::v2::Authorization::auth_cache_mark_used(const std::string& id_token_hash) {
+    const auto it = this->auth_cache.find(id_token_hash);
+    if (it == this->auth_cache.end()) {
+        return;
+    }
+
+    it->second.last_used = DateTime();
+    this->auth_cache_lru.splice(this->auth_cache_lru.end(), this->auth_cache_lru, it->second.lru_position);
+    this->auth_cache_last_used_dirty.insert(id_token_hash);
+}
+
+void ocpp::v2::Authorization::auth_cache_write_last_used() {
+    if (this->auth_cache_last_used_dirty.empty()) {
+        return;
+    }
+
+    std::map<std::string, DateTime> last_used_by_id_token_hash;
+    for (const auto& id_token_hash : this->auth_cache_last_used_dirty) {
+        last_used_by_id_token_hash.emplace(id_token_hash, this->auth_cache.at(id_token_hash).last_used);
+    }
+    this->context.database_handler.authorization_cache_update_last_used(last_used_by_id_token_hash);
+    this->auth_cache_last_used_dirty.clear();
+}
+
 void ocpp::v2::Authorization::handle_send_local_authorization_list_req(Call<SendLocalListRequest> call) {
     SendLocalListResponse response;
 
@@ -573,13 +710,11 @@ ocpp::v2::Authorization::apply_local_authorization_list(const SendLocalListReque
             if (!has_duplicate_in_list(list) and
                 std::find_if(list.begin(), list.end(), has_no_token_info) == list.end()) {
                 try {
-                    this->context.database_handler.clear_local_authorization_list();
-                    this->context.database_handler.insert_or_update_local_authorization_list(list);
+                    this->context.database_handler.replace_local_authorization_list(list);
                     status = SendLocalListStatusEnum::Accepted;
                 } catch (const everest::db::Exception& e) {
                     status = SendLocalListStatusEnum::Failed;
-                    EVLOG_warning << "Full update of local authorization list failed (at least partially): "
-                                  << e.what();
+                    EVLOG_warning << "Full update of local authorization list failed: " << e.what();
                 }
             }
         }
@@ -621,4 +756,18 @@ bool has_duplicate_in_list(const std::vector<ocpp::v2::AuthorizationData>& list)
 bool has_no_token_info(const ocpp::v2::AuthorizationData& item) {
     return !item.idTokenInfo.has_value();
 };
+
+size_t estimate_auth_cache_entry_size(const std::string& id_token_hash, const ocpp::v2::IdTokenInfo& id_token_info) {
+    return id_token_hash.size() + json(id_token_info).dump().size() + 2 * sizeof(std::int64_t);
+}
+
+bool is_auth_cache_entry_expired(const ocpp::v2::IdTokenInfo& id_token_info, const ocpp::DateTime& last_used,
+                                 const ocpp::DateTime& now, const std::optional<int>& lifetime) {
+    const bool lifetime_expired =
+        lifetime.has_value() and
+        ((last_used.to_time_point() + std::chrono::seconds(lifetime.value())) < now.to_time_point());
+    const bool cache_expiry_passed =
+        id_token_info.cacheExpiryDateTime.has_value() and (id_token_info.cacheExpiryDateTime.value() < now);
+    return lifetime_expired or cache_expiry_passed;
+}
 } // namespace
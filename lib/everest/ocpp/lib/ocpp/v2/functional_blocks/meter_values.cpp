@@ -4,6 +4,7 @@
 #include <ocpp/v2/functional_blocks/meter_values.hpp>
 
 #include <ocpp/common/constants.hpp>
+#include <ocpp/v2/comparators.hpp>
 #include <ocpp/v2/ctrlr_component_variables.hpp>
 #include <ocpp/v2/device_model.hpp>
 #include <ocpp/v2/evse_manager.hpp>
@@ -11,6 +12,8 @@
 #include <ocpp/v2/message_dispatcher.hpp>
 #include <ocpp/v2/messages/MeterValues.hpp>
 
+#include <algorithm>
+
 ocpp::v2::MeterValues::MeterValues(const FunctionalBlockContext& functional_block_context) :
     context(functional_block_context) {
 }
@@ -99,14 +102,48 @@ void ocpp::v2::MeterValues::on_meter_value(const std::int32_t evse_id, const Met
 ocpp::v2::MeterValue
 ocpp::v2::MeterValues::get_latest_meter_value_filtered(const MeterValue& meter_value, ReadingContextEnum context,
                                                        const RequiredComponentVariable& component_variable) {
-    auto filtered_meter_value = utils::get_meter_value_with_measurands_applied(
-        meter_value, utils::get_measurands_vec(this->context.device_model.get_value<std::string>(component_variable)));
+    auto filtered_meter_value =
+        utils::get_meter_value_with_measurands_applied(meter_value, this->get_measurands_mask(component_variable));
     for (auto& sampled_value : filtered_meter_value.sampledValue) {
         sampled_value.context = context;
     }
     return filtered_meter_value;
 }
 
+ocpp::v2::utils::MeasurandEnumMask
+ocpp::v2::MeterValues::get_measurands_mask(const RequiredComponentVariable& component_variable) {
+    const ComponentVariable& key = component_variable;
+    {
+        const std::lock_guard<std::mutex> lock(this->measurands_masks_mutex);
+        for (const auto& [cached_component_variable, mask] : this->measurands_masks) {
+            if (cached_component_variable == key) {
+                return mask;
+            }
+        }
+    }
+
+    // compile outside of the lock, reading the device model might take a while
+    const auto mask =
+        utils::get_measurands_mask(this->context.device_model.get_value<std::string>(component_variable));
+
+    const std::lock_guard<std::mutex> lock(this->measurands_masks_mutex);
+    const auto it = std::find_if(this->measurands_masks.begin(), this->measurands_masks.end(),
+                                 [&key](const auto& entry) { return entry.first == key; });
+    if (it == this->measurands_masks.end()) {
+        this->measurands_masks.emplace_back(key, mask);
+    }
+    return mask;
+}
+
+void ocpp::v2::MeterValues::invalidate_measurands_mask(const ComponentVariable& component_variable) {
+    const std::lock_guard<std::mutex> lock(this->measurands_masks_mutex);
+    this->measurands_masks.erase(std::remove_if(this->measurands_masks.begin(), this->measurands_masks.end(),
+                                                [&component_variable](const auto& entry) {
+                                                    return entry.first == component_variable;
+                                                }),
+                                 this->measurands_masks.end());
+}
+
 void ocpp::v2::MeterValues::meter_values_req(const std::int32_t evse_id, const std::vector<MeterValue>& meter_values,
                                              const bool initiated_by_trigger_message) {
     MeterValuesRequest req;
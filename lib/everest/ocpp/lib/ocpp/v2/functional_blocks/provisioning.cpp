@@ -147,26 +147,24 @@ Provisioning::set_variables(const std::vector<SetVariableData>& set_variable_dat
 }
 
 void Provisioning::notify_report_req(const int request_id, const std::vector<ReportData>& report_data) {
-    NotifyReportRequest req;
-    req.requestId = request_id;
-    req.seqNo = 0;
-    req.generatedAt = ocpp::DateTime();
-    req.reportData.emplace(report_data);
-    req.tbc = false;
-
-    if (report_data.size() <= 1) {
-        const ocpp::Call<NotifyReportRequest> call(req);
-        this->context.message_dispatcher.dispatch_call(call);
-    } else {
-        NotifyReportRequestsSplitter splitter{
-            req,
-            this->context.device_model.get_optional_value<size_t>(ControllerComponentVariables::MaxMessageSize)
-                .value_or(DEFAULT_MAX_MESSAGE_SIZE),
-            []() { return ocpp::create_message_id(); }};
-        for (const auto& msg : splitter.create_call_payloads()) {
-            this->message_queue.push_call(msg);
+    this->notify_report_req(request_id, [&report_data](const std::function<void(const ReportData&)>& add) {
+        for (const auto& entry : report_data) {
+            add(entry);
         }
-    }
+    });
+}
+
+void Provisioning::notify_report_req(
+    const int request_id,
+    const std::function<void(const std::function<void(const ReportData&)>&)>& generate_report_data) {
+    NotifyReportStreamer streamer{
+        request_id, ocpp::DateTime(),
+        this->context.device_model.get_optional_value<size_t>(ControllerComponentVariables::MaxMessageSize)
+            .value_or(DEFAULT_MAX_MESSAGE_SIZE),
+        []() { return ocpp::create_message_id(); },
+        [this](json&& call) { this->context.message_dispatcher.dispatch_call(call); }};
+    generate_report_data([&streamer](const ReportData& report_data) { streamer.add(report_data); });
+    streamer.finish();
 }
 
 void Provisioning::handle_boot_notification_response(CallResult<BootNotificationResponse> call_result) {
@@ -284,8 +282,10 @@ void Provisioning::handle_get_base_report_req(Call<GetBaseReportRequest> call) {
     this->context.message_dispatcher.dispatch_call_result(call_result);
 
     if (response.status == GenericDeviceModelStatusEnum::Accepted) {
-        const auto report_data = this->context.device_model.get_base_report_data(msg.reportBase);
-        this->notify_report_req(msg.requestId, report_data);
+        // the base report can contain the whole device model, so its pages are sent while it is being generated
+        this->notify_report_req(msg.requestId, [this, &msg](const std::function<void(const ReportData&)>& add) {
+            this->context.device_model.for_each_base_report_data(msg.reportBase, add);
+        });
     }
 }
 
@@ -565,6 +565,8 @@ void Provisioning::handle_variable_changed(const SetVariableData& set_variable_d
     if (component_variable == ControllerComponentVariables::AlignedDataInterval) {
         this->meter_values.update_aligned_data_interval();
     }
+    // a changed measurands variable has to be compiled again on its next use
+    this->meter_values.invalidate_measurands_mask(component_variable);
 
     if (component_variable_change_requires_websocket_option_update_without_reconnect(component_variable)) {
         EVLOG_debug << "Reconfigure websocket due to relevant change of ControllerComponentVariable";
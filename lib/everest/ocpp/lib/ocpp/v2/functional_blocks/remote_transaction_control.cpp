@@ -257,15 +257,15 @@ void RemoteTransactionControl::handle_trigger_message(Call<TriggerMessageRequest
 
     case MessageTriggerEnum::MeterValues:
         if (msg.evse.has_value()) {
-            if (evse_ptr != nullptr and utils::meter_value_has_any_measurand(
-                                            evse_ptr->get_meter_value(),
-                                            utils::get_measurands_vec(this->context.device_model.get_value<std::string>(
-                                                ControllerComponentVariables::AlignedDataMeasurands)))) {
+            if (evse_ptr != nullptr and
+                utils::meter_value_has_any_measurand(
+                    evse_ptr->get_meter_value(),
+                    this->meter_values.get_measurands_mask(ControllerComponentVariables::AlignedDataMeasurands))) {
                 response.status = TriggerMessageStatusEnum::Accepted;
             }
         } else {
-            const auto measurands = utils::get_measurands_vec(
-                this->context.device_model.get_value<std::string>(ControllerComponentVariables::AlignedDataMeasurands));
+            const auto measurands =
+                this->meter_values.get_measurands_mask(ControllerComponentVariables::AlignedDataMeasurands);
             for (auto& evse : this->context.evse_manager) {
                 if (utils::meter_value_has_any_measurand(evse.get_meter_value(), measurands)) {
                     response.status = TriggerMessageStatusEnum::Accepted;
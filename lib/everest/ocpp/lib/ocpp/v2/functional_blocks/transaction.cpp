@@ -64,7 +64,7 @@ void TransactionBlock::on_transaction_started(const std::int32_t evse_id, const
                                  reservation_id, charging_state);
 
     const auto meter_value = utils::get_meter_value_with_measurands_applied(
-        meter_start, utils::get_measurands_vec(this->context.device_model.get_value<std::string>(
+        meter_start, utils::get_measurands_mask(this->context.device_model.get_value<std::string>(
                          ControllerComponentVariables::SampledDataTxStartedMeasurands)));
 
     const auto& enhanced_transaction = evse_handle.get_transaction();
@@ -108,9 +108,9 @@ void TransactionBlock::on_transaction_finished(const std::int32_t evse_id, const
     try {
         meter_values = std::make_optional(utils::get_meter_values_with_measurands_applied(
             this->context.database_handler.transaction_metervalues_get_all(enhanced_transaction->transactionId.get()),
-            utils::get_measurands_vec(this->context.device_model.get_value<std::string>(
+            utils::get_measurands_mask(this->context.device_model.get_value<std::string>(
                 ControllerComponentVariables::SampledDataTxEndedMeasurands)),
-            utils::get_measurands_vec(this->context.device_model.get_value<std::string>(
+            utils::get_measurands_mask(this->context.device_model.get_value<std::string>(
                 ControllerComponentVariables::AlignedDataTxEndedMeasurands)),
             timestamp,
             this->context.device_model.get_optional_value<bool>(ControllerComponentVariables::SampledDataSignReadings)
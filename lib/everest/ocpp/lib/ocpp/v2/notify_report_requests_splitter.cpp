@@ -7,106 +7,145 @@
 namespace ocpp {
 namespace v2 {
 
-const std::string NotifyReportRequestsSplitter::MESSAGE_TYPE =
-    conversions::messagetype_to_string(MessageType::NotifyReport);
+namespace {
+size_t number_of_digits(int value) {
+    return std::to_string(value).size();
+}
+} // namespace
 
-std::vector<json> NotifyReportRequestsSplitter::create_call_payloads() {
+const std::string NotifyReportStreamer::MESSAGE_TYPE = conversions::messagetype_to_string(MessageType::NotifyReport);
 
-    // In case there is no report data, fallback to no-splitting call creation
-    if (!original_request.reportData.has_value()) {
-        return std::vector<json>{
-            {MessageTypeId::CALL, message_id_generator_callback().get(), MESSAGE_TYPE, json(original_request)}};
+NotifyReportStreamer::SizeCounter::int_type NotifyReportStreamer::SizeCounter::overflow(int_type ch) {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        this->size++;
     }
+    return traits_type::not_eof(ch);
+}
 
-    // Loop along reportData and create payloads
-    std::vector<json> payloads{};
-    int seq_no = 0;
+std::streamsize NotifyReportStreamer::SizeCounter::xsputn(const char* /*s*/, std::streamsize count) {
+    this->size += static_cast<size_t>(count);
+    return count;
+}
 
-    auto report_data_iterator = original_request.reportData->begin();
-    while (seq_no == 0 || report_data_iterator != original_request.reportData->end()) {
-        payloads.emplace_back(create_next_payload(seq_no, report_data_iterator, original_request.reportData->end(),
-                                                  message_id_generator_callback().get()));
-        seq_no++;
-    }
+NotifyReportStreamer::NotifyReportStreamer(std::int32_t request_id, const ocpp::DateTime& generated_at,
+                                           size_t max_size, std::function<MessageId()>&& message_id_generator_callback,
+                                           std::function<void(json&&)>&& payload_callback) :
+    max_size(max_size),
+    message_id_generator_callback{std::move(message_id_generator_callback)},
+    payload_callback{std::move(payload_callback)},
+    size_stream(&this->size_counter),
+    page_report_data(json::array()),
+    page_report_data_size(0),
+    page_remaining_size(0),
+    seq_no(0) {
 
-    if (seq_no > 1) {
-        EVLOG_info << "Split NotifyReportRequest '" << original_request.requestId << "' into " << seq_no
-                   << " messages.";
-    }
+    NotifyReportRequest req{};
+    req.requestId = request_id;
+    req.generatedAt = generated_at;
+    req.tbc = false;
+    this->request_json_template = req;
 
-    return payloads;
+    // Skeleton json sizeof( [MessageTypeId::CALL, "", "NotifyReport", {<json of request without
+    // reportData>,"reportData":}] )
+    this->json_skeleton_size = this->serialized_size(json{MessageTypeId::CALL, "", MESSAGE_TYPE,
+                                                          this->request_json_template}) +
+                               std::string{R"(,"reportData":)"}.size();
 }
 
-json NotifyReportRequestsSplitter::create_next_report_data_json(
-    std::vector<ocpp::v2::ReportData>::const_iterator& report_data_iterator,
-    const std::vector<ocpp::v2::ReportData>::const_iterator& report_data_end, const size_t& remaining_size) {
+void NotifyReportStreamer::add(const ReportData& report_data) {
+    json report_data_json = report_data;
+    const auto size = this->serialized_size(report_data_json);
 
-    if (report_data_iterator == report_data_end) {
-        return json::array();
+    if (this->message_id.empty()) {
+        this->start_page();
+    } else if (this->page_report_data_size + size + 1 > this->page_remaining_size) {
+        // new report data object would increase payload size by its dump + 1 (caused by the separating comma)
+        this->emit_page(true);
+        this->start_page();
     }
 
-    json report_data_json{*report_data_iterator};
-    report_data_iterator++;
-    if (report_data_iterator == report_data_end) {
-        return report_data_json;
-    }
+    // the first report data of a page is always added, even if it exceeds the remaining size on its own
+    this->page_report_data_size += this->page_report_data.empty() ? size + 2 : size + 1;
+    this->page_report_data.emplace_back(std::move(report_data_json));
+}
 
-    auto size = report_data_json.dump().size();
-
-    for (; report_data_iterator != report_data_end; report_data_iterator++) {
-        json current_json = *report_data_iterator;
-        // new report data object will increase payload size by its dump + 1 (caused by the separating comma)
-        auto additional_json_size = current_json.dump().size() + 1;
-        if (size + additional_json_size <= remaining_size) {
-            size += additional_json_size;
-            report_data_json.emplace_back(std::move(current_json));
-        } else {
-            break;
-        }
+void NotifyReportStreamer::finish() {
+    if (this->message_id.empty()) {
+        this->start_page();
     }
+    this->emit_page(false);
 
-    return report_data_json;
+    if (this->seq_no > 1) {
+        EVLOG_info << "Split NotifyReportRequest '" << this->request_json_template.at("requestId") << "' into "
+                   << this->seq_no << " messages.";
+    }
 }
 
-json NotifyReportRequestsSplitter::create_next_payload(
-    const int& seq_no, std::vector<ocpp::v2::ReportData>::const_iterator& report_data_iterator,
-    const std::vector<ocpp::v2::ReportData>::const_iterator& report_data_end, const std::string& message_id) {
+int NotifyReportStreamer::get_number_of_payloads() const {
+    return this->seq_no;
+}
 
-    json call_base{MessageTypeId::CALL, message_id, MESSAGE_TYPE};
+size_t NotifyReportStreamer::serialized_size(const json& value) {
+    this->size_counter.size = 0;
+    this->size_stream << value;
+    return this->size_counter.size;
+}
 
-    const size_t base_json_string_length = this->json_skeleton_size + message_id.size();
-    const size_t remaining_size =
+void NotifyReportStreamer::start_page() {
+    this->message_id = this->message_id_generator_callback().get();
+    // the skeleton contains a single digit seqNo
+    const size_t base_json_string_length =
+        this->json_skeleton_size + this->message_id.size() + number_of_digits(this->seq_no) - 1;
+    this->page_remaining_size =
         this->max_size >= base_json_string_length ? this->max_size - base_json_string_length : 0;
+    this->page_report_data = json::array();
+    this->page_report_data_size = 0;
+}
 
-    auto request_json = request_json_template;
-    request_json["reportData"] = create_next_report_data_json(report_data_iterator, report_data_end, remaining_size);
-    request_json["tbc"] = report_data_iterator != report_data_end;
-    request_json["seqNo"] = seq_no;
+void NotifyReportStreamer::emit_page(bool tbc) {
+    auto request_json = this->request_json_template;
+    if (!this->page_report_data.empty()) {
+        request_json["reportData"] = std::move(this->page_report_data);
+    }
+    request_json["tbc"] = tbc;
+    request_json["seqNo"] = this->seq_no;
 
-    call_base.emplace_back(request_json);
+    this->payload_callback(json{MessageTypeId::CALL, this->message_id, MESSAGE_TYPE, std::move(request_json)});
 
-    return call_base;
+    this->message_id.clear();
+    this->page_report_data = json::array();
+    this->page_report_data_size = 0;
+    this->seq_no++;
 }
+
+const std::string NotifyReportRequestsSplitter::MESSAGE_TYPE =
+    conversions::messagetype_to_string(MessageType::NotifyReport);
+
 NotifyReportRequestsSplitter::NotifyReportRequestsSplitter(const NotifyReportRequest& originalRequest, size_t max_size,
                                                            std::function<MessageId()>&& message_id_generator_callback) :
     original_request(originalRequest),
     max_size(max_size),
-    message_id_generator_callback{std::move(message_id_generator_callback)},
-    json_skeleton_size(create_request_template_json_and_return_skeleton_size()) {
+    message_id_generator_callback{std::move(message_id_generator_callback)} {
 }
 
-size_t NotifyReportRequestsSplitter::create_request_template_json_and_return_skeleton_size() {
+std::vector<json> NotifyReportRequestsSplitter::create_call_payloads() {
 
-    NotifyReportRequest req{};
-    req.requestId = original_request.requestId;
-    req.generatedAt = original_request.generatedAt;
-    req.tbc = false;
-    this->request_json_template = req;
+    // In case there is no report data, fallback to no-splitting call creation
+    if (!original_request.reportData.has_value()) {
+        return std::vector<json>{
+            {MessageTypeId::CALL, message_id_generator_callback().get(), MESSAGE_TYPE, json(original_request)}};
+    }
 
-    // Skeleton json sizeof( [MessageTypeId::CALL, "", "NotifyReport", {<json of request without
-    // reportData>,"reportData":}] )
-    return json{MessageTypeId::CALL, "", MESSAGE_TYPE, request_json_template}.dump().size() +
-           std::string{R"(,"reportData":)"}.size();
+    std::vector<json> payloads{};
+    NotifyReportStreamer streamer{original_request.requestId, original_request.generatedAt, this->max_size,
+                                  std::function<MessageId()>{this->message_id_generator_callback},
+                                  [&payloads](json&& payload) { payloads.emplace_back(std::move(payload)); }};
+    for (const auto& report_data : original_request.reportData.value()) {
+        streamer.add(report_data);
+    }
+    streamer.finish();
+
+    return payloads;
 }
 
 } // namespace v2
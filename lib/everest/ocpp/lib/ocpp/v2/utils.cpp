@@ -28,29 +28,61 @@ std::vector<MeasurandEnum> get_measurands_vec(const std::string& measurands_csv)
     return measurands;
 }
 
+static_assert(static_cast<int>(MeasurandEnum::Voltage_Maximum) < 64, "MeasurandEnum does not fit into a mask");
+
+MeasurandEnumMask get_measurands_mask(const std::string& measurands_csv) {
+    MeasurandEnumMask mask;
+    for (const auto& measurand_string : ocpp::split_string(measurands_csv, ',')) {
+        try {
+            mask.set(conversions::string_to_measurand_enum(measurand_string));
+        } catch (const StringToEnumException& e) {
+            EVLOG_warning << "Could not convert string: " << measurand_string << " to MeasurandEnum";
+        }
+    }
+    return mask;
+}
+
+MeasurandEnumMask get_measurands_mask(const std::vector<MeasurandEnum>& measurands) {
+    MeasurandEnumMask mask;
+    for (const auto measurand : measurands) {
+        mask.set(measurand);
+    }
+    return mask;
+}
+
 bool meter_value_has_any_measurand(const MeterValue& _meter_value, const std::vector<MeasurandEnum>& measurands) {
-    auto compare = [](const SampledValue& a, MeasurandEnum b) { return a.measurand == b; };
+    return meter_value_has_any_measurand(_meter_value, get_measurands_mask(measurands));
+}
 
-    return std::find_first_of(_meter_value.sampledValue.begin(), _meter_value.sampledValue.end(), measurands.begin(),
-                              measurands.end(), compare) != _meter_value.sampledValue.end();
+bool meter_value_has_any_measurand(const MeterValue& _meter_value, const MeasurandEnumMask& measurands) {
+    return std::any_of(_meter_value.sampledValue.begin(), _meter_value.sampledValue.end(),
+                       [&measurands](const SampledValue& sampled_value) {
+                           return sampled_value.measurand.has_value() and
+                                  measurands.contains(sampled_value.measurand.value());
+                       });
 }
 
 MeterValue get_meter_value_with_measurands_applied(const MeterValue& _meter_value,
                                                    const std::vector<MeasurandEnum>& measurands, bool include_signed) {
-    auto meter_value = _meter_value;
-    for (auto it = meter_value.sampledValue.begin(); it != meter_value.sampledValue.end();) {
-        auto measurand = it->measurand;
-        if (measurand.has_value()) {
-            if (std::find(measurands.begin(), measurands.end(), measurand.value()) == measurands.end()) {
-                it = meter_value.sampledValue.erase(it);
-            } else {
-                if (not include_signed) {
-                    it->signedMeterValue.reset();
-                }
-                ++it;
+    return get_meter_value_with_measurands_applied(_meter_value, get_measurands_mask(measurands), include_signed);
+}
+
+MeterValue get_meter_value_with_measurands_applied(const MeterValue& _meter_value, const MeasurandEnumMask& measurands,
+                                                   bool include_signed) {
+    // only copy the sampled values that pass the filter instead of copying all and erasing afterwards
+    MeterValue meter_value;
+    meter_value.timestamp = _meter_value.timestamp;
+    meter_value.customData = _meter_value.customData;
+    if (measurands.empty()) {
+        return meter_value;
+    }
+    meter_value.sampledValue.reserve(_meter_value.sampledValue.size());
+    for (const auto& sampled_value : _meter_value.sampledValue) {
+        if (sampled_value.measurand.has_value() and measurands.contains(sampled_value.measurand.value())) {
+            auto& added = meter_value.sampledValue.emplace_back(sampled_value);
+            if (not include_signed) {
+                added.signedMeterValue.reset();
             }
-        } else {
-            it = meter_value.sampledValue.erase(it);
         }
     }
 
@@ -61,6 +93,15 @@ std::vector<MeterValue> get_meter_values_with_measurands_applied(
     const std::vector<MeterValue>& meter_values, const std::vector<MeasurandEnum>& sampled_tx_ended_measurands,
     const std::vector<MeasurandEnum>& aligned_tx_ended_measurands, ocpp::DateTime max_timestamp,
     bool include_sampled_signed, bool include_aligned_signed) {
+    return get_meter_values_with_measurands_applied(meter_values, get_measurands_mask(sampled_tx_ended_measurands),
+                                                    get_measurands_mask(aligned_tx_ended_measurands), max_timestamp,
+                                                    include_sampled_signed, include_aligned_signed);
+}
+
+std::vector<MeterValue> get_meter_values_with_measurands_applied(
+    const std::vector<MeterValue>& meter_values, const MeasurandEnumMask& sampled_tx_ended_measurands,
+    const MeasurandEnumMask& aligned_tx_ended_measurands, ocpp::DateTime max_timestamp, bool include_sampled_signed,
+    bool include_aligned_signed) {
     std::vector<MeterValue> meter_values_result;
 
     for (const auto& meter_value : meter_values) {
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include <ocpp/common/ocpp_logging.hpp>
+
+namespace ocpp {
+namespace {
+
+namespace fs = std::filesystem;
+
+std::string read_file(const fs::path& path) {
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+std::size_t count_occurrences(const std::string& haystack, const std::string& needle) {
+    std::size_t count = 0;
+    for (auto pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+class OcppLoggingTest : public ::testing::Test {
+protected:
+    fs::path log_dir;
+
+    void SetUp() override {
+        log_dir = fs::temp_directory_path() /
+                  ("ocpp_logging_test_" + std::to_string(getpid()) + "_" +
+                   ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(log_dir);
+        fs::create_directories(log_dir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(log_dir);
+    }
+
+    std::unique_ptr<MessageLogging> create_logging(bool log_to_file, bool log_to_html, bool log_security) {
+        return std::make_unique<MessageLogging>(true, log_dir.string(), "test", false, false, log_to_file,
+                                                log_to_html, false, log_security, false, nullptr);
+    }
+};
+
+TEST_F(OcppLoggingTest, AllMessagesWrittenOnDestruction) {
+    constexpr int message_count = 200;
+    auto logging = create_logging(true, true, false);
+    for (int i = 0; i < message_count; i++) {
+        logging->charge_point("Heartbeat", R"([2,")" + std::to_string(i) + R"(","Heartbeat",{}])");
+    }
+    logging.reset();
+
+    const auto log = read_file(log_dir / "test.log");
+    EXPECT_EQ(count_occurrences(log, "ChargePoint>CentralSystem Heartbeat"), message_count);
+
+    const auto html = read_file(log_dir / "test.html");
+    EXPECT_EQ(count_occurrences(html, "<tr class=\"ChargePoint\">"), message_count);
+    // closing tags are written after all queued entries
+    EXPECT_EQ(html.rfind("</table></body></html>\n"), html.size() - std::string("</table></body></html>\n").size());
+}
+
+TEST_F(OcppLoggingTest, StatisticsCountQueuedEntries) {
+    auto logging = create_logging(true, false, false);
+    logging->central_system("BootNotification", R"([3,"1",{"status":"Accepted"}])");
+    const auto statistics = logging->get_statistics();
+    // "Session logging started." and the message
+    EXPECT_EQ(statistics.queued, 2);
+    EXPECT_EQ(statistics.dropped, 0);
+}
+
+TEST_F(OcppLoggingTest, SecurityLogRotatedBySize) {
+    std::size_t rotations_with_deletion = 0;
+    auto logging = std::make_unique<MessageLogging>(
+        true, log_dir.string(), "test", false, false, false, false, false, true, false, nullptr,
+        LogRotationConfig(false, 100, 3), [&rotations_with_deletion](LogRotationStatus status) {
+            if (status == LogRotationStatus::RotatedWithDeletion) {
+                rotations_with_deletion++;
+            }
+        });
+    for (int i = 0; i < 20; i++) {
+        logging->security("security event number " + std::to_string(i) + " with some padding to fill the log");
+    }
+    logging.reset();
+
+    std::size_t file_count = 0;
+    for (const auto& entry : fs::directory_iterator(log_dir)) {
+        if (entry.path().filename().string().find("test.security.log") == 0) {
+            file_count++;
+            EXPECT_LE(fs::file_size(entry.path()), 200);
+        }
+    }
+    EXPECT_EQ(file_count, 3);
+    EXPECT_GT(rotations_with_deletion, 0);
+    EXPECT_NE(read_file(log_dir / "test.security.log").find("security event number 19"), std::string::npos);
+}
+
+} // namespace
+} // namespace ocpp
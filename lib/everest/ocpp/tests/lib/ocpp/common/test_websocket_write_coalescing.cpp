@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocpp/common/websocket/websocket_base.hpp>
+#include <ocpp/common/websocket/websocket_write_coalescing.hpp>
+
+using namespace ocpp;
+
+namespace {
+
+struct TestMessage {
+    std::string payload;
+};
+
+using TestMessagePtr = std::shared_ptr<TestMessage>;
+
+std::vector<TestMessagePtr> make_messages(std::size_t count, std::size_t payload_size) {
+    std::vector<TestMessagePtr> messages;
+    for (std::size_t i = 0; i < count; i++) {
+        messages.push_back(std::make_shared<TestMessage>(TestMessage{std::string(payload_size, 'x')}));
+    }
+    return messages;
+}
+
+class TestWebsocket : public WebsocketBase {
+public:
+    bool start_connecting() override {
+        return true;
+    }
+    void set_connection_options(const WebsocketConnectionOptions& connection_options) override {
+        set_connection_options_base(connection_options);
+    }
+    void reconnect(long /*delay*/) override {
+    }
+    void close(const WebsocketCloseReason /*code*/, const std::string& /*reason*/) override {
+    }
+    bool send(const std::string& /*message*/) override {
+        return true;
+    }
+
+    using WebsocketBase::on_message_written;
+    using WebsocketBase::on_write_cycle;
+
+protected:
+    void ping() override {
+    }
+};
+
+} // namespace
+
+TEST(PermessageDeflateOfferTest, DefaultWindowBits) {
+    WebsocketConnectionOptions options{};
+    options.permessage_deflate_max_window_bits = 15;
+    EXPECT_EQ(permessage_deflate_offer(options), "permessage-deflate; client_max_window_bits");
+}
+
+TEST(PermessageDeflateOfferTest, ReducedWindowBits) {
+    WebsocketConnectionOptions options{};
+    options.permessage_deflate_max_window_bits = 10;
+    EXPECT_EQ(permessage_deflate_offer(options),
+              "permessage-deflate; client_max_window_bits=10; server_max_window_bits=10");
+}
+
+TEST(PermessageDeflateOfferTest, NoContextTakeover) {
+    WebsocketConnectionOptions options{};
+    options.permessage_deflate_max_window_bits = 15;
+    options.permessage_deflate_no_context_takeover = true;
+    EXPECT_EQ(permessage_deflate_offer(options),
+              "permessage-deflate; client_max_window_bits; client_no_context_takeover; server_no_context_takeover");
+
+    options.permessage_deflate_max_window_bits = 9;
+    EXPECT_EQ(permessage_deflate_offer(options), "permessage-deflate; client_max_window_bits=9; "
+                                                 "server_max_window_bits=9; client_no_context_takeover; "
+                                                 "server_no_context_takeover");
+}
+
+TEST(WebsocketWriteCoalescingTest, WritesAtMostMaxCoalescedMessages) {
+    const auto messages = make_messages(MAX_COALESCED_MESSAGES + 4, 10);
+    std::size_t write_calls = 0;
+
+    const auto written = write_coalesced(
+        messages,
+        [&](const TestMessagePtr&) {
+            write_calls++;
+            return true;
+        },
+        [] { return false; });
+
+    EXPECT_EQ(written, MAX_COALESCED_MESSAGES);
+    EXPECT_EQ(write_calls, MAX_COALESCED_MESSAGES);
+}
+
+TEST(WebsocketWriteCoalescingTest, WritesAllPendingSmallMessages) {
+    const auto messages = make_messages(3, MAX_COALESCED_MESSAGE_SIZE);
+
+    const auto written = write_coalesced(
+        messages, [](const TestMessagePtr&) { return true; }, [] { return false; });
+
+    EXPECT_EQ(written, 3);
+}
+
+TEST(WebsocketWriteCoalescingTest, StopsAfterLargeMessage) {
+    auto messages = make_messages(4, 10);
+    messages.at(1)->payload = std::string(MAX_COALESCED_MESSAGE_SIZE + 1, 'x');
+    std::vector<TestMessagePtr> written_messages;
+
+    const auto written = write_coalesced(
+        messages,
+        [&](const TestMessagePtr& message) {
+            written_messages.push_back(message);
+            return true;
+        },
+        [] { return false; });
+
+    EXPECT_EQ(written, 2);
+    ASSERT_EQ(written_messages.size(), 2);
+    EXPECT_EQ(written_messages.at(0), messages.at(0));
+    EXPECT_EQ(written_messages.at(1), messages.at(1));
+}
+
+TEST(WebsocketWriteCoalescingTest, LargeFirstMessageIsWrittenAlone) {
+    const auto messages = make_messages(2, MAX_COALESCED_MESSAGE_SIZE * 4);
+
+    const auto written = write_coalesced(
+        messages, [](const TestMessagePtr&) { return true; }, [] { return false; });
+
+    EXPECT_EQ(written, 1);
+}
+
+TEST(WebsocketWriteCoalescingTest, StopsWhenChoked) {
+    const auto messages = make_messages(8, 10);
+    std::size_t choked_calls = 0;
+
+    const auto written = write_coalesced(
+        messages, [](const TestMessagePtr&) { return true; }, [&] { return ++choked_calls == 3; });
+
+    EXPECT_EQ(written, 3);
+    EXPECT_EQ(choked_calls, 3);
+}
+
+TEST(WebsocketWriteCoalescingTest, StopsOnWriteFailure) {
+    const auto messages = make_messages(8, 10);
+    std::size_t write_calls = 0;
+
+    const auto written = write_coalesced(
+        messages, [&](const TestMessagePtr&) { return ++write_calls < 3; }, [] { return false; });
+
+    EXPECT_EQ(written, 2);
+    EXPECT_EQ(write_calls, 3);
+}
+
+TEST(WebsocketWriteCoalescingTest, NothingPending) {
+    const std::vector<TestMessagePtr> messages;
+
+    const auto written = write_coalesced(
+        messages, [](const TestMessagePtr&) { return true; }, [] { return false; });
+
+    EXPECT_EQ(written, 0);
+}
+
+TEST(WebsocketTrafficCountersTest, InitiallyZero) {
+    TestWebsocket websocket;
+    const auto counters = websocket.get_traffic_counters();
+
+    EXPECT_EQ(counters.messages_sent, 0);
+    EXPECT_EQ(counters.payload_bytes, 0);
+    EXPECT_EQ(counters.wire_payload_bytes, 0);
+    EXPECT_EQ(counters.write_cycles, 0);
+}
+
+TEST(WebsocketTrafficCountersTest, UncompressedMessages) {
+    TestWebsocket websocket;
+    websocket.on_write_cycle();
+    websocket.on_message_written(100, std::nullopt);
+    websocket.on_message_written(50, std::nullopt);
+
+    const auto counters = websocket.get_traffic_counters();
+    EXPECT_EQ(counters.messages_sent, 2);
+    EXPECT_EQ(counters.payload_bytes, 150);
+    EXPECT_EQ(counters.wire_payload_bytes, 150);
+    EXPECT_EQ(counters.write_cycles, 1);
+}
+
+TEST(WebsocketTrafficCountersTest, CompressedMessages) {
+    TestWebsocket websocket;
+    websocket.on_write_cycle();
+    websocket.on_message_written(1000, 120);
+    websocket.on_write_cycle();
+    websocket.on_message_written(200, std::nullopt);
+    websocket.on_message_written(300, 0);
+
+    const auto counters = websocket.get_traffic_counters();
+    EXPECT_EQ(counters.messages_sent, 3);
+    EXPECT_EQ(counters.payload_bytes, 1500);
+    EXPECT_EQ(counters.wire_payload_bytes, 320);
+    EXPECT_EQ(counters.write_cycles, 2);
+}
@@ -300,7 +300,7 @@ TEST_F(ProfileTestsB, validate_profileA) {
     ocpp::DateTime timestamp(now);
     add_connectors(5);
     connectors[connector_id]->transaction =
-        std::make_shared<Transaction>(-1, connector_id, "1234", "4567", meter_start, std::nullopt, timestamp, nullptr);
+        std::make_shared<Transaction>(-1, connector_id, "1234", "4567", meter_start, std::nullopt, timestamp);
     // map doesn't include connector 0, database does
     SmartChargingHandler handler(connectors, database_handler, *configuration);
     auto tmp_profile = profileA;
@@ -329,7 +329,7 @@ TEST_F(ProfileTestsB, validate_profileB) {
     ocpp::DateTime timestamp(now + seconds(5));
     add_connectors(5);
     connectors[connector_id]->transaction =
-        std::make_shared<Transaction>(-1, connector_id, "1234", "4567", meter_start, std::nullopt, timestamp, nullptr);
+        std::make_shared<Transaction>(-1, connector_id, "1234", "4567", meter_start, std::nullopt, timestamp);
     // map doesn't include connector 0, database does
     SmartChargingHandler handler(connectors, database_handler, *configuration);
     auto tmp_profile = profileB;
@@ -373,7 +373,7 @@ TEST_F(ProfileTestsB, single_profile) {
     add_connectors(1);
 
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", meter_start, std::nullopt, timestamp, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", meter_start, std::nullopt, timestamp);
     // map doesn't include connector 0, database does
     SmartChargingHandler handler(connectors, database_handler, *configuration);
 
@@ -417,7 +417,7 @@ TEST_F(ProfileTestsB, startup_no_charge) {
 
     // now with a transaction
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", meter_start, std::nullopt, timestamp, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", meter_start, std::nullopt, timestamp);
     valid_profiles = handler.get_valid_profiles(start_time, profileNoCharge_end_time, 1);
     ASSERT_EQ(valid_profiles.size(), 1);
     EXPECT_EQ(profileNoCharge.chargingSchedule, valid_profiles[0].chargingSchedule);
@@ -453,7 +453,7 @@ TEST_F(ProfileTestsB, get_valid_profiles_absolute) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     SmartChargingHandler handler(connectors, database_handler, *configuration);
 
@@ -477,7 +477,7 @@ TEST_F(ProfileTestsB, get_valid_profiles_absolute_delay) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto absoluteB = profileStackB;
     absoluteB.validFrom = ocpp::DateTime(now + minutes(5));
@@ -505,7 +505,7 @@ TEST_F(ProfileTestsB, get_valid_profiles_relative) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto relativeA = profileStackA;
     auto relativeB = profileStackB;
@@ -536,7 +536,7 @@ TEST_F(ProfileTestsB, get_valid_profiles_relative_delay) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto relativeA = profileStackA;
     auto relativeB = profileStackB;
@@ -572,7 +572,7 @@ TEST_F(ProfileTestsB, single_absolute) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto absoluteA = profileStackA;
 
@@ -606,7 +606,7 @@ TEST_F(ProfileTestsB, stack_absolute) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     SmartChargingHandler handler(connectors, database_handler, *configuration);
 
@@ -646,7 +646,7 @@ TEST_F(ProfileTestsB, stack_absolute_delay) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto absoluteA = profileStackA;
     absoluteA.validTo = ocpp::DateTime(now + minutes(5));
@@ -700,7 +700,7 @@ TEST_F(ProfileTestsB, stack_absolute_delay_overlap) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto absoluteB = profileStackB;
     absoluteB.validFrom = ocpp::DateTime(now + minutes(5));
@@ -750,7 +750,7 @@ TEST_F(ProfileTestsB, stack_relative) {
     ocpp::DateTime start_time(now);
     ocpp::DateTime end_time(now + minutes(10));
     connectors[1]->transaction =
-        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time, nullptr);
+        std::make_shared<Transaction>(-1, connector, "1234", "4567", 100, std::nullopt, start_time);
 
     auto relativeA = profileStackA;
     auto relativeB = profileStackB;
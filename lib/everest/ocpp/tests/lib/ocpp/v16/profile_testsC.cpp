@@ -57,7 +57,7 @@ protected:
         std::int32_t meter_start = 0;
         std::int32_t connector_id = 1;
         connectors[connector_id]->transaction = std::make_shared<Transaction>(
-            -1, connector_id, "1234", "4567", meter_start, std::nullopt, transaction_start, nullptr);
+            -1, connector_id, "1234", "4567", meter_start, std::nullopt, transaction_start);
     }
 
     void configure() {
@@ -45,4 +45,30 @@ TEST_F(ConfigurationTester, BrokenChain) {
     EXPECT_TRUE(set_result.has_value());
 }
 
+TEST_F(ConfigurationTester, SettersUpdateTypedValues) {
+    EXPECT_EQ(config->set("HeartbeatInterval", "352"), ConfigurationStatus::Accepted);
+    EXPECT_EQ(config->getHeartbeatInterval(), 352);
+
+    EXPECT_EQ(config->set("StopTxnSampledData", "Energy.Active.Import.Register"), ConfigurationStatus::Accepted);
+    const auto stop_txn_sampled = config->getStopTxnSampledDataMask();
+    EXPECT_TRUE(stop_txn_sampled.contains(Measurand::Energy_Active_Import_Register));
+    EXPECT_FALSE(stop_txn_sampled.contains(Measurand::Power_Active_Import));
+
+    EXPECT_EQ(config->set("MeterValuesSampledData", "Energy.Active.Import.Register"), ConfigurationStatus::Accepted);
+    const auto sampled = config->getMeterValuesSampledDataVector();
+    ASSERT_FALSE(sampled.empty());
+    EXPECT_EQ(sampled.front().measurand, Measurand::Energy_Active_Import_Register);
+}
+
+TEST_F(ConfigurationTester, UserConfigIsWrittenOnFlush) {
+    EXPECT_EQ(config->set("HeartbeatInterval", "353"), ConfigurationStatus::Accepted);
+    EXPECT_EQ(config->set("MeterValueSampleInterval", "17"), ConfigurationStatus::Accepted);
+    config->flushUserConfig();
+
+    std::ifstream ifs(USER_CONFIG_FILE_LOCATION_V16);
+    const auto user_config = json::parse(ifs);
+    EXPECT_EQ(user_config["Core"]["HeartbeatInterval"], 353);
+    EXPECT_EQ(user_config["Core"]["MeterValueSampleInterval"], 17);
+}
+
 } // namespace
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <gtest/gtest.h>
+
+#include <ocpp/v16/meter_values_sampler.hpp>
+
+namespace ocpp {
+namespace v16 {
+
+class MeterValuesSamplerTest : public ::testing::Test {
+protected:
+    boost::asio::io_context io_context;
+    std::vector<std::vector<std::int32_t>> batches;
+    MeterValuesSampler sampler{&io_context,
+                               [this](const std::vector<std::int32_t>& connectors) { batches.push_back(connectors); }};
+};
+
+TEST_F(MeterValuesSamplerTest, coinciding_connectors_are_sampled_together) {
+    sampler.set_interval(std::chrono::seconds(1));
+    sampler.add_connector(1);
+    sampler.add_connector(2);
+
+    io_context.run_for(std::chrono::milliseconds(1500));
+
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches.at(0), (std::vector<std::int32_t>{1, 2}));
+}
+
+TEST_F(MeterValuesSamplerTest, removed_connector_is_not_sampled) {
+    sampler.set_interval(std::chrono::seconds(1));
+    sampler.add_connector(1);
+    sampler.add_connector(2);
+    sampler.remove_connector(1);
+
+    io_context.run_for(std::chrono::milliseconds(1500));
+
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_EQ(batches.at(0), (std::vector<std::int32_t>{2}));
+}
+
+TEST_F(MeterValuesSamplerTest, zero_interval_disables_sampling) {
+    sampler.set_interval(std::chrono::seconds(1));
+    sampler.add_connector(1);
+    sampler.set_interval(std::chrono::seconds(0));
+
+    io_context.run_for(std::chrono::milliseconds(1500));
+
+    EXPECT_TRUE(batches.empty());
+}
+
+} // namespace v16
+} // namespace ocpp
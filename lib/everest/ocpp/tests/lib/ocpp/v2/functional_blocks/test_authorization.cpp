@@ -9,6 +9,7 @@
 #include <ocpp/v2/ctrlr_component_variables.hpp>
 #include <ocpp/v2/device_model.hpp>
 #include <ocpp/v2/functional_blocks/functional_block_context.hpp>
+#include <ocpp/v2/utils.hpp>
 
 #include "component_state_manager_mock.hpp"
 #include "connectivity_manager_mock.hpp"
@@ -48,9 +49,11 @@ protected: // Members
 
     std::unique_ptr<Authorization> authorization;
 
-    std::atomic<std::uint32_t> delete_expired_entries_count = 0;
-    std::atomic<std::uint32_t> get_binary_size_count = 0;
-    std::atomic<std::uint32_t> delete_nr_of_oldest_entries_count = 0;
+    std::atomic<std::uint32_t> get_all_entries_count = 0;
+    std::atomic<std::uint32_t> update_last_used_count = 0;
+    std::atomic<std::uint32_t> delete_entries_count = 0;
+    std::map<std::string, ocpp::DateTime> written_last_used;
+    std::vector<std::string> deleted_id_token_hashes;
     std::mutex call_mutex;
     std::condition_variable call_condition_variable;
 
@@ -74,34 +77,46 @@ protected: // Functions
     ~AuthorizationTest() {
     }
 
-    auto update_count_and_notify(std::atomic<std::uint32_t>& variable) {
-        return testing::Invoke([this, &variable]() {
+    auto get_all_entries_and_notify(const std::map<std::string, AuthorizationCacheEntry>& entries) {
+        return testing::Invoke([this, entries]() {
             std::unique_lock<std::mutex> lock(this->call_mutex);
-            variable++;
+            this->get_all_entries_count++;
             this->call_condition_variable.notify_all();
+            return entries;
         });
     }
 
-    auto update_count_and_notify(const size_t return_value, std::atomic<std::uint32_t>& variable) {
-        return testing::Invoke([this, &variable, return_value]() -> size_t {
+    auto update_last_used_and_notify() {
+        return testing::Invoke([this](const std::map<std::string, ocpp::DateTime>& last_used_by_id_token_hash) {
             std::unique_lock<std::mutex> lock(this->call_mutex);
-            variable++;
+            this->update_last_used_count++;
+            this->written_last_used = last_used_by_id_token_hash;
             this->call_condition_variable.notify_all();
-            return return_value;
         });
     }
 
-    void wait_for_calls(const std::uint32_t expected_delete_expired_entries_count,
-                        const std::uint32_t expected_binary_size_count,
-                        const std::uint32_t expected_delete_nr_of_oldest_entries_count) {
+    auto delete_entries_and_notify(const bool throw_on_first_call = false) {
+        return testing::Invoke([this, throw_on_first_call](const std::vector<std::string>& id_token_hashes) {
+            std::unique_lock<std::mutex> lock(this->call_mutex);
+            this->delete_entries_count++;
+            this->deleted_id_token_hashes = id_token_hashes;
+            this->call_condition_variable.notify_all();
+            if (throw_on_first_call and this->delete_entries_count == 1) {
+                throw everest::db::Exception("Oops!");
+            }
+        });
+    }
+
+    void wait_for_calls(const std::uint32_t expected_get_all_entries_count,
+                        const std::uint32_t expected_update_last_used_count,
+                        const std::uint32_t expected_delete_entries_count) {
         std::unique_lock<std::mutex> lock(this->call_mutex);
         EXPECT_TRUE(call_condition_variable.wait_for(
             lock, std::chrono::seconds(3),
-            [this, expected_delete_expired_entries_count, expected_binary_size_count,
-             expected_delete_nr_of_oldest_entries_count] {
-                return this->delete_expired_entries_count >= expected_delete_expired_entries_count &&
-                       this->get_binary_size_count >= expected_binary_size_count &&
-                       this->delete_nr_of_oldest_entries_count >= expected_delete_nr_of_oldest_entries_count;
+            [this, expected_get_all_entries_count, expected_update_last_used_count, expected_delete_entries_count] {
+                return this->get_all_entries_count >= expected_get_all_entries_count &&
+                       this->update_last_used_count >= expected_update_last_used_count &&
+                       this->delete_entries_count >= expected_delete_entries_count;
             }));
     }
 
@@ -296,6 +311,25 @@ protected: // Functions
         return authorization_cache_entry;
     }
 
+    ///
+    /// \brief Create the content of the authorization cache table, containing only the given entry.
+    /// \param id_token    The id token of the entry.
+    /// \param entry       The authorization cache entry.
+    /// \return The authorization cache entries by id token hash.
+    ///
+    std::map<std::string, AuthorizationCacheEntry> create_authorization_cache(const IdToken& id_token,
+                                                                              const AuthorizationCacheEntry& entry) {
+        return {{ocpp::v2::utils::generate_token_hash(id_token), entry}};
+    }
+
+    ///
+    /// \brief Estimated size of an authorization cache entry, the hash, the serialized info and two timestamps.
+    ///
+    static size_t get_authorization_cache_entry_size(const std::string& id_token_hash,
+                                                     const IdTokenInfo& id_token_info) {
+        return id_token_hash.size() + json(id_token_info).dump().size() + 2 * sizeof(std::int64_t);
+    }
+
     ///
     /// \brief Create local auth list with two or three items.
     /// \param include_duplicate    If true, three items are in the list with one duplicate id token. Otherwise there
@@ -416,16 +450,39 @@ TEST_F(AuthorizationTest, update_authorization_cache_size) {
     ASSERT_TRUE(size.has_value());
     EXPECT_EQ(size.value(), 42);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size()).WillRepeatedly(Return(35));
+    // The size is estimated from the entries loaded from the database.
+    const auto first_id_token = get_id_token("FIRST_TOKEN");
+    const auto second_id_token = get_id_token("SECOND_TOKEN");
+    const auto first_entry =
+        create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, false, false, 0);
+    const auto second_entry =
+        create_authorization_cache_entry(AuthorizationStatusEnum::Blocked, false, false, false, 0);
+    auto entries = create_authorization_cache(first_id_token, first_entry);
+    entries.merge(create_authorization_cache(second_id_token, second_entry));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries()).WillOnce(Return(entries));
     this->authorization->update_authorization_cache_size();
 
     size = device_model->get_optional_value<int>(auth_cache_size, AttributeEnum::Actual);
     ASSERT_TRUE(size.has_value());
-    EXPECT_EQ(size.value(), 35);
+    const auto expected_size = get_authorization_cache_entry_size(ocpp::v2::utils::generate_token_hash(first_id_token),
+                                                                  first_entry.id_token_info) +
+                               get_authorization_cache_entry_size(ocpp::v2::utils::generate_token_hash(second_id_token),
+                                                                  second_entry.id_token_info);
+    EXPECT_EQ(size.value(), expected_size);
+
+    // Deleting an entry subtracts its size without reading the database again.
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entry(_));
+    this->authorization->authorization_cache_delete_entry(ocpp::v2::utils::generate_token_hash(first_id_token));
+    this->authorization->update_authorization_cache_size();
+
+    size = device_model->get_optional_value<int>(auth_cache_size, AttributeEnum::Actual);
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(size.value(), get_authorization_cache_entry_size(ocpp::v2::utils::generate_token_hash(second_id_token),
+                                                               second_entry.id_token_info));
 }
 
 TEST_F(AuthorizationTest, update_authorization_cache_size_exception) {
-    // Test update authorization cache size. When requesting the size from the database handler, it throws a
+    // Test update authorization cache size. When loading the cache from the database handler, it throws a
     // Exception.
     auto& auth_cache_size = ControllerComponentVariables::AuthCacheStorage;
     this->device_model->set_read_only_value(auth_cache_size.component, auth_cache_size.variable.value(),
@@ -434,8 +491,8 @@ TEST_F(AuthorizationTest, update_authorization_cache_size_exception) {
     ASSERT_TRUE(size.has_value());
     EXPECT_EQ(size.value(), 42);
 
-    // Throw Exception when requesting the binary size of the authorization cache. Application should not crash!
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
+    // Throw Exception when loading the authorization cache. Application should not crash!
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
         .WillRepeatedly(Throw(everest::db::Exception("Database exception thrown!!")));
 
     this->authorization->update_authorization_cache_size();
@@ -447,7 +504,7 @@ TEST_F(AuthorizationTest, update_authorization_cache_size_exception) {
 }
 
 TEST_F(AuthorizationTest, update_authorization_cache_size_exception2) {
-    // Test update authorization cache size. When requesting the size from the database handler, it throws (something
+    // Test update authorization cache size. When loading the cache from the database handler, it throws (something
     // else than Exception).
     auto& auth_cache_size = ControllerComponentVariables::AuthCacheStorage;
     this->device_model->set_read_only_value(auth_cache_size.component, auth_cache_size.variable.value(),
@@ -456,8 +513,8 @@ TEST_F(AuthorizationTest, update_authorization_cache_size_exception2) {
     ASSERT_TRUE(size.has_value());
     EXPECT_EQ(size.value(), 42);
 
-    // Throw other exception when requesting the binary size of the authorization cache. Application should not crash!
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
+    // Throw other exception when loading the authorization cache. Application should not crash!
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
         .WillRepeatedly(Throw(std::out_of_range("out of range exception thrown!!")));
 
     this->authorization->update_authorization_cache_size();
@@ -877,13 +934,13 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_accepted) {
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, false, false, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
-
     IdToken id_token;
     id_token.type = IdTokenEnumStringType::ISO14443;
     id_token.idToken = "test_token";
 
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
+
     EXPECT_EQ(authorization->validate_token(id_token, std::nullopt, std::nullopt).idTokenInfo.status,
               AuthorizationStatusEnum::Accepted);
 }
@@ -927,13 +984,13 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_blocked_post_authorize_disab
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::Blocked, true, false, false, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
-
     IdToken id_token;
     id_token.type = IdTokenEnumStringType::ISO14443;
     id_token.idToken = "test_token";
 
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
+
     EXPECT_EQ(authorization->validate_token(id_token, std::nullopt, std::nullopt).idTokenInfo.status,
               AuthorizationStatusEnum::Blocked);
 }
@@ -957,8 +1014,12 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_invalid_post_authorize_enabl
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::NotAtThisLocation, true, false, false, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
+    IdToken id_token;
+    id_token.type = IdTokenEnumStringType::ISO14443;
+    id_token.idToken = "test_token";
+
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
 
     // Because the authorization status was not 'Accepted', an authorize request is performed.
     EXPECT_CALL(mock_dispatcher, dispatch_call_async(_, _)).WillOnce(Return(std::async(std::launch::deferred, [this]() {
@@ -969,10 +1030,6 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_invalid_post_authorize_enabl
     // Since the auth cache is enabled, after authorizing, the entry is added to the authorization cache.
     EXPECT_CALL(this->database_handler_mock, authorization_cache_insert_entry(_, _));
 
-    IdToken id_token;
-    id_token.type = IdTokenEnumStringType::ISO14443;
-    id_token.idToken = "test_token";
-
     EXPECT_EQ(authorization->validate_token(id_token, std::nullopt, std::nullopt).idTokenInfo.status,
               AuthorizationStatusEnum::Invalid);
 }
@@ -991,18 +1048,17 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_cache_expired_and_status_inv
     // The websocket is connected.
     EXPECT_CALL(this->connectivity_manager, is_websocket_connected()).WillRepeatedly(Return(true));
 
-    // Since the cache is expired, it will delete the entry from the cache and update the cache size.
+    // Since the cache is expired, it will delete the entry from the cache.
     EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entry(_)).Times(1);
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size());
 
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::Invalid, true, true, false, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
-
     IdToken id_token = get_id_token("test_token", IdTokenEnumStringType::ISO14443);
 
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
+
     // Because the cache is expired, an authorize request is performed.
     EXPECT_CALL(mock_dispatcher, dispatch_call_async(_, _)).WillOnce(Return(std::async(std::launch::deferred, [this]() {
         return create_example_authorize_response(AuthorizeCertificateStatusEnum::Accepted,
@@ -1028,18 +1084,17 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_lifetime_expired) {
     // The websocket is connected.
     EXPECT_CALL(this->connectivity_manager, is_websocket_connected()).WillRepeatedly(Return(true));
 
-    // Since the lifetime is expired, it will delete the entry from the cache and update the cache size.
+    // Since the lifetime is expired, it will delete the entry from the cache.
     EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entry(_)).Times(1);
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size());
 
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, false, true, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
-
     IdToken id_token = get_id_token("test_token", IdTokenEnumStringType::ISO14443);
 
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
+
     // Because the cache is expired, an authorize request is performed.
     EXPECT_CALL(mock_dispatcher, dispatch_call_async(_, _)).WillOnce(Return(std::async(std::launch::deferred, [this]() {
         return create_example_authorize_response(AuthorizeCertificateStatusEnum::Accepted,
@@ -1063,7 +1118,7 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_exception) {
     // The websocket is connected.
     EXPECT_CALL(this->connectivity_manager, is_websocket_connected()).WillRepeatedly(Return(true));
     // Throw exception when trying to get the cache entry.
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
         .WillRepeatedly(Throw(everest::db::Exception("Test exception for the database!")));
 
     // Because of the database exception, an authorize request is performed
@@ -1094,7 +1149,7 @@ TEST_F(AuthorizationTest,
     // The websocket is connected.
     EXPECT_CALL(this->connectivity_manager, is_websocket_connected()).WillRepeatedly(Return(false));
     // Throw exception when trying to get the cache entry.
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
         .WillRepeatedly(Throw(std::out_of_range("Test exception!")));
 
     // Because of the database exception, and the websocket disabled, and offline tx for unknown id enabled, it will
@@ -1116,18 +1171,17 @@ TEST_F(AuthorizationTest, validate_token_auth_cache_insert_entry_exception) {
     // The websocket is connected.
     EXPECT_CALL(this->connectivity_manager, is_websocket_connected()).WillRepeatedly(Return(true));
 
-    // The lifetime is expired, it will delete the entry from the cache and update the cache size.
+    // The lifetime is expired, it will delete the entry from the cache.
     EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entry(_)).Times(1);
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size());
 
     AuthorizationCacheEntry authorization_cache_entry =
         create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, false, true, 5000);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_entry(_))
-        .WillOnce(Return(authorization_cache_entry));
-
     IdToken id_token = get_id_token("test_token", IdTokenEnumStringType::ISO14443);
 
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(Return(create_authorization_cache(id_token, authorization_cache_entry)));
+
     // Because the cache is expired, an authorize request is performed.
     EXPECT_CALL(mock_dispatcher, dispatch_call_async(_, _)).WillOnce(Return(std::async(std::launch::deferred, [this]() {
         return create_example_authorize_response(AuthorizeCertificateStatusEnum::Accepted,
@@ -1156,7 +1210,6 @@ TEST_F(AuthorizationTest, handle_message_clear_cache) {
 
     // Expect that the authorization cache is cleared and the cache size is updated.
     EXPECT_CALL(this->database_handler_mock, authorization_cache_clear());
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size()).WillRepeatedly(Return(45));
 
     // Clear cache is accepted, and the result is sent.
     EXPECT_CALL(mock_dispatcher, dispatch_call_result(_)).WillOnce(Invoke([](const json& call_result) {
@@ -1170,7 +1223,7 @@ TEST_F(AuthorizationTest, handle_message_clear_cache) {
     auto& auth_cache_size = ControllerComponentVariables::AuthCacheStorage;
     std::optional<int> size = device_model->get_optional_value<int>(auth_cache_size, AttributeEnum::Actual);
     ASSERT_TRUE(size.has_value());
-    EXPECT_EQ(size.value(), 45);
+    EXPECT_EQ(size.value(), 0);
 }
 
 TEST_F(AuthorizationTest, handle_message_clear_cache_auth_cache_ctrlr_disabled) {
@@ -1208,10 +1261,9 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list) {
     const auto request = create_send_local_list_request(
         33, UpdateEnum::Full, this->create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list is inserted, therefor the list is first cleared and then the new list is inserted. The
-    // list version is also updated.
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list);
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_));
+    // Local authorization list is inserted, therefor the list replaces the current list. The list version is also
+    // updated.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_));
     EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list_version(33));
 
     // The number of entries is requested from the database after storing the new list, and stored in the device model.
@@ -1239,10 +1291,9 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_get_entries_excep
     const auto request = create_send_local_list_request(
         33, UpdateEnum::Full, this->create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list is inserted, therefor the list is first cleared and then the new list is inserted. The
-    // list version is also updated.
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list);
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_));
+    // Local authorization list is inserted, therefor the list replaces the current list. The list version is also
+    // updated.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_));
     EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list_version(33));
 
     // The number of entries is requested from the database after storing the new list, and stored in the device model.
@@ -1272,10 +1323,9 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_get_entries_excep
     const auto request = create_send_local_list_request(
         33, UpdateEnum::Full, this->create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list is inserted, therefor the list is first cleared and then the new list is inserted. The
-    // list version is also updated.
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list);
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_));
+    // Local authorization list is inserted, therefor the list replaces the current list. The list version is also
+    // updated.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_));
     EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list_version(33));
 
     // The number of entries is requested from the database after storing the new list, and stored in the device model.
@@ -1305,10 +1355,9 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_get_entries_excep
     const auto request = create_send_local_list_request(
         33, UpdateEnum::Full, this->create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list is inserted, therefor the list is first cleared and then the new list is inserted. The
-    // list version is also updated.
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list);
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_));
+    // Local authorization list is inserted, therefor the list replaces the current list. The list version is also
+    // updated.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_));
     EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list_version(33));
 
     // The number of entries is requested from the database after storing the new list, and stored in the device model.
@@ -1332,9 +1381,8 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_set_version_excep
     const auto request = create_send_local_list_request(
         33, UpdateEnum::Full, this->create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list is inserted, therefor the list is first cleared and then the new list is inserted.
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list);
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_));
+    // Local authorization list is inserted, therefor the list replaces the current list.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_));
 
     // When trying to update the authorization list version, an exception is thrown.
     EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list_version(33))
@@ -1474,7 +1522,7 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_duplicate) {
         create_send_local_list_request(1, UpdateEnum::Full, create_example_authorization_data_local_list(true, true));
 
     // There are duplicates in the list, so the request has failed. Nothing is inserted.
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_)).Times(0);
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_)).Times(0);
 
     // The authorization list should now be cleared and is accepted.
     EXPECT_CALL(mock_dispatcher, dispatch_call_result(_)).WillOnce(Invoke([](const json& call_result) {
@@ -1493,7 +1541,7 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_no_token_info) {
         create_send_local_list_request(1, UpdateEnum::Full, create_example_authorization_data_local_list(false, false));
 
     // There is at least one token without id token info, so the request has failed. Nothing is inserted.
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_)).Times(0);
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_)).Times(0);
 
     // The authorization list should now be cleared and is accepted.
     EXPECT_CALL(mock_dispatcher, dispatch_call_result(_)).WillOnce(Invoke([](const json& call_result) {
@@ -1511,9 +1559,8 @@ TEST_F(AuthorizationTest, handle_send_local_authorization_list_clear_list_except
     const auto request =
         create_send_local_list_request(1, UpdateEnum::Full, create_example_authorization_data_local_list(false, true));
 
-    // Local authorization list must be inserted, but clearing it throws an exception.
-    EXPECT_CALL(this->database_handler_mock, insert_or_update_local_authorization_list(_)).Times(0);
-    EXPECT_CALL(this->database_handler_mock, clear_local_authorization_list)
+    // Local authorization list must be inserted, but replacing it throws an exception.
+    EXPECT_CALL(this->database_handler_mock, replace_local_authorization_list(_))
         .WillRepeatedly(Throw(everest::db::Exception("exception :(")));
 
     // The authorization list should now be cleared and is accepted.
@@ -1755,23 +1802,50 @@ TEST_F(AuthorizationTest, handle_get_local_authorization_list_version_exception)
 }
 
 TEST_F(AuthorizationTest, cache_cleanup_handler) {
-    // Test cache cleanup handler happy flow.
+    // Test cache cleanup handler happy flow, the expired entry is removed.
+    const auto valid_id_token = get_id_token("VALID_TOKEN");
+    const auto expired_id_token = get_id_token("EXPIRED_TOKEN");
+    auto entries = create_authorization_cache(
+        valid_id_token, create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, false, false, 0));
+    entries.merge(create_authorization_cache(
+        expired_id_token, create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, true, true, false, 0)));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(get_all_entries_and_notify(entries));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entries(_))
+        .WillOnce(delete_entries_and_notify());
+
     this->authorization->start_auth_cache_cleanup_thread();
-    this->delete_expired_entries_count = 0;
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_expired_entries(_))
-        .WillRepeatedly(update_count_and_notify(this->delete_expired_entries_count));
     this->authorization->trigger_authorization_cache_cleanup();
-    this->wait_for_calls(1, 0, 0);
+    this->wait_for_calls(1, 0, 1);
+
+    const std::unique_lock<std::mutex> lock(this->call_mutex);
+    EXPECT_EQ(this->deleted_id_token_hashes,
+              std::vector<std::string>{ocpp::v2::utils::generate_token_hash(expired_id_token)});
 }
 
 TEST_F(AuthorizationTest, cache_cleanup_handler_exceeds_max_storage) {
-    // Test cleanup handler where the authorization cache exceeds the max storage for a few times. It will then
-    // cleanup, the binary size count will be increased by the test (otherwise it will spin forever).
-    auto component_variable = ControllerComponentVariables::AuthCacheStorage;
+    // Test cleanup handler where the authorization cache exceeds the max storage. The least recently used entries are
+    // evicted until the cache fits, an entry used by an authorization counts as recently used.
+    const auto oldest_id_token = get_id_token("TOKEN_1");
+    const auto middle_id_token = get_id_token("TOKEN_2");
+    const auto newest_id_token = get_id_token("TOKEN_3");
+    std::map<std::string, AuthorizationCacheEntry> entries;
+    size_t entry_size = 0;
+    int age_seconds = 300;
+    for (const auto& id_token : {oldest_id_token, middle_id_token, newest_id_token}) {
+        auto entry = create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, false, false, false, 0);
+        entry.last_used = ocpp::DateTime(date::utc_clock::now() - std::chrono::seconds(age_seconds));
+        age_seconds -= 100;
+        entry_size = get_authorization_cache_entry_size(ocpp::v2::utils::generate_token_hash(id_token),
+                                                        entry.id_token_info);
+        entries.merge(create_authorization_cache(id_token, entry));
+    }
 
+    // Only two of the three entries fit.
+    auto component_variable = ControllerComponentVariables::AuthCacheStorage;
     VariableCharacteristics characteristics;
     characteristics.dataType = DataEnum::integer;
-    characteristics.maxLimit = 500.0f;
+    characteristics.maxLimit = static_cast<float>(2 * entry_size);
     characteristics.supportsMonitoring = true;
     EXPECT_TRUE(this->device_model_test_helper.update_variable_characteristics(
         characteristics, component_variable.component.name, std::nullopt, std::nullopt, std::nullopt,
@@ -1789,51 +1863,43 @@ TEST_F(AuthorizationTest, cache_cleanup_handler_exceeds_max_storage) {
     ASSERT_TRUE(meta_data.value().characteristics.maxLimit.has_value());
     EXPECT_EQ(meta_data.value().characteristics.maxLimit.value(), characteristics.maxLimit);
 
-    {
-        InSequence seq;
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(0, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        // Increase size once (which is strange but this is a test...)
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(600, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(650, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        // Decrease size from now on with every get binary size read.
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(550, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(300, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillRepeatedly(update_count_and_notify(0, this->get_binary_size_count));
-    }
+    this->set_auth_cache_enabled(this->device_model, true);
+    this->set_local_auth_list_ctrlr_enabled(this->device_model, false);
+    this->set_auth_cache_lifetime(this->device_model, 5000);
+    this->set_local_pre_authorize(this->device_model, true);
 
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_expired_entries(_))
-        .WillRepeatedly(update_count_and_notify(this->delete_expired_entries_count));
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_nr_of_oldest_entries(1))
-        .WillRepeatedly(update_count_and_notify(this->delete_nr_of_oldest_entries_count));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(get_all_entries_and_notify(entries));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_update_last_used(_))
+        .WillOnce(update_last_used_and_notify());
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entries(_))
+        .WillOnce(delete_entries_and_notify());
 
-    this->authorization->start_auth_cache_cleanup_thread();
-
-    this->delete_expired_entries_count = 0;
-    this->delete_nr_of_oldest_entries_count = 0;
-    this->get_binary_size_count = 0;
+    // Authorizing with the oldest token is served from the cache and makes it the most recently used entry.
+    EXPECT_EQ(authorization->validate_token(oldest_id_token, std::nullopt, std::nullopt).idTokenInfo.status,
+              AuthorizationStatusEnum::Accepted);
 
+    this->authorization->start_auth_cache_cleanup_thread();
     this->authorization->trigger_authorization_cache_cleanup();
-    this->wait_for_calls(1, 6, 3);
+    this->wait_for_calls(1, 1, 1);
+
+    const std::unique_lock<std::mutex> lock(this->call_mutex);
+    ASSERT_EQ(this->written_last_used.size(), 1);
+    EXPECT_EQ(this->written_last_used.count(ocpp::v2::utils::generate_token_hash(oldest_id_token)), 1);
+    EXPECT_EQ(this->deleted_id_token_hashes,
+              std::vector<std::string>{ocpp::v2::utils::generate_token_hash(middle_id_token)});
 }
 
 TEST_F(AuthorizationTest, cache_cleanup_handler_exceeds_max_storage_database_exception) {
-    // Test cleanup handler with an exception thrown when trying to get the binary size from the database handler.
-    auto component_variable = ControllerComponentVariables::AuthCacheStorage;
+    // Test cleanup handler with an exception thrown when deleting the evicted entries. The entries stay in the cache,
+    // so they are deleted again by the next cleanup.
+    const auto id_token = get_id_token("TOKEN_1");
+    const auto entry = create_authorization_cache_entry(AuthorizationStatusEnum::Accepted, false, false, false, 0);
 
+    auto component_variable = ControllerComponentVariables::AuthCacheStorage;
     VariableCharacteristics characteristics;
     characteristics.dataType = DataEnum::integer;
-    characteristics.maxLimit = 500.0f;
+    characteristics.maxLimit = 1.0f;
     characteristics.supportsMonitoring = true;
     EXPECT_TRUE(this->device_model_test_helper.update_variable_characteristics(
         characteristics, component_variable.component.name, std::nullopt, std::nullopt, std::nullopt,
@@ -1853,58 +1919,35 @@ TEST_F(AuthorizationTest, cache_cleanup_handler_exceeds_max_storage_database_exc
     ASSERT_TRUE(meta_data.value().characteristics.maxLimit.has_value());
     EXPECT_EQ(meta_data.value().characteristics.maxLimit.value(), characteristics.maxLimit);
 
-    {
-        InSequence seq;
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(0, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(600, this->get_binary_size_count))
-            .RetiresOnSaturation();
-        // One of the calls will throw an exception.
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(Throw(everest::db::Exception("Oops!")))
-            .RetiresOnSaturation();
-        // After that, it is still called once at the end of the function (after catching the exception)
-        EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-            .WillOnce(update_count_and_notify(550, this->get_binary_size_count))
-            .RetiresOnSaturation();
-    }
-
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_expired_entries(_))
-        .WillRepeatedly(update_count_and_notify(this->delete_expired_entries_count));
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_nr_of_oldest_entries(1))
-        .WillRepeatedly(update_count_and_notify(this->delete_nr_of_oldest_entries_count));
-
-    this->delete_expired_entries_count = 0;
-    this->delete_nr_of_oldest_entries_count = 0;
-    this->get_binary_size_count = 0;
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillOnce(get_all_entries_and_notify(create_authorization_cache(id_token, entry)));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entries(_))
+        .Times(2)
+        .WillRepeatedly(delete_entries_and_notify(true));
 
     this->authorization->start_auth_cache_cleanup_thread();
 
     this->authorization->trigger_authorization_cache_cleanup();
-    this->wait_for_calls(1, 3, 1);
+    this->wait_for_calls(1, 0, 1);
+    this->authorization->trigger_authorization_cache_cleanup();
+    this->wait_for_calls(1, 0, 2);
+
+    const std::unique_lock<std::mutex> lock(this->call_mutex);
+    EXPECT_EQ(this->deleted_id_token_hashes, std::vector<std::string>{ocpp::v2::utils::generate_token_hash(id_token)});
 }
 
 TEST_F(AuthorizationTest, cache_cleanup_handler_database_exception) {
-    // Cache cleanup handler, another exception is thrown at another place (when calling
-    // 'authorization_cache_delete_expired_entries')
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_binary_size())
-        .WillRepeatedly(update_count_and_notify(0, this->get_binary_size_count));
-
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_expired_entries(_))
-        .WillRepeatedly(Throw(std::out_of_range("expired entries out of range! (?)")));
-    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_nr_of_oldest_entries(1))
-        .WillRepeatedly(update_count_and_notify(this->delete_nr_of_oldest_entries_count));
-
-    this->delete_expired_entries_count = 0;
-    this->delete_nr_of_oldest_entries_count = 0;
-    this->get_binary_size_count = 0;
+    // Cache cleanup handler, another exception is thrown at another place (when loading the authorization cache). It
+    // is loaded again by the next cleanup.
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_get_all_entries())
+        .WillRepeatedly(testing::DoAll(get_all_entries_and_notify({}),
+                                       Throw(std::out_of_range("all entries out of range! (?)"))));
+    EXPECT_CALL(this->database_handler_mock, authorization_cache_delete_entries(_)).Times(0);
 
     this->authorization->start_auth_cache_cleanup_thread();
 
     this->authorization->trigger_authorization_cache_cleanup();
-    this->wait_for_calls(0, 2, 0);
+    this->wait_for_calls(2, 0, 0);
 }
 
 TEST_F(AuthorizationTest, online_local_pre_authorize_local_list) {
@@ -12,15 +12,13 @@ class DatabaseHandlerMock : public DatabaseHandlerInterface {
 public:
     MOCK_METHOD(void, authorization_cache_insert_entry,
                 (const std::string& id_token_hash, const IdTokenInfo& id_token_info));
-    MOCK_METHOD(void, authorization_cache_update_last_used, (const std::string& id_token_hash));
+    MOCK_METHOD(void, authorization_cache_update_last_used, ((const std::map<std::string, DateTime>&)));
     MOCK_METHOD(std::optional<AuthorizationCacheEntry>, authorization_cache_get_entry,
                 (const std::string& id_token_hash));
+    MOCK_METHOD((std::map<std::string, AuthorizationCacheEntry>), authorization_cache_get_all_entries, ());
     MOCK_METHOD(void, authorization_cache_delete_entry, (const std::string& id_token_hash));
-    MOCK_METHOD(void, authorization_cache_delete_nr_of_oldest_entries, (size_t nr_to_remove));
-    MOCK_METHOD(void, authorization_cache_delete_expired_entries,
-                (std::optional<std::chrono::seconds> auth_cache_lifetime));
+    MOCK_METHOD(void, authorization_cache_delete_entries, (const std::vector<std::string>& id_token_hashes));
     MOCK_METHOD(void, authorization_cache_clear, ());
-    MOCK_METHOD(size_t, authorization_cache_get_binary_size, ());
     MOCK_METHOD(void, insert_cs_availability, (OperationalStatusEnum operational_status, bool replace));
     MOCK_METHOD(OperationalStatusEnum, get_cs_availability, ());
     MOCK_METHOD(void, insert_evse_availability,
@@ -37,6 +35,8 @@ public:
                 (const IdToken& id_token, const IdTokenInfo& id_token_info));
     MOCK_METHOD(void, insert_or_update_local_authorization_list,
                 (const std::vector<AuthorizationData>& local_authorization_list));
+    MOCK_METHOD(void, replace_local_authorization_list,
+                (const std::vector<AuthorizationData>& local_authorization_list));
     MOCK_METHOD(void, delete_local_authorization_list_entry, (const IdToken& id_token));
     MOCK_METHOD(std::optional<IdTokenInfo>, get_local_authorization_list_entry, (const IdToken& id_token));
     MOCK_METHOD(void, clear_local_authorization_list, ());
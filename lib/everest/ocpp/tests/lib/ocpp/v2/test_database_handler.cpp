@@ -167,6 +167,95 @@ TEST_F(DatabaseHandlerTest, TransactionDeleteNotFound) {
     EXPECT_NO_THROW(this->database_handler.transaction_delete("txIdNotFound"));
 }
 
+TEST_F(DatabaseHandlerTest, AuthorizationCacheGetAllEntries) {
+    IdTokenInfo accepted;
+    accepted.status = AuthorizationStatusEnum::Accepted;
+    IdTokenInfo blocked;
+    blocked.status = AuthorizationStatusEnum::Blocked;
+
+    this->database_handler.authorization_cache_insert_entry("hash1", accepted);
+    this->database_handler.authorization_cache_insert_entry("hash2", blocked);
+
+    const auto entries = this->database_handler.authorization_cache_get_all_entries();
+
+    ASSERT_EQ(entries.size(), 2);
+    EXPECT_EQ(entries.at("hash1").id_token_info.status, AuthorizationStatusEnum::Accepted);
+    EXPECT_EQ(entries.at("hash2").id_token_info.status, AuthorizationStatusEnum::Blocked);
+}
+
+TEST_F(DatabaseHandlerTest, AuthorizationCacheUpdateLastUsed) {
+    IdTokenInfo accepted;
+    accepted.status = AuthorizationStatusEnum::Accepted;
+    this->database_handler.authorization_cache_insert_entry("hash1", accepted);
+    this->database_handler.authorization_cache_insert_entry("hash2", accepted);
+
+    const DateTime last_used1{date::utc_clock::time_point{std::chrono::seconds{1700000000}}};
+    const DateTime last_used2{date::utc_clock::time_point{std::chrono::seconds{1700000100}}};
+    this->database_handler.authorization_cache_update_last_used({{"hash1", last_used1}, {"hash2", last_used2}});
+
+    EXPECT_EQ(this->database_handler.authorization_cache_get_entry("hash1")->last_used.to_time_point(),
+              last_used1.to_time_point());
+    EXPECT_EQ(this->database_handler.authorization_cache_get_entry("hash2")->last_used.to_time_point(),
+              last_used2.to_time_point());
+}
+
+TEST_F(DatabaseHandlerTest, AuthorizationCacheDeleteEntries) {
+    IdTokenInfo accepted;
+    accepted.status = AuthorizationStatusEnum::Accepted;
+    this->database_handler.authorization_cache_insert_entry("hash1", accepted);
+    this->database_handler.authorization_cache_insert_entry("hash2", accepted);
+    this->database_handler.authorization_cache_insert_entry("hash3", accepted);
+
+    this->database_handler.authorization_cache_delete_entries({"hash1", "hash3"});
+
+    const auto entries = this->database_handler.authorization_cache_get_all_entries();
+    ASSERT_EQ(entries.size(), 1);
+    EXPECT_EQ(entries.count("hash2"), 1);
+}
+
+TEST_F(DatabaseHandlerTest, LocalAuthorizationListDifferentialUpdate) {
+    IdTokenInfo accepted;
+    accepted.status = AuthorizationStatusEnum::Accepted;
+    IdTokenInfo blocked;
+    blocked.status = AuthorizationStatusEnum::Blocked;
+    const IdToken token1{"token1", IdTokenEnumStringType::ISO14443};
+    const IdToken token2{"token2", IdTokenEnumStringType::ISO14443};
+    const IdToken token3{"token3", IdTokenEnumStringType::ISO14443};
+
+    this->database_handler.insert_or_update_local_authorization_list({{token1, accepted}, {token2, accepted}});
+    // update token1, delete token2 and add token3 in a single batch
+    this->database_handler.insert_or_update_local_authorization_list(
+        {{token1, blocked}, {token2, std::nullopt}, {token3, accepted}});
+
+    EXPECT_EQ(this->database_handler.get_local_authorization_list_number_of_entries(), 2);
+    EXPECT_EQ(this->database_handler.get_local_authorization_list_entry(token1)->status,
+              AuthorizationStatusEnum::Blocked);
+    EXPECT_FALSE(this->database_handler.get_local_authorization_list_entry(token2).has_value());
+    EXPECT_EQ(this->database_handler.get_local_authorization_list_entry(token3)->status,
+              AuthorizationStatusEnum::Accepted);
+}
+
+TEST_F(DatabaseHandlerTest, LocalAuthorizationListReplace) {
+    IdTokenInfo accepted;
+    accepted.status = AuthorizationStatusEnum::Accepted;
+    const IdToken token1{"token1", IdTokenEnumStringType::ISO14443};
+    const IdToken token2{"token2", IdTokenEnumStringType::ISO14443};
+    const IdToken token3{"token3", IdTokenEnumStringType::ISO14443};
+
+    this->database_handler.insert_or_update_local_authorization_list({{token1, accepted}, {token2, accepted}});
+    this->database_handler.replace_local_authorization_list({{token2, accepted}, {token3, accepted}});
+
+    EXPECT_EQ(this->database_handler.get_local_authorization_list_number_of_entries(), 2);
+    EXPECT_FALSE(this->database_handler.get_local_authorization_list_entry(token1).has_value());
+    EXPECT_TRUE(this->database_handler.get_local_authorization_list_entry(token2).has_value());
+    EXPECT_TRUE(this->database_handler.get_local_authorization_list_entry(token3).has_value());
+
+    // the staging table is emptied after the swap, so a second replace only contains its own entries
+    this->database_handler.replace_local_authorization_list({{token1, accepted}});
+    EXPECT_EQ(this->database_handler.get_local_authorization_list_number_of_entries(), 1);
+    EXPECT_TRUE(this->database_handler.get_local_authorization_list_entry(token1).has_value());
+}
+
 TEST_F(DatabaseHandlerTest, KO1_FR27_DatabaseWithNoData_InsertProfile) {
     ChargingProfile profile;
     profile.id = 1;
@@ -160,5 +160,42 @@ TEST_F(NotifyReportRequestsSplitterTest, test_splits_contains_at_least_one_repor
     }
 }
 
+/// \brief Test that the streamer emits full pages before the report is finished and never exceeds the size bound
+TEST_F(NotifyReportRequestsSplitterTest, test_streamer_emits_pages_while_adding) {
+    // Setup
+    const size_t max_size = 500;
+    std::vector<ReportData> report_data;
+    for (int i = 0; i < 50; i++) {
+        report_data.push_back(
+            ReportData{{"component_" + std::to_string(i)}, {"variable_" + std::to_string(i)}, {}, {}, {}});
+    }
+    std::vector<json> payloads;
+    NotifyReportStreamer streamer{42, ocpp::DateTime(), max_size, [this]() { return this->generate_message_id(); },
+                                  [&payloads](json&& payload) { payloads.emplace_back(std::move(payload)); }};
+
+    // Act: add all report data
+    for (const auto& entry : report_data) {
+        streamer.add(entry);
+    }
+
+    // Verify pages have been emitted before the report is finished
+    ASSERT_GT(payloads.size(), 1);
+    streamer.finish();
+    ASSERT_EQ(payloads.size(), streamer.get_number_of_payloads());
+
+    // Verify pages are within the bound and contain all report data in order
+    json streamed_report_data = json::array();
+    for (size_t i = 0; i < payloads.size(); i++) {
+        check_valid_call_payload(payloads[i]);
+        ASSERT_LE(payloads[i].dump().size(), max_size);
+        ASSERT_EQ(payloads[i][3]["seqNo"], i);
+        ASSERT_EQ(payloads[i][3]["tbc"], i + 1 < payloads.size());
+        for (const auto& entry : payloads[i][3]["reportData"]) {
+            streamed_report_data.push_back(entry);
+        }
+    }
+    ASSERT_EQ(streamed_report_data, json(report_data));
+}
+
 } // namespace v2
 } // namespace ocpp
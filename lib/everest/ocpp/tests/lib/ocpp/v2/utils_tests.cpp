@@ -16,7 +16,7 @@ protected:
         "hello there hello there hello there hello there hello there hello there hello there hello there "
         "hello there hello there hello there hello there hello there hello there hello there hello there "
         "hello there hello there hello there hello there hello there hello there hello there hello there";
-    const ocpp::v2::IdToken valid_central_token = {"valid", ocpp::v2::IdTokenEnum::Central};
+    const ocpp::v2::IdToken valid_central_token = {"valid", ocpp::v2::IdTokenEnumStringType::Central};
     void SetUp() override {
     }
 
@@ -31,8 +31,8 @@ TEST_F(V2UtilsTest, test_valid_sha256) {
 }
 
 TEST_F(V2UtilsTest, test_valid_generate_token_hash) {
-    ocpp::v2::IdToken valid_iso14443_token = {"ABAD1DEA", ocpp::v2::IdTokenEnum::ISO14443};
-    ocpp::v2::IdToken valid_iso15693_token = {"ABAD1DEA", ocpp::v2::IdTokenEnum::ISO15693};
+    ocpp::v2::IdToken valid_iso14443_token = {"ABAD1DEA", ocpp::v2::IdTokenEnumStringType::ISO14443};
+    ocpp::v2::IdToken valid_iso15693_token = {"ABAD1DEA", ocpp::v2::IdTokenEnumStringType::ISO15693};
 
     ASSERT_EQ("63f3202a9c2e08a033a861481c6259e7a70a2b6e243f91233ebf26f33859c113",
               ocpp::v2::utils::generate_token_hash(valid_central_token));
@@ -68,5 +68,48 @@ TEST_F(V2UtilsTest, test_is_critical_security_event) {
     EXPECT_FALSE(ocpp::v2::utils::is_critical(ocpp::security_events::ATTEMPTEDREPLAYATTACKS));
 }
 
+TEST_F(V2UtilsTest, test_get_measurands_mask) {
+    const auto mask =
+        ocpp::v2::utils::get_measurands_mask("Energy.Active.Import.Register,Unknown.Measurand,Voltage.Maximum");
+    EXPECT_TRUE(mask.contains(ocpp::v2::MeasurandEnum::Energy_Active_Import_Register));
+    EXPECT_TRUE(mask.contains(ocpp::v2::MeasurandEnum::Voltage_Maximum));
+    EXPECT_FALSE(mask.contains(ocpp::v2::MeasurandEnum::Power_Active_Import));
+    EXPECT_EQ(mask, ocpp::v2::utils::get_measurands_mask(std::vector<ocpp::v2::MeasurandEnum>{
+                        ocpp::v2::MeasurandEnum::Voltage_Maximum, ocpp::v2::MeasurandEnum::Energy_Active_Import_Register}));
+    EXPECT_TRUE(ocpp::v2::utils::get_measurands_mask("").empty());
+}
+
+TEST_F(V2UtilsTest, test_get_meter_value_with_measurands_applied) {
+    ocpp::v2::MeterValue meter_value;
+    ocpp::v2::SampledValue energy;
+    energy.value = 1000;
+    energy.measurand = ocpp::v2::MeasurandEnum::Energy_Active_Import_Register;
+    energy.signedMeterValue = ocpp::v2::SignedMeterValue{};
+    ocpp::v2::SampledValue power;
+    power.value = 11000;
+    power.measurand = ocpp::v2::MeasurandEnum::Power_Active_Import;
+    ocpp::v2::SampledValue no_measurand;
+    no_measurand.value = 1;
+    meter_value.sampledValue = {energy, power, no_measurand};
+
+    const auto mask = ocpp::v2::utils::get_measurands_mask("Energy.Active.Import.Register");
+    EXPECT_TRUE(ocpp::v2::utils::meter_value_has_any_measurand(meter_value, mask));
+
+    const auto filtered = ocpp::v2::utils::get_meter_value_with_measurands_applied(meter_value, mask, false);
+    EXPECT_EQ(filtered.timestamp, meter_value.timestamp);
+    ASSERT_EQ(filtered.sampledValue.size(), 1);
+    EXPECT_EQ(filtered.sampledValue.at(0).measurand, ocpp::v2::MeasurandEnum::Energy_Active_Import_Register);
+    EXPECT_FALSE(filtered.sampledValue.at(0).signedMeterValue.has_value());
+
+    const auto filtered_with_signed = ocpp::v2::utils::get_meter_value_with_measurands_applied(meter_value, mask);
+    ASSERT_EQ(filtered_with_signed.sampledValue.size(), 1);
+    EXPECT_TRUE(filtered_with_signed.sampledValue.at(0).signedMeterValue.has_value());
+
+    const auto empty_mask = ocpp::v2::utils::MeasurandEnumMask{};
+    EXPECT_FALSE(ocpp::v2::utils::meter_value_has_any_measurand(meter_value, empty_mask));
+    const auto filtered_empty = ocpp::v2::utils::get_meter_value_with_measurands_applied(meter_value, empty_mask);
+    EXPECT_TRUE(filtered_empty.sampledValue.empty());
+}
+
 } // namespace common
 } // namespace ocpp
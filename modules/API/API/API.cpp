@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2022 Pionix GmbH and Contributors to EVerest
 #include "API.hpp"
+#include <algorithm>
 #include <everest/external_energy_limits/external_energy_limits.hpp>
 #include <utils/date.hpp>
 #include <utils/yaml_loader.hpp>
@@ -328,6 +329,9 @@ void API::init() {
     }
 
     this->limit_decimal_places = std::make_unique<LimitDecimalPlaces>(this->config);
+    this->publish_pipeline = std::make_unique<everest::lib::API::PublishPipeline>(
+        [this](const std::string& topic, const std::string& payload) { this->mqtt.publish(topic, payload); });
+    const auto publish_policies = everest::lib::API::parse_publish_policies(this->config.publish_policies);
     std::vector<std::string> connectors;
     std::string var_connectors = this->api_base + "connectors";
 
@@ -348,17 +352,23 @@ void API::init() {
 
         // API variables
         std::string var_base = evse_base + "/var/";
+        for (const auto& [var, policy] : publish_policies) {
+            this->publish_pipeline->set_policy(var_base + var, policy);
+        }
 
         std::string var_hw_caps = var_base + "hardware_capabilities";
         evse->subscribe_hw_capabilities(
             [this, var_hw_caps, &hw_caps](types::evse_board_support::HardwareCapabilities hw_capabilities) {
                 hw_caps = this->limit_decimal_places->limit(hw_capabilities);
-                this->mqtt.publish(var_hw_caps, hw_caps);
+                this->publish_pipeline->publish(var_hw_caps, hw_caps);
             });
 
         std::string var_powermeter = var_base + "powermeter";
         evse->subscribe_powermeter([this, var_powermeter, &session_info](types::powermeter::Powermeter powermeter) {
-            this->mqtt.publish(var_powermeter, this->limit_decimal_places->limit(powermeter));
+            const auto payload = this->limit_decimal_places->limit(powermeter);
+            // the timestamp is the first member and changes with every sample, leave it out of change detection
+            this->publish_pipeline->publish(var_powermeter, payload,
+                                            payload.substr(std::min(payload.find(','), payload.size())));
             session_info->set_latest_energy_import_wh(powermeter.energy_Wh_import.total);
             if (powermeter.energy_Wh_export.has_value()) {
                 session_info->set_latest_energy_export_wh(powermeter.energy_Wh_export.value().total);
@@ -370,12 +380,12 @@ void API::init() {
 
         std::string var_limits = var_base + "limits";
         evse->subscribe_limits([this, var_limits](types::evse_manager::Limits limits) {
-            this->mqtt.publish(var_limits, this->limit_decimal_places->limit(limits));
+            this->publish_pipeline->publish(var_limits, this->limit_decimal_places->limit(limits));
         });
 
         std::string var_telemetry = var_base + "telemetry";
         evse->subscribe_telemetry([this, var_telemetry](types::evse_board_support::Telemetry telemetry) {
-            this->mqtt.publish(var_telemetry, this->limit_decimal_places->limit(telemetry));
+            this->publish_pipeline->publish(var_telemetry, this->limit_decimal_places->limit(telemetry));
         });
 
         std::string var_ev_info = var_base + "ev_info";
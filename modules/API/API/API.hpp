@@ -32,6 +32,8 @@
 #include <date/date.h>
 #include <date/tz.h>
 
+#include <everest_api_types/utilities/PublishPipeline.hpp>
+
 #include "StartupMonitor.hpp"
 #include "limit_decimal_places.hpp"
 
@@ -154,6 +156,7 @@ struct Conf {
     double telemetry_supply_voltage_12V_round_to;
     double telemetry_supply_voltage_minus_12V_round_to;
     double telemetry_plug_temperature_C_round_to;
+    std::string publish_policies;
 };
 
 class API : public Everest::ModuleBase {
@@ -212,6 +215,7 @@ private:
     std::string selected_protocol;
     json charger_information;
     std::unique_ptr<LimitDecimalPlaces> limit_decimal_places;
+    std::unique_ptr<everest::lib::API::PublishPipeline> publish_pipeline;
 
     std::mutex ocpp_data_mutex;
     json ocpp_charging_schedule;
@@ -58,6 +58,9 @@ void evse_manager_consumer_API::init() {
     invoke_init(*p_main);
 
     topics.setup(info.id, "evse_manager_consumer", 1);
+    for (auto const& [var, policy] : ev_API::parse_publish_policies(config.cfg_publish_policies)) {
+        publish_pipeline.set_policy(topics.everest_to_extern(var), policy);
+    }
 }
 
 void evse_manager_consumer_API::ready() {
@@ -115,7 +118,7 @@ auto evse_manager_consumer_API::forward_api_var(std::string const& var) {
         try {
             auto&& external = to_external_api(val);
             auto&& payload = serialize(external);
-            mqtt.publish(topic, payload);
+            publish_pipeline.publish(topic, payload);
         } catch (const std::exception& e) {
             EVLOG_warning << "Variable: '" << topic << "' failed with -> " << e.what();
         } catch (...) {
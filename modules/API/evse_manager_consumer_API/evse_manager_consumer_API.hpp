@@ -31,6 +31,7 @@
 // insert your custom include headers here
 #include <everest/util/async/monitor.hpp>
 #include <everest_api_types/utilities/CommCheckHandler.hpp>
+#include <everest_api_types/utilities/PublishPipeline.hpp>
 #include <everest_api_types/utilities/Topics.hpp>
 
 #include "session_info.hpp"
@@ -45,6 +46,7 @@ struct Conf {
     int cfg_communication_check_to_s;
     int cfg_heartbeat_interval_ms;
     int cfg_request_reply_to_s;
+    std::string cfg_publish_policies;
 };
 
 class evse_manager_consumer_API : public Everest::ModuleBase {
@@ -70,7 +72,8 @@ public:
         r_random_delay(std::move(r_random_delay)),
 
         config(config),
-        comm_check("generic/CommunicationFault", "Bridge to implementation connection lost", this->p_main){};
+        comm_check("generic/CommunicationFault", "Bridge to implementation connection lost", this->p_main),
+        publish_pipeline([this](auto const& topic, auto const& payload) { mqtt.publish(topic, payload); }){};
 
     Everest::MqttProvider& mqtt;
     const std::shared_ptr<generic_errorImplBase> p_main;
@@ -144,6 +147,7 @@ private:
     ev_API::CommCheckHandler<generic_errorImplBase> comm_check;
     size_t hb_id{0};
     everest::lib::util::monitor<SessionInfo> session_info;
+    ev_API::PublishPipeline publish_pipeline;
 
     // ev@211cfdbe-f69a-4cd6-a4ec-f8aaa3d1b6c8:v1
 };
@@ -224,51 +224,14 @@ private: // Functions
                                                   const types::evse_manager::ConnectorTypeEnum connector_type);
 
     ///
-    /// \brief Get all possible orders of connector types given a vector of connector types.
-    ///
-    /// For the reservations, there must be checked if all combinations of arriving cars with specific connector types
-    /// are possible. For that, we want to  have a list of all different combinations of arriving.
-    ///
-    /// So for example for connector type A, B and C, the different combinations are:
-    /// - A, B, C
-    /// - A, C, B
-    /// - B, A, C
-    /// - B, C, A
-    /// - C, A, B
-    /// - C, B, A
-    ///
-    /// And for connector types A, A and B, the combinations are:
-    /// - A, A, B
-    /// - A, B, A
-    /// - B, A, A
-    ///
-    /// \param connectors   The connector types to get all orders from.
-    /// \return A vector of all orders of the connector types.
-    ///
-    std::vector<std::vector<types::evse_manager::ConnectorTypeEnum>>
-    get_all_possible_orders(const std::vector<types::evse_manager::ConnectorTypeEnum>& connectors) const;
-
-    ///
-    /// \brief Helper function: For a specific order of arrival of cars, check if there is still an EVSE available for
-    /// each car.
-    ///
-    /// This function is called recursively, until no 'virtual cars' are left.
-    ///
-    /// \param used_evse_ids                The evse id's we have used in previous checks. This will be empty when the
-    ///                                     function is first called and will be filled every time an evse id is
-    ///                                     'used'.
-    /// \param next_car_arrival_order       The order in which the cars arrive. This is for example 'A, B, C' and as
-    ///                                     soon as the first is handled, it is removed from the list before
-    ///                                     recursively calling the function again.
-    /// \param evse_specific_reservations   EVSE specific reservations, to see if an EVSE is already reserved.
-    /// \return True if this combination of car arrival orders is possible.
+    /// \brief Check if it is possible to make a new reservation.
     ///
-    bool can_virtual_car_arrive(const std::vector<uint32_t>& used_evse_ids,
-                                const std::vector<types::evse_manager::ConnectorTypeEnum>& next_car_arrival_order,
-                                const std::map<uint32_t, types::reservation::Reservation>& evse_specific_reservations);
-
+    /// Global reservations are only possible if every car with a reservation still finds an available EVSE, whatever
+    /// the order of arrival of the cars is and whichever of the suitable EVSE's every car takes. A car can only be left
+    /// without EVSE if the cars of the other reservations can occupy all EVSE's it could charge at. This is checked for
+    /// every reservation with a maximum bipartite matching between the other reservations and these EVSE's, which is
+    /// polynomial in the number of reservations and EVSE's.
     ///
-    /// \brief Check if it is possible to make a new reservation.
     /// \param global_reservation_type      If it is a global reservation: the reservation type.
     /// \param reservations_no_evse         The list of global reservations.
     /// \param evse_specific_reservations   The list of evse specific reservations.
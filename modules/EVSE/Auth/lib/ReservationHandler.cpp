@@ -15,6 +15,7 @@ namespace module {
 
 static types::reservation::ReservationResult
 connector_state_to_reservation_result(const ConnectorState connector_state);
+static bool can_other_cars_occupy_all_evses(const size_t car, const std::vector<std::vector<bool>>& suitable_evses);
 
 ReservationHandler::ReservationHandler(std::map<int, std::unique_ptr<module::EVSEContext>>& evses,
                                        const std::string& id, kvsIntf* store) :
@@ -532,74 +533,6 @@ types::reservation::ReservationResult ReservationHandler::get_connector_availabi
     return connector_state_to_reservation_result(connector_state);
 }
 
-std::vector<std::vector<types::evse_manager::ConnectorTypeEnum>> ReservationHandler::get_all_possible_orders(
-    const std::vector<types::evse_manager::ConnectorTypeEnum>& connectors) const {
-
-    std::vector<types::evse_manager::ConnectorTypeEnum> input_next = connectors;
-    std::vector<types::evse_manager::ConnectorTypeEnum> input_prev = connectors;
-    std::vector<std::vector<types::evse_manager::ConnectorTypeEnum>> output;
-
-    if (connectors.empty()) {
-        return output;
-    }
-
-    // For next_permutation, the input must be ordered or it will stop halfway. So if it stops halafway,
-    // prev_permutation will find the others.
-    do {
-        output.push_back(input_next);
-    } while (std::next_permutation(input_next.begin(), input_next.end()));
-
-    while (std::prev_permutation(input_prev.begin(), input_prev.end())) {
-        output.push_back(input_prev);
-    }
-
-    return output;
-}
-
-bool ReservationHandler::can_virtual_car_arrive(
-    const std::vector<uint32_t>& used_evse_ids,
-    const std::vector<types::evse_manager::ConnectorTypeEnum>& next_car_arrival_order,
-    const std::map<uint32_t, types::reservation::Reservation>& evse_specific_reservations) {
-
-    bool is_possible = false;
-
-    for (const auto& [evse_id, evse] : evses) {
-        // Check if there is a car already at this evse id.
-        if (std::find(used_evse_ids.begin(), used_evse_ids.end(), evse_id) != used_evse_ids.end()) {
-            continue;
-        }
-
-        if (get_evse_connector_state_reservation_result(evse_id, evse_specific_reservations) ==
-                types::reservation::ReservationResult::Accepted &&
-            has_evse_connector_type(evse->connectors, next_car_arrival_order.at(0)) &&
-            get_connector_availability_reservation_result(evse_id, next_car_arrival_order.at(0)) ==
-                types::reservation::ReservationResult::Accepted) {
-            is_possible = true;
-
-            std::vector<uint32_t> next_used_evse_ids = used_evse_ids;
-            // Add evse id to list when we call the function recursively.
-            next_used_evse_ids.push_back(evse_id);
-
-            // Check if this is the last.
-            if (next_car_arrival_order.size() == 1) {
-                // If this is the last and a car can arrive, then this combination is possible.
-                return true;
-            }
-
-            // Call next level recursively.
-            // Remove connector type ('car') from list when we call the function recursively.
-            const std::vector<types::evse_manager::ConnectorTypeEnum> next_arrival_order(
-                next_car_arrival_order.begin() + 1, next_car_arrival_order.end());
-
-            if (!this->can_virtual_car_arrive(next_used_evse_ids, next_arrival_order, evse_specific_reservations)) {
-                return false;
-            }
-        }
-    }
-
-    return is_possible;
-}
-
 bool ReservationHandler::is_reservation_possible(
     const std::optional<types::evse_manager::ConnectorTypeEnum> global_reservation_type,
     const std::vector<types::reservation::Reservation>& reservations_no_evse,
@@ -619,10 +552,39 @@ bool ReservationHandler::is_reservation_possible(
         return false;
     }
 
-    const std::vector<std::vector<types::evse_manager::ConnectorTypeEnum>> orders = get_all_possible_orders(types);
+    // Evse's that are not occupied and not reserved for a specific reservation.
+    std::vector<uint32_t> free_evse_ids;
+    for (const auto& [evse_id, evse] : evses) {
+        if (get_evse_connector_state_reservation_result(evse_id, evse_specific_reservations) ==
+            types::reservation::ReservationResult::Accepted) {
+            free_evse_ids.push_back(evse_id);
+        }
+    }
+
+    // For every reservation, the free evse's its car could charge at. This only depends on the connector type.
+    std::map<types::evse_manager::ConnectorTypeEnum, std::vector<bool>> suitable_evses_per_type;
+    std::vector<std::vector<bool>> suitable_evses;
+    for (const auto type : types) {
+        auto it = suitable_evses_per_type.find(type);
+        if (it == suitable_evses_per_type.end()) {
+            std::vector<bool> suitable;
+            for (const auto evse_id : free_evse_ids) {
+                suitable.push_back(has_evse_connector_type(this->evses[evse_id]->connectors, type) &&
+                                   get_connector_availability_reservation_result(evse_id, type) ==
+                                       types::reservation::ReservationResult::Accepted);
+            }
+            it = suitable_evses_per_type.emplace(type, std::move(suitable)).first;
+        }
+        suitable_evses.push_back(it->second);
+    }
 
-    for (const auto& o : orders) {
-        if (!this->can_virtual_car_arrive({}, o, evse_specific_reservations)) {
+    // Reservations with the same connector type have the same outcome, so only one of them has to be checked.
+    std::set<types::evse_manager::ConnectorTypeEnum> checked_types;
+    for (size_t car = 0; car < types.size(); car++) {
+        if (!checked_types.insert(types.at(car)).second) {
+            continue;
+        }
+        if (can_other_cars_occupy_all_evses(car, suitable_evses)) {
             return false;
         }
     }
@@ -855,6 +817,56 @@ void ReservationHandler::print_reservations_debug_info(const types::reservation:
     EVLOG_debug << "Current reservations: \n" << reservation_info;
 }
 
+///
+/// \brief Try to let \p car occupy one of the \p target_evses, moving cars that already occupy one of them to another
+///        target evse if needed (augmenting path of the bipartite matching between cars and evse's).
+///
+static bool try_occupy_evse(const size_t car, const std::vector<bool>& target_evses,
+                            const std::vector<std::vector<bool>>& suitable_evses, std::vector<bool>& visited,
+                            std::vector<std::optional<size_t>>& occupied_by) {
+    for (size_t evse = 0; evse < target_evses.size(); evse++) {
+        if (!target_evses[evse] || !suitable_evses[car][evse] || visited[evse]) {
+            continue;
+        }
+        visited[evse] = true;
+        if (!occupied_by[evse].has_value() ||
+            try_occupy_evse(occupied_by[evse].value(), target_evses, suitable_evses, visited, occupied_by)) {
+            occupied_by[evse] = car;
+            return true;
+        }
+    }
+    return false;
+}
+
+///
+/// \brief Check if the cars of all other reservations can occupy every evse the car of reservation \p car could charge
+///        at, which would leave this car without evse.
+/// \param car              Index of the reservation in \p suitable_evses.
+/// \param suitable_evses   For every reservation, the evse's its car could charge at.
+/// \return True if the other cars can occupy all evse's of \p car.
+///
+static bool can_other_cars_occupy_all_evses(const size_t car, const std::vector<std::vector<bool>>& suitable_evses) {
+    const std::vector<bool>& target_evses = suitable_evses.at(car);
+    const auto number_of_target_evses = static_cast<size_t>(std::count(target_evses.begin(), target_evses.end(), true));
+    if (number_of_target_evses == 0) {
+        return true;
+    }
+
+    std::vector<std::optional<size_t>> occupied_by(target_evses.size());
+    size_t number_of_occupied_evses = 0;
+    for (size_t other_car = 0; other_car < suitable_evses.size(); other_car++) {
+        if (other_car == car) {
+            continue;
+        }
+        std::vector<bool> visited(target_evses.size(), false);
+        if (try_occupy_evse(other_car, target_evses, suitable_evses, visited, occupied_by) &&
+            ++number_of_occupied_evses == number_of_target_evses) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static types::reservation::ReservationResult
 connector_state_to_reservation_result(const ConnectorState connector_state) {
     switch (connector_state) {
@@ -8,7 +8,7 @@
 #include <generated/interfaces/kvs/Interface.hpp>
 
 #define private public
-// Make 'ReservationHandler.hpp privates public to test a helper function 'get_all_possible_orders'.
+// Make 'ReservationHandler.hpp privates public to test helper functions.
 #include "ReservationHandler.hpp"
 #undef private
 
@@ -290,50 +290,48 @@ TEST_F(ReservationHandlerTest, global_reservation_scenario_12) {
               ReservationResult::Occupied);
 }
 
-TEST_F(ReservationHandlerTest, get_all_possible_orders) {
-    using namespace types::evse_manager;
-    std::vector<ConnectorTypeEnum> connectors;
-    connectors.push_back(ConnectorTypeEnum::cCCS2);
-
-    std::vector<std::vector<ConnectorTypeEnum>> result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result, std::vector<std::vector<ConnectorTypeEnum>>({{ConnectorTypeEnum::cCCS2}}));
-
-    connectors.push_back(ConnectorTypeEnum::cCCS2);
-    result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result,
-              std::vector<std::vector<ConnectorTypeEnum>>({{ConnectorTypeEnum::cCCS2, ConnectorTypeEnum::cCCS2}}));
-
-    connectors.push_back(ConnectorTypeEnum::cCCS1);
-    result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result, std::vector<std::vector<ConnectorTypeEnum>>(
-                          {{ConnectorTypeEnum::cCCS2, ConnectorTypeEnum::cCCS2, ConnectorTypeEnum::cCCS1},
-                           {ConnectorTypeEnum::cCCS2, ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::cCCS2},
-                           {ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::cCCS2, ConnectorTypeEnum::cCCS2}}));
+TEST_F(ReservationHandlerTest, global_reservation_large_hub) {
+    // Test global reservations on a hub with 24 EVSE's, all with cCCS2 and cType2. Every EVSE can be reserved, the
+    // check must not depend on the number of possible orders of arrival of the cars.
+    for (int32_t evse_id = 1; evse_id <= 24; evse_id++) {
+        add_connector(evse_id, 0, types::evse_manager::ConnectorTypeEnum::cCCS2, this->evses);
+        add_connector(evse_id, 1, types::evse_manager::ConnectorTypeEnum::cType2, this->evses);
+    }
+
+    for (int i = 0; i < 24; i++) {
+        const auto type =
+            i % 2 == 0 ? types::evse_manager::ConnectorTypeEnum::cCCS2 : types::evse_manager::ConnectorTypeEnum::cType2;
+        EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(type)), ReservationResult::Accepted);
+    }
+    EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(types::evse_manager::ConnectorTypeEnum::cCCS2)),
+              ReservationResult::Occupied);
 }
 
-TEST_F(ReservationHandlerTest, get_all_possible_orders2) {
-    using namespace types::evse_manager;
-    std::vector<ConnectorTypeEnum> connectors;
-    connectors.push_back(ConnectorTypeEnum::cType1);
-
-    std::vector<std::vector<ConnectorTypeEnum>> result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result, std::vector<std::vector<ConnectorTypeEnum>>({{ConnectorTypeEnum::cType1}}));
-
-    connectors.push_back(ConnectorTypeEnum::Pan);
-    result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result,
-              std::vector<std::vector<ConnectorTypeEnum>>({{ConnectorTypeEnum::cType1, ConnectorTypeEnum::Pan},
-                                                           {ConnectorTypeEnum::Pan, ConnectorTypeEnum::cType1}}));
-
-    connectors.push_back(ConnectorTypeEnum::cCCS1);
-    result = r.get_all_possible_orders(connectors);
-    EXPECT_EQ(result, std::vector<std::vector<ConnectorTypeEnum>>(
-                          {{ConnectorTypeEnum::cType1, ConnectorTypeEnum::Pan, ConnectorTypeEnum::cCCS1},
-                           {ConnectorTypeEnum::Pan, ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::cType1},
-                           {ConnectorTypeEnum::Pan, ConnectorTypeEnum::cType1, ConnectorTypeEnum::cCCS1},
-                           {ConnectorTypeEnum::cType1, ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::Pan},
-                           {ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::Pan, ConnectorTypeEnum::cType1},
-                           {ConnectorTypeEnum::cCCS1, ConnectorTypeEnum::cType1, ConnectorTypeEnum::Pan}}));
+TEST_F(ReservationHandlerTest, global_reservation_large_hub_arrival_order) {
+    // Test global reservations on a hub with 12 EVSE's with cCCS2 and 12 EVSE's with cCCS2 and cType2. All cType2
+    // EVSE's can be reserved for cType2, but then no cCCS2 reservation can be made: the cCCS2 car could arrive first
+    // and take one of the cType2 EVSE's.
+    for (int32_t evse_id = 1; evse_id <= 24; evse_id++) {
+        add_connector(evse_id, 0, types::evse_manager::ConnectorTypeEnum::cCCS2, this->evses);
+        if (evse_id > 12) {
+            add_connector(evse_id, 1, types::evse_manager::ConnectorTypeEnum::cType2, this->evses);
+        }
+    }
+
+    for (int i = 0; i < 12; i++) {
+        EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(types::evse_manager::ConnectorTypeEnum::cType2)),
+                  ReservationResult::Accepted);
+    }
+    EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(types::evse_manager::ConnectorTypeEnum::cCCS2)),
+              ReservationResult::Occupied);
+
+    // With one cType2 reservation less, one cCCS2 reservation can be made. A second one is not possible, because then
+    // two cCCS2 cars and ten cType2 cars could occupy all cType2 EVSE's before the last cType2 car arrives.
+    EXPECT_TRUE(r.cancel_reservation(0, false, ReservationEndReason::Cancelled).first);
+    EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(types::evse_manager::ConnectorTypeEnum::cCCS2)),
+              ReservationResult::Accepted);
+    EXPECT_EQ(r.make_reservation(std::nullopt, create_reservation(types::evse_manager::ConnectorTypeEnum::cCCS2)),
+              ReservationResult::Occupied);
 }
 
 TEST_F(ReservationHandlerTest, specific_evse_scenario_01) {
@@ -95,9 +95,13 @@ void Charger::main_thread() {
     signal_max_current(get_max_current_internal());
     signal_state(shared_context.current_state);
 
+    auto next_run = std::chrono::steady_clock::now();
+
     while (!main_thread_handle.shouldExit()) {
 
-        const auto events = bsp_event_queue.wait_for(MAINLOOP_UPDATE_RATE);
+        // Sleep until a BSP event or command arrives or the active state needs to be looked at again
+        const auto events = bsp_event_queue.wait_until(next_run);
+        internal_context.state_machine_triggered = bsp_event_queue.get_last_signalled();
 
         for (const auto& event : events) {
             process_event(event);
@@ -107,9 +111,10 @@ void Charger::main_thread() {
             Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_mainloop);
             // update power limits
             power_available();
-            // Run our own state machine update (i.e. run everything that needs
-            // to be done on regular intervals independent from events)
+            // Run our own state machine update (i.e. run everything that needs to be done on timeouts independent
+            // from events). This also schedules the next run.
             run_state_machine();
+            next_run = internal_context.next_state_machine_run;
         }
     }
 }
@@ -122,6 +127,7 @@ void Charger::error_thread() {
         auto events = error_handling_event_queue.wait();
         if (!events.empty()) {
             Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_signal_loop);
+            wake_main_loop();
             for (auto& event : events) {
                 switch (event) {
                 case ErrorHandlingEvents::ForceErrorShutdown:
@@ -147,6 +153,14 @@ void Charger::error_thread() {
 }
 
 void Charger::run_state_machine() {
+    // States without timers only need to run again on the next event
+    internal_context.next_state_machine_run = std::chrono::steady_clock::now() + MAINLOOP_MAX_IDLE;
+
+    // An expiring power budget needs to be noticed in time
+    if (shared_context.max_current > 0.) {
+        schedule_state_machine_in(std::chrono::duration_cast<std::chrono::milliseconds>(
+            shared_context.max_current_valid_until - std::chrono::steady_clock::now() + std::chrono::seconds(1)));
+    }
 
     constexpr int max_mainloop_runs = 10;
     int mainloop_runs = 0;
@@ -162,6 +176,7 @@ void Charger::run_state_machine() {
             session_log.evse(false, fmt::format("Charger state: {}->{}",
                                                 evse_state_to_string(internal_context.last_state_detect_state_change),
                                                 evse_state_to_string(shared_context.current_state)));
+            record_transition_latency(shared_context.current_state, std::chrono::steady_clock::now());
         }
 
         internal_context.last_state = internal_context.last_state_detect_state_change;
@@ -170,6 +185,10 @@ void Charger::run_state_machine() {
 
         auto now = std::chrono::system_clock::now();
 
+        if (shared_context.ac_with_soc_timeout) {
+            // the timer counts state machine runs, keep running at the update rate
+            schedule_state_machine_in(MAINLOOP_UPDATE_RATE);
+        }
         if (shared_context.ac_with_soc_timeout and (shared_context.ac_with_soc_timer -= 50) < 0) {
             shared_context.ac_with_soc_timeout = false;
             shared_context.ac_with_soc_timer = 3600000;
@@ -292,6 +311,7 @@ void Charger::run_state_machine() {
                         EVLOG_warning << "PP ampacity is zero, still waiting for BSP to report it...";
                         internal_context.pp_warning_printed = true;
                     }
+                    schedule_state_machine_in(MAINLOOP_UPDATE_RATE);
                     break;
                 }
             }
@@ -305,6 +325,8 @@ void Charger::run_state_machine() {
 
                     // Wait some time here in this state to see if we get energy from the EnergyManager...
                     if (time_in_current_state < WAIT_FOR_ENERGY_IN_AUTHLOOP_TIMEOUT_MS) {
+                        schedule_state_machine_in(
+                            std::chrono::milliseconds(WAIT_FOR_ENERGY_IN_AUTHLOOP_TIMEOUT_MS - time_in_current_state));
                         break;
                     }
 
@@ -474,6 +496,9 @@ void Charger::run_state_machine() {
                 bsp->switch_three_phases_while_charging(shared_context.switch_3ph1ph_threephase);
                 shared_context.switch_3ph1ph_threephase_ongoing = false;
                 shared_context.current_state = internal_context.switching_phases_return_state;
+            } else {
+                schedule_state_machine_in(
+                    std::chrono::milliseconds(config_context.switch_3ph1ph_delay_s * 1000 - time_in_current_state));
             }
             break;
 
@@ -495,11 +520,16 @@ void Charger::run_state_machine() {
                     internal_context.pwm_set_last_ampere = internal_context.t_step_EF_return_ampere;
                 }
                 shared_context.current_state = internal_context.t_step_EF_return_state;
-            } else if (time_in_current_state >= T_STEP_EF and not internal_context.t_step_ef_x1_pause) {
-                internal_context.t_step_ef_x1_pause = true;
-                // stay in X1 for a little while as required by EV READY regulations
-                session_log.evse(false, "Pause in X1 for EV READY regulations");
-                pwm_off();
+            } else {
+                if (time_in_current_state >= T_STEP_EF and not internal_context.t_step_ef_x1_pause) {
+                    internal_context.t_step_ef_x1_pause = true;
+                    // stay in X1 for a little while as required by EV READY regulations
+                    session_log.evse(false, "Pause in X1 for EV READY regulations");
+                    pwm_off();
+                }
+                const auto next_step =
+                    internal_context.t_step_ef_x1_pause ? T_STEP_EF + STAY_IN_X1_AFTER_TSTEP_EF_MS : T_STEP_EF;
+                schedule_state_machine_in(std::chrono::milliseconds(next_step - time_in_current_state));
             }
             break;
 
@@ -517,10 +547,14 @@ void Charger::run_state_machine() {
                     internal_context.pwm_set_last_ampere = internal_context.t_step_EF_return_ampere;
                 }
                 shared_context.current_state = internal_context.t_step_X1_return_state;
+            } else {
+                schedule_state_machine_in(std::chrono::milliseconds(T_STEP_X1 - time_in_current_state));
             }
             break;
 
         case EvseState::PrepareCharging:
+            // supervises power budget, errors and the EV wake up
+            schedule_state_machine_in(MAINLOOP_UPDATE_RATE);
             if (initialize_state) {
                 signal_simple_event(types::evse_manager::SessionEventEnum::PrepareCharging);
                 bcb_toggle_reset();
@@ -602,6 +636,8 @@ void Charger::run_state_machine() {
             break;
 
         case EvseState::Charging:
+            // supervises power budget, errors, over current and PWM updates
+            schedule_state_machine_in(MAINLOOP_UPDATE_RATE);
             if (initialize_state) {
                 shared_context.hlc_charging_terminate_pause = HlcTerminatePause::Unknown;
                 stopwatch.mark("Charging started");
@@ -672,6 +708,8 @@ void Charger::run_state_machine() {
             break;
 
         case EvseState::ChargingPausedEV:
+            // supervises power budget, over current and PWM updates
+            schedule_state_machine_in(MAINLOOP_UPDATE_RATE);
 
             if (config_context.charge_mode == ChargeMode::AC) {
                 check_soft_over_current();
@@ -803,6 +841,17 @@ void Charger::run_state_machine() {
             // Only allow that if the transaction is still running. If it was cancelled externally with
             // cancel_transaction(), we do not allow restart. If OCPP cancels a transaction it assumes it cannot be
             // restarted. In all other cases, e.g. the EV stopping the transaction it may resume with a BCB toggle.
+            // A started BCB sequence is only complete once the toggle window has passed, so wake up at its end.
+            if (shared_context.hlc_charging_active and internal_context.hlc_bcb_sequence_started) {
+                const auto toggle_window_left =
+                    TT_EVSE_VALD_TOGGLE -
+                    (std::chrono::steady_clock::now() - internal_context.hlc_ev_pause_start_of_bcb_sequence);
+                if (toggle_window_left > std::chrono::steady_clock::duration::zero()) {
+                    schedule_state_machine_in(
+                        std::chrono::duration_cast<std::chrono::milliseconds>(toggle_window_left) +
+                        std::chrono::milliseconds(1));
+                }
+            }
             if (shared_context.hlc_charging_active and bcb_toggle_detected()) {
                 if (shared_context.transaction_active) {
                     shared_context.current_state = EvseState::PrepareCharging;
@@ -847,6 +896,28 @@ void Charger::run_state_machine() {
     } while (internal_context.last_state_detect_state_change not_eq shared_context.current_state);
 }
 
+void Charger::schedule_state_machine_in(std::chrono::milliseconds delay) {
+    const auto run_at = std::chrono::steady_clock::now() + std::max(delay, std::chrono::milliseconds(0));
+    internal_context.next_state_machine_run = std::min(internal_context.next_state_machine_run, run_at);
+}
+
+void Charger::wake_main_loop() {
+    bsp_event_queue.wake();
+}
+
+void Charger::record_transition_latency(EvseState state, std::chrono::steady_clock::time_point now) {
+    const auto latency = now - internal_context.state_machine_triggered;
+    auto& stats = internal_context.transition_latency[state];
+    stats.count++;
+    stats.total += latency;
+    stats.max = std::max(stats.max, latency);
+    EVLOG_debug << fmt::format("Entered {} {}us after trigger (avg {}us, max {}us over {} transitions)",
+                               evse_state_to_string(state),
+                               std::chrono::duration_cast<std::chrono::microseconds>(latency).count(),
+                               std::chrono::duration_cast<std::chrono::microseconds>(stats.total / stats.count).count(),
+                               std::chrono::duration_cast<std::chrono::microseconds>(stats.max).count(), stats.count);
+}
+
 void Charger::process_event(CPEvent cp_event) {
     switch (cp_event) {
     case CPEvent::CarPluggedIn:
@@ -1096,6 +1167,7 @@ bool Charger::set_max_current(float c, std::chrono::time_point<std::chrono::stea
             {
                 Everest::scoped_lock_timeout lock(state_machine_mutex,
                                                   Everest::MutexDescription::Charger_set_max_current);
+                wake_main_loop();
                 shared_context.max_current = c_abs;
                 shared_context.max_current_valid_until = validUntil;
             }
@@ -1115,6 +1187,7 @@ bool Charger::set_max_current(float c, std::chrono::time_point<std::chrono::stea
 // pause if currently charging, else do nothing.
 bool Charger::pause_charging() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_pause_charging);
+    wake_main_loop();
     if (shared_context.current_state == EvseState::Charging) {
         if (shared_context.hlc_charging_active and shared_context.transaction_active) {
             signal_hlc_pause_charging();
@@ -1128,6 +1201,7 @@ bool Charger::pause_charging() {
 
 bool Charger::resume_charging() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_resume_charging);
+    wake_main_loop();
 
     if (shared_context.hlc_charging_active and shared_context.transaction_active and
         shared_context.current_state == EvseState::ChargingPausedEVSE) {
@@ -1147,6 +1221,7 @@ bool Charger::resume_charging() {
 // pause charging since no power is available at the moment
 bool Charger::pause_charging_wait_for_power() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_waiting_for_power);
+    wake_main_loop();
     return pause_charging_wait_for_power_internal();
 }
 
@@ -1163,6 +1238,7 @@ bool Charger::pause_charging_wait_for_power_internal() {
 // resume charging since power became available. Does not resume if user paused charging.
 bool Charger::resume_charging_power_available() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_resume_power_available);
+    wake_main_loop();
 
     if (shared_context.transaction_active and shared_context.current_state == EvseState::WaitingForEnergy and
         power_available()) {
@@ -1186,6 +1262,7 @@ bool Charger::evse_replug() {
 // Cancel transaction/charging from external EvseManager interface (e.g. via OCPP)
 bool Charger::cancel_transaction(const types::evse_manager::StopTransactionRequest& request) {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_cancel_transaction);
+    wake_main_loop();
 
     if (shared_context.transaction_active) {
 
@@ -1397,6 +1474,7 @@ void Charger::setup(bool has_ventilation, const ChargeMode _charge_mode, bool _a
     bsp->setup(has_ventilation);
 
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_setup);
+    wake_main_loop();
     // cache our config variables
     config_context.charge_mode = _charge_mode;
     ac_hlc_enabled_current_session = config_context.ac_hlc_enabled = _ac_hlc_enabled;
@@ -1467,6 +1545,7 @@ std::string Charger::get_session_id() const {
 void Charger::authorize(bool a, const types::authorization::ProvidedIdToken& token,
                         const types::authorization::ValidationResult& result) {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_authorize);
+    wake_main_loop();
     if (a) {
         shared_context.id_token = token;
         shared_context.validation_result = result;
@@ -1488,6 +1567,7 @@ void Charger::authorize(bool a, const types::authorization::ProvidedIdToken& tok
 
 bool Charger::deauthorize() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_deauthorize);
+    wake_main_loop();
     return deauthorize_internal();
 }
 
@@ -1518,6 +1598,7 @@ bool Charger::deauthorize_internal() {
 
 void Charger::enable_disable_initial_state_publish() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_disable);
+    wake_main_loop();
     types::evse_manager::EnableDisableSource source{types::evse_manager::Enable_source::Unspecified,
                                                     types::evse_manager::Enable_state::Unassigned, 10000};
 
@@ -1537,6 +1618,7 @@ void Charger::enable_disable_initial_state_publish() {
 
 bool Charger::enable_disable(int connector_id, const types::evse_manager::EnableDisableSource& source) {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_disable);
+    wake_main_loop();
 
     const auto last = active_enable_disable_source;
 
@@ -1817,6 +1899,7 @@ bool Charger::power_available() {
 
 void Charger::request_error_sequence() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_request_error_sequence);
+    wake_main_loop();
     if (shared_context.current_state == EvseState::WaitingForAuthentication or
         shared_context.current_state == EvseState::PrepareCharging) {
         internal_context.t_step_EF_return_state = shared_context.current_state;
@@ -1833,12 +1916,14 @@ void Charger::request_error_sequence() {
 
 void Charger::set_matching_started(bool m) {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_set_matching_started);
+    wake_main_loop();
     shared_context.matching_started = m;
 }
 
 void Charger::notify_currentdemand_started() {
     Everest::scoped_lock_timeout lock(state_machine_mutex,
                                       Everest::MutexDescription::Charger_notify_currentdemand_started);
+    wake_main_loop();
     if (shared_context.current_state == EvseState::PrepareCharging) {
         signal_simple_event(types::evse_manager::SessionEventEnum::ChargingStarted);
         shared_context.current_state = EvseState::Charging;
@@ -1848,6 +1933,7 @@ void Charger::notify_currentdemand_started() {
 void Charger::inform_new_evse_max_hlc_limits(const types::iso15118::DcEvseMaximumLimits& _currentEvseMaxLimits) {
     Everest::scoped_lock_timeout lock(state_machine_mutex,
                                       Everest::MutexDescription::Charger_inform_new_evse_max_hlc_limits);
+    wake_main_loop();
     shared_context.current_evse_max_limits = _currentEvseMaxLimits;
 }
 
@@ -1859,6 +1945,7 @@ types::iso15118::DcEvseMaximumLimits Charger::get_evse_max_hlc_limits() {
 void Charger::inform_new_evse_min_hlc_limits(const types::iso15118::DcEvseMinimumLimits& limits) {
     Everest::scoped_lock_timeout lock(state_machine_mutex,
                                       Everest::MutexDescription::Charger_inform_new_evse_min_hlc_limits);
+    wake_main_loop();
     shared_context.current_evse_min_limits = limits;
 }
 
@@ -1870,6 +1957,7 @@ types::iso15118::DcEvseMinimumLimits Charger::get_evse_min_hlc_limits() {
 // HLC stack signalled a pause request for the lower layers.
 void Charger::dlink_pause() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_dlink_pause);
+    wake_main_loop();
     shared_context.hlc_allow_close_contactor = false;
     pwm_off();
     shared_context.hlc_charging_terminate_pause = HlcTerminatePause::Pause;
@@ -1878,6 +1966,7 @@ void Charger::dlink_pause() {
 // HLC requested end of charging session, so we can stop the 5% PWM
 void Charger::dlink_terminate() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_dlink_terminate);
+    wake_main_loop();
     shared_context.hlc_allow_close_contactor = false;
     pwm_off();
     shared_context.hlc_charging_terminate_pause = HlcTerminatePause::Terminate;
@@ -1885,6 +1974,7 @@ void Charger::dlink_terminate() {
 
 void Charger::dlink_error() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_dlink_error);
+    wake_main_loop();
 
     shared_context.hlc_allow_close_contactor = false;
 
@@ -1933,12 +2023,14 @@ void Charger::dlink_error() {
 
 void Charger::set_hlc_charging_active() {
     Everest::scoped_lock_timeout lock(state_machine_mutex, Everest::MutexDescription::Charger_set_hlc_charging_active);
+    wake_main_loop();
     shared_context.hlc_charging_active = true;
 }
 
 void Charger::set_hlc_allow_close_contactor(bool on) {
     Everest::scoped_lock_timeout lock(state_machine_mutex,
                                       Everest::MutexDescription::Charger_set_hlc_allow_close_contactor);
+    wake_main_loop();
     shared_context.hlc_allow_close_contactor = on;
 }
 
@@ -34,6 +34,7 @@
 #include <generated/types/authorization.hpp>
 #include <generated/types/evse_manager.hpp>
 #include <generated/types/units_signed.hpp>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -256,6 +257,11 @@ private:
     void process_cp_events_independent(CPEvent cp_event);
     void process_cp_events_state(CPEvent cp_event);
     void run_state_machine();
+    // request the main loop to run the state machine again in at most the given time
+    void schedule_state_machine_in(std::chrono::milliseconds delay);
+    // wake up the main loop, needs to be called after changing the shared context from outside of the main loop
+    void wake_main_loop();
+    void record_transition_latency(EvseState state, std::chrono::steady_clock::time_point now);
 
     void main_thread();
     void error_thread();
@@ -392,6 +398,19 @@ private:
 
         std::chrono::time_point<std::chrono::steady_clock> fatal_error_became_active;
         bool fatal_error_timer_running{false};
+
+        // next time the main loop needs to run the state machine if no event arrives before
+        std::chrono::steady_clock::time_point next_state_machine_run;
+        // time the event or command that led to the current state machine run was signalled
+        std::chrono::steady_clock::time_point state_machine_triggered;
+
+        struct TransitionLatency {
+            std::uint64_t count{0};
+            std::chrono::steady_clock::duration total{0};
+            std::chrono::steady_clock::duration max{0};
+        };
+        // time from the triggering event until the new state was entered, per entered state
+        std::map<EvseState, TransitionLatency> transition_latency;
     } internal_context;
 
     // main Charger thread
@@ -420,7 +439,11 @@ private:
     // Maximum duration of a BCB toggle sequence of 1-3 BCB toggles
     static constexpr auto TT_EVSE_VALD_TOGGLE =
         std::chrono::milliseconds(3500 + 200); // We give 200 msecs tolerance to the norm values (table 3 ISO15118-3)
+    // Update rate of states that continuously supervise the charging process (power budget, PWM, over current)
     static constexpr auto MAINLOOP_UPDATE_RATE = std::chrono::milliseconds(100);
+    // All other states only run on events and their own timeouts, this is just a safety net for anything that is
+    // changed without waking up the main loop
+    static constexpr auto MAINLOOP_MAX_IDLE = std::chrono::milliseconds(1000);
     static constexpr float PWM_5_PERCENT = 0.05;
     static constexpr int T_REPLUG_MS = 4000;
     // 3 seconds according to IEC61851-1
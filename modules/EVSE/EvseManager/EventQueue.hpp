@@ -17,20 +17,42 @@ public:
 
 private:
     events_t pending;
+    bool woken{false};
+    // time the oldest pending event or wake up was signalled
+    std::chrono::steady_clock::time_point pending_since;
+    std::chrono::steady_clock::time_point last_signalled;
     std::mutex mux;
     std::condition_variable cv;
 
+    void mark_pending() {
+        if (pending.empty() and not woken) {
+            pending_since = std::chrono::steady_clock::now();
+        }
+    }
+
 public:
     void push(const E& event) {
         {
             std::lock_guard<std::mutex> lock(mux);
+            mark_pending();
             pending.push_back(event);
         }
         cv.notify_all();
     }
 
+    // wakes up a waiting consumer without adding an event, e.g. because some other state changed
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(mux);
+            mark_pending();
+            woken = true;
+        }
+        cv.notify_all();
+    }
+
     events_t get_events() {
         std::lock_guard<std::mutex> lock(mux);
+        woken = false;
         events_t active;
         pending.swap(active);
         return active;
@@ -39,6 +61,7 @@ public:
     events_t wait() {
         std::unique_lock<std::mutex> ul(mux);
         cv.wait(ul, [this]() { return !pending.empty(); });
+        woken = false;
         events_t active;
         pending.swap(active);
         ul.unlock();
@@ -50,10 +73,31 @@ public:
         if (!cv.wait_for(ul, rel_time, [this]() { return !pending.empty(); })) {
             return {};
         }
+        woken = false;
         events_t active;
         pending.swap(active);
         return active;
     }
+
+    // waits until events are pushed, wake() is called or the deadline is reached, whichever comes first
+    events_t wait_until(const std::chrono::steady_clock::time_point& deadline) {
+        std::unique_lock<std::mutex> ul(mux);
+        if (!cv.wait_until(ul, deadline, [this]() { return woken or !pending.empty(); })) {
+            last_signalled = deadline;
+            return {};
+        }
+        last_signalled = pending_since;
+        woken = false;
+        events_t active;
+        pending.swap(active);
+        return active;
+    }
+
+    // time the events returned by the last wait_until() were signalled, or the deadline if it timed out.
+    // Only to be called by the thread calling wait_until()
+    std::chrono::steady_clock::time_point get_last_signalled() const {
+        return last_signalled;
+    }
 };
 
 } // namespace module
@@ -661,5 +661,14 @@ void energyImpl::handle_enforce_limits(types::energy::EnforcedLimits& value) {
     }
 }
 
+void energyImpl::handle_enforce_limits_batch(std::vector<types::energy::EnforcedLimits>& value) {
+    // a leaf only needs its own entry of the batch
+    for (auto& limits : value) {
+        if (limits.uuid == energy_flow_request.uuid) {
+            handle_enforce_limits(limits);
+        }
+    }
+}
+
 } // namespace energy_grid
 } // namespace module
@@ -34,6 +34,7 @@ public:
 protected:
     // command handler functions (virtual)
     virtual void handle_enforce_limits(types::energy::EnforcedLimits& value) override;
+    virtual void handle_enforce_limits_batch(std::vector<types::energy::EnforcedLimits>& value) override;
 
     // ev@d2d1847a-7b88-41dd-ad07-92785f06f5c4:v1
     // insert your protected definitions here
@@ -3,6 +3,7 @@
 #include <EventQueue.hpp>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -91,4 +92,47 @@ TEST(EventQueue, wait) {
     wait_thread.join();
 }
 
+TEST(EventQueue, wait_until_deadline) {
+    module::EventQueue<ErrorHandlingEvents> queue;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    auto events = queue.wait_until(deadline);
+    EXPECT_EQ(events.size(), 0);
+    EXPECT_GE(std::chrono::steady_clock::now(), deadline);
+    EXPECT_EQ(queue.get_last_signalled(), deadline);
+}
+
+TEST(EventQueue, wait_until_event) {
+    module::EventQueue<ErrorHandlingEvents> queue;
+    const auto before_push = std::chrono::steady_clock::now();
+    queue.push(ErrorHandlingEvents::PreventCharging);
+    queue.push(ErrorHandlingEvents::AllErrorsCleared);
+
+    auto events = queue.wait_until(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0], ErrorHandlingEvents::PreventCharging);
+    // the oldest pending event defines when the queue was signalled
+    EXPECT_GE(queue.get_last_signalled(), before_push);
+    EXPECT_LE(queue.get_last_signalled(), std::chrono::steady_clock::now());
+}
+
+TEST(EventQueue, wake) {
+    module::EventQueue<ErrorHandlingEvents> queue;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread wake_thread([&queue]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        queue.wake();
+    });
+
+    auto events = queue.wait_until(start + std::chrono::seconds(10));
+    EXPECT_EQ(events.size(), 0);
+    EXPECT_LT(std::chrono::steady_clock::now(), start + std::chrono::seconds(10));
+    wake_thread.join();
+
+    // a wake up is consumed by the wait it interrupted
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+    queue.wait_until(deadline);
+    EXPECT_EQ(queue.get_last_signalled(), deadline);
+}
+
 } // namespace
@@ -13,11 +13,13 @@
 #include <ctype.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <fstream>
 #include <inttypes.h>
 #include <iostream>
 #include <net/if.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,6 +37,9 @@
 #define DEFAULT_TLS_PORT              64110
 #define ERROR_SESSION_ALREADY_STARTED 2
 #define CLIENT_FIN_TIMEOUT            3000
+#define CLIENT_CLOSE_GRACE_PERIOD     2000
+#define PROXY_BUFFER_SIZE             2048
+#define PROXY_SPLICE_SIZE             65536
 
 /*!
  * \brief connection_create_socket This function creates a tcp/tls socket
@@ -361,19 +366,47 @@ ssize_t connection_write(struct v2g_connection* conn, unsigned char* buf, size_t
     return (ssize_t)bytes_written;
 }
 
-static void wait_for_peer_close(int fd, int timeout_ms) {
-    struct pollfd pfd = {};
-    pfd.fd = fd;
-    pfd.events = POLLIN | POLLHUP;
-
-    int rc = poll(&pfd, 1, timeout_ms);
-    if (rc <= 0) {
-        return;
+/*!
+ * \brief wait_for_peer_close This function waits until the peer closed its side of the connection, received data
+ * is discarded
+ * \param fd is the socket of the connection
+ * \param timeout_ms is the maximum time to wait
+ * \return Returns \c true if the peer closed the connection, otherwise \c false
+ */
+static bool wait_for_peer_close(int fd, int timeout_ms) {
+    struct timespec ts_start, ts_current;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts_start) == -1) {
+        return false;
     }
 
-    if (pfd.revents & (POLLIN | POLLHUP)) {
+    while (true) {
+        if (clock_gettime(CLOCK_MONOTONIC, &ts_current) == -1) {
+            return false;
+        }
+        const long long remaining_ms = timeout_ms - timespec_to_ms(timespec_sub(ts_current, ts_start));
+        if (remaining_ms <= 0) {
+            return false;
+        }
+
+        struct pollfd pfd = {};
+        pfd.fd = fd;
+        pfd.events = POLLIN | POLLHUP;
+
+        int rc = poll(&pfd, 1, static_cast<int>(remaining_ms));
+        if (rc == -1 && errno == EINTR) {
+            continue;
+        }
+        if (rc <= 0) {
+            return false;
+        }
+
         char buf[64];
-        while (recv(fd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {
+        ssize_t n;
+        while ((n = recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+        }
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) ||
+            (pfd.revents & (POLLHUP | POLLERR))) {
+            return true;
         }
     }
 }
@@ -388,8 +421,9 @@ void* connection_handle_tcp(void* data) {
     /* tear down connection gracefully */
     dlog(DLOG_LEVEL_INFO, "Multiplexer: Closing TCP connection");
 
-    /* some EV's did not like the immediate shutdown. Therefore we sleep for 2 seconds */
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    /* some EV's did not like the immediate shutdown. Therefore we give the EV up to 2 seconds to close the
+     * connection first */
+    wait_for_peer_close(conn->conn.socket_fd, CLIENT_CLOSE_GRACE_PERIOD);
 
     if (shutdown(conn->conn.socket_fd, SHUT_WR) == -1) {
         dlog(DLOG_LEVEL_ERROR, "shutdown() failed: %s", strerror(errno));
@@ -452,14 +486,160 @@ void* connection_handle(void* data) {
     return nullptr;
 }
 
+void proxy_counters_add(struct proxy_counters* counters, size_t bytes, struct timespec ts_available) {
+    struct timespec ts_current;
+    clock_gettime(CLOCK_MONOTONIC, &ts_current);
+    const long long delay_us = timespec_to_us(timespec_sub(ts_current, ts_available));
+
+    counters->bytes += bytes;
+    counters->chunks++;
+    counters->total_delay_us += delay_us;
+    if (delay_us > counters->max_delay_us) {
+        counters->max_delay_us = delay_us;
+    }
+}
+
+void proxy_counters_log(const struct proxy_counters* to_module, const struct proxy_counters* to_ev) {
+    const struct proxy_counters* counters[] = {to_module, to_ev};
+    const char* names[] = {"EV->ISO module", "ISO module->EV"};
+
+    for (int i = 0; i < 2; i++) {
+        const long long avg_delay_us = counters[i]->chunks ? counters[i]->total_delay_us / counters[i]->chunks : 0;
+        dlog(DLOG_LEVEL_INFO, "Multiplexer: %s forwarded %llu bytes in %llu chunks, delay avg %lld us, max %lld us",
+             names[i], counters[i]->bytes, counters[i]->chunks, avg_delay_us, counters[i]->max_delay_us);
+    }
+}
+
+ssize_t proxy_write_all(int fd, const unsigned char* buf, size_t count) {
+    size_t bytes_written = 0;
+
+    while (bytes_written < count) {
+        ssize_t num_of_bytes = write(fd, &buf[bytes_written], count - bytes_written);
+
+        if (num_of_bytes == -1) {
+            if (errno == EINTR)
+                continue;
+
+            return -1;
+        }
+
+        bytes_written += num_of_bytes;
+    }
+
+    return (ssize_t)bytes_written;
+}
+
+void proxy_set_nodelay(int fd) {
+    int enable = 1;
+    if (setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) == -1) {
+        dlog(DLOG_LEVEL_WARNING, "setsockopt(TCP_NODELAY) failed: %s", strerror(errno));
+    }
+}
+
+/*!
+ * \brief proxy_splice This function moves the data available on a socket to another socket through a pipe,
+ * without copying it to user space
+ * \param from_fd is the socket to read from
+ * \param to_fd is the socket to write to
+ * \param pipe_fds is the pipe the data is moved through, it is empty before and after the call
+ * \return Returns the number of forwarded bytes, \c 0 if \c from_fd was closed and \c -1 on error. errno is
+ * \c EINVAL only if nothing was moved because the sockets do not support splicing.
+ */
+static ssize_t proxy_splice(int from_fd, int to_fd, const int pipe_fds[2]) {
+    const ssize_t received =
+        splice(from_fd, nullptr, pipe_fds[1], nullptr, PROXY_SPLICE_SIZE, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (received <= 0) {
+        return received;
+    }
+
+    ssize_t remaining = received;
+    while (remaining > 0) {
+        const ssize_t sent = splice(pipe_fds[0], nullptr, to_fd, nullptr, remaining, SPLICE_F_MOVE);
+        if (sent == -1) {
+            if (errno == EINTR)
+                continue;
+
+            // data is stuck in the pipe, this must not be retried with a copy
+            if (errno == EINVAL)
+                errno = EIO;
+            return -1;
+        }
+        remaining -= sent;
+    }
+
+    return received;
+}
+
+/*!
+ * \brief proxy_copy This function copies the data available on a socket to another socket
+ * \return Returns the number of forwarded bytes, \c 0 if \c from_fd was closed and \c -1 on error
+ */
+static ssize_t proxy_copy(int from_fd, int to_fd) {
+    unsigned char buf[PROXY_BUFFER_SIZE];
+
+    const ssize_t received = read(from_fd, buf, sizeof(buf));
+    if (received <= 0) {
+        return received;
+    }
+
+    return proxy_write_all(to_fd, buf, received);
+}
+
+/*!
+ * \brief proxy_forward_ready This function forwards the data available on a socket to another socket and counts it
+ * \param use_splice is set to \c false if splicing is not supported, the data is copied then
+ * \return Returns \c 1 if the connection is still open, \c 0 if \c from_fd was closed and \c -1 on error
+ */
+static int proxy_forward_ready(int from_fd, int to_fd, const int pipe_fds[2], bool* use_splice,
+                               struct proxy_counters* counters, struct timespec ts_available) {
+    ssize_t forwarded = -1;
+
+    if (*use_splice) {
+        forwarded = proxy_splice(from_fd, to_fd, pipe_fds);
+        if (forwarded == -1 && errno == EINVAL) {
+            dlog(DLOG_LEVEL_WARNING, "Multiplexer: splice() is not supported, copying proxied data");
+            *use_splice = false;
+        }
+    }
+
+    if (not *use_splice) {
+        forwarded = proxy_copy(from_fd, to_fd);
+    }
+
+    if (forwarded == -1) {
+        // spurious wakeup, nothing to forward yet
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 1 : -1;
+    }
+
+    if (forwarded == 0) {
+        return 0;
+    }
+
+    proxy_counters_add(counters, forwarded, ts_available);
+    return 1;
+}
+
 int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
 
     dlog(DLOG_LEVEL_INFO, "Multiplexer: Proxy TCP->TCP");
 
     int ev_fd = conn->conn.socket_fd;
+    proxy_set_nodelay(ev_fd);
 
     // SupportedAppProtocolReq message is still in buffer, we need to forward it to the external stack
-    write(proxy_fd, conn->buffer, conn->payload_len + 8);
+    if (proxy_write_all(proxy_fd, conn->buffer, conn->payload_len + 8) == -1) {
+        dlog(DLOG_LEVEL_ERROR, "Multiplexer: forwarding SupportedAppProtocolReq failed: %s", strerror(errno));
+        close(proxy_fd);
+        return -1;
+    }
+
+    // One pipe per direction, the data is moved between the sockets through them without copying it to user space
+    int to_ev_pipe[2] = {-1, -1};
+    int to_module_pipe[2] = {-1, -1};
+    bool use_splice = (pipe2(to_ev_pipe, O_CLOEXEC) == 0) and (pipe2(to_module_pipe, O_CLOEXEC) == 0);
+    if (not use_splice) {
+        dlog(DLOG_LEVEL_WARNING, "Multiplexer: pipe2() failed, copying proxied data: %s", strerror(errno));
+    }
 
     struct pollfd poll_list[2];
     poll_list[0].fd = proxy_fd;
@@ -467,14 +647,21 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
     poll_list[0].events = POLLIN;
     poll_list[1].events = POLLIN;
 
-    unsigned char buf[2048];
+    struct proxy_counters to_ev = {};
+    struct proxy_counters to_module = {};
+    int rv = 0;
+    int state = 1;
 
-    while (true) {
+    while (state > 0) {
 
         int ret = poll(poll_list, 2, -1);
 
         if (ret == -1) {
-            return -1; // poll error
+            if (errno == EINTR)
+                continue;
+
+            rv = -1; // poll error
+            break;
         }
 
         // Timed out, but we blocked forever. This could be a spurious wakeup, so just try again.
@@ -482,40 +669,43 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
             continue;
         }
 
-        if (poll_list[0].revents & POLLIN) {
-            // we can read from proxy (connection to local ISO module)
-            int nrbytes = read(proxy_fd, buf, sizeof(buf));
-
-            if (nrbytes == 0) {
-                break;
-            }
-            // write data to EV
-            nrbytes = conn->write(conn, buf, nrbytes);
-        }
+        struct timespec ts_available;
+        clock_gettime(CLOCK_MONOTONIC, &ts_available);
 
-        if (poll_list[0].revents & POLLERR or poll_list[0].revents & POLLHUP or poll_list[0].revents & POLLNVAL) {
+        if (poll_list[0].revents & POLLIN) {
+            // we can read from proxy (connection to local ISO module), forward data to EV
+            state = proxy_forward_ready(proxy_fd, ev_fd, to_ev_pipe, &use_splice, &to_ev, ts_available);
+        } else if (poll_list[0].revents & POLLERR or poll_list[0].revents & POLLHUP or
+                   poll_list[0].revents & POLLNVAL) {
             // something is wrong with the TCP connection to the ISO module
-            return -1;
+            state = -1;
         }
 
-        if (poll_list[1].revents & POLLIN) {
-            // we can read from EV
-            int nrbytes = conn->read(conn, buf, sizeof(buf), false);
-            if (nrbytes == 0) {
-                break;
+        if (state > 0) {
+            if (poll_list[1].revents & POLLIN) {
+                // we can read from EV, forward data to proxy
+                state = proxy_forward_ready(ev_fd, proxy_fd, to_module_pipe, &use_splice, &to_module, ts_available);
+            } else if (poll_list[1].revents & POLLERR or poll_list[1].revents & POLLHUP or
+                       poll_list[1].revents & POLLNVAL) {
+                // something is wrong with the TCP connection to the EV
+                state = -1;
             }
-            // write data to proxy
-            nrbytes = write(proxy_fd, buf, nrbytes);
         }
 
-        if (poll_list[1].revents & POLLERR or poll_list[1].revents & POLLHUP or poll_list[1].revents & POLLNVAL) {
-            // something is wrong with the TCP connection to the EV
-            return -1;
+        if (state < 0) {
+            rv = -1;
         }
     }
 
+    proxy_counters_log(&to_module, &to_ev);
+
+    for (int fd : {to_ev_pipe[0], to_ev_pipe[1], to_module_pipe[0], to_module_pipe[1]}) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
     close(proxy_fd);
-    return 0;
+    return rv;
 }
 
 static void* connection_server(void* data) {
@@ -57,4 +57,41 @@ void* connection_handle_tcp(void* data);
 void* connection_handle(void* data);
 int connection_proxy(struct v2g_connection* conn, int proxy_fd);
 
+/*!
+ * \brief counters of one direction of a proxied connection
+ */
+struct proxy_counters {
+    unsigned long long bytes;  /* forwarded bytes */
+    unsigned long long chunks; /* number of forwarded chunks */
+    long long total_delay_us;  /* sum of the times from data being available until it was forwarded */
+    long long max_delay_us;    /* longest time from data being available until it was forwarded */
+};
+
+/*!
+ * \brief proxy_counters_add This function counts a forwarded chunk
+ * \param counters the counters of the direction the chunk was forwarded in
+ * \param bytes number of forwarded bytes
+ * \param ts_available time (CLOCK_MONOTONIC) at which the chunk was available for forwarding
+ */
+void proxy_counters_add(struct proxy_counters* counters, size_t bytes, struct timespec ts_available);
+
+/*!
+ * \brief proxy_counters_log This function logs the counters of a proxied connection
+ * \param to_module counters of the direction EV to ISO module
+ * \param to_ev counters of the direction ISO module to EV
+ */
+void proxy_counters_log(const struct proxy_counters* to_module, const struct proxy_counters* to_ev);
+
+/*!
+ * \brief proxy_write_all This function writes the whole buffer to a socket
+ * \return Returns \c count on success, otherwise \c -1
+ */
+ssize_t proxy_write_all(int fd, const unsigned char* buf, size_t count);
+
+/*!
+ * \brief proxy_set_nodelay This function disables Nagle's algorithm on a proxied socket, so that forwarded chunks
+ * are never held back waiting for an acknowledgement
+ */
+void proxy_set_nodelay(int fd);
+
 #endif /* CONNECTION_H */
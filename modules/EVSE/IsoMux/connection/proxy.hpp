@@ -7,6 +7,7 @@
 
 #include <cstddef>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
 /*!
  * \brief connect to a local V2G server
@@ -38,6 +39,12 @@ inline int proxy_connect(uint16_t port) {
         return -1;
     }
 
+    /* Forward every chunk right away, V2G messages are request-response pairs */
+    int enable = 1;
+    if (setsockopt(sock_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) == -1) {
+        perror("setsockopt(TCP_NODELAY)");
+    }
+
     return sock_fd;
 }
 
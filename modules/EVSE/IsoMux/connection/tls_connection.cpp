@@ -329,9 +329,14 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
 
     dlog(DLOG_LEVEL_INFO, "Multiplexer: Proxy TLS->TCP");
     int ev_fd = conn->tls_connection->socket(); // underlying socket of TLS connection
+    ::proxy_set_nodelay(ev_fd);
 
     // SupportedAppProtocolReq message is still in buffer, we need to forward it to the external stack
-    write(proxy_fd, conn->buffer, conn->payload_len + 8);
+    if (::proxy_write_all(proxy_fd, conn->buffer, conn->payload_len + 8) == -1) {
+        dlog(DLOG_LEVEL_ERROR, "Multiplexer: forwarding SupportedAppProtocolReq failed: %s", strerror(errno));
+        close(proxy_fd);
+        return -1;
+    }
 
     struct pollfd poll_list[2];
     poll_list[0].fd = proxy_fd;
@@ -341,38 +346,69 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
 
     unsigned char buf[2048];
 
-    // Set reading to (more or less) non-blocking
-    conn->tls_connection->set_read_timeout(10);
+    struct proxy_counters to_ev = {};
+    struct proxy_counters to_module = {};
+    int rv = 0;
+    bool proxying{true};
 
-    while (true) {
+    while (proxying) {
         // Note we cannot simply poll on the underlying system socket for TLS connection
         // as it does not guarantee that SSL_read/write will not block after the poll
         // (an SSL_read my trigger an actual write or multiple reads on the system socket)
-        // So we have to try a non-blocking SSL_read first, openssl will then tell us
-        // what to wait for on the socket before we try again (read, write or both)
-
-        auto r = conn->read(conn, buf, sizeof(buf), false);
+        // So we read without waiting until openssl tells us what to wait for on the socket
+        // (read, write or both). Records that openssl already received are read before polling,
+        // as they are not signalled on the socket anymore.
+        bool want_write{false};
+        bool reading{true};
+        while (reading) {
+            timespec ts_available{};
+            clock_gettime(CLOCK_MONOTONIC, &ts_available);
+
+            std::size_t bytes_in{0};
+            auto* ptr = reinterpret_cast<std::byte*>(buf);
+            const auto read_res = conn->tls_connection->read(ptr, sizeof(buf), bytes_in, 0);
+            switch (read_res) {
+            case tls::Connection::result_t::success:
+                if (bytes_in == 0) {
+                    reading = false;
+                } else if (::proxy_write_all(proxy_fd, buf, bytes_in) == -1) {
+                    // something is wrong with the TCP connection to the ISO module
+                    reading = proxying = false;
+                    rv = -1;
+                } else {
+                    ::proxy_counters_add(&to_module, bytes_in, ts_available);
+                }
+                break;
+            case tls::Connection::result_t::want_write:
+                want_write = true;
+                reading = false;
+                break;
+            case tls::Connection::result_t::want_read:
+            case tls::Connection::result_t::timeout:
+                reading = false;
+                break;
+            case tls::Connection::result_t::closed:
+            default:
+                // something is wrong with the connection, exiting...
+                reading = proxying = false;
+                break;
+            }
+        }
 
-        if (r < 0) {
-            // something is wrong with the connection, exiting...
+        if (not proxying or conn->ctx->is_connection_terminated) {
             break;
-        } else if (r > 0) {
-            // successfully read bytes, forward to proxy module
-            write(proxy_fd, buf, r);
         }
 
-        // check if SSL was actually waiting on write
-        int e = SSL_get_error(conn->tls_connection->ssl_context(), r);
-        if (e == SSL_ERROR_WANT_WRITE) {
-            poll_list[1].events = POLLIN | POLLOUT;
-        } else {
-            poll_list[1].events = POLLIN;
-        }
+        poll_list[1].events = want_write ? (POLLIN | POLLOUT) : POLLIN;
 
         int ret = poll(poll_list, 2, -1);
 
         if (ret == -1) {
-            return -1; // poll error
+            if (errno == EINTR) {
+                continue;
+            }
+            rv = -1; // poll error
+            break;
         }
 
         // Timed out, but we blocked forever. This could be a spurious wakeup, so just try again.
@@ -381,19 +417,27 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
         }
 
         if (poll_list[0].revents & POLLIN) {
+            timespec ts_available{};
+            clock_gettime(CLOCK_MONOTONIC, &ts_available);
+
             // we can read from proxy (connection to local ISO module)
             int nrbytes = read(proxy_fd, buf, sizeof(buf));
 
-            if (nrbytes == 0) {
+            if (nrbytes <= 0) {
+                rv = (nrbytes == 0) ? 0 : -1;
                 break;
             }
             // write data to EV
-            nrbytes = conn->write(conn, buf, nrbytes);
-        }
-
-        if (poll_list[0].revents & POLLERR or poll_list[0].revents & POLLHUP or poll_list[0].revents & POLLNVAL) {
+            if (conn->write(conn, buf, nrbytes) < 0) {
+                rv = -1;
+                break;
+            }
+            ::proxy_counters_add(&to_ev, nrbytes, ts_available);
+        } else if (poll_list[0].revents & POLLERR or poll_list[0].revents & POLLHUP or
+                   poll_list[0].revents & POLLNVAL) {
             // something is wrong with the TCP connection to the ISO module
-            return -1;
+            rv = -1;
+            break;
         }
 
         if (poll_list[1].revents & POLLIN or poll_list[1].revents & POLLOUT) {
@@ -404,12 +448,15 @@ int connection_proxy(struct v2g_connection* conn, int proxy_fd) {
 
         if (poll_list[1].revents & POLLERR or poll_list[1].revents & POLLHUP or poll_list[1].revents & POLLNVAL) {
             // something is wrong with the TCP connection to the EV
-            return -1;
+            rv = -1;
+            break;
         }
     }
 
+    ::proxy_counters_log(&to_module, &to_ev);
+
     close(proxy_fd);
-    return 0;
+    return rv;
 }
 
 } // namespace tls
@@ -126,6 +126,10 @@ long long timespec_to_ms(struct timespec ts) {
     return ((long long)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
 }
 
+long long timespec_to_us(struct timespec ts) {
+    return ((long long)ts.tv_sec * 1000000) + (ts.tv_nsec / 1000);
+}
+
 bool get_dir_filename(char* file_name, uint8_t file_name_len, const char* path, const char* file_name_identifier) {
 
     file_name[0] = '\0';
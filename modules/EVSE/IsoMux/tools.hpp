@@ -26,6 +26,7 @@ int get_interface_ipv6_address(const char* if_name, enum Addr6Type type, struct
 void set_normalized_timespec(struct timespec* ts, time_t sec, int64_t nsec);
 struct timespec timespec_sub(struct timespec lhs, struct timespec rhs);
 long long timespec_to_ms(struct timespec ts);
+long long timespec_to_us(struct timespec ts);
 
 /*!
  * \brief get_dir_filename This function searches for a specific name (AFileNameIdentifier) in a file path and stores
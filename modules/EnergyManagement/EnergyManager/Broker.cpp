@@ -83,33 +83,9 @@ bool Broker::trade(Offer& _offer) {
     }
 }
 
-date::utc_clock::time_point Broker::to_timestamp(const types::energy::ScheduleReqEntry& entry) {
-    return Everest::Date::from_rfc3339(entry.timestamp);
-}
-
-bool Broker::time_slot_active(const int i, const ScheduleReq& offer) {
-    const auto& now = globals.start_time;
-    const auto t_i = to_timestamp(offer[i]);
-
-    int active_slot = 0;
-    // Get active slot:
-    if (now < to_timestamp(offer[0])) {
-        // First element already in the future
-        active_slot = 0;
-    } else if (now > to_timestamp(offer[offer.size() - 1])) {
-        // Last element in the past
-        active_slot = offer.size() - 1;
-    } else {
-        // Somewhere in between
-        for (int n = 0; n < offer.size() - 1; n++) {
-            if (now > to_timestamp(offer[n]) and now < to_timestamp(offer[n + 1])) {
-                active_slot = n;
-                break;
-            }
-        }
-    }
-
-    return active_slot == i;
+bool Broker::time_slot_active(const int i) {
+    // all offers share the time axis of the globals, so the active slot is the same for all of them
+    return globals.active_slot == i;
 }
 
 bool Broker::buy_ampere_import(int index, float ampere, bool allow_less,
@@ -86,8 +86,7 @@ protected:
     bool buy_watt_export(int index, float watt, bool allow_less);
     bool buy_watt(const types::energy::ScheduleReqEntry& _offer, int index, float watt, bool allow_less, bool import);
 
-    date::utc_clock::time_point to_timestamp(const types::energy::ScheduleReqEntry& entry);
-    bool time_slot_active(const int i, const ScheduleReq& offer);
+    bool time_slot_active(const int i);
 
     // reference to local market at the broker's node
     Market& local_market;
@@ -35,7 +35,10 @@ void EnergyManager::init() {
                                           it.limits_root_side.ac_max_current_A.value_or(nonumber).value,
                                           it.limits_root_side.total_power_W.value_or(nonumber).value,
                                           it.limits_root_side.ac_max_phase_count.value_or(noint).value);
-            r_energy_trunk->call_enforce_limits(it);
+        }
+        // all limits of one optimization round are routed through the tree as one batch
+        if (not limits.empty()) {
+            r_energy_trunk->call_enforce_limits_batch(limits);
         }
     };
 
@@ -144,19 +144,23 @@ std::vector<types::energy::EnforcedLimits> EnergyManagerImpl::run_optimizer(type
     time_probe offer_tp;
     time_probe broker_tp;
 
+    // one offer per broker, updated in place in every round to avoid reallocating all schedules
+    std::vector<Offer> offers(brokers.size());
+
     while (max_number_of_trading_rounds-- > 0) {
         bool trade_happend_in_this_round = false;
-        for (auto broker : brokers) {
+        for (std::size_t i = 0; i < brokers.size(); i++) {
+            auto& broker = brokers[i];
             // EVLOG_info << broker->get_local_market().energy_flow_request;
             //     create local offer at evse's marketplace
 
             offer_tp.start();
-            Offer local_offer(broker->get_local_market());
+            offers[i].update(broker->get_local_market());
             offer_tp.pause();
 
             // ask broker to trade
             broker_tp.start();
-            if (broker->trade(local_offer))
+            if (broker->trade(offers[i]))
                 trade_happend_in_this_round = true;
             broker_tp.pause();
         }
@@ -192,14 +196,14 @@ std::vector<types::energy::EnforcedLimits> EnergyManagerImpl::run_optimizer(type
             // select root limit from schedule based on globals.start_time
             l.limits_root_side = sold_energy[0].limits_to_root;
 
-            for (const auto& s : sold_energy) {
-                const auto schedule_time = Everest::Date::from_rfc3339(s.timestamp);
-                if (globals.start_time < schedule_time) {
+            // the sold energy uses the time axis of the globals, so there is no need to parse the timestamps again
+            for (std::size_t i = 0; i < sold_energy.size() and i < globals.timestamps.size(); i++) {
+                if (globals.start_time < globals.timestamps[i]) {
                     // all further schedules will be further into the future
                     break;
                 } else {
                     // use this schedule as the starting point
-                    l.limits_root_side = s.limits_to_root;
+                    l.limits_root_side = sold_energy[i].limits_to_root;
                 }
             }
 
@@ -20,6 +20,7 @@ void globals_t::init(date::utc_clock::time_point _start_time, int _interval_dura
     debug = _debug;
 
     create_timestamps(energy_flow_request);
+    find_active_slot();
 
     create_empty_schedule(zero_schedule_req);
 
@@ -72,21 +73,47 @@ void globals_t::create_timestamps(const types::energy::EnergyFlowRequest& energy
     schedule_length = timestamps.size();
 }
 
+void globals_t::find_active_slot() {
+    active_slot = 0;
+
+    if (timestamps.empty() or start_time < timestamps.front()) {
+        // First element already in the future
+        active_slot = 0;
+    } else if (start_time > timestamps.back()) {
+        // Last element in the past
+        active_slot = timestamps.size() - 1;
+    } else {
+        // Somewhere in between
+        for (std::size_t n = 0; n + 1 < timestamps.size(); n++) {
+            if (start_time > timestamps[n] and start_time < timestamps[n + 1]) {
+                active_slot = n;
+                break;
+            }
+        }
+    }
+}
+
+// The schedules carry the timestamps with millisecond resolution, so the time axis uses the same resolution. This
+// keeps the typed time axis identical to the timestamps written into the schedules.
+static date::utc_clock::time_point to_time_axis(const std::string& timestamp) {
+    return std::chrono::time_point_cast<std::chrono::milliseconds>(Everest::Date::from_rfc3339(timestamp));
+}
+
 void globals_t::add_timestamps(const types::energy::EnergyFlowRequest& energy_flow_request) {
     // add local timestamps
-    for (auto t : energy_flow_request.schedule_import) {
+    for (const auto& t : energy_flow_request.schedule_import) {
         // insert current timestamp
-        timestamps.push_back(Everest::Date::from_rfc3339(t.timestamp));
+        timestamps.push_back(to_time_axis(t.timestamp));
     }
 
-    for (auto t : energy_flow_request.schedule_export) {
+    for (const auto& t : energy_flow_request.schedule_export) {
         // insert current timestamp
-        timestamps.push_back(Everest::Date::from_rfc3339(t.timestamp));
+        timestamps.push_back(to_time_axis(t.timestamp));
     }
 
-    for (auto t : energy_flow_request.schedule_setpoints) {
+    for (const auto& t : energy_flow_request.schedule_setpoints) {
         // insert current timestamp
-        timestamps.push_back(Everest::Date::from_rfc3339(t.timestamp));
+        timestamps.push_back(to_time_axis(t.timestamp));
     }
 
     // recurse to all children
@@ -162,33 +189,45 @@ template <typename T> std::optional<T> max_optional(std::optional<T> a, std::opt
     return b;
 }
 
+// Parses the timestamps of a requested schedule once, so that resampling only compares time points
+template <typename T> static std::vector<date::utc_clock::time_point> parse_timestamps(const T& request) {
+    std::vector<date::utc_clock::time_point> parsed;
+    parsed.reserve(request.size());
+    for (const auto& r : request) {
+        parsed.push_back(Everest::Date::from_rfc3339(r.timestamp));
+    }
+    return parsed;
+}
+
+// Returns the index of the entry in the requested schedule that is valid at time tp_a
+static std::size_t find_request_entry(const std::vector<date::utc_clock::time_point>& request,
+                                      date::utc_clock::time_point tp_a) {
+    for (std::size_t ir = 0; ir < request.size(); ir++) {
+        if (ir + 1 == request.size()) {
+            return ir;
+        }
+        if ((tp_a >= request[ir] && tp_a < request[ir + 1]) || (ir == 0 && tp_a < request[ir])) {
+            return ir;
+        }
+    }
+    return 0;
+}
+
 ScheduleSetpoints Market::resample(const ScheduleSetpoints& request) {
 
     ScheduleSetpoints sp = globals.empty_schedule_setpoints;
 
-    // First resample request to the timestamps in available and merge all limits on root sides
-    for (auto& s : sp) {
+    if (request.empty()) {
+        return sp;
+    }
 
-        // find corresponding entry in request
-        auto r = request.begin();
-        auto tp_a = Everest::Date::from_rfc3339(s.timestamp);
-        for (auto ir = request.begin(); ir != request.end(); ir++) {
-            auto tp_r_1 = Everest::Date::from_rfc3339((*ir).timestamp);
-            if ((ir + 1 == request.end())) {
-                r = ir;
-                break;
-            }
-            auto tp_r_2 = Everest::Date::from_rfc3339((*(ir + 1)).timestamp);
-            if ((tp_a >= tp_r_1 && tp_a < tp_r_2) || (ir == request.begin() && tp_a < tp_r_1)) {
-                r = ir;
-                break;
-            }
-        }
+    const auto request_timestamps = parse_timestamps(request);
 
-        if (r != request.end()) {
-            // copy setpoint if any
-            s.setpoint = (*r).setpoint;
-        }
+    // First resample request to the timestamps in available and merge all limits on root sides
+    for (ScheduleSetpoints::size_type i = 0; i < sp.size(); i++) {
+        // find corresponding entry in request and copy setpoint if any
+        const auto& r = request[find_request_entry(request_timestamps, globals.timestamps[i])];
+        sp[i].setpoint = r.setpoint;
     }
 
     return sp;
@@ -198,61 +237,52 @@ ScheduleReq Market::get_max_available_energy(const ScheduleReq& request) {
 
     ScheduleReq available = globals.empty_schedule_req;
 
-    // First resample request to the timestamps in available and merge all limits on root sides
-    for (auto& a : available) {
+    if (request.empty()) {
+        return available;
+    }
 
-        // find corresponding entry in request
-        auto r = request.begin();
-        auto tp_a = Everest::Date::from_rfc3339(a.timestamp);
-        for (auto ir = request.begin(); ir != request.end(); ir++) {
-            auto tp_r_1 = Everest::Date::from_rfc3339((*ir).timestamp);
-            if ((ir + 1 == request.end())) {
-                r = ir;
-                break;
-            }
-            auto tp_r_2 = Everest::Date::from_rfc3339((*(ir + 1)).timestamp);
-            if ((tp_a >= tp_r_1 && tp_a < tp_r_2) || (ir == request.begin() && tp_a < tp_r_1)) {
-                r = ir;
-                break;
-            }
-        }
+    const auto request_timestamps = parse_timestamps(request);
 
-        if (r != request.end()) {
+    // First resample request to the timestamps in available and merge all limits on root sides
+    for (ScheduleReq::size_type i = 0; i < available.size(); i++) {
+        auto& a = available[i];
 
-            {
-                auto leaves_power_W = (*r).limits_to_leaves.total_power_W;
-                if (leaves_power_W.has_value()) {
-                    leaves_power_W.value().value =
-                        leaves_power_W.value().value / (*r).conversion_efficiency.value_or(1.);
-                }
+        // find corresponding entry in request
+        const auto r = request.begin() + find_request_entry(request_timestamps, globals.timestamps[i]);
 
-                a.limits_to_root.total_power_W = min_optional(leaves_power_W, (*r).limits_to_root.total_power_W);
+        {
+            auto leaves_power_W = (*r).limits_to_leaves.total_power_W;
+            if (leaves_power_W.has_value()) {
+                leaves_power_W.value().value = leaves_power_W.value().value / (*r).conversion_efficiency.value_or(1.);
             }
 
-            a.limits_to_root.ac_max_current_A =
-                min_optional((*r).limits_to_leaves.ac_max_current_A, (*r).limits_to_root.ac_max_current_A);
+            a.limits_to_root.total_power_W = min_optional(leaves_power_W, (*r).limits_to_root.total_power_W);
+        }
 
-            a.limits_to_root.ac_min_phase_count =
-                max_optional((*r).limits_to_root.ac_min_phase_count, (*r).limits_to_leaves.ac_min_phase_count);
+        a.limits_to_root.ac_max_current_A =
+            min_optional((*r).limits_to_leaves.ac_max_current_A, (*r).limits_to_root.ac_max_current_A);
 
-            a.limits_to_root.ac_max_phase_count =
-                min_optional((*r).limits_to_root.ac_max_phase_count, (*r).limits_to_leaves.ac_max_phase_count);
+        a.limits_to_root.ac_min_phase_count =
+            max_optional((*r).limits_to_root.ac_min_phase_count, (*r).limits_to_leaves.ac_min_phase_count);
 
-            a.limits_to_root.ac_min_current_A =
-                max_optional((*r).limits_to_root.ac_min_current_A, (*r).limits_to_leaves.ac_min_current_A);
+        a.limits_to_root.ac_max_phase_count =
+            min_optional((*r).limits_to_root.ac_max_phase_count, (*r).limits_to_leaves.ac_max_phase_count);
 
-            // all request limits have been merged on root side in available.
-            // copy other information if any
-            a.price_per_kwh = (*r).price_per_kwh;
-            a.limits_to_root.ac_number_of_active_phases = (*r).limits_to_root.ac_number_of_active_phases;
-        }
+        a.limits_to_root.ac_min_current_A =
+            max_optional((*r).limits_to_root.ac_min_current_A, (*r).limits_to_leaves.ac_min_current_A);
+
+        // all request limits have been merged on root side in available.
+        // copy other information if any
+        a.price_per_kwh = (*r).price_per_kwh;
+        a.limits_to_root.ac_number_of_active_phases = (*r).limits_to_root.ac_number_of_active_phases;
     }
 
     return available;
 }
 
-ScheduleReq Market::get_available_energy(const ScheduleReq& max_available, bool add_sold) {
-    ScheduleReq available = max_available;
+void Market::get_available_energy(const ScheduleReq& max_available, bool add_sold, ScheduleReq& available) {
+    // copy assignment keeps the storage of the buffer, so this does not allocate after the first trading round
+    available = max_available;
     for (ScheduleReq::size_type i = 0; i < available.size(); i++) {
         // FIXME: sold_root is the sum of all energy sold, but we need to limit indivdual paths as well
         // add config option for pure star type of cabling here as well.
@@ -281,15 +311,16 @@ ScheduleReq Market::get_available_energy(const ScheduleReq& max_available, bool
         if (available[i].limits_to_root.total_power_W.has_value())
             available[i].limits_to_root.total_power_W.value().value += sold_watt;
     }
-    return available;
 }
 
-ScheduleReq Market::get_available_energy_import() {
-    return get_available_energy(import_max_available, false);
+const ScheduleReq& Market::get_available_energy_import() {
+    get_available_energy(import_max_available, false, import_available);
+    return import_available;
 }
 
-ScheduleReq Market::get_available_energy_export() {
-    return get_available_energy(export_max_available, true);
+const ScheduleReq& Market::get_available_energy_export() {
+    get_available_energy(export_max_available, true, export_available);
+    return export_available;
 }
 
 float get_watt_from_freq_table(const std::vector<types::energy::FrequencyWattPoint>& table, float freq) {
@@ -31,11 +31,16 @@ public:
     ScheduleRes zero_schedule_res, empty_schedule_res;
     ScheduleSetpoints empty_schedule_setpoints;
 
+    // typed time axis of all schedules: entry i of every schedule starts at timestamps[i]. The RFC 3339 strings in the
+    // schedules are only needed at the interface boundary and should not be parsed again while optimizing.
+    std::vector<date::utc_clock::time_point> timestamps;
+    int active_slot{0}; // index of the slot that contains start_time
+
 private:
     void create_timestamps(const types::energy::EnergyFlowRequest& energy_flow_request);
     void add_timestamps(const types::energy::EnergyFlowRequest& energy_flow_request);
+    void find_active_slot();
     template <typename T> void create_empty_schedule(T& s);
-    std::vector<date::utc_clock::time_point> timestamps;
 };
 
 extern globals_t globals;
@@ -63,8 +68,9 @@ public:
 
     void get_list_of_evses(std::vector<Market*>& list);
     std::vector<Market*> get_list_of_evses();
-    ScheduleReq get_available_energy_import();
-    ScheduleReq get_available_energy_export();
+    // Note: the returned schedules are buffers of this market that are updated on every call
+    const ScheduleReq& get_available_energy_import();
+    const ScheduleReq& get_available_energy_export();
     ScheduleSetpoints get_setpoints() {
         return setpoints;
     };
@@ -89,8 +95,11 @@ private:
     ScheduleRes sold_root;
     std::vector<ScheduleRes> sold_leaves;
 
+    // reused for every offer that is created during the trading rounds
+    ScheduleReq import_available, export_available;
+
     ScheduleReq get_max_available_energy(const ScheduleReq& request);
-    ScheduleReq get_available_energy(const ScheduleReq& available, bool add_sold);
+    void get_available_energy(const ScheduleReq& max_available, bool add_sold, ScheduleReq& available);
     ScheduleSetpoints resample(const ScheduleSetpoints& request);
 };
 
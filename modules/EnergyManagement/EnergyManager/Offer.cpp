@@ -79,6 +79,10 @@ static void apply_limits(ScheduleReq& a, const ScheduleReq& b) {
 }
 
 Offer::Offer(Market& market) {
+    update(market);
+}
+
+void Offer::update(Market& market) {
     // create maximum offer for this market place
     create_offer_for_local_market(market);
 }
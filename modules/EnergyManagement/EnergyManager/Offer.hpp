@@ -13,8 +13,12 @@ namespace module {
 
 class Offer {
 public:
+    Offer() = default;
     Offer(Market& market);
 
+    // Recreates the offer for the local market in place, reusing the schedule buffers of the previous offer
+    void update(Market& market);
+
     std::optional<types::energy::OptimizerTarget> optimizer_target;
     ScheduleReq import_offer, export_offer;
 
@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <benchmark/benchmark.h>
+
+#include "JsonDefinedEnergyManagerTest.hpp"
+
+namespace module {
+
+// Builds synthetic sites from the two EVSE load balancing fixture: the grid connection of the fixture is the root, the
+// EVSEs are copies of the first EVSE of the fixture, grouped in feeders of up to ten EVSEs each.
+class SyntheticSite : public JsonDefinedEnergyManagerTest {
+public:
+    static constexpr int EVSES_PER_FEEDER = 10;
+
+    SyntheticSite(int number_of_evses, int schedule_interval_duration, int schedule_total_duration) {
+        load_test(std::filesystem::path(JSON_TESTS_LOCATION) / "1_0_two_ac_evse_load_balancing.json");
+
+        config.schedule_interval_duration = schedule_interval_duration;
+        config.schedule_total_duration = schedule_total_duration;
+        impl = std::make_unique<EnergyManagerImpl>(config, [](const std::vector<types::energy::EnforcedLimits>&) {});
+
+        const auto evse = request.children.at(0);
+        auto feeder = request;
+        feeder.children.clear();
+        request.children.clear();
+
+        // scale the grid connection with the number of EVSEs, so that all sites need a similar amount of trading rounds
+        scale_limits(request, number_of_evses / 2.);
+
+        for (int i = 0; i < number_of_evses; i++) {
+            if (i % EVSES_PER_FEEDER == 0) {
+                request.children.push_back(feeder);
+                request.children.back().uuid = "feeder_" + std::to_string(i / EVSES_PER_FEEDER);
+                scale_limits(request.children.back(), EVSES_PER_FEEDER / 2.);
+            }
+            auto& e = request.children.back().children.emplace_back(evse);
+            e.uuid = "evse_" + std::to_string(i);
+        }
+    }
+
+    std::vector<types::energy::EnforcedLimits> run() {
+        return impl->run_optimizer(request, start_times.at(0));
+    }
+
+private:
+    static void scale_limits(types::energy::EnergyFlowRequest& node, float factor) {
+        for (auto* schedule : {&node.schedule_import, &node.schedule_export}) {
+            for (auto& entry : *schedule) {
+                for (auto* limits : {&entry.limits_to_root, &entry.limits_to_leaves}) {
+                    if (limits->ac_max_current_A.has_value()) {
+                        limits->ac_max_current_A.value().value *= factor;
+                    }
+                }
+            }
+        }
+    }
+};
+
+} // namespace module
+
+namespace {
+
+// Arguments: number of EVSEs, schedule interval duration in minutes, total schedule duration in hours
+void BM_RunOptimizer(benchmark::State& state) {
+    module::SyntheticSite site(state.range(0), state.range(1), state.range(2));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(site.run());
+    }
+    state.counters["evses"] = state.range(0);
+}
+
+} // namespace
+
+BENCHMARK(BM_RunOptimizer)
+    ->ArgNames({"evses", "interval_min", "duration_h"})
+    ->ArgsProduct({{10, 50, 200}, {60}, {1}})
+    ->Args({10, 15, 24})
+    ->Args({50, 15, 24})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
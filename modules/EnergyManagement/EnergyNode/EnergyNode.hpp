@@ -29,6 +29,7 @@ namespace module {
 struct Conf {
     double fuse_limit_A;
     int phase_count;
+    int update_coalescing_window_ms;
 };
 
 class EnergyNode : public Everest::ModuleBase {
@@ -5,11 +5,27 @@
 #include <chrono>
 #include <date/date.h>
 #include <date/tz.h>
+#include <thread>
 #include <utils/date.hpp>
 
 namespace module {
 namespace energy_grid {
 
+// Check if any node in the subtree set the priority request flag
+static bool contains_priority_request(const types::energy::EnergyFlowRequest& e) {
+    if (e.priority_request.value_or(false)) {
+        return true;
+    }
+
+    for (const auto& c : e.children) {
+        if (contains_priority_request(c)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void energyImpl::init() {
 
     // UUID must be unique also beyond this charging station -> will be handled on framework level and above later
@@ -22,25 +38,16 @@ void energyImpl::init() {
     energy_flow_request.schedule_import = get_local_schedule();
     energy_flow_request.schedule_export = get_local_schedule();
 
-    for (auto& entry : mod->r_energy_consumer) {
-        entry->subscribe_energy_flow_request([this](types::energy::EnergyFlowRequest e) {
-            // Received new energy_flow_request object from a child. Update in the cached object and republish.
-            std::scoped_lock lock(energy_mutex);
-
-            bool child_found = false;
-            for (auto& child : energy_flow_request.children) {
-                if (child.uuid == e.uuid) {
-                    child = e;
-                    child_found = true;
-                }
-            }
-
-            if (!child_found) {
-                energy_flow_request.children.push_back(e);
-            }
-
-            publish_complete_energy_object();
-        });
+    for (std::size_t branch = 0; branch < mod->r_energy_consumer.size(); branch++) {
+        mod->r_energy_consumer[branch]->subscribe_energy_flow_request(
+            [this, branch](types::energy::EnergyFlowRequest e) {
+                // Received new energy_flow_request object from a child. Update in the cached object and republish.
+                const bool priority = contains_priority_request(e);
+                std::scoped_lock lock(energy_mutex);
+                learn_routes(e, branch);
+                update_child(std::move(e));
+                mark_changed(priority);
+            });
     }
 
     if (!mod->r_powermeter.empty()) {
@@ -48,7 +55,7 @@ void energyImpl::init() {
             EVLOG_debug << "Incoming powermeter readings: " << p;
             std::scoped_lock lock(energy_mutex);
             energy_flow_request.energy_usage_root = p;
-            publish_complete_energy_object();
+            mark_changed(false);
         });
     }
 
@@ -58,7 +65,7 @@ void energyImpl::init() {
                 EVLOG_debug << "Incoming price schedule: " << p;
                 std::scoped_lock lock(energy_mutex);
                 energy_pricing = p;
-                publish_complete_energy_object();
+                mark_changed(false);
             });
     }
 }
@@ -122,9 +129,81 @@ void energyImpl::set_external_limits(types::energy::ExternalLimits& l) {
     }
 
     energy_flow_request.schedule_setpoints = l.schedule_setpoints;
+    mark_changed(false);
+}
+
+void energyImpl::update_child(types::energy::EnergyFlowRequest&& e) {
+    const auto it = child_index.find(e.uuid);
+    if (it != child_index.end()) {
+        energy_flow_request.children[it->second] = std::move(e);
+    } else {
+        child_index[e.uuid] = energy_flow_request.children.size();
+        energy_flow_request.children.push_back(std::move(e));
+    }
 }
 
-void energyImpl::publish_complete_energy_object() {
+void energyImpl::learn_routes(const types::energy::EnergyFlowRequest& e, std::size_t branch) {
+    routes[e.uuid] = branch;
+    for (const auto& child : e.children) {
+        learn_routes(child, branch);
+    }
+}
+
+std::optional<std::size_t> energyImpl::find_route(const std::string& uuid) {
+    std::scoped_lock lock(energy_mutex);
+    const auto it = routes.find(uuid);
+    if (it == routes.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void energyImpl::mark_changed(bool priority) {
+    // energy_mutex must be held by the caller
+    version++;
+
+    if (not publisher_started) {
+        // no coalescing, publish every change right away
+        publish_energy_flow_request(get_complete_energy_object());
+        published_version = version;
+        return;
+    }
+
+    if (not publish_pending) {
+        publish_pending = true;
+        first_pending_change = std::chrono::steady_clock::now();
+    }
+    priority_pending = priority_pending or priority;
+    publish_cv.notify_one();
+}
+
+void energyImpl::publisher_loop() {
+    const auto window = std::chrono::milliseconds(mod->config.update_coalescing_window_ms);
+    std::unique_lock<std::mutex> lock(energy_mutex);
+
+    while (true) {
+        publish_cv.wait(lock, [this] { return publish_pending; });
+        // collect further updates until the window is over, a priority request ends the window early
+        publish_cv.wait_until(lock, first_pending_change + window, [this] { return priority_pending; });
+
+        publish_pending = false;
+        priority_pending = false;
+
+        if (version == published_version) {
+            continue;
+        }
+        published_version = version;
+
+        const auto energy_complete = get_complete_energy_object();
+
+        // serialize and publish without blocking incoming updates
+        lock.unlock();
+        publish_energy_flow_request(energy_complete);
+        lock.lock();
+    }
+}
+
+types::energy::EnergyFlowRequest energyImpl::get_complete_energy_object() {
     // join the different schedules to the complete array (with resampling)
     types::energy::EnergyFlowRequest energy_complete = energy_flow_request;
 
@@ -132,7 +211,7 @@ void energyImpl::publish_complete_energy_object() {
         merge_price_into_schedule(energy_complete.schedule_export, energy_pricing.schedule_export);
     }
 
-    publish_energy_flow_request(energy_complete);
+    return energy_complete;
 }
 
 void energyImpl::merge_price_into_schedule(std::vector<types::energy::ScheduleReqEntry>& schedule,
@@ -181,21 +260,64 @@ void energyImpl::merge_price_into_schedule(std::vector<types::energy::ScheduleRe
 }
 
 void energyImpl::ready() {
-    // publish own limits at least once
-    publish_energy_flow_request(energy_flow_request);
+    {
+        // publish own limits at least once
+        std::scoped_lock lock(energy_mutex);
+        publish_energy_flow_request(energy_flow_request);
+        published_version = version;
+
+        if (mod->config.update_coalescing_window_ms > 0) {
+            publisher_started = true;
+            std::thread([this] { publisher_loop(); }).detach();
+        }
+    }
     mod->signalExternalLimit.connect([this](types::energy::ExternalLimits& l) { set_external_limits(l); });
 }
 
 void energyImpl::handle_enforce_limits(types::energy::EnforcedLimits& value) {
 
     // route to children if it is not for me
-    // FIXME: this sends it to all children, we could do a lookup on which branch it actually is
     if (value.uuid != energy_flow_request.uuid) {
+        if (const auto branch = find_route(value.uuid)) {
+            mod->r_energy_consumer[branch.value()]->call_enforce_limits(value);
+            return;
+        }
+
+        // not seen in any energy flow request yet, send it to all children
         for (auto& entry : mod->r_energy_consumer) {
             entry->call_enforce_limits(value);
         }
     }
 };
 
+void energyImpl::handle_enforce_limits_batch(std::vector<types::energy::EnforcedLimits>& value) {
+    // split the batch into one batch per branch
+    std::vector<std::vector<types::energy::EnforcedLimits>> branch_limits(mod->r_energy_consumer.size());
+    {
+        std::scoped_lock lock(energy_mutex);
+        for (auto& limits : value) {
+            if (limits.uuid == energy_flow_request.uuid) {
+                continue;
+            }
+
+            const auto it = routes.find(limits.uuid);
+            if (it != routes.end()) {
+                branch_limits[it->second].push_back(std::move(limits));
+            } else {
+                // not seen in any energy flow request yet, send it to all children
+                for (auto& b : branch_limits) {
+                    b.push_back(limits);
+                }
+            }
+        }
+    }
+
+    for (std::size_t branch = 0; branch < branch_limits.size(); branch++) {
+        if (not branch_limits[branch].empty()) {
+            mod->r_energy_consumer[branch]->call_enforce_limits_batch(branch_limits[branch]);
+        }
+    }
+}
+
 } // namespace energy_grid
 } // namespace module
@@ -14,7 +14,12 @@
 
 // ev@75ac1216-19eb-4182-a85c-820f1fc2c091:v1
 // insert your custom include headers here
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
 #include <mutex>
+#include <optional>
 // ev@75ac1216-19eb-4182-a85c-820f1fc2c091:v1
 
 namespace module {
@@ -35,6 +40,7 @@ public:
 protected:
     // command handler functions (virtual)
     virtual void handle_enforce_limits(types::energy::EnforcedLimits& value) override;
+    virtual void handle_enforce_limits_batch(std::vector<types::energy::EnforcedLimits>& value) override;
 
     // ev@d2d1847a-7b88-41dd-ad07-92785f06f5c4:v1
     // insert your protected definitions here
@@ -51,14 +57,32 @@ private:
     std::mutex energy_mutex;
     // subtree including children
     types::energy::EnergyFlowRequest energy_flow_request;
+    // index of each child uuid in energy_flow_request.children
+    std::map<std::string, std::size_t> child_index;
+    // index into r_energy_consumer of the branch that contains a uuid, learned from the energy flow requests
+    std::map<std::string, std::size_t> routes;
 
     // contains only the pricing informations last update
     types::energy_price_information::EnergyPriceSchedule energy_pricing;
 
+    // incremented on every change of the cached subtree, the publisher only publishes versions not yet sent
+    std::uint64_t version{0};
+    std::uint64_t published_version{0};
+    bool publish_pending{false};
+    bool priority_pending{false};
+    std::chrono::steady_clock::time_point first_pending_change;
+    std::condition_variable publish_cv;
+    bool publisher_started{false};
+
     types::energy::ScheduleReqEntry get_local_schedule_req_entry();
     std::vector<types::energy::ScheduleReqEntry> get_local_schedule();
 
-    void publish_complete_energy_object();
+    void update_child(types::energy::EnergyFlowRequest&& e);
+    void learn_routes(const types::energy::EnergyFlowRequest& e, std::size_t branch);
+    std::optional<std::size_t> find_route(const std::string& uuid);
+    void mark_changed(bool priority);
+    void publisher_loop();
+    types::energy::EnergyFlowRequest get_complete_energy_object();
     void set_external_limits(types::energy::ExternalLimits& l);
     void merge_price_into_schedule(std::vector<types::energy::ScheduleReqEntry>& schedule,
                                    const std::vector<types::energy_price_information::PricePerkWh>& price);
@@ -4,12 +4,11 @@
 #define YETI_SERIAL
 
 #include "yeti.pb.h"
-#include <date/date.h>
-#include <date/tz.h>
+#include <atomic>
+#include <everest/io/mcu_link/mcu_link.hpp>
 #include <sigslot/signal.hpp>
 #include <stdint.h>
-#include <termios.h>
-#include <utils/thread.hpp>
+#include <thread>
 
 class evSerial {
 
@@ -19,10 +18,9 @@ public:
 
     bool openDevice(const char* device, int baud);
     bool is_open() {
-        return fd > 0;
+        return link.is_open();
     };
 
-    void readThread();
     void run();
 
     bool reset(const std::string& reset_chip, const int reset_line);
@@ -46,34 +44,15 @@ public:
     sigslot::signal<> signalConnectionTimeout;
 
 private:
-    // Serial interface
-    bool setSerialAttributes();
-    int fd;
-    int baud;
-
-    // COBS de-/encoder
-    void cobsDecodeReset();
-    void handlePacket(uint8_t* buf, int len);
-    void cobsDecode(uint8_t* buf, int len);
-    void cobsDecodeByte(uint8_t byte);
-    size_t cobsEncode(const void* data, size_t length, uint8_t* buffer);
-    uint8_t msg[2048];
-    uint8_t code;
-    uint8_t block;
-    uint8_t* decode;
-    uint32_t crc32(uint8_t* buf, int len);
-
-    // Read thread for serial port
-    Everest::Thread readThreadHandle;
-    Everest::Thread timeoutDetectionThreadHandle;
-
+    // COBS framed link to the uC, all packets are handled in the event loop of the link
+    void handlePacket(everest::lib::io::mcu_link::mcu_link::payload const& packet);
     bool linkWrite(EverestToMcu* m);
-    volatile bool reset_done_flag;
-    volatile bool forced_reset;
+    everest::lib::io::mcu_link::mcu_link link;
+    std::atomic_bool link_online{false};
+    std::thread link_thread;
 
-    bool serial_timed_out();
-    void timeoutDetectionThread();
-    std::chrono::time_point<date::utc_clock> last_keep_alive_lo_timestamp;
+    std::atomic_bool reset_done_flag{false};
+    std::atomic_bool forced_reset{false};
 };
 
 #endif
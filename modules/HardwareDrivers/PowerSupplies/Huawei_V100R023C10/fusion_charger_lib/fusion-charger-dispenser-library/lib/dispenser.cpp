@@ -52,15 +52,15 @@ void Dispenser::modbus_unsolicitated_event_thread_run() {
 }
 
 void Dispenser::goose_receiver_thread_run() {
+    // reused for all received frames, so receiving does not allocate
+    goose_ethernet::EthernetFrame packet;
+
     while (psu_communication_is_ok()) {
-        auto p = eth_interface.receive_packet();
-        if (!p.has_value()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // waits for a frame with a timeout, no need to sleep
+        if (!eth_interface.receive_packet(packet)) {
             continue;
         }
 
-        auto packet = p.value();
-
         // we are only interested in GOOSE packets and there a other packets
         if (packet.ethertype != goose::frame::GOOSE_ETHERTYPE) {
             continue;
@@ -148,6 +148,7 @@ void Dispenser::modbus_event_loop_thread_run() {
 
     try {
         while (psu_communication_is_ok()) {
+            // returns as soon as data was received, so no additional sleep is needed
             bool data_received = pcl->poll();
             if (data_received) {
                 timeout = std::chrono::steady_clock::now() + dispenser_config.modbus_timeout_ms;
@@ -156,8 +157,6 @@ void Dispenser::modbus_event_loop_thread_run() {
                     throw std::runtime_error("No Modbus data received for " +
                                              std::to_string(dispenser_config.modbus_timeout_ms.count()) + " ms");
                 }
-
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
         }
     } catch (modbus_server::transport_exceptions::ConnectionClosedException& e) {
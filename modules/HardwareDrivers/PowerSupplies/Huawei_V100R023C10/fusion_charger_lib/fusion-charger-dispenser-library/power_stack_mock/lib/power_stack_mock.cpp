@@ -254,10 +254,7 @@ void PowerStackMock::start_modbus_event_loop() {
         psu_printf("Started: Modbus event loop");
         try {
             while (running) {
-                bool poll = pas->poll();
-                if (!poll) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                }
+                pas->poll();
             }
         } catch (const std::exception& e) {
             fail_printf("Exception in event loop: %s", e.what());
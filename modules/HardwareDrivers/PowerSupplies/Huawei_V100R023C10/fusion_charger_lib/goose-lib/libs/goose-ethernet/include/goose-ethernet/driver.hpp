@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #ifdef __APPLE__
@@ -14,22 +15,50 @@
 
 namespace goose_ethernet {
 
+// received raw frame (without crc), only valid until the next receive call
+struct RawFrameView {
+    const std::uint8_t* data;
+    size_t size;
+};
+
 class EthernetInterfaceIntf {
 protected:
     virtual void send_packet_raw(const std::uint8_t* packet, size_t size) = 0;
     virtual std::optional<std::vector<std::uint8_t>> receive_packet_raw() = 0;
 
+    // receive frame blocking into buffer, returns the size of the frame; the
+    // default implementation copies the result of receive_packet_raw()
+    virtual std::optional<size_t> receive_packet_raw_into(std::uint8_t* buffer, size_t buffer_size);
+
+    // receive frame blocking and return a view of it, so it can be
+    // deserialized without an intermediate copy; the default implementation
+    // copies the frame into receive_buffer with receive_packet_raw_into()
+    virtual std::optional<RawFrameView> receive_packet_raw_view();
+
 public:
+    // more than enough for an ethernet frame
+    static const size_t MAX_FRAME_SIZE = 2000;
+
     virtual ~EthernetInterfaceIntf() = default;
 
     // send frame, throws runtime_error on failure or SerializeError if the
     // frame could not be serialized
     void send_packet(const EthernetFrame& frame);
+    // send an already serialized frame (without crc), throws runtime_error on
+    // failure or SerializeError if the frame is too short
+    void send_packet(const std::uint8_t* packet, size_t size);
     // receive frame blocking, throws runtime_error on failure or DeserializeError
     // if the frame could not be deserialized
     std::optional<EthernetFrame> receive_packet();
+    // receive frame blocking into frame, reusing its payload memory; returns
+    // false if no frame was received. Throws like receive_packet()
+    bool receive_packet(EthernetFrame& frame);
 
     virtual const std::uint8_t* get_mac_address() const = 0;
+
+private:
+    // used by the default receive_packet_raw_view(), allocated on first use
+    std::vector<std::uint8_t> receive_buffer;
 };
 
 class EthernetInterface : public EthernetInterfaceIntf {
@@ -39,6 +68,14 @@ protected:
     pcap_t* pcap;
 #else
     int fd;
+
+    // frames received at once with recvmmsg, handed out one by one
+    struct ReceiveBatch;
+    std::unique_ptr<ReceiveBatch> receive_batch;
+
+    std::optional<size_t> receive_packet_raw_into(std::uint8_t* buffer, size_t buffer_size) override;
+    // hands out the frame in place in the recvmmsg batch buffer
+    std::optional<RawFrameView> receive_packet_raw_view() override;
 #endif
 
     void send_packet_raw(const std::uint8_t* packet, size_t size) override;
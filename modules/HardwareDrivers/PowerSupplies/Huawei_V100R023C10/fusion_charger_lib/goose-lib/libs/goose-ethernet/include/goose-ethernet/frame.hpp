@@ -52,6 +52,16 @@ struct EthernetFrame {
      */
     EthernetFrame(const std::vector<std::uint8_t>& data);
 
+    /**
+     * @brief Deserialize into this frame, reusing the memory of the payload
+     *
+     * @param data Ethernet frame data
+     * @param size Size of the data
+     * @throws DeserializeError if the data is too short/long; the frame is left
+     * in an unspecified state then
+     */
+    void deserialize(const std::uint8_t* data, size_t size);
+
     /**
      * @brief Serialize the Ethernet frame with header and payload, without crc
      *
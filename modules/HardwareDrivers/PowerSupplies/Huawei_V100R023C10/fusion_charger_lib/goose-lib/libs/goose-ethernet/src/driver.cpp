@@ -1,6 +1,8 @@
 // SPDX-License-Identifier: Apache-2.0
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <cstring>
 #include <goose-ethernet/driver.hpp>
+#include <stdexcept>
 
 using namespace goose_ethernet;
 
@@ -9,13 +11,52 @@ void EthernetInterfaceIntf::send_packet(const EthernetFrame& frame) {
     this->send_packet_raw(serialized.data(), serialized.size());
 }
 
-std::optional<EthernetFrame> EthernetInterfaceIntf::receive_packet() {
+void EthernetInterfaceIntf::send_packet(const std::uint8_t* packet, size_t size) {
+    if (size < 60) {
+        throw SerializeError("Ethernet frame too short (size < 60)");
+    }
+    this->send_packet_raw(packet, size);
+}
+
+std::optional<size_t> EthernetInterfaceIntf::receive_packet_raw_into(std::uint8_t* buffer, size_t buffer_size) {
     auto received = this->receive_packet_raw();
     if (!received.has_value()) {
         return std::nullopt;
     }
-    if (received.value().size() < 60) {
+    if (received.value().size() > buffer_size) {
+        throw std::runtime_error("Received frame does not fit into receive buffer");
+    }
+    memcpy(buffer, received.value().data(), received.value().size());
+    return received.value().size();
+}
+
+std::optional<RawFrameView> EthernetInterfaceIntf::receive_packet_raw_view() {
+    if (this->receive_buffer.empty()) {
+        this->receive_buffer.resize(MAX_FRAME_SIZE);
+    }
+    auto size = this->receive_packet_raw_into(this->receive_buffer.data(), this->receive_buffer.size());
+    if (!size.has_value()) {
         return std::nullopt;
     }
-    return EthernetFrame(received.value());
+    return RawFrameView{this->receive_buffer.data(), size.value()};
+}
+
+std::optional<EthernetFrame> EthernetInterfaceIntf::receive_packet() {
+    EthernetFrame frame;
+    if (!receive_packet(frame)) {
+        return std::nullopt;
+    }
+    return frame;
+}
+
+bool EthernetInterfaceIntf::receive_packet(EthernetFrame& frame) {
+    auto view = this->receive_packet_raw_view();
+    if (!view.has_value()) {
+        return false;
+    }
+    if (view->size < 60) {
+        return false;
+    }
+    frame.deserialize(view->data, view->size);
+    return true;
 }
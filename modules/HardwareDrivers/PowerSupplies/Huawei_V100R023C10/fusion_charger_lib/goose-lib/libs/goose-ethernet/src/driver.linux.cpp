@@ -23,7 +23,29 @@
 
 using namespace goose_ethernet;
 
-EthernetInterface::EthernetInterface(const char* interface_name) {
+// number of frames fetched with one recvmmsg call
+static const size_t RECEIVE_BATCH_SIZE = 16;
+
+struct EthernetInterface::ReceiveBatch {
+    std::uint8_t buffers[RECEIVE_BATCH_SIZE][MAX_FRAME_SIZE];
+    struct iovec iovecs[RECEIVE_BATCH_SIZE];
+    struct mmsghdr messages[RECEIVE_BATCH_SIZE];
+
+    size_t count = 0; // number of frames received by the last recvmmsg call
+    size_t next = 0;  // index of the next frame to hand out
+
+    ReceiveBatch() {
+        memset(messages, 0, sizeof(messages));
+        for (size_t i = 0; i < RECEIVE_BATCH_SIZE; i++) {
+            iovecs[i].iov_base = buffers[i];
+            iovecs[i].iov_len = MAX_FRAME_SIZE;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+    }
+};
+
+EthernetInterface::EthernetInterface(const char* interface_name) : receive_batch(std::make_unique<ReceiveBatch>()) {
     this->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
     if (this->fd == -1) {
         throw std::runtime_error("Failed to open socket for ethernet interface: " + std::string(interface_name) +
@@ -97,30 +119,68 @@ void EthernetInterface::send_packet_raw(const std::uint8_t* packet, size_t size)
 }
 
 std::optional<std::vector<std::uint8_t>> EthernetInterface::receive_packet_raw() {
-    std::vector<std::uint8_t> buffer(2000); // more than enough for an ethernet frame
-                                            //
-                                            //
-    struct pollfd pfd[1];
-    pfd[0].fd = this->fd;
-    pfd[0].events = POLLIN;
-
-    auto result_code = poll(pfd, 1, 50);
-    auto error = errno;
-    if (result_code < 0) {
-        throw std::runtime_error("Failed to poll ethernet frame, errno: " + std::to_string(error));
+    std::vector<std::uint8_t> buffer(MAX_FRAME_SIZE);
+    auto size = receive_packet_raw_into(buffer.data(), buffer.size());
+    if (!size.has_value()) {
+        return std::nullopt;
     }
 
-    if (result_code == 0) {
+    buffer.resize(size.value());
+    return buffer;
+}
+
+std::optional<size_t> EthernetInterface::receive_packet_raw_into(std::uint8_t* buffer, size_t buffer_size) {
+    auto view = receive_packet_raw_view();
+    if (!view.has_value()) {
         return std::nullopt;
     }
+    if (view->size > buffer_size) {
+        throw std::runtime_error("Received frame does not fit into receive buffer");
+    }
+    memcpy(buffer, view->data, view->size);
+    return view->size;
+}
 
-    ssize_t ret = read(this->fd, buffer.data(), buffer.size());
-    if (ret == -1) {
-        throw std::runtime_error("Failed to receive packet, errno: " + std::to_string(errno));
+std::optional<RawFrameView> EthernetInterface::receive_packet_raw_view() {
+    auto& batch = *this->receive_batch;
+
+    // fetch all frames that are waiting with a single syscall, and hand them
+    // out one by one in the following calls
+    if (batch.next == batch.count) {
+        struct pollfd pfd[1];
+        pfd[0].fd = this->fd;
+        pfd[0].events = POLLIN;
+
+        auto result_code = poll(pfd, 1, 50);
+        auto error = errno;
+        if (result_code < 0) {
+            throw std::runtime_error("Failed to poll ethernet frame, errno: " + std::to_string(error));
+        }
+
+        if (result_code == 0) {
+            return std::nullopt;
+        }
+
+        int ret = recvmmsg(this->fd, batch.messages, RECEIVE_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (ret == -1) {
+            error = errno;
+            if (error == EAGAIN || error == EWOULDBLOCK) {
+                return std::nullopt;
+            }
+            throw std::runtime_error("Failed to receive packet, errno: " + std::to_string(error));
+        }
+
+        batch.count = ret;
+        batch.next = 0;
+        if (batch.count == 0) {
+            return std::nullopt;
+        }
     }
 
-    buffer.resize(ret);
-    return buffer;
+    // the buffer of this frame is only reused by the next recvmmsg call,
+    // which happens after all frames of the batch have been handed out
+    size_t index = batch.next++;
+    return RawFrameView{batch.buffers[index], batch.messages[index].msg_len};
 }
 
 const std::uint8_t* EthernetInterface::get_mac_address() const {
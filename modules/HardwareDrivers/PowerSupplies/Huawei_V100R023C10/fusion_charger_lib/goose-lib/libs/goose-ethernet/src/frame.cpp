@@ -6,6 +6,10 @@
 using namespace goose_ethernet;
 
 EthernetFrame::EthernetFrame(const std::uint8_t* data, size_t size) {
+    deserialize(data, size);
+}
+
+void EthernetFrame::deserialize(const std::uint8_t* data, size_t size) {
     // minimum size of a normal ethernet frame is 64 bytes, without crc it is 60
     if (size < 60) {
         throw DeserializeError("Ethernet frame too short (size < 60)");
@@ -17,10 +21,10 @@ EthernetFrame::EthernetFrame(const std::uint8_t* data, size_t size) {
     if (ethertype == 0x8100) {
         eth_802_1q_tag = (data[14] << 8) | data[15];
         ethertype = (data[16] << 8) | data[17];
-        payload = std::vector<std::uint8_t>(data + 18, data + size);
+        payload.assign(data + 18, data + size);
     } else {
         eth_802_1q_tag = std::nullopt;
-        payload = std::vector<std::uint8_t>(data + 14, data + size);
+        payload.assign(data + 14, data + size);
     }
 
     // todo: check if redundant
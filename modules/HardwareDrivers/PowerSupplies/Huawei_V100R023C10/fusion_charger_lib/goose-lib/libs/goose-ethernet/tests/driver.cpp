@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <goose-ethernet/driver.hpp>
+#include <thread>
+
+using namespace goose_ethernet;
+
+class QueueEthernetInterface : public EthernetInterfaceIntf {
+public:
+    std::deque<std::vector<std::uint8_t>> received;
+    std::vector<std::vector<std::uint8_t>> sent;
+
+protected:
+    void send_packet_raw(const std::uint8_t* packet, size_t size) override {
+        sent.emplace_back(packet, packet + size);
+    }
+
+    std::optional<std::vector<std::uint8_t>> receive_packet_raw() override {
+        if (received.empty()) {
+            return std::nullopt;
+        }
+        auto packet = received.front();
+        received.pop_front();
+        return packet;
+    }
+
+public:
+    const std::uint8_t* get_mac_address() const override {
+        return nullptr;
+    }
+};
+
+static std::vector<std::uint8_t> test_frame(std::uint8_t marker, size_t size = 60) {
+    std::vector<std::uint8_t> frame(size);
+    memset(frame.data(), 0xff, 6);
+    frame[12] = 0x88;
+    frame[13] = 0xb8;
+    frame[14] = marker;
+    return frame;
+}
+
+TEST(EthernetInterfaceIntf, receive_into_frame) {
+    QueueEthernetInterface intf;
+    intf.received.push_back(test_frame(1, 100));
+    intf.received.push_back(test_frame(2, 20)); // too short, dropped
+    intf.received.push_back(test_frame(3));
+
+    EthernetFrame frame;
+    ASSERT_TRUE(intf.receive_packet(frame));
+    EXPECT_EQ(frame.ethertype, 0x88b8);
+    EXPECT_EQ(frame.payload.size(), 86);
+    EXPECT_EQ(frame.payload[0], 1);
+
+    ASSERT_FALSE(intf.receive_packet(frame));
+
+    // the payload memory of the previous frame is reused
+    auto payload_data = frame.payload.data();
+    ASSERT_TRUE(intf.receive_packet(frame));
+    EXPECT_EQ(frame.payload.size(), 46);
+    EXPECT_EQ(frame.payload[0], 3);
+    EXPECT_EQ(frame.payload.data(), payload_data);
+
+    ASSERT_FALSE(intf.receive_packet(frame));
+}
+
+// hands out frames in place, like the batched linux receive path
+class ViewEthernetInterface : public QueueEthernetInterface {
+public:
+    std::vector<std::uint8_t> batch;
+    size_t raw_into_calls = 0;
+
+protected:
+    std::optional<size_t> receive_packet_raw_into(std::uint8_t* buffer, size_t buffer_size) override {
+        raw_into_calls++;
+        return QueueEthernetInterface::receive_packet_raw_into(buffer, buffer_size);
+    }
+
+    std::optional<RawFrameView> receive_packet_raw_view() override {
+        if (batch.empty()) {
+            return std::nullopt;
+        }
+        return RawFrameView{batch.data(), batch.size()};
+    }
+};
+
+TEST(EthernetInterfaceIntf, receive_from_view) {
+    ViewEthernetInterface intf;
+    intf.batch = test_frame(7, 80);
+
+    EthernetFrame frame;
+    ASSERT_TRUE(intf.receive_packet(frame));
+    EXPECT_EQ(frame.ethertype, 0x88b8);
+    EXPECT_EQ(frame.payload.size(), 66);
+    EXPECT_EQ(frame.payload[0], 7);
+    // deserialized directly from the view, without copying into a buffer first
+    EXPECT_EQ(intf.raw_into_calls, 0);
+
+    intf.batch = test_frame(8, 20); // too short, dropped
+    ASSERT_FALSE(intf.receive_packet(frame));
+}
+
+TEST(EthernetInterfaceIntf, send_serialized_frame) {
+    QueueEthernetInterface intf;
+    auto frame = test_frame(1);
+
+    intf.send_packet(frame.data(), frame.size());
+    ASSERT_EQ(intf.sent.size(), 1);
+    ASSERT_EQ(intf.sent[0], frame);
+
+    ASSERT_THROW(intf.send_packet(frame.data(), 59), SerializeError);
+}
+
+#ifdef __linux__
+
+// Sends frames between the two ends of a veth pair; needs CAP_NET_ADMIN to
+// create the pair and CAP_NET_RAW to open the interfaces, skipped otherwise
+class VethPair : public ::testing::Test {
+protected:
+    static constexpr const char* A = "goosetest0";
+    static constexpr const char* B = "goosetest1";
+
+    void SetUp() override {
+        std::system("ip link delete goosetest0 > /dev/null 2>&1");
+        if (std::system("ip link add goosetest0 type veth peer name goosetest1 > /dev/null 2>&1") != 0 ||
+            std::system("ip link set goosetest0 up > /dev/null 2>&1") != 0 ||
+            std::system("ip link set goosetest1 up > /dev/null 2>&1") != 0) {
+            GTEST_SKIP() << "Could not create veth pair";
+        }
+
+        // wait until the link is up, frames sent before are dropped
+        for (int i = 0; i < 100; i++) {
+            std::ifstream operstate(std::string("/sys/class/net/") + B + "/operstate");
+            std::string state;
+            operstate >> state;
+            if (state == "up") {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    void TearDown() override {
+        std::system("ip link delete goosetest0 > /dev/null 2>&1");
+    }
+};
+
+TEST_F(VethPair, burst_is_received_in_order) {
+    EthernetInterface sender(A);
+    EthernetInterface receiver(B);
+
+    const int frame_count = 100;
+    std::vector<std::uint8_t> frame = test_frame(0, 200);
+    memcpy(frame.data() + 6, sender.get_mac_address(), 6);
+
+    // not a GOOSE frame, filtered by the interface
+    std::vector<std::uint8_t> other_frame = frame;
+    other_frame[12] = 0x08;
+    other_frame[13] = 0x00;
+    sender.send_packet(other_frame.data(), other_frame.size());
+
+    for (int i = 0; i < frame_count; i++) {
+        frame[14] = i;
+        sender.send_packet(frame.data(), frame.size());
+    }
+
+    EthernetFrame received;
+    int next = 0;
+    auto end_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (next < frame_count && std::chrono::steady_clock::now() < end_time) {
+        if (!receiver.receive_packet(received)) {
+            continue;
+        }
+        ASSERT_EQ(received.ethertype, 0x88b8);
+        // ignore frames from others, e.g. queued before the socket was bound
+        if (memcmp(received.source, sender.get_mac_address(), 6) != 0) {
+            continue;
+        }
+        ASSERT_EQ(received.payload.size(), 186);
+        ASSERT_EQ(received.payload[0], next);
+        next++;
+    }
+
+    ASSERT_EQ(next, frame_count);
+}
+
+#endif
@@ -19,14 +19,97 @@ template <typename T> std::vector<std::uint8_t> encode_be(T value) {
     return result;
 }
 
-template <typename T> T decode_be(const std::vector<std::uint8_t>& input) {
+template <typename T> T decode_be(const std::uint8_t* input, size_t size) {
     T result = 0;
-    for (size_t i = 0; i < sizeof(T) && i < input.size(); i++) {
+    for (size_t i = 0; i < sizeof(T) && i < size; i++) {
         result = (result << 8) | input[i];
     }
     return result;
 }
 
+template <typename T> T decode_be(const std::vector<std::uint8_t>& input) {
+    return decode_be<T>(input.data(), input.size());
+}
+
+/**
+ * @brief Write \p value big endian into \p output, which has to hold \c sizeof(T) bytes
+ */
+template <typename T> void encode_be(T value, std::uint8_t* output) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        output[i] = (value >> (8 * (sizeof(T) - i - 1))) & 0xFF;
+    }
+}
+
+/**
+ * @brief Non-owning view of a decoded BER entry; points into the decoded buffer
+ */
+struct BERView {
+    std::uint8_t tag;
+    const std::uint8_t* value;
+    size_t length;
+};
+
+/**
+ * @brief Non-allocating decoder reading BER entries one after another from a
+ * buffer
+ *
+ * @note the buffer must outlive the reader and all views returned by it
+ */
+class BERReader {
+    const std::uint8_t* data;
+    size_t remaining;
+
+public:
+    BERReader(const std::uint8_t* data, size_t size) : data(data), remaining(size) {
+    }
+
+    /**
+     * @brief Reader over the value of \p entry, e.g. to decode the entries of a
+     * constructed entry
+     */
+    BERReader(const BERView& entry) : BERReader(entry.value, entry.length) {
+    }
+
+    /**
+     * @brief Decode the next entry
+     *
+     * @throws std::runtime_error if the input is too short
+     */
+    BERView next();
+
+    /**
+     * @brief Decode the next entry and check its tag
+     *
+     * @throws std::runtime_error if the input is too short or the tag does not
+     * match
+     */
+    BERView next(std::uint8_t expected_tag);
+
+    /**
+     * @brief Decode the next entry as big endian integer, see \c
+     * PrimitiveBEREntry
+     *
+     * @throws std::runtime_error if the input is too short, the tag does not
+     * match or the value does not fit into \c T
+     */
+    template <typename T> T next_primitive(std::uint8_t expected_tag) {
+        auto entry = next(expected_tag);
+        if (entry.length > sizeof(T)) {
+            throw std::runtime_error("BERReader: value size too big mismatch");
+        }
+        return decode_be<T>(entry.value, entry.length);
+    }
+
+    // Pointer to the first byte that was not read yet
+    const std::uint8_t* position() const {
+        return data;
+    }
+
+    bool empty() const {
+        return remaining == 0;
+    }
+};
+
 struct BEREntry {
     std::uint8_t tag;
     std::vector<std::uint8_t> value;
@@ -34,6 +117,8 @@ struct BEREntry {
     BEREntry() = default;
     BEREntry(std::uint8_t tag, std::vector<std::uint8_t> value) : tag(tag), value(value) {
     }
+    BEREntry(const BERView& view) : tag(view.tag), value(view.value, view.value + view.length) {
+    }
 
     /**
      * @brief Input-modifying decoding constructor; removes read bytes from input
@@ -33,7 +33,18 @@ struct GooseTimestamp {
 
     GooseTimestamp(const std::vector<std::uint8_t>& raw);
 
+    /**
+     * @param raw 8 bytes encoded timestamp
+     * @param size size of \p raw, must be 8
+     */
+    GooseTimestamp(const std::uint8_t* raw, size_t size);
+
     std::vector<std::uint8_t> encode() const;
+
+    /**
+     * @brief Encode the timestamp into \p output, which has to hold 8 bytes
+     */
+    void encode(std::uint8_t* output) const;
     float to_ms();
     bool operator==(const GooseTimestamp& other) const;
 
@@ -68,6 +79,15 @@ struct GoosePDU {
     GoosePDU() = default;
     GoosePDU(const std::vector<std::uint8_t>& pdu);
 
+    /**
+     * @brief Decode the PDU directly from \p pdu without copying the
+     * undecoded data
+     *
+     * @param pdu BER encoded PDU
+     * @param size size of \p pdu, has to match the encoded PDU exactly
+     */
+    GoosePDU(const std::uint8_t* pdu, size_t size);
+
     std::vector<std::uint8_t> serialize() const;
 };
 
@@ -122,5 +142,48 @@ public:
     goose_ethernet::EthernetFrame serialize(std::vector<std::uint8_t> hmac_key) const;
 };
 
+/**
+ * @brief Serialized GOOSE frame whose per transmission fields are patched in
+ * place
+ *
+ * The frame is encoded once. st_num, sq_num and the timestamp are always
+ * encoded with a fixed size, so they are overwritten without encoding the PDU
+ * again. For secure frames the HMAC is recalculated when the frame is fetched
+ * after a change.
+ */
+class GooseFrameTemplate {
+protected:
+    std::vector<std::uint8_t> data;
+    size_t timestamp_offset;
+    size_t st_num_offset;
+    size_t sq_num_offset;
+
+    std::optional<std::vector<std::uint8_t>> hmac_key;
+    bool hmac_outdated = false;
+
+    void locate_fields();
+
+public:
+    /**
+     * @throws goose_ethernet::SerializeError if the frame can not be serialized
+     */
+    GooseFrameTemplate(const GooseFrame& frame);
+
+    /**
+     * @throws goose_ethernet::SerializeError if the frame can not be serialized
+     */
+    GooseFrameTemplate(const SecureGooseFrame& frame, std::vector<std::uint8_t> hmac_key);
+
+    void set_timestamp(const GooseTimestamp& timestamp);
+    void set_st_num(std::uint32_t st_num);
+    void set_sq_num(std::uint32_t sq_num);
+
+    /**
+     * @brief The serialized ethernet frame (without crc) with all patched
+     * fields; valid until the template is modified
+     */
+    const std::vector<std::uint8_t>& get_data();
+};
+
 } // namespace frame
 } // namespace goose
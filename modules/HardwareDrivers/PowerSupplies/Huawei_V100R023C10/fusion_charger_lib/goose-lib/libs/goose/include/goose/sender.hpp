@@ -26,11 +26,28 @@ public:
     virtual ~SendPacketIntf() = default;
 
     virtual goose_ethernet::EthernetFrame build_packet(const PerPacketInfo& info) = 0;
+
+    /**
+     * @brief Build the serialized frame for a single transmission; the
+     * returned data is valid until the next call
+     *
+     * The default implementation serializes the frame returned by \c
+     * build_packet
+     */
+    virtual const std::vector<std::uint8_t>& build_raw_packet(const PerPacketInfo& info) {
+        raw_packet = build_packet(info).serialize();
+        return raw_packet;
+    }
+
+protected:
+    std::vector<std::uint8_t> raw_packet;
 };
 
 class SendPacketNormal : public SendPacketIntf {
 protected:
     goose::frame::GooseFrame frame;
+    // created on the first transmission, retransmissions only patch it
+    std::optional<goose::frame::GooseFrameTemplate> frame_template;
 
 public:
     SendPacketNormal(goose::frame::GooseFrame frame) : frame(frame) {
@@ -40,12 +57,23 @@ public:
         frame.pdu.sq_num = info.sq_num;
         return frame.serialize();
     }
+
+    const std::vector<std::uint8_t>& build_raw_packet(const PerPacketInfo& info) override {
+        if (!frame_template.has_value()) {
+            frame_template.emplace(frame);
+        }
+        frame_template->set_st_num(info.st_num);
+        frame_template->set_sq_num(info.sq_num);
+        return frame_template->get_data();
+    }
 };
 
 class SendPacketSecure : public SendPacketIntf {
 protected:
     goose::frame::SecureGooseFrame frame;
     std::vector<std::uint8_t> hmac_key;
+    // created on the first transmission, retransmissions only patch it
+    std::optional<goose::frame::GooseFrameTemplate> frame_template;
 
 public:
     SendPacketSecure(goose::frame::SecureGooseFrame frame, std::vector<std::uint8_t> hmac_key) :
@@ -57,6 +85,15 @@ public:
         frame.pdu.sq_num = info.sq_num;
         return frame.serialize(hmac_key);
     }
+
+    const std::vector<std::uint8_t>& build_raw_packet(const PerPacketInfo& info) override {
+        if (!frame_template.has_value()) {
+            frame_template.emplace(frame, hmac_key);
+        }
+        frame_template->set_st_num(info.st_num);
+        frame_template->set_sq_num(info.sq_num);
+        return frame_template->get_data();
+    }
 };
 
 class SenderIntf {
@@ -106,6 +143,9 @@ protected:
     std::vector<std::chrono::milliseconds> ts;
 
     size_t current_ts_index = 0;
+    // the delays are measured from the scheduled time of the last transmission,
+    // so the time needed to send does not add up
+    std::chrono::steady_clock::time_point last_send_time;
 
     std::optional<std::thread> thread;
     bool stop_flag = false;
@@ -6,43 +6,66 @@ namespace goose {
 namespace frame {
 namespace ber {
 
-BEREntry::BEREntry(std::vector<std::uint8_t>* input) {
-    if (input == nullptr) {
-        throw std::runtime_error("BEREntry: input is nullptr");
-    }
-
-    if (input->size() < 2) {
+BERView BERReader::next() {
+    if (remaining < 2) {
         throw std::runtime_error("BEREntry: input has no tag or length");
     }
 
-    tag = (*input)[0];
+    BERView entry;
+    entry.tag = data[0];
     std::uint8_t length_octets;
     size_t length;
 
-    if ((*input)[1] & 0x80) {
-        length_octets = (*input)[1] & 0x7F;
+    if (data[1] & 0x80) {
+        length_octets = data[1] & 0x7F;
         length = 0;
-        if (length_octets > input->size() - 2) {
+        if (length_octets > remaining - 2) {
             throw std::runtime_error("BEREntry: input too short, length octets missing");
         }
 
         for (size_t i = 0; i < length_octets; i++) {
-            length = (length << 8) | (*input)[2 + i];
+            length = (length << 8) | data[2 + i];
         }
     } else {
         length_octets = 0;
-        length = (*input)[1];
+        length = data[1];
     }
 
-    // Remove tag and length bytes
-    input->erase(input->begin(), input->begin() + 2 + length_octets);
+    // Skip tag and length bytes
+    data += 2 + length_octets;
+    remaining -= 2 + length_octets;
 
-    // Copy and remove value bytes
-    if (length > input->size()) {
+    if (length > remaining) {
         throw std::runtime_error("BEREntry: input too short, payload missing");
     }
-    value.insert(value.end(), input->begin(), input->begin() + length);
-    input->erase(input->begin(), input->begin() + length);
+    entry.value = data;
+    entry.length = length;
+
+    data += length;
+    remaining -= length;
+    return entry;
+}
+
+BERView BERReader::next(std::uint8_t expected_tag) {
+    auto entry = next();
+    if (entry.tag != expected_tag) {
+        throw std::runtime_error("BERReader: tag mismatch");
+    }
+    return entry;
+}
+
+BEREntry::BEREntry(std::vector<std::uint8_t>* input) {
+    if (input == nullptr) {
+        throw std::runtime_error("BEREntry: input is nullptr");
+    }
+
+    BERReader reader(input->data(), input->size());
+    auto entry = reader.next();
+    tag = entry.tag;
+    value.assign(entry.value, entry.value + entry.length);
+
+    // Remove the read bytes
+    input->erase(input->begin(), input->begin() + (reader.position() - input->data()));
 }
 
 void BEREntry::add(const BEREntry& entry) {
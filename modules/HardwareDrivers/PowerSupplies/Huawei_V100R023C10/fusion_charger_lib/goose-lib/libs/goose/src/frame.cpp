@@ -7,8 +7,11 @@
 
 using namespace goose::frame;
 
-GooseTimestamp::GooseTimestamp(const std::vector<std::uint8_t>& raw) {
-    if (raw.size() != 8) {
+GooseTimestamp::GooseTimestamp(const std::vector<std::uint8_t>& raw) : GooseTimestamp(raw.data(), raw.size()) {
+}
+
+GooseTimestamp::GooseTimestamp(const std::uint8_t* raw, size_t size) {
+    if (size != 8) {
         throw std::runtime_error("GooseTimestamp: raw data is not 8 bytes");
     }
 
@@ -26,14 +29,19 @@ GooseTimestamp::GooseTimestamp(const std::vector<std::uint8_t>& raw) {
 }
 
 std::vector<std::uint8_t> GooseTimestamp::encode() const {
-    std::vector<std::uint8_t> result;
-    auto seconds_be = ber::encode_be(seconds);
-    auto fraction_be = ber::encode_be(fraction);
-    result.insert(result.end(), seconds_be.begin(), seconds_be.end());
-    result.insert(result.end(), fraction_be.begin() + 1, fraction_be.end());
-    result.push_back(quality_of_time);
+    std::vector<std::uint8_t> result(8);
+    encode(result.data());
     return result;
 }
+
+void GooseTimestamp::encode(std::uint8_t* output) const {
+    ber::encode_be(seconds, output);
+    output[4] = (fraction >> 16) & 0xFF;
+    output[5] = (fraction >> 8) & 0xFF;
+    output[6] = fraction & 0xFF;
+    output[7] = quality_of_time;
+}
+
 float GooseTimestamp::to_ms() {
     return static_cast<std::uint64_t>(seconds) * 1000 + (static_cast<std::uint64_t>(fraction) * 1000) / 0x1000000;
 }
@@ -59,107 +67,94 @@ bool GooseTimestamp::operator==(const GooseTimestamp& other) const {
     return seconds == other.seconds && fraction == other.fraction && quality_of_time == other.quality_of_time;
 }
 
-GoosePDU::GoosePDU(const std::vector<std::uint8_t>& pdu) {
-    auto pdu_c = pdu;
-    goose::frame::ber::BEREntry root(&pdu_c);
+// Copy a visible string entry into a fixed size, null terminated buffer
+static void copy_visible_string(char (&destination)[65], const goose::frame::ber::BERView& entry, const char* name) {
+    if (entry.length > 65) { // todo: check length
+        throw std::runtime_error(std::string("GoosePDU: ") + name + " is too long");
+    }
+    memcpy(destination, entry.value, entry.length);
+    if (entry.length < 65) {
+        destination[entry.length] = '\0';
+    }
+}
+
+GoosePDU::GoosePDU(const std::vector<std::uint8_t>& pdu) : GoosePDU(pdu.data(), pdu.size()) {
+}
+
+GoosePDU::GoosePDU(const std::uint8_t* pdu, size_t size) {
+    ber::BERReader pdu_reader(pdu, size);
+    auto root = pdu_reader.next();
     if (root.tag != 0x61) {
         throw std::runtime_error("GoosePDU: root tag is not 0x61");
     }
 
-    if (pdu_c.size() > 0) {
+    if (!pdu_reader.empty()) {
         throw std::runtime_error("GoosePDU: received extra data, that is not part of BER encoded "
                                  "region");
     }
 
-    auto root_value = root.value;
+    ber::BERReader root_reader(root);
 
     // go_cb_ref
-    goose::frame::ber::BEREntry go_cb_ref_entry(&root_value);
+    auto go_cb_ref_entry = root_reader.next();
     if (go_cb_ref_entry.tag != 0x80) {
         throw std::runtime_error("GoosePDU: go_cb_ref tag is not 0x80");
     }
-    if (go_cb_ref_entry.value.size() > 65) { // todo: check length
-        throw std::runtime_error("GoosePDU: go_cb_ref is too long");
-    }
-    memcpy(go_cb_ref, go_cb_ref_entry.value.data(), go_cb_ref_entry.value.size());
+    copy_visible_string(go_cb_ref, go_cb_ref_entry, "go_cb_ref");
 
     // time_allowed_to_live
-    ber::PrimitiveBEREntry<std::uint32_t> time_allowed_to_live_entry(root_value, 0x81);
-    time_allowed_to_live = time_allowed_to_live_entry.data;
+    time_allowed_to_live = root_reader.next_primitive<std::uint32_t>(0x81);
 
     // dat_set
-    goose::frame::ber::BEREntry dat_set_entry(&root_value);
+    auto dat_set_entry = root_reader.next();
     if (dat_set_entry.tag != 0x82) {
         throw std::runtime_error("GoosePDU: dat_set tag is not 0x82");
     }
-    if (dat_set_entry.value.size() > 65) { // todo: check length
-        throw std::runtime_error("GoosePDU: dat_set is too long");
-    }
-    memcpy(dat_set, dat_set_entry.value.data(), dat_set_entry.value.size());
+    copy_visible_string(dat_set, dat_set_entry, "dat_set");
 
     // go_id
-    goose::frame::ber::BEREntry go_id_entry(&root_value);
+    auto go_id_entry = root_reader.next();
     if (go_id_entry.tag != 0x83) {
         throw std::runtime_error("GoosePDU: go_id tag is not 0x83");
     }
-    if (go_id_entry.value.size() > 65) { // todo: check length
-        throw std::runtime_error("GoosePDU: go_id is too long");
-    }
-    memcpy(go_id, go_id_entry.value.data(), go_id_entry.value.size());
+    copy_visible_string(go_id, go_id_entry, "go_id");
 
     // timestamp
-    goose::frame::ber::BEREntry timestamp_entry(&root_value);
+    auto timestamp_entry = root_reader.next();
     if (timestamp_entry.tag != 0x84) {
         throw std::runtime_error("GoosePDU: timestamp tag is not 0x84");
     }
-    if (timestamp_entry.value.size() != 8) {
+    if (timestamp_entry.length != 8) {
         throw std::runtime_error("GoosePDU: timestamp is not 8 bytes");
     }
-    timestamp = GooseTimestamp(timestamp_entry.value);
-
-    // st_num
-    ber::PrimitiveBEREntry<std::uint32_t> st_num_entry(root_value, 0x85);
-    st_num = st_num_entry.data;
-
-    // sq_num
-    ber::PrimitiveBEREntry<std::uint32_t> sq_num_entry(root_value, 0x86);
-    sq_num = sq_num_entry.data;
-
-    // simulation
-    ber::PrimitiveBEREntry<std::uint8_t> simulation_entry(root_value, 0x87);
-    simulation = simulation_entry.data;
-
-    // conf_rev
-    ber::PrimitiveBEREntry<std::uint32_t> conf_rev_entry(root_value, 0x88);
-    conf_rev = conf_rev_entry.data;
-
-    // ndsCom
-    ber::PrimitiveBEREntry<std::uint8_t> ndsCom_entry(root_value, 0x89);
-    ndsCom = ndsCom_entry.data;
+    timestamp = GooseTimestamp(timestamp_entry.value, timestamp_entry.length);
 
-    // apdu count
-    ber::PrimitiveBEREntry<std::uint32_t> apdu_count_entry(root_value, 0x8A);
-    auto apdu_entry_count = apdu_count_entry.data;
+    st_num = root_reader.next_primitive<std::uint32_t>(0x85);
+    sq_num = root_reader.next_primitive<std::uint32_t>(0x86);
+    simulation = root_reader.next_primitive<std::uint8_t>(0x87);
+    conf_rev = root_reader.next_primitive<std::uint32_t>(0x88);
+    ndsCom = root_reader.next_primitive<std::uint8_t>(0x89);
+    auto apdu_entry_count = root_reader.next_primitive<std::uint32_t>(0x8A);
 
     // apdu sequence
-    goose::frame::ber::BEREntry apdu_entry(&root_value);
+    auto apdu_entry = root_reader.next();
     if (apdu_entry.tag != 0xAB) {
         throw std::runtime_error("GoosePDU: apdu tag is not 0xAB");
     }
-    auto apdu = apdu_entry.value;
 
     // check that no more data is left in root node
-    if (root_value.size() > 0) {
+    if (!root_reader.empty()) {
         throw std::runtime_error("GoosePDU: frame has extra data");
     }
 
     // apdu entries
+    ber::BERReader apdu_reader(apdu_entry);
     for (size_t i = 0; i < apdu_entry_count; i++) {
-        apdu_entries.emplace_back(&apdu);
+        apdu_entries.emplace_back(apdu_reader.next());
     }
 
     // check that no more data is left in apdu sequence node
-    if (apdu.size() > 0) {
+    if (!apdu_reader.empty()) {
         throw std::runtime_error("GoosePDU: apdu has extra data");
     }
 }
@@ -254,22 +249,20 @@ GooseFrameIntf::GooseFrameIntf(const goose_ethernet::EthernetFrame& ethernet_fra
     this->priority = (tag_802_1q & 0xE000) >> 13;
     this->vlan_id = tag_802_1q & 0x0FFF;
 
-    // appid
-    if (ethernet_frame.payload.size() < 2) {
+    // appid, length, reserve1 and reserve2
+    if (ethernet_frame.payload.size() < 8) {
         throw std::runtime_error("GooseFrame: no appid");
     }
     appid[0] = ethernet_frame.payload[0];
     appid[1] = ethernet_frame.payload[1];
 
     std::uint16_t length = (ethernet_frame.payload[2] << 8) | ethernet_frame.payload[3];
+    if (length < 8 || length > ethernet_frame.payload.size()) {
+        throw std::runtime_error("GooseFrame: length does not match payload size");
+    }
 
-    std::uint16_t reserve1 = (ethernet_frame.payload[4] << 8) | ethernet_frame.payload[5];
-    std::uint16_t reserve2 = (ethernet_frame.payload[6] << 8) | ethernet_frame.payload[7];
-
-    // goose pdu
-    goose::frame::GoosePDU pdu(
-        std::vector<std::uint8_t>(ethernet_frame.payload.data() + 8, ethernet_frame.payload.data() + length));
-    this->pdu = pdu;
+    // goose pdu, decoded in place
+    this->pdu = GoosePDU(ethernet_frame.payload.data() + 8, length - 8);
 };
 
 GooseFrame::GooseFrame(const goose_ethernet::EthernetFrame& ethernet_frame) : GooseFrameIntf(ethernet_frame) {
@@ -284,7 +277,10 @@ GooseFrame::GooseFrame(const goose_ethernet::EthernetFrame& ethernet_frame) : Go
         throw std::runtime_error("GooseFrame: reserve2 byte 2 is not 0");
     }
 
-    if (ethernet_frame.payload.size() != 8 + pdu.serialize().size()) {
+    // the pdu decoder already checked that the pdu fills the length from the
+    // header exactly
+    std::uint16_t length = (ethernet_frame.payload[2] << 8) | ethernet_frame.payload[3];
+    if (ethernet_frame.payload.size() != length) {
         throw std::runtime_error("GooseFrame: payload size does not match");
     }
 }
@@ -316,9 +312,9 @@ goose_ethernet::EthernetFrame GooseFrame::serialize() const {
     return ethernet_frame;
 }
 
-std::uint16_t crc(std::vector<std::uint8_t> data) {
+static std::uint16_t crc(const std::uint8_t* data, size_t size) {
     std::uint16_t crc = 0xFFFF;
-    for (size_t i = 0; i < data.size(); i++) {
+    for (size_t i = 0; i < size; i++) {
         crc ^= data[i];
         for (size_t j = 0; j < 8; j++) {
             if (crc & 0x0001) {
@@ -347,21 +343,20 @@ SecureGooseFrame::SecureGooseFrame(const goose_ethernet::EthernetFrame& ethernet
         throw std::runtime_error("GooseFrame: reserve1 byte 2 is less than 32, thus no hmac 256 fits");
     }
 
-    std::vector<std::uint8_t> reserve2_crc_data;
-    reserve2_crc_data.push_back(ethernet_frame.ethertype >> 8);
-    reserve2_crc_data.push_back(ethernet_frame.ethertype & 0xFF);
-    reserve2_crc_data.push_back(ethernet_frame.payload[0]);
-    reserve2_crc_data.push_back(ethernet_frame.payload[1]);
-    reserve2_crc_data.push_back(ethernet_frame.payload[2]);
-    reserve2_crc_data.push_back(ethernet_frame.payload[3]);
-    reserve2_crc_data.push_back(ethernet_frame.payload[4]);
-    reserve2_crc_data.push_back(ethernet_frame.payload[5]);
+    std::uint8_t reserve2_crc_data[8];
+    reserve2_crc_data[0] = ethernet_frame.ethertype >> 8;
+    reserve2_crc_data[1] = ethernet_frame.ethertype & 0xFF;
+    memcpy(reserve2_crc_data + 2, ethernet_frame.payload.data(), 6);
 
-    std::uint16_t crc_value = crc(reserve2_crc_data);
+    std::uint16_t crc_value = crc(reserve2_crc_data, sizeof(reserve2_crc_data));
     if (crc_value != reserve2) {
         throw std::runtime_error("GooseFrame: crc value does not match");
     }
 
+    if (static_cast<size_t>(length) + extended_length > ethernet_frame.payload.size()) {
+        throw std::runtime_error("GooseFrame: extended length exceeds payload size");
+    }
+
     if (hmac_key.has_value()) {
         // verify hmac
         std::vector<std::uint8_t> hmac =
@@ -414,7 +409,7 @@ goose_ethernet::EthernetFrame SecureGooseFrame::serialize(std::vector<std::uint8
     ethernet_payload.push_back(0);
     ethernet_payload.push_back(0x23); // 32 bytes hmac + 3 bytes TLV
     // reserve2
-    std::uint16_t crc_val = crc(ethernet_payload);
+    std::uint16_t crc_val = crc(ethernet_payload.data(), ethernet_payload.size());
     ethernet_payload.push_back(crc_val >> 8);
     ethernet_payload.push_back(crc_val & 0xFF);
     // pdu
@@ -446,3 +441,79 @@ goose_ethernet::EthernetFrame SecureGooseFrame::serialize(std::vector<std::uint8
 
     return ethernet_frame;
 }
+
+// Offset of the ethertype in a serialized frame, as it is always serialized
+// with a 802.1Q tag; the goose header and pdu follow directly
+static const size_t TEMPLATE_ETHERTYPE_OFFSET = 16;
+static const size_t TEMPLATE_PDU_OFFSET = TEMPLATE_ETHERTYPE_OFFSET + 2 + 8;
+// HMAC TLV (3 bytes) and HMAC (32 bytes) at the end of a secure frame
+static const size_t TEMPLATE_HMAC_SIZE = 32;
+static const size_t TEMPLATE_HMAC_TRAILER_SIZE = 3 + TEMPLATE_HMAC_SIZE;
+
+GooseFrameTemplate::GooseFrameTemplate(const GooseFrame& frame) : data(frame.serialize().serialize()) {
+    locate_fields();
+}
+
+GooseFrameTemplate::GooseFrameTemplate(const SecureGooseFrame& frame, std::vector<std::uint8_t> hmac_key) :
+    data(frame.serialize(hmac_key).serialize()), hmac_key(std::move(hmac_key)) {
+    locate_fields();
+}
+
+void GooseFrameTemplate::locate_fields() {
+    std::uint16_t length = (data[TEMPLATE_ETHERTYPE_OFFSET + 4] << 8) | data[TEMPLATE_ETHERTYPE_OFFSET + 5];
+
+    ber::BERReader pdu_reader(data.data() + TEMPLATE_PDU_OFFSET, length - 8);
+    ber::BERReader root_reader(pdu_reader.next(0x61));
+
+    std::optional<size_t> timestamp, st_num, sq_num;
+    while (!root_reader.empty() && !sq_num.has_value()) {
+        auto entry = root_reader.next();
+        size_t offset = entry.value - data.data();
+        if (entry.tag == 0x84 && entry.length == 8) {
+            timestamp = offset;
+        } else if (entry.tag == 0x85 && entry.length == 4) {
+            st_num = offset;
+        } else if (entry.tag == 0x86 && entry.length == 4) {
+            sq_num = offset;
+        }
+    }
+
+    if (!timestamp.has_value() || !st_num.has_value() || !sq_num.has_value()) {
+        throw std::runtime_error("GooseFrameTemplate: timestamp, st_num or sq_num not found");
+    }
+
+    timestamp_offset = timestamp.value();
+    st_num_offset = st_num.value();
+    sq_num_offset = sq_num.value();
+}
+
+void GooseFrameTemplate::set_timestamp(const GooseTimestamp& timestamp) {
+    timestamp.encode(data.data() + timestamp_offset);
+    hmac_outdated = true;
+}
+
+void GooseFrameTemplate::set_st_num(std::uint32_t st_num) {
+    ber::encode_be(st_num, data.data() + st_num_offset);
+    hmac_outdated = true;
+}
+
+void GooseFrameTemplate::set_sq_num(std::uint32_t sq_num) {
+    ber::encode_be(sq_num, data.data() + sq_num_offset);
+    hmac_outdated = true;
+}
+
+const std::vector<std::uint8_t>& GooseFrameTemplate::get_data() {
+    if (hmac_key.has_value() && hmac_outdated) {
+        // the hmac covers the ethertype, goose header and pdu, see
+        // SecureGooseFrame::serialize
+        auto ret = HMAC(EVP_sha256(), hmac_key.value().data(), hmac_key.value().size(),
+                        data.data() + TEMPLATE_ETHERTYPE_OFFSET,
+                        data.size() - TEMPLATE_ETHERTYPE_OFFSET - TEMPLATE_HMAC_TRAILER_SIZE,
+                        data.data() + data.size() - TEMPLATE_HMAC_SIZE, NULL);
+        if (ret == NULL) {
+            throw std::runtime_error("GooseFrameTemplate: HMAC failed");
+        }
+    }
+    hmac_outdated = false;
+    return data;
+}
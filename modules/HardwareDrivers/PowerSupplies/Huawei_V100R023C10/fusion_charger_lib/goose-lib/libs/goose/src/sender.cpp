@@ -65,13 +65,23 @@ void Sender::run() {
         current_packet_cv.wait(lock, [this] { return stop_flag || current_packet.has_value(); });
         log.verbose << "Got first packet!";
         // after wait, we own the lock and send the packet
+        last_send_time = std::chrono::steady_clock::now();
     } else {
         std::chrono::milliseconds wait_time = t0;
         if (current_ts_index < ts.size()) {
             wait_time = ts[current_ts_index];
             current_ts_index++;
         }
-        current_packet_cv.wait_for(lock, wait_time, [this] { return stop_flag || has_new_package; });
+        auto send_time = last_send_time + wait_time;
+        current_packet_cv.wait_until(lock, send_time, [this] { return stop_flag || has_new_package; });
+
+        auto now = std::chrono::steady_clock::now();
+        if (has_new_package || now - send_time >= wait_time) {
+            // a new packet is sent right away; if we are behind by more than a
+            // whole delay the schedule starts over instead of sending a burst
+            send_time = now;
+        }
+        last_send_time = send_time;
         has_new_package = false;
     }
 
@@ -82,12 +92,14 @@ void Sender::run() {
         }
     }
 
-    // Send the packet
+    // Send the packet; retransmissions only patch the sequence numbers of the
+    // already serialized frame
     try {
-        intf->send_packet(current_packet.value()->build_packet({
+        const auto& packet = current_packet.value()->build_raw_packet({
             sq_num,
             st_num,
-        }));
+        });
+        intf->send_packet(packet.data(), packet.size());
     } catch (...) {
         log.error << "goose::sender: Failed to send packet";
     }
@@ -124,3 +124,40 @@ TEST(BEREntry, decode_mid_length_frame) {
 }
 
 // todo: PrimitiveBEREntry
+
+TEST(BERReader, reads_entries_in_place) {
+    std::vector<std::uint8_t> input = {
+        0x61, 0x08,             // constructed entry
+        0x85, 0x02, 0x01, 0x02, // st_num
+        0x86, 0x02, 0x03, 0x04, // sq_num
+    };
+
+    goose::frame::ber::BERReader reader(input.data(), input.size());
+    auto root = reader.next(0x61);
+    ASSERT_TRUE(reader.empty());
+    ASSERT_EQ(root.value, input.data() + 2);
+    ASSERT_EQ(root.length, 8);
+
+    goose::frame::ber::BERReader root_reader(root);
+    ASSERT_EQ(root_reader.next_primitive<std::uint32_t>(0x85), 0x0102);
+
+    auto sq_num = root_reader.next();
+    ASSERT_EQ(sq_num.tag, 0x86);
+    ASSERT_EQ(sq_num.value, input.data() + 8);
+    ASSERT_EQ(sq_num.length, 2);
+    ASSERT_TRUE(root_reader.empty());
+}
+
+TEST(BERReader, throws_on_invalid_input) {
+    std::vector<std::uint8_t> input = {0x85, 0x04, 0x01, 0x02};
+
+    goose::frame::ber::BERReader truncated(input.data(), input.size());
+    ASSERT_THROW(truncated.next(), std::runtime_error);
+
+    goose::frame::ber::BERReader wrong_tag(input.data(), 2);
+    ASSERT_THROW(wrong_tag.next(0x86), std::runtime_error);
+
+    std::vector<std::uint8_t> too_big = {0x85, 0x02, 0x01, 0x02};
+    goose::frame::ber::BERReader too_big_reader(too_big.data(), too_big.size());
+    ASSERT_THROW(too_big_reader.next_primitive<std::uint8_t>(0x85), std::runtime_error);
+}
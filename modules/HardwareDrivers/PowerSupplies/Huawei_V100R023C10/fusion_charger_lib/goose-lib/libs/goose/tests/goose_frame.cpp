@@ -56,3 +56,44 @@ TEST(GooseFrame, encode_decode) {
     ASSERT_EQ(decoded.pdu.apdu_entries[0].value[0], 0);
     ASSERT_EQ(decoded.pdu.apdu_entries[0].value[1], 1);
 }
+
+TEST(GooseFrameTemplate, patches_fields_in_place) {
+    goose::frame::GooseFrame goose_frame;
+    memset(goose_frame.destination_mac_address, 0x01, 6);
+    memset(goose_frame.source_mac_address, 0x02, 6);
+    goose_frame.vlan_id = 2;
+    goose_frame.priority = 5;
+    goose_frame.appid[0] = 0x00;
+    goose_frame.appid[1] = 0x01;
+
+    strcpy(goose_frame.pdu.go_cb_ref, "PDU");
+    goose_frame.pdu.time_allowed_to_live = 10000;
+    strcpy(goose_frame.pdu.dat_set, "DAT_SET");
+    strcpy(goose_frame.pdu.go_id, "GO_ID");
+    goose_frame.pdu.timestamp = goose::frame::GooseTimestamp::from_ms(1667349763000);
+    goose_frame.pdu.st_num = 1;
+    goose_frame.pdu.sq_num = 0;
+    goose_frame.pdu.simulation = false;
+    goose_frame.pdu.conf_rev = 0;
+    goose_frame.pdu.ndsCom = 0;
+    goose_frame.pdu.apdu_entries.resize(1);
+    goose_frame.pdu.apdu_entries[0].tag = 0x86;
+    goose_frame.pdu.apdu_entries[0].value = {0, 1};
+
+    goose::frame::GooseFrameTemplate frame_template(goose_frame);
+    ASSERT_EQ(frame_template.get_data(), goose_frame.serialize().serialize());
+
+    frame_template.set_st_num(0x12345678);
+    frame_template.set_sq_num(42);
+    frame_template.set_timestamp(goose::frame::GooseTimestamp::from_ms(1700000000123));
+
+    goose_frame.pdu.st_num = 0x12345678;
+    goose_frame.pdu.sq_num = 42;
+    goose_frame.pdu.timestamp = goose::frame::GooseTimestamp::from_ms(1700000000123);
+    ASSERT_EQ(frame_template.get_data(), goose_frame.serialize().serialize());
+
+    auto decoded = goose::frame::GooseFrame(goose_ethernet::EthernetFrame(frame_template.get_data()));
+    ASSERT_EQ(decoded.pdu.st_num, 0x12345678);
+    ASSERT_EQ(decoded.pdu.sq_num, 42);
+    ASSERT_EQ(decoded.pdu.timestamp, goose_frame.pdu.timestamp);
+}
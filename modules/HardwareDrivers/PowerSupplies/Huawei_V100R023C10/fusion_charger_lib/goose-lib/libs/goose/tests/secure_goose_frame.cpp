@@ -263,3 +263,45 @@ TEST(SecureGooseFrame, deserialize_edited_payload_throws_invalid_hmac) {
     ASSERT_THROW(goose::frame::SecureGooseFrame frame(serialized, std::vector<std::uint8_t>(key, key + sizeof(key))),
                  std::runtime_error);
 }
+
+TEST(SecureGooseFrame, template_updates_hmac) {
+    goose::frame::SecureGooseFrame goose_frame;
+    goose_frame.appid[0] = 0x00;
+    goose_frame.appid[1] = 0x01;
+    memset(goose_frame.source_mac_address, 0x00, 6);
+    memset(goose_frame.destination_mac_address, 0x00, 6);
+    goose_frame.vlan_id = 2;
+    goose_frame.priority = 7;
+
+    strcpy(goose_frame.pdu.go_cb_ref, "GO_CB_REF");
+    goose_frame.pdu.time_allowed_to_live = 10000;
+    strcpy(goose_frame.pdu.dat_set, "DAT_SET");
+    strcpy(goose_frame.pdu.go_id, "GO_ID");
+    goose_frame.pdu.timestamp = goose::frame::GooseTimestamp::from_ms(1667349763000);
+    goose_frame.pdu.st_num = 1;
+    goose_frame.pdu.sq_num = 0;
+    goose_frame.pdu.simulation = false;
+    goose_frame.pdu.conf_rev = 0;
+    goose_frame.pdu.ndsCom = 0;
+    goose_frame.pdu.apdu_entries.resize(1);
+    goose_frame.pdu.apdu_entries[0].tag = 0x86;
+    goose_frame.pdu.apdu_entries[0].value = {0, 1};
+
+    std::vector<std::uint8_t> key(48);
+    for (size_t i = 0; i < key.size(); i++) {
+        key[i] = i;
+    }
+
+    goose::frame::GooseFrameTemplate frame_template(goose_frame, key);
+    frame_template.set_st_num(7);
+    frame_template.set_sq_num(3);
+
+    goose_frame.pdu.st_num = 7;
+    goose_frame.pdu.sq_num = 3;
+    ASSERT_EQ(frame_template.get_data(), goose_frame.serialize(key).serialize());
+
+    // verifies the recalculated hmac
+    auto decoded = goose::frame::SecureGooseFrame(goose_ethernet::EthernetFrame(frame_template.get_data()), key);
+    ASSERT_EQ(decoded.pdu.st_num, 7);
+    ASSERT_EQ(decoded.pdu.sq_num, 3);
+}
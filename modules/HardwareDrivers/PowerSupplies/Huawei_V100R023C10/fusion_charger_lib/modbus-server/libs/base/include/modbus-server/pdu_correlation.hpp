@@ -3,12 +3,12 @@
 #ifndef MODBUS_SERVER__PDU_CORRELATION_HPP
 #define MODBUS_SERVER__PDU_CORRELATION_HPP
 
-#include <condition_variable>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <optional>
 #include <stdexcept>
-#include <vector>
+#include <unordered_map>
 
 #include "transport_protocol.hpp"
 
@@ -17,6 +17,8 @@ namespace modbus_server {
 class PDUCorrelationLayerIntf {
 public:
     using On_PDU_Callback_t = std::function<std::optional<pdu::GenericPDU>(const pdu::GenericPDU&)>;
+    // Called with the response, or with std::nullopt if the request timed out
+    using On_Response_Callback_t = std::function<void(std::optional<pdu::GenericPDU>)>;
 
 protected:
     std::optional<On_PDU_Callback_t> on_pdu;
@@ -50,6 +52,22 @@ public:
      */
     virtual pdu::GenericPDU request_response(const pdu::GenericPDU& request, std::chrono::milliseconds timeout) = 0;
 
+    /**
+     * @brief Send a request and return without waiting for the response. \c
+     * on_response is called with the response once it is received, or with \c
+     * std::nullopt once \c timeout is reached. Several requests may be in
+     * transit at the same time.
+     *
+     * @note The default implementation calls \c request_response and thus
+     * blocks until the request is done.
+     *
+     * @param request The request to send
+     * @param timeout The timeout to wait for the response
+     * @param on_response The callback for the response
+     */
+    virtual void request_response_async(const pdu::GenericPDU& request, std::chrono::milliseconds timeout,
+                                        On_Response_Callback_t on_response);
+
     /**
      * @brief Send a request without waiting for a response.
      *
@@ -66,30 +84,69 @@ public:
     }
 };
 
+/**
+ * @brief Correlates responses to requests in transit by their context. The
+ * requests in transit are looked up by context in constant time and every
+ * request is completed on its own, so neither the number of requests in
+ * transit nor other waiting requests slow down a response.
+ *
+ * Responses are received by \c poll or \c blocking_poll, callbacks passed to
+ * \c request_response_async are called from the polling thread and must not
+ * block it. Timeouts of asynchronous requests are checked whenever polling
+ * returns.
+ */
 class PDUCorrelationLayer : public PDUCorrelationLayerIntf {
+public:
+    // Timeout used by \c poll without a timeout argument
+    static constexpr std::chrono::milliseconds DEFAULT_POLL_TIMEOUT{50};
+
 protected:
     std::shared_ptr<ModbusProtocol> protocol;
 
-    struct ListeningForResponseEntry {
-        ModbusProtocol::Context context;
+    struct RequestInTransit {
         std::uint8_t function_code;
-        std::optional<pdu::GenericPDU> pdu;
+        std::chrono::steady_clock::time_point end_time;
+        On_Response_Callback_t on_response;
     };
 
-    std::vector<ListeningForResponseEntry> listening_for_response;
-
-    std::mutex listening_for_response_mutex;
-    std::condition_variable listening_for_response_cv;
+    std::unordered_map<ModbusProtocol::Context, RequestInTransit, ModbusProtocol::Context::Hash> requests_in_transit;
+    std::mutex requests_in_transit_mutex;
 
     void on_poll_data(modbus_server::ModbusProtocol::Context context, pdu::GenericPDU pdu);
 
+    /**
+     * @brief Register a request in transit and send it
+     *
+     * @return ModbusProtocol::Context The context the request was sent with
+     */
+    ModbusProtocol::Context send_request(const pdu::GenericPDU& request, std::chrono::milliseconds timeout,
+                                         On_Response_Callback_t on_response);
+
+    /**
+     * @brief Remove all requests in transit that reached their timeout and
+     * call their callbacks with \c std::nullopt
+     */
+    void expire_requests();
+
 public:
     PDUCorrelationLayer(std::shared_ptr<ModbusProtocol> protocol) : protocol(protocol) {
     }
 
     void blocking_poll() override;
     bool poll() override;
+
+    /**
+     * @brief Receive and correlate a single PDU, waiting up to \c timeout for
+     * it to arrive. Returns as soon as a PDU was received.
+     *
+     * @param timeout The maximum time to wait for a PDU
+     * @return true if a PDU was received
+     */
+    bool poll(std::chrono::milliseconds timeout);
+
     pdu::GenericPDU request_response(const pdu::GenericPDU& request, std::chrono::milliseconds timeout) override;
+    void request_response_async(const pdu::GenericPDU& request, std::chrono::milliseconds timeout,
+                                On_Response_Callback_t on_response) override;
     void request_without_response(const pdu::GenericPDU& request) override;
 };
 
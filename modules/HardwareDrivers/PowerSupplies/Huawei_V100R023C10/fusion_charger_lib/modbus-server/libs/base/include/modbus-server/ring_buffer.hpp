@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#ifndef MODBUS_SERVER__RING_BUFFER_HPP
+#define MODBUS_SERVER__RING_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace modbus_server {
+
+/**
+ * @brief A fixed size byte ring buffer. Received bytes are written directly
+ * into its free space and consumed from the front once a complete frame has
+ * been parsed, so the storage is allocated only once.
+ */
+class RingBuffer {
+protected:
+    std::vector<std::uint8_t> buffer;
+    size_t head;
+    size_t count;
+
+public:
+    /**
+     * @brief Create a new RingBuffer
+     *
+     * @param capacity The maximum number of bytes the buffer can hold
+     */
+    RingBuffer(size_t capacity);
+
+    /**
+     * @brief The number of bytes currently stored
+     */
+    size_t size() const;
+
+    /**
+     * @brief The maximum number of bytes that can be stored
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Get the stored byte at position \c offset, counted from the front
+     *
+     * @throws std::out_of_range if \c offset is not smaller than \c size()
+     */
+    std::uint8_t peek(size_t offset) const;
+
+    /**
+     * @brief Copy \c length stored bytes, starting at \c offset counted from the
+     * front, to \c destination
+     *
+     * @throws std::out_of_range if the range exceeds the stored bytes
+     */
+    void copy_to(size_t offset, size_t length, std::uint8_t* destination) const;
+
+    /**
+     * @brief Remove \c length bytes from the front
+     *
+     * @throws std::out_of_range if \c length is bigger than \c size()
+     */
+    void consume(size_t length);
+
+    /**
+     * @brief Get the contiguous free region after the stored bytes. Bytes
+     * written into it must be committed using \c commit. The region may be
+     * smaller than the total free space if the free space wraps around.
+     *
+     * @return std::pair<std::uint8_t*, size_t> The start and length of the region
+     */
+    std::pair<std::uint8_t*, size_t> write_region();
+
+    /**
+     * @brief Mark \c length bytes written into the region returned by \c
+     * write_region as stored
+     *
+     * @throws std::out_of_range if \c length is bigger than the region
+     */
+    void commit(size_t length);
+};
+
+} // namespace modbus_server
+
+#endif
@@ -3,6 +3,7 @@
 #ifndef MODBUS_SERVER__TRANSPORT_HPP
 #define MODBUS_SERVER__TRANSPORT_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <optional>
 #include <stdexcept>
@@ -44,6 +45,21 @@ public:
 
     virtual std::optional<std::vector<std::uint8_t>> try_read_bytes(size_t count) = 0;
 
+    /**
+     * @brief Read the bytes that are already available, but at most \c
+     * max_count, into \c buffer. If no bytes are available, wait up to \c
+     * timeout for them to arrive. A negative \c timeout waits until data is
+     * available. Must not poll with a fixed interval, the receive loops rely on
+     * it to block until data arrives.
+     *
+     * @param buffer The buffer to read into
+     * @param max_count The maximum number of bytes to read
+     * @param timeout The time to wait for data if none is available
+     * @return size_t The number of bytes read, 0 if no data arrived in time
+     * @throws ConnectionClosedException if the connection is closed
+     */
+    virtual size_t read_available(std::uint8_t* buffer, size_t max_count, std::chrono::milliseconds timeout) = 0;
+
     /**
      * @brief Write a number of bytes to the transport layer. The buffer to write
      * is specified by the \c bytes parameter
@@ -74,6 +90,7 @@ public:
 
     std::vector<std::uint8_t> read_bytes(size_t count) override;
     std::optional<std::vector<std::uint8_t>> try_read_bytes(size_t count) override;
+    size_t read_available(std::uint8_t* buffer, size_t max_count, std::chrono::milliseconds timeout) override;
     void write_bytes(const std::vector<std::uint8_t>& bytes) override;
 };
 
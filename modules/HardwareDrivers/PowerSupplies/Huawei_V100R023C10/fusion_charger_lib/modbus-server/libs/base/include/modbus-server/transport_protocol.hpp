@@ -3,9 +3,12 @@
 #ifndef MODBUS_SERVER__TRANSPORT_PROTOCOL_HPP
 #define MODBUS_SERVER__TRANSPORT_PROTOCOL_HPP
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <tuple>
 
+#include "ring_buffer.hpp"
 #include "transport.hpp"
 
 namespace modbus_server {
@@ -29,6 +32,13 @@ public:
 
         bool operator==(const Context& other) const;
         bool operator!=(const Context& other) const;
+
+        /**
+         * @brief Hash of a context, used to look up requests in transit
+         */
+        struct Hash {
+            size_t operator()(const Context& context) const;
+        };
     };
 
 protected:
@@ -57,7 +67,18 @@ public:
 
     virtual std::tuple<Context, pdu::GenericPDU> receive_blocking() = 0;
 
-    virtual std::optional<std::pair<Context, pdu::GenericPDU>> try_receive() = 0;
+    /**
+     * @brief Receive a PDU via the transport layer, waiting up to \c timeout
+     * for it to arrive. Returns as soon as a complete PDU is available. A PDU
+     * that is only partially received when the timeout is reached is kept and
+     * completed by the next call.
+     *
+     * @param timeout The maximum time to wait for a PDU
+     * @return std::optional<std::pair<Context, pdu::GenericPDU>> The context and
+     * the received PDU, or \c std::nullopt if no complete PDU arrived in time
+     */
+    virtual std::optional<std::pair<Context, pdu::GenericPDU>> try_receive(std::chrono::milliseconds timeout) = 0;
+
     /**
      * @brief Send a PDU via the transport layer and block until the message is
      * sent. If you need to send a message without already having a context, use
@@ -73,11 +94,22 @@ public:
 /**
  * @brief A modbus protocol implementation for Modbus TCP.
  *
+ * Received bytes are read into a ring buffer in chunks of whatever the
+ * transport has available and frames are parsed from there, so receiving
+ * several frames does not need a read call per header and per body.
+ * Receiving must only be done from one thread at a time, sending and
+ * creating send contexts may be done from any thread.
+ *
  */
 class ModbusTCPProtocol : public ModbusProtocol {
+public:
+    // A header (without unit id) followed by the maximum length the length field can express
+    static constexpr size_t RECEIVE_BUFFER_SIZE = 6 + 0xFFFF;
+
 protected:
     std::uint16_t sending_unit_id = 0xFF; // default 0xFF
-    std::uint16_t current_transaction_id;
+    std::atomic<std::uint16_t> current_transaction_id;
+    RingBuffer receive_buffer;
     struct ModbusTCPContext {
         std::uint16_t transaction_id;
         std::uint16_t protocol_id;
@@ -88,6 +120,22 @@ protected:
         Context to_context();
     };
 
+    /**
+     * @brief Take the first complete frame out of the receive buffer. Frames
+     * with an invalid length are dropped.
+     *
+     * @throws std::runtime_error if the frame can never fit into the buffer
+     */
+    std::optional<std::pair<Context, pdu::GenericPDU>> take_frame();
+
+    /**
+     * @brief Read the available bytes from the transport into the receive
+     * buffer, waiting up to \c timeout for data
+     *
+     * @return true if bytes were read
+     */
+    bool fill_receive_buffer(std::chrono::milliseconds timeout);
+
 public:
     /**
      * @brief Create a new ModbusTCPProtocol using a transport layer
@@ -107,7 +155,7 @@ public:
 
     Context new_send_context() override;
     std::tuple<Context, pdu::GenericPDU> receive_blocking() override;
-    std::optional<std::pair<Context, pdu::GenericPDU>> try_receive() override;
+    std::optional<std::pair<Context, pdu::GenericPDU>> try_receive(std::chrono::milliseconds timeout) override;
     void send_blocking(const pdu::GenericPDU& pdu, const Context& context) override;
 };
 
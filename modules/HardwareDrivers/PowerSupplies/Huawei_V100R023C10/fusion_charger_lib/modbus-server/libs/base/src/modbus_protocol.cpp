@@ -2,6 +2,9 @@
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
 #include <modbus-server/transport_protocol.hpp>
 
+#include <algorithm>
+#include <string_view>
+
 using namespace modbus_server;
 
 ModbusProtocol::ModbusProtocol(std::shared_ptr<ModbusTransport> transport) : transport(transport) {
@@ -15,6 +18,11 @@ bool ModbusProtocol::Context::operator!=(const ModbusProtocol::Context& other) c
     return this->data != other.data;
 }
 
+size_t ModbusProtocol::Context::Hash::operator()(const ModbusProtocol::Context& context) const {
+    return std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(context.data.data()), context.data.size()));
+}
+
 ModbusTCPProtocol::ModbusTCPContext::ModbusTCPContext(const ModbusProtocol::Context& context) {
     this->transaction_id = context.data[0] << 8 | context.data[1];
     this->protocol_id = context.data[2] << 8 | context.data[3];
@@ -36,12 +44,15 @@ ModbusProtocol::Context ModbusTCPProtocol::ModbusTCPContext::to_context() {
 }
 
 ModbusTCPProtocol::ModbusTCPProtocol(std::shared_ptr<ModbusTransport> transport) :
-    ModbusProtocol(transport), current_transaction_id(0) {
+    ModbusProtocol(transport), current_transaction_id(0), receive_buffer(RECEIVE_BUFFER_SIZE) {
 }
 
 ModbusTCPProtocol::ModbusTCPProtocol(std::shared_ptr<ModbusTransport> transport, std::uint16_t unit_id,
                                      std::uint16_t transaction_id) :
-    ModbusProtocol(transport), sending_unit_id(unit_id), current_transaction_id(transaction_id) {
+    ModbusProtocol(transport),
+    sending_unit_id(unit_id),
+    current_transaction_id(transaction_id),
+    receive_buffer(RECEIVE_BUFFER_SIZE) {
 }
 
 ModbusTCPProtocol::Context ModbusTCPProtocol::new_send_context() {
@@ -52,58 +63,86 @@ ModbusTCPProtocol::Context ModbusTCPProtocol::new_send_context() {
     return context.to_context();
 }
 
-std::tuple<ModbusProtocol::Context, pdu::GenericPDU> ModbusTCPProtocol::receive_blocking() {
-    auto header = this->transport->read_bytes(7);
+std::optional<std::pair<ModbusProtocol::Context, pdu::GenericPDU>> ModbusTCPProtocol::take_frame() {
+    std::uint16_t length = 0;
+    while (true) {
+        if (this->receive_buffer.size() < 7) {
+            return std::nullopt;
+        }
 
-    std::uint16_t transaction_id = header[0] << 8 | header[1];
-    std::uint16_t protocol_id = header[2] << 8 | header[3];
-    std::uint16_t length = header[4] << 8 | header[5];
-    std::uint8_t unit_id = header[6];
+        length = this->receive_buffer.peek(4) << 8 | this->receive_buffer.peek(5);
+        if (length > 1) {
+            break;
+        }
 
-    auto data = this->transport->read_bytes(length - 1);
+        // nothing to be read and the length is invalid, drop the header
+        this->receive_buffer.consume(7);
+    }
 
     ModbusTCPContext context;
-    context.transaction_id = transaction_id;
-    context.protocol_id = protocol_id;
-    context.unit_id = unit_id;
-
-    return {context.to_context(), pdu::GenericPDU(data)};
-}
+    context.transaction_id = this->receive_buffer.peek(0) << 8 | this->receive_buffer.peek(1);
+    context.protocol_id = this->receive_buffer.peek(2) << 8 | this->receive_buffer.peek(3);
+    context.unit_id = this->receive_buffer.peek(6);
+
+    // the length includes the unit id
+    size_t frame_size = 6 + length;
+    if (frame_size > this->receive_buffer.capacity()) {
+        throw std::runtime_error("Modbus frame of " + std::to_string(frame_size) + " bytes exceeds receive buffer");
+    }
 
-std::optional<std::pair<modbus_server::ModbusProtocol::Context, pdu::GenericPDU>>
-modbus_server::ModbusTCPProtocol::try_receive() {
-    auto header_opt = this->transport->try_read_bytes(7);
-    if (!header_opt.has_value()) {
+    if (this->receive_buffer.size() < frame_size) {
         return std::nullopt;
     }
-    auto header = header_opt.value();
 
-    std::uint16_t transaction_id = header[0] << 8 | header[1];
-    std::uint16_t protocol_id = header[2] << 8 | header[3];
-    std::uint16_t length = header[4] << 8 | header[5];
-    std::uint8_t unit_id = header[6];
-
-    if (length <= 1) {
-        return std::nullopt; // first of all: nothing to be read, secondly: the
-                             // length is invalid
-    }
+    pdu::GenericPDU pdu;
+    pdu.function_code = this->receive_buffer.peek(7);
+    pdu.data.resize(length - 2);
+    this->receive_buffer.copy_to(8, pdu.data.size(), pdu.data.data());
+    this->receive_buffer.consume(frame_size);
 
-    auto data = this->transport->read_bytes(length - 1);
+    return std::make_pair(context.to_context(), std::move(pdu));
+}
 
-    if (data.size() != length - 1) {
-        throw std::runtime_error("Transport returned less data than requested");
+bool ModbusTCPProtocol::fill_receive_buffer(std::chrono::milliseconds timeout) {
+    auto [region, region_size] = this->receive_buffer.write_region();
+    if (region_size == 0) {
+        throw std::runtime_error("Modbus receive buffer is full");
     }
 
-    ModbusTCPContext context;
-    context.transaction_id = transaction_id;
-    context.protocol_id = protocol_id;
-    context.unit_id = unit_id;
+    size_t read = this->transport->read_available(region, region_size, timeout);
+    this->receive_buffer.commit(read);
+    return read > 0;
+}
+
+std::tuple<ModbusProtocol::Context, pdu::GenericPDU> ModbusTCPProtocol::receive_blocking() {
+    while (true) {
+        auto frame = this->take_frame();
+        if (frame.has_value()) {
+            return {std::move(frame.value().first), std::move(frame.value().second)};
+        }
 
-    std::pair<modbus_server::ModbusProtocol::Context, pdu::GenericPDU> result = {context.to_context(),
-                                                                                 pdu::GenericPDU(data)};
+        this->fill_receive_buffer(std::chrono::milliseconds(-1));
+    }
+}
 
-    return std::optional(result);
+std::optional<std::pair<modbus_server::ModbusProtocol::Context, pdu::GenericPDU>>
+modbus_server::ModbusTCPProtocol::try_receive(std::chrono::milliseconds timeout) {
+    auto end_time = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        auto frame = this->take_frame();
+        if (frame.has_value()) {
+            return frame;
+        }
+
+        auto rest_timeout =
+            std::chrono::duration_cast<std::chrono::milliseconds>(end_time - std::chrono::steady_clock::now());
+        if (!this->fill_receive_buffer(std::max(rest_timeout, std::chrono::milliseconds(0)))) {
+            return std::nullopt;
+        }
+    }
 }
+
 void ModbusTCPProtocol::send_blocking(const pdu::GenericPDU& pdu, const ModbusProtocol::Context& context) {
     auto pdu_data = pdu.to_vector();
     std::uint16_t size_in_header = pdu_data.size() + 1; // +1 for the unit id in the header
@@ -3,27 +3,40 @@
 
 #include <modbus-server/pdu_correlation.hpp>
 
+#include <future>
+
 using namespace modbus_server;
 
+void PDUCorrelationLayerIntf::request_response_async(const pdu::GenericPDU& request, std::chrono::milliseconds timeout,
+                                                     On_Response_Callback_t on_response) {
+    std::optional<pdu::GenericPDU> response;
+    try {
+        response = this->request_response(request, timeout);
+    } catch (const std::runtime_error&) {
+        response = std::nullopt;
+    }
+    on_response(response);
+}
+
 void modbus_server::PDUCorrelationLayer::on_poll_data(modbus_server::ModbusProtocol::Context context,
                                                       pdu::GenericPDU pdu) {
+    std::optional<On_Response_Callback_t> on_response;
     {
-        std::lock_guard<std::mutex> lock(this->listening_for_response_mutex);
-        for (auto& entry : this->listening_for_response) {
-            if (entry.context != context) {
-                continue;
-            }
-
-            if ((entry.function_code & 0x7f) != (pdu.function_code & 0x7f)) {
-                continue;
-            }
-
-            entry.pdu = pdu;
-            this->listening_for_response_cv.notify_all();
-            return;
+        std::lock_guard<std::mutex> lock(this->requests_in_transit_mutex);
+        auto entry = this->requests_in_transit.find(context);
+        if (entry != this->requests_in_transit.end() &&
+            (entry->second.function_code & 0x7f) == (pdu.function_code & 0x7f)) {
+            on_response = std::move(entry->second.on_response);
+            this->requests_in_transit.erase(entry);
         }
     }
 
+    // call outside of the lock, the callback may send new requests
+    if (on_response.has_value()) {
+        on_response.value()(std::move(pdu));
+        return;
+    }
+
     if (!this->on_pdu.has_value()) {
         return;
     }
@@ -34,66 +47,101 @@ void modbus_server::PDUCorrelationLayer::on_poll_data(modbus_server::ModbusProto
     }
 }
 
+void PDUCorrelationLayer::expire_requests() {
+    std::vector<On_Response_Callback_t> expired;
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(this->requests_in_transit_mutex);
+        for (auto it = this->requests_in_transit.begin(); it != this->requests_in_transit.end();) {
+            if (it->second.end_time <= now) {
+                expired.push_back(std::move(it->second.on_response));
+                it = this->requests_in_transit.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    for (auto& on_response : expired) {
+        on_response(std::nullopt);
+    }
+}
+
 void PDUCorrelationLayer::blocking_poll() {
     auto [context, pdu] = this->protocol->receive_blocking();
     on_poll_data(context, pdu);
+    expire_requests();
 }
 
 bool modbus_server::PDUCorrelationLayer::poll() {
+    return this->poll(DEFAULT_POLL_TIMEOUT);
+}
+
+bool modbus_server::PDUCorrelationLayer::poll(std::chrono::milliseconds timeout) {
     std::optional<std::pair<modbus_server::ModbusProtocol::Context, pdu::GenericPDU>> data =
-        this->protocol->try_receive();
+        this->protocol->try_receive(timeout);
 
-    if (!data.has_value()) {
-        return false;
+    if (data.has_value()) {
+        on_poll_data(data.value().first, data.value().second);
     }
+    expire_requests();
 
-    on_poll_data(data.value().first, data.value().second);
-    return true;
+    return data.has_value();
 }
 
-pdu::GenericPDU PDUCorrelationLayer::request_response(const pdu::GenericPDU& request,
-                                                      std::chrono::milliseconds timeout) {
+ModbusProtocol::Context PDUCorrelationLayer::send_request(const pdu::GenericPDU& request,
+                                                          std::chrono::milliseconds timeout,
+                                                          On_Response_Callback_t on_response) {
     auto context = this->protocol->new_send_context();
 
     {
-        std::lock_guard<std::mutex> lock(this->listening_for_response_mutex);
-        this->listening_for_response.push_back({context, request.function_code, std::nullopt});
-    }
-
-    this->protocol->send_blocking(request, context);
-
-    auto end_time = std::chrono::steady_clock::now() + timeout;
-
-    while (std::chrono::steady_clock::now() < end_time) {
-        auto rest_timeout = end_time - std::chrono::steady_clock::now();
-
-        std::unique_lock<std::mutex> lock(this->listening_for_response_mutex);
-        this->listening_for_response_cv.wait_for(lock, rest_timeout);
-
-        // check if we have a response
-        ssize_t index = -1;
-        for (ssize_t i = 0; i < this->listening_for_response.size(); i++) {
-            if (this->listening_for_response[i].context == context) {
-                index = i;
-            }
+        std::lock_guard<std::mutex> lock(this->requests_in_transit_mutex);
+        auto inserted = this->requests_in_transit.emplace(
+            context, RequestInTransit{request.function_code, std::chrono::steady_clock::now() + timeout,
+                                      std::move(on_response)});
+        if (!inserted.second) {
+            throw std::runtime_error("context is already in transit");
         }
+    }
 
-        if (index == -1) {
-            throw std::runtime_error("context is gone");
-        }
+    try {
+        this->protocol->send_blocking(request, context);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(this->requests_in_transit_mutex);
+        this->requests_in_transit.erase(context);
+        throw;
+    }
 
-        // if we have a response, erase the entry and return the response
-        if (this->listening_for_response[index].pdu.has_value()) {
-            auto ret = this->listening_for_response[index].pdu.value();
-            this->listening_for_response.erase(this->listening_for_response.begin() + index);
+    return context;
+}
 
-            return ret;
-        }
+pdu::GenericPDU PDUCorrelationLayer::request_response(const pdu::GenericPDU& request,
+                                                      std::chrono::milliseconds timeout) {
+    // the promise is shared with the callback, which may still be called after giving up waiting
+    auto response_promise = std::make_shared<std::promise<std::optional<pdu::GenericPDU>>>();
+    auto response_future = response_promise->get_future();
+
+    auto context = this->send_request(request, timeout, [response_promise](std::optional<pdu::GenericPDU> response) {
+        response_promise->set_value(std::move(response));
+    });
+
+    if (response_future.wait_for(timeout) != std::future_status::ready) {
+        std::lock_guard<std::mutex> lock(this->requests_in_transit_mutex);
+        this->requests_in_transit.erase(context);
+        throw std::runtime_error("timeout");
+    }
 
-        // if we don't have a response, check if we have timed out and wait again
+    auto response = response_future.get();
+    if (!response.has_value()) {
+        throw std::runtime_error("timeout");
     }
 
-    throw std::runtime_error("timeout");
+    return response.value();
+}
+
+void PDUCorrelationLayer::request_response_async(const pdu::GenericPDU& request, std::chrono::milliseconds timeout,
+                                                 On_Response_Callback_t on_response) {
+    this->send_request(request, timeout, std::move(on_response));
 }
 
 void PDUCorrelationLayer::request_without_response(const pdu::GenericPDU& request) {
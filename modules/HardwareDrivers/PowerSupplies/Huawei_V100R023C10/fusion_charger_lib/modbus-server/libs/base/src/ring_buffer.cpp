@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <modbus-server/ring_buffer.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace modbus_server;
+
+RingBuffer::RingBuffer(size_t capacity) : buffer(capacity), head(0), count(0) {
+    if (capacity == 0) {
+        throw std::invalid_argument("RingBuffer: capacity must not be 0");
+    }
+}
+
+size_t RingBuffer::size() const {
+    return this->count;
+}
+
+size_t RingBuffer::capacity() const {
+    return this->buffer.size();
+}
+
+std::uint8_t RingBuffer::peek(size_t offset) const {
+    if (offset >= this->count) {
+        throw std::out_of_range("RingBuffer: peek beyond stored bytes");
+    }
+    return this->buffer[(this->head + offset) % this->buffer.size()];
+}
+
+void RingBuffer::copy_to(size_t offset, size_t length, std::uint8_t* destination) const {
+    if (offset + length > this->count) {
+        throw std::out_of_range("RingBuffer: copy beyond stored bytes");
+    }
+
+    size_t start = (this->head + offset) % this->buffer.size();
+    size_t first_part = std::min(length, this->buffer.size() - start);
+    std::copy_n(this->buffer.begin() + start, first_part, destination);
+    std::copy_n(this->buffer.begin(), length - first_part, destination + first_part);
+}
+
+void RingBuffer::consume(size_t length) {
+    if (length > this->count) {
+        throw std::out_of_range("RingBuffer: consume beyond stored bytes");
+    }
+
+    this->count -= length;
+    // restart at the beginning when empty, so the next write region is as big as possible
+    this->head = this->count == 0 ? 0 : (this->head + length) % this->buffer.size();
+}
+
+std::pair<std::uint8_t*, size_t> RingBuffer::write_region() {
+    size_t tail = (this->head + this->count) % this->buffer.size();
+    size_t length;
+    if (this->count == this->buffer.size()) {
+        length = 0;
+    } else if (tail >= this->head) {
+        length = this->buffer.size() - tail;
+    } else {
+        length = this->head - tail;
+    }
+    return {this->buffer.data() + tail, length};
+}
+
+void RingBuffer::commit(size_t length) {
+    if (length > this->write_region().second) {
+        throw std::out_of_range("RingBuffer: commit beyond write region");
+    }
+    this->count += length;
+}
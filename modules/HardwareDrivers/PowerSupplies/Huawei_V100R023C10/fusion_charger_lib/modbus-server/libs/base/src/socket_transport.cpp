@@ -3,6 +3,8 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 
+#include <cerrno>
+
 #include <modbus-server/transport.hpp>
 
 #include "poll.h"
@@ -50,6 +52,40 @@ std::optional<std::vector<std::uint8_t>> modbus_server::ModbusSocketTransport::t
 
     return read_bytes(count);
 }
+
+size_t ModbusSocketTransport::read_available(std::uint8_t* buffer, size_t max_count,
+                                             std::chrono::milliseconds timeout) {
+    struct pollfd pfd[1];
+    pfd[0].fd = this->socket;
+    pfd[0].events = POLLIN;
+
+    auto result_code = poll(pfd, 1, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+    auto error = errno;
+    if (result_code < 0) {
+        if (error == EINTR) {
+            return 0;
+        }
+        throw std::runtime_error("Failed to poll modbus data, errno: " + std::to_string(error));
+    }
+
+    if (result_code == 0) {
+        return 0;
+    }
+
+    ssize_t err = recv(this->socket, buffer, max_count, 0);
+
+    if (err == 0) {
+        throw transport_exceptions::ConnectionClosedException("Socket closed");
+    }
+
+    if (err < 0) {
+        throw std::runtime_error("Failed to read bytes, err: " + std::to_string(err) +
+                                 "errno: " + std::to_string(errno));
+    }
+
+    return static_cast<size_t>(err);
+}
+
 void ModbusSocketTransport::write_bytes(const std::vector<std::uint8_t>& bytes) {
     int err = send(this->socket, bytes.data(), bytes.size(), 0);
 
@@ -3,6 +3,7 @@
 #ifndef DUMMY_MODBUS_TRANSPORT_HPP_
 #define DUMMY_MODBUS_TRANSPORT_HPP_
 
+#include <algorithm>
 #include <modbus-server/transport.hpp>
 #include <stdexcept>
 
@@ -26,6 +27,16 @@ public:
         return bytes;
     }
 
+    size_t read_available(std::uint8_t* buffer, size_t max_count, std::chrono::milliseconds timeout) override {
+        if (incoming_data.empty() && timeout.count() < 0) {
+            throw std::runtime_error("DummyModbusTransport: not enough data to read");
+        }
+        size_t count = std::min(max_count, incoming_data.size());
+        std::copy_n(incoming_data.begin(), count, buffer);
+        incoming_data.erase(incoming_data.begin(), incoming_data.begin() + count);
+        return count;
+    }
+
     void write_bytes(const std::vector<std::uint8_t>& bytes) override {
         outgoing_data.insert(outgoing_data.end(), bytes.begin(), bytes.end());
     }
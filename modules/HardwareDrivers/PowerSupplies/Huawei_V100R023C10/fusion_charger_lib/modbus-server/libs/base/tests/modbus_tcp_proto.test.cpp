@@ -196,7 +196,37 @@ TEST(ModbusTCPProtocol, zero_length) {
     ModbusTCPProtocol protocol = ModbusTCPProtocol(transport, 0xab, 0xc0de);
 
     transport->add_incoming_data({0xc0, 0xde, 0, 0, 0, 0, 0xab}); // empty pdu
-    auto a = protocol.try_receive();
+    auto a = protocol.try_receive(std::chrono::milliseconds(0));
 
     ASSERT_EQ(a.has_value(), false);
 }
+
+TEST(ModbusTCPProtocol, multiple_frames_in_one_read) {
+    auto transport = std::make_shared<DummyModbusTransport>();
+    ModbusTCPProtocol protocol = ModbusTCPProtocol(transport, 0xab, 0xc0de);
+
+    // two frames and the first half of a third frame arrive at once
+    transport->add_incoming_data({0x00, 0x01, 0, 0, 0, 3, 0xab, 0x03, 0x10});
+    transport->add_incoming_data({0x00, 0x02, 0, 0, 0, 4, 0xab, 0x06, 0x20, 0x21});
+    transport->add_incoming_data({0x00, 0x03, 0, 0, 0, 3});
+
+    auto first = protocol.try_receive(std::chrono::milliseconds(0));
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->second.function_code, 0x03);
+    ASSERT_EQ(first->second.data, std::vector<std::uint8_t>({0x10}));
+
+    auto second = protocol.try_receive(std::chrono::milliseconds(0));
+    ASSERT_TRUE(second.has_value());
+    ASSERT_EQ(second->second.function_code, 0x06);
+    ASSERT_EQ(second->second.data, std::vector<std::uint8_t>({0x20, 0x21}));
+
+    // the third frame is incomplete and kept until the rest arrives
+    ASSERT_FALSE(protocol.try_receive(std::chrono::milliseconds(0)).has_value());
+    transport->add_incoming_data({0xab, 0x10, 0x30});
+
+    auto third = protocol.try_receive(std::chrono::milliseconds(0));
+    ASSERT_TRUE(third.has_value());
+    ASSERT_EQ(third->first.data[1], 0x03);
+    ASSERT_EQ(third->second.function_code, 0x10);
+    ASSERT_EQ(third->second.data, std::vector<std::uint8_t>({0x30}));
+}
@@ -352,3 +352,60 @@ TEST(PDUCorrelationLayer, timeout_works_accurate) {
 
     thread.join();
 }
+
+TEST(PDUCorrelationLayer, request_response_async_pipelined) {
+    auto transport = std::make_shared<DummyModbusTransport>();
+    auto protocol = std::make_shared<ModbusTCPProtocol>(transport, 0x01, 0x0000);
+    PDUCorrelationLayer pal(protocol);
+
+    std::vector<std::pair<int, pdu::GenericPDU>> responses;
+
+    // both requests are in transit before any response is received
+    pal.request_response_async(pdu::GenericPDU(0x03, {0x01}), std::chrono::milliseconds(1000),
+                               [&responses](std::optional<pdu::GenericPDU> response) {
+                                   ASSERT_TRUE(response.has_value());
+                                   responses.emplace_back(1, response.value());
+                               });
+    pal.request_response_async(pdu::GenericPDU(0x06, {0x02}), std::chrono::milliseconds(1000),
+                               [&responses](std::optional<pdu::GenericPDU> response) {
+                                   ASSERT_TRUE(response.has_value());
+                                   responses.emplace_back(2, response.value());
+                               });
+    ASSERT_EQ(transport->get_outgoing_data().size(), 2 * 9);
+
+    // answers arrive out of order, the second one as error response
+    transport->add_incoming_data({0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x01, 0x86, 0x02});
+    transport->add_incoming_data({0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0x03, 0x0a});
+
+    ASSERT_TRUE(pal.poll(std::chrono::milliseconds(0)));
+    ASSERT_TRUE(pal.poll(std::chrono::milliseconds(0)));
+
+    ASSERT_EQ(responses.size(), 2);
+    ASSERT_EQ(responses[0].first, 2);
+    ASSERT_EQ(responses[0].second.function_code, 0x86);
+    ASSERT_EQ(responses[1].first, 1);
+    ASSERT_EQ(responses[1].second.function_code, 0x03);
+    ASSERT_EQ(responses[1].second.data, std::vector<std::uint8_t>({0x0a}));
+}
+
+TEST(PDUCorrelationLayer, request_response_async_timeout) {
+    auto transport = std::make_shared<DummyModbusTransport>();
+    auto protocol = std::make_shared<ModbusTCPProtocol>(transport, 0x01, 0x0000);
+    PDUCorrelationLayer pal(protocol);
+
+    std::optional<std::optional<pdu::GenericPDU>> result;
+    pal.request_response_async(pdu::GenericPDU(0xab, {0x01}), std::chrono::milliseconds(20),
+                               [&result](std::optional<pdu::GenericPDU> response) { result = response; });
+
+    ASSERT_FALSE(pal.poll(std::chrono::milliseconds(0)));
+    ASSERT_FALSE(result.has_value());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    ASSERT_FALSE(pal.poll(std::chrono::milliseconds(0)));
+    ASSERT_TRUE(result.has_value());
+    ASSERT_FALSE(result.value().has_value());
+
+    // a late response is not correlated anymore
+    transport->add_incoming_data({0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x01, 0xab, 0x0a});
+    ASSERT_TRUE(pal.poll(std::chrono::milliseconds(0)));
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <modbus-server/ring_buffer.hpp>
+
+using namespace modbus_server;
+
+static void write(RingBuffer& buffer, const std::vector<std::uint8_t>& data) {
+    auto [region, region_size] = buffer.write_region();
+    ASSERT_GE(region_size, data.size());
+    std::memcpy(region, data.data(), data.size());
+    buffer.commit(data.size());
+}
+
+TEST(RingBuffer, write_peek_consume) {
+    RingBuffer buffer(8);
+    write(buffer, {0x01, 0x02, 0x03});
+
+    ASSERT_EQ(buffer.size(), 3);
+    ASSERT_EQ(buffer.peek(0), 0x01);
+    ASSERT_EQ(buffer.peek(2), 0x03);
+    ASSERT_THROW(buffer.peek(3), std::out_of_range);
+
+    buffer.consume(2);
+    ASSERT_EQ(buffer.size(), 1);
+    ASSERT_EQ(buffer.peek(0), 0x03);
+}
+
+TEST(RingBuffer, wraps_around) {
+    RingBuffer buffer(8);
+    write(buffer, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06});
+    buffer.consume(5);
+
+    // the free space wraps around, so it is split into two write regions
+    ASSERT_EQ(buffer.write_region().second, 2);
+    write(buffer, {0x07, 0x08});
+    ASSERT_EQ(buffer.write_region().second, 5);
+    write(buffer, {0x09, 0x0a, 0x0b});
+
+    std::vector<std::uint8_t> data(buffer.size());
+    buffer.copy_to(0, data.size(), data.data());
+    ASSERT_EQ(data, std::vector<std::uint8_t>({0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b}));
+}
+
+TEST(RingBuffer, full) {
+    RingBuffer buffer(4);
+    write(buffer, {0x01, 0x02, 0x03, 0x04});
+
+    ASSERT_EQ(buffer.write_region().second, 0);
+    ASSERT_THROW(buffer.commit(1), std::out_of_range);
+    ASSERT_THROW(buffer.consume(5), std::out_of_range);
+}
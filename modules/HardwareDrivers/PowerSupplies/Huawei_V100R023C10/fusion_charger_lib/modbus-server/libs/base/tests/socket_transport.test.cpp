@@ -116,3 +116,35 @@ TEST(SocketTransport, closed_socket_write_throws_err) {
 
     ASSERT_THROW(transport.write_bytes({0x01}), std::runtime_error);
 }
+
+TEST(SocketTransport, read_available_works) {
+    int fds[2];
+    int err = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    ASSERT_EQ(err, 0);
+
+    modbus_server::ModbusSocketTransport transport(fds[0]);
+    std::uint8_t buffer[8];
+
+    // nothing available, the timeout is reached
+    ASSERT_EQ(transport.read_available(buffer, sizeof(buffer), std::chrono::milliseconds(10)), 0);
+
+    // returns as soon as data arrives, without waiting for the buffer to be filled
+    auto thread = std::thread([&fds]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::vector<std::uint8_t> data = {0x01, 0x02, 0x03};
+        ASSERT_EQ(write(fds[1], data.data(), data.size()), data.size());
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(transport.read_available(buffer, sizeof(buffer), std::chrono::milliseconds(5000)), 3);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+    ASSERT_EQ(buffer[0], 0x01);
+    ASSERT_EQ(buffer[2], 0x03);
+
+    thread.join();
+
+    close(fds[1]);
+    ASSERT_THROW(transport.read_available(buffer, sizeof(buffer), std::chrono::milliseconds(10)),
+                 modbus_server::transport_exceptions::ConnectionClosedException);
+    close(fds[0]);
+}
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <future>
+#include <modbus-server/client.hpp>
+#include <modbus-server/modbus_basic_server.hpp>
+#include <thread>
+
+using namespace modbus_server;
+using namespace modbus_server::client;
+
+// Client and ModbusBasicServer connected via a socket pair
+class ModbusLoopback : public ::testing::Test {
+protected:
+    int fds[2];
+    std::vector<std::uint16_t> registers = std::vector<std::uint16_t>(0x100);
+
+    std::shared_ptr<PDUCorrelationLayer> client_pcl;
+    std::shared_ptr<PDUCorrelationLayer> server_pcl;
+    std::optional<ModbusBasicServer> server;
+
+    std::atomic<bool> running{true};
+    std::thread client_thread;
+    std::thread server_thread;
+
+    void SetUp() override {
+        ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+        for (size_t i = 0; i < registers.size(); i++) {
+            registers[i] = 0x1000 + i;
+        }
+
+        server_pcl = std::make_shared<PDUCorrelationLayer>(
+            std::make_shared<ModbusTCPProtocol>(std::make_shared<ModbusSocketTransport>(fds[1])));
+        server.emplace(server_pcl);
+        server->set_read_holding_registers_request_cb([this](const pdu::ReadHoldingRegistersRequest& req) {
+            std::vector<std::uint8_t> data;
+            for (int i = 0; i < req.register_count; i++) {
+                data.push_back(registers.at(req.register_start + i) >> 8);
+                data.push_back(registers.at(req.register_start + i) & 0xFF);
+            }
+            return pdu::ReadHoldingRegistersResponse(req, data);
+        });
+        server->set_write_single_register_request_cb([this](const pdu::WriteSingleRegisterRequest& req) {
+            registers.at(req.register_address) = req.register_value;
+            return pdu::WriteSingleRegisterResponse(req);
+        });
+
+        client_pcl = std::make_shared<PDUCorrelationLayer>(
+            std::make_shared<ModbusTCPProtocol>(std::make_shared<ModbusSocketTransport>(fds[0]), 0x01, 0x0000));
+
+        server_thread = std::thread([this]() {
+            try {
+                while (true) {
+                    server_pcl->blocking_poll();
+                }
+            } catch (const transport_exceptions::ConnectionClosedException&) {
+            }
+        });
+        client_thread = std::thread([this]() {
+            while (running) {
+                client_pcl->poll(std::chrono::milliseconds(10));
+            }
+        });
+    }
+
+    void TearDown() override {
+        running = false;
+        client_thread.join();
+        shutdown(fds[0], SHUT_RDWR);
+        server_thread.join();
+        close(fds[0]);
+        close(fds[1]);
+    }
+};
+
+TEST_F(ModbusLoopback, client_requests) {
+    ModbusClient client(client_pcl);
+
+    client.write_single_register(0x05, 0xbeef);
+    auto response = client.read_holding_registers(0x04, 3);
+
+    ASSERT_EQ(response, std::vector<std::uint16_t>({0x1004, 0xbeef, 0x1006}));
+}
+
+TEST_F(ModbusLoopback, pipelined_async_requests) {
+    const int request_count = 32;
+    std::vector<std::optional<std::uint16_t>> results(request_count);
+    std::atomic<int> outstanding{request_count};
+    std::promise<void> all_done;
+
+    // all requests are sent before the responses are awaited
+    for (int i = 0; i < request_count; i++) {
+        pdu::ReadHoldingRegistersRequest request;
+        request.register_start = i;
+        request.register_count = 1;
+
+        client_pcl->request_response_async(
+            request.to_generic(), std::chrono::seconds(5), [&, i](std::optional<pdu::GenericPDU> response) {
+                if (response.has_value()) {
+                    pdu::ReadHoldingRegistersResponse response_data;
+                    response_data.from_generic(response.value());
+                    results[i] = response_data.get_register_data().at(0);
+                }
+                if (--outstanding == 0) {
+                    all_done.set_value();
+                }
+            });
+    }
+
+    ASSERT_EQ(all_done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    for (int i = 0; i < request_count; i++) {
+        ASSERT_TRUE(results[i].has_value());
+        ASSERT_EQ(results[i].value(), 0x1000 + i);
+    }
+}
@@ -16,6 +16,7 @@ public:
 
     std::vector<std::uint8_t> read_bytes(size_t count) override;
     std::optional<std::vector<std::uint8_t>> try_read_bytes(size_t count) override;
+    size_t read_available(std::uint8_t* buffer, size_t max_count, std::chrono::milliseconds timeout) override;
 
     void write_bytes(const std::vector<std::uint8_t>& bytes) override;
 
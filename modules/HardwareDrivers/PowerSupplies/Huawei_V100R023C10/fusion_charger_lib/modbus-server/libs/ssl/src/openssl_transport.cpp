@@ -2,6 +2,7 @@
 // Copyright 2020 - 2025 Pionix GmbH and Contributors to EVerest
 #include <openssl/err.h>
 #include <openssl/ssl.h>
+#include <poll.h>
 
 #include <modbus-ssl/openssl_transport.hpp>
 #include <stdexcept>
@@ -114,6 +115,55 @@ std::optional<std::vector<std::uint8_t>> OpenSSLTransport::try_read_bytes(size_t
     return buffer;
 }
 
+size_t OpenSSLTransport::read_available(std::uint8_t* buffer, size_t max_count, std::chrono::milliseconds timeout) {
+    bool pending;
+    int fd;
+    {
+        auto lock = std::lock_guard(mutex);
+        pending = SSL_pending(ssl) > 0;
+        fd = SSL_get_fd(ssl);
+    }
+
+    // Wait on the socket without holding the lock, so writes are not blocked while waiting for data
+    if (!pending) {
+        struct pollfd pfd[1];
+        pfd[0].fd = fd;
+        pfd[0].events = POLLIN;
+
+        auto result_code = poll(pfd, 1, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+        auto error = errno;
+        if (result_code < 0) {
+            if (error == EINTR) {
+                return 0;
+            }
+            throw std::runtime_error("Failed to poll modbus data, errno: " + std::to_string(error));
+        }
+
+        if (result_code == 0) {
+            return 0;
+        }
+    }
+
+    auto lock = std::lock_guard(mutex);
+    int ret = SSL_read(ssl, buffer, max_count);
+    if (ret <= 0) {
+        int err = SSL_get_error(ssl, ret);
+
+        // "The operation did not complete and can be retried later.", e.g. only a partial record arrived
+        if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+            return 0;
+        }
+
+        if (err == SSL_ERROR_ZERO_RETURN) {
+            throw modbus_server::transport_exceptions::ConnectionClosedException();
+        }
+
+        throw OpenSSLTransportException("SSL_read failed with error " + std::string(ERR_error_string(err, NULL)), err);
+    }
+
+    return static_cast<size_t>(ret);
+}
+
 void OpenSSLTransport::write_bytes(const std::vector<std::uint8_t>& bytes) {
     size_t written = 0;
 
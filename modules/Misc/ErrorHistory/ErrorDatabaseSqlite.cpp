@@ -11,10 +11,27 @@
 
 #include <utils/date.hpp>
 
+#include <chrono>
 #include <set>
+#include <vector>
 
 namespace module {
 
+namespace {
+// time the writer waits for further errors before committing, so that error storms are written in few transactions
+constexpr std::chrono::milliseconds GROUP_COMMIT_DELAY{100};
+
+const std::string ERROR_COLUMNS = "uuid, type, description, message, origin_module, origin_implementation, timestamp, "
+                                  "severity, state, sub_type, vendor_id";
+
+// secondary indexes for the columns used by filters_to_sql_condition, uuid is the primary key
+const std::vector<std::string> ERROR_INDEXES = {
+    "CREATE INDEX IF NOT EXISTS errors_state_index ON errors(state);",
+    "CREATE INDEX IF NOT EXISTS errors_origin_index ON errors(origin_module, origin_implementation);",
+    "CREATE INDEX IF NOT EXISTS errors_type_index ON errors(type);",
+    "CREATE INDEX IF NOT EXISTS errors_timestamp_index ON errors(timestamp);"};
+} // namespace
+
 ErrorDatabaseSqlite::ErrorDatabaseSqlite(const fs::path& db_path_, const bool reset_) :
     db_path(fs::absolute(db_path_)) {
     BOOST_LOG_FUNCTION();
@@ -34,6 +51,52 @@ ErrorDatabaseSqlite::ErrorDatabaseSqlite(const fs::path& db_path_, const bool re
             this->reset_database();
         }
     }
+    this->open_database();
+    this->writer = std::thread([this]() { this->run_writer(); });
+}
+
+ErrorDatabaseSqlite::~ErrorDatabaseSqlite() {
+    {
+        std::lock_guard<std::mutex> lock(this->queue_mutex);
+        this->stop_writer = true;
+    }
+    this->queue_cv.notify_one();
+    if (this->writer.joinable()) {
+        this->writer.join();
+    }
+    std::lock_guard<std::mutex> lock(this->db_mutex);
+    this->write_queued_errors_without_mutex();
+}
+
+void ErrorDatabaseSqlite::open_database() {
+    BOOST_LOG_FUNCTION();
+    try {
+        this->db = std::make_unique<everest::db::sqlite::Connection>(this->db_path);
+        if (!this->db->open_connection()) {
+            EVLOG_error << "Error opening database";
+            throw everest::db::ConnectionException(this->db->get_error_message());
+        }
+        // with write-ahead logging a commit only appends to the log instead of rewriting the database pages
+        if (!this->db->execute_statement("PRAGMA journal_mode = WAL;")) {
+            EVLOG_warning << "Could not enable write-ahead logging";
+        }
+        for (const auto& sql : ERROR_INDEXES) {
+            if (!this->db->execute_statement(sql)) {
+                throw everest::db::QueryExecutionException(this->db->get_error_message());
+            }
+        }
+        this->insert_stmt = this->db->new_statement("INSERT INTO errors(" + ERROR_COLUMNS +
+                                                    ") VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11);");
+        this->update_stmt = this->db->new_statement(
+            "UPDATE errors SET uuid = ?1, type = ?2, description = ?3, message = ?4, origin_module = ?5, "
+            "origin_implementation = ?6, timestamp = ?7, severity = ?8, state = ?9, sub_type = ?10, vendor_id = ?11 "
+            "WHERE uuid = ?12;");
+    } catch (const std::exception& e) {
+        EVLOG_error << "Error opening database: " << e.what();
+        this->insert_stmt.reset();
+        this->update_stmt.reset();
+        this->db.reset();
+    }
 }
 
 void ErrorDatabaseSqlite::check_database() {
@@ -99,6 +162,8 @@ void ErrorDatabaseSqlite::reset_database() {
     if (fs::exists(this->db_path)) {
         fs::remove(this->db_path);
     }
+    fs::remove(this->db_path.string() + "-wal");
+    fs::remove(this->db_path.string() + "-shm");
     try {
         everest::db::sqlite::Connection db(this->db_path);
         if (!db.open_connection()) {
@@ -128,42 +193,74 @@ void ErrorDatabaseSqlite::reset_database() {
 }
 
 void ErrorDatabaseSqlite::add_error(Everest::error::ErrorPtr error) {
-    std::lock_guard<std::mutex> lock(this->db_mutex);
-    this->add_error_without_mutex(error);
+    {
+        std::lock_guard<std::mutex> lock(this->queue_mutex);
+        // queue a copy, the error is written later and must not change in the meantime
+        this->queued_errors.push_back(std::make_shared<Everest::error::Error>(*error));
+    }
+    this->queue_cv.notify_one();
+}
+
+void ErrorDatabaseSqlite::run_writer() {
+    std::unique_lock<std::mutex> queue_lock(this->queue_mutex);
+    while (!this->stop_writer) {
+        this->queue_cv.wait(queue_lock, [this]() { return this->stop_writer || !this->queued_errors.empty(); });
+        this->queue_cv.wait_for(queue_lock, GROUP_COMMIT_DELAY, [this]() { return this->stop_writer; });
+        queue_lock.unlock();
+        {
+            std::lock_guard<std::mutex> lock(this->db_mutex);
+            this->write_queued_errors_without_mutex();
+        }
+        queue_lock.lock();
+    }
 }
 
-void ErrorDatabaseSqlite::add_error_without_mutex(Everest::error::ErrorPtr error) {
+void ErrorDatabaseSqlite::write_queued_errors_without_mutex() const {
     BOOST_LOG_FUNCTION();
+    // queued errors are only taken while holding db_mutex, so every reader sees all errors added before
+    std::vector<Everest::error::ErrorPtr> errors;
+    {
+        std::lock_guard<std::mutex> lock(this->queue_mutex);
+        errors.swap(this->queued_errors);
+    }
+    if (errors.empty()) {
+        return;
+    }
     try {
-        everest::db::sqlite::Connection db(this->db_path);
-        if (!db.open_connection()) {
-            EVLOG_error << "Error opening database";
-            throw everest::db::ConnectionException(db.get_error_message());
+        if (this->db == nullptr) {
+            throw everest::db::ConnectionException("Database is not open");
         }
-        std::string sql = "INSERT INTO errors(uuid, type, description, message, origin_module, origin_implementation, "
-                          "timestamp, severity, state, sub_type, vendor_id) VALUES(";
-        sql += "?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11);";
-        auto stmt = db.new_statement(sql);
-        stmt->bind_text(1, error->uuid.to_string(), everest::db::sqlite::SQLiteString::Transient);
-        stmt->bind_text(2, error->type);
-        stmt->bind_text(3, error->description);
-        stmt->bind_text(4, error->message);
-        stmt->bind_text(5, error->origin.module_id);
-        stmt->bind_text(6, error->origin.implementation_id);
-        stmt->bind_text(7, Everest::Date::to_rfc3339(error->timestamp), everest::db::sqlite::SQLiteString::Transient);
-        stmt->bind_text(8, Everest::error::severity_to_string(error->severity),
-                        everest::db::sqlite::SQLiteString::Transient);
-        stmt->bind_text(9, Everest::error::state_to_string(error->state), everest::db::sqlite::SQLiteString::Transient);
-        stmt->bind_text(10, error->sub_type);
-        stmt->bind_text(11, error->vendor_id);
-        if (stmt->step() != SQLITE_DONE) {
-            throw everest::db::QueryExecutionException(db.get_error_message());
+        auto transaction = this->db->begin_transaction();
+        for (const Everest::error::ErrorPtr& error : errors) {
+            this->bind_error(*this->insert_stmt, error);
+            const int status = this->insert_stmt->step();
+            this->insert_stmt->reset();
+            if (status != SQLITE_DONE) {
+                EVLOG_error << "Error adding error to database: " << this->db->get_error_message();
+            }
         }
+        transaction->commit();
     } catch (const std::exception& e) {
-        EVLOG_error << "Error adding error to database: " << e.what();
+        EVLOG_error << "Error adding errors to database: " << e.what();
     }
 }
 
+void ErrorDatabaseSqlite::bind_error(everest::db::sqlite::StatementInterface& stmt,
+                                     const Everest::error::ErrorPtr& error) const {
+    stmt.bind_text(1, error->uuid.to_string(), everest::db::sqlite::SQLiteString::Transient);
+    stmt.bind_text(2, error->type);
+    stmt.bind_text(3, error->description);
+    stmt.bind_text(4, error->message);
+    stmt.bind_text(5, error->origin.module_id);
+    stmt.bind_text(6, error->origin.implementation_id);
+    stmt.bind_text(7, Everest::Date::to_rfc3339(error->timestamp), everest::db::sqlite::SQLiteString::Transient);
+    stmt.bind_text(8, Everest::error::severity_to_string(error->severity),
+                   everest::db::sqlite::SQLiteString::Transient);
+    stmt.bind_text(9, Everest::error::state_to_string(error->state), everest::db::sqlite::SQLiteString::Transient);
+    stmt.bind_text(10, error->sub_type);
+    stmt.bind_text(11, error->vendor_id);
+}
+
 std::string ErrorDatabaseSqlite::filter_to_sql_condition(const Everest::error::ErrorFilter& filter) {
     std::string condition{};
     switch (filter.get_filter_type()) {
@@ -228,6 +325,7 @@ ErrorDatabaseSqlite::filters_to_sql_condition(const std::list<Everest::error::Er
 std::list<Everest::error::ErrorPtr>
 ErrorDatabaseSqlite::get_errors(const std::list<Everest::error::ErrorFilter>& filters) const {
     std::lock_guard<std::mutex> lock(this->db_mutex);
+    this->write_queued_errors_without_mutex();
     return this->get_errors(ErrorDatabaseSqlite::filters_to_sql_condition(filters));
 }
 
@@ -235,42 +333,35 @@ std::list<Everest::error::ErrorPtr> ErrorDatabaseSqlite::get_errors(const std::o
     BOOST_LOG_FUNCTION();
     std::list<Everest::error::ErrorPtr> result;
     try {
-        everest::db::sqlite::Connection db(this->db_path);
-        if (!db.open_connection()) {
-            EVLOG_error << "Error opening database";
-            throw everest::db::ConnectionException(db.get_error_message());
+        if (this->db == nullptr) {
+            throw everest::db::ConnectionException("Database is not open");
         }
-        std::string sql = "SELECT * FROM errors";
+        std::string sql = "SELECT " + ERROR_COLUMNS + " FROM errors";
         if (condition.has_value()) {
             sql += " WHERE " + condition.value();
         }
         EVLOG_debug << "Executing SQL statement: " << sql;
-        auto stmt = db.new_statement(sql);
+        auto stmt = this->db->new_statement(sql);
         int status;
         while ((status = stmt->step()) == SQLITE_ROW) {
-            const Everest::error::ErrorType err_type(std::get<std::string>(stmt->column_variant("type")));
-            const std::string err_description = std::get<std::string>(stmt->column_variant("description"));
-            const std::string err_msg = std::get<std::string>(stmt->column_variant("message"));
-            const std::string err_origin_module_id = std::get<std::string>(stmt->column_variant("origin_module"));
-            const std::string err_origin_impl_id = std::get<std::string>(stmt->column_variant("origin_implementation"));
-            const ImplementationIdentifier err_origin(err_origin_module_id, err_origin_impl_id);
-            const Everest::error::Error::time_point err_timestamp =
-                Everest::Date::from_rfc3339(std::get<std::string>(stmt->column_variant("timestamp")));
-            const Everest::error::Severity err_severity =
-                Everest::error::string_to_severity(std::get<std::string>(stmt->column_variant("severity")));
-            const Everest::error::State err_state =
-                Everest::error::string_to_state(std::get<std::string>(stmt->column_variant("state")));
-            const Everest::error::ErrorHandle err_handle(
-                Everest::error::ErrorHandle(std::get<std::string>(stmt->column_variant("uuid"))));
-            const Everest::error::ErrorSubType err_sub_type(std::get<std::string>(stmt->column_variant("sub_type")));
-            const std::string err_vendor_id = std::get<std::string>(stmt->column_variant("vendor_id"));
+            // columns in the order of ERROR_COLUMNS
+            const Everest::error::ErrorHandle err_handle(Everest::error::ErrorHandle(stmt->column_text(0)));
+            const Everest::error::ErrorType err_type(stmt->column_text(1));
+            const std::string err_description = stmt->column_text(2);
+            const std::string err_msg = stmt->column_text(3);
+            const ImplementationIdentifier err_origin(stmt->column_text(4), stmt->column_text(5));
+            const Everest::error::Error::time_point err_timestamp = Everest::Date::from_rfc3339(stmt->column_text(6));
+            const Everest::error::Severity err_severity = Everest::error::string_to_severity(stmt->column_text(7));
+            const Everest::error::State err_state = Everest::error::string_to_state(stmt->column_text(8));
+            const Everest::error::ErrorSubType err_sub_type(stmt->column_text(9));
+            const std::string err_vendor_id = stmt->column_text(10);
             Everest::error::ErrorPtr error = std::make_shared<Everest::error::Error>(
                 err_type, err_sub_type, err_msg, err_description, err_origin, err_vendor_id, err_severity,
                 err_timestamp, err_handle, err_state);
             result.push_back(error);
         }
         if (status != SQLITE_DONE) {
-            throw everest::db::QueryExecutionException(db.get_error_message());
+            throw everest::db::QueryExecutionException(this->db->get_error_message());
         }
     } catch (const std::exception& e) {
         EVLOG_error << "Error getting errors from database: " << e.what();
@@ -280,37 +371,56 @@ std::list<Everest::error::ErrorPtr> ErrorDatabaseSqlite::get_errors(const std::o
 
 std::list<Everest::error::ErrorPtr>
 ErrorDatabaseSqlite::edit_errors(const std::list<Everest::error::ErrorFilter>& filters, EditErrorFunc edit_func) {
+    BOOST_LOG_FUNCTION();
     std::lock_guard<std::mutex> lock(this->db_mutex);
-    std::list<Everest::error::ErrorPtr> result = this->remove_errors_without_mutex(filters);
-    for (Everest::error::ErrorPtr& error : result) {
-        edit_func(error);
-        this->add_error_without_mutex(error);
+    this->write_queued_errors_without_mutex();
+    std::list<Everest::error::ErrorPtr> result =
+        this->get_errors(ErrorDatabaseSqlite::filters_to_sql_condition(filters));
+    if (result.empty()) {
+        return result;
+    }
+    try {
+        if (this->db == nullptr) {
+            throw everest::db::ConnectionException("Database is not open");
+        }
+        auto transaction = this->db->begin_transaction();
+        for (Everest::error::ErrorPtr& error : result) {
+            // the edit function may change the uuid as well, so the row is identified by the uuid before the edit
+            const std::string uuid = error->uuid.to_string();
+            edit_func(error);
+            this->bind_error(*this->update_stmt, error);
+            this->update_stmt->bind_text(12, uuid);
+            const int status = this->update_stmt->step();
+            this->update_stmt->reset();
+            if (status != SQLITE_DONE) {
+                throw everest::db::QueryExecutionException(this->db->get_error_message());
+            }
+        }
+        transaction->commit();
+    } catch (const std::exception& e) {
+        EVLOG_error << "Error editing errors in database: " << e.what();
     }
     return result;
 }
 
 std::list<Everest::error::ErrorPtr>
 ErrorDatabaseSqlite::remove_errors(const std::list<Everest::error::ErrorFilter>& filters) {
-    std::lock_guard<std::mutex> lock(this->db_mutex);
-    return this->remove_errors_without_mutex(filters);
-}
-
-std::list<Everest::error::ErrorPtr>
-ErrorDatabaseSqlite::remove_errors_without_mutex(const std::list<Everest::error::ErrorFilter>& filters) {
     BOOST_LOG_FUNCTION();
+    std::lock_guard<std::mutex> lock(this->db_mutex);
+    this->write_queued_errors_without_mutex();
     std::optional<std::string> condition = ErrorDatabaseSqlite::filters_to_sql_condition(filters);
     std::list<Everest::error::ErrorPtr> result = this->get_errors(condition);
     try {
-        everest::db::sqlite::Connection db(this->db_path);
-        if (!db.open_connection()) {
-            EVLOG_error << "Error opening database";
-            throw everest::db::ConnectionException(db.get_error_message());
+        if (this->db == nullptr) {
+            throw everest::db::ConnectionException("Database is not open");
         }
         std::string sql = "DELETE FROM errors";
         if (condition.has_value()) {
             sql += " WHERE " + condition.value();
         }
-        db.execute_statement(sql);
+        if (!this->db->execute_statement(sql)) {
+            throw everest::db::QueryExecutionException(this->db->get_error_message());
+        }
     } catch (const std::exception& e) {
         EVLOG_error << "Error removing errors from database: " << e.what();
     }
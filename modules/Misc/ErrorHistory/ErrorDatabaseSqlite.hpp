@@ -6,15 +6,28 @@
 
 #include <utils/error/error_database.hpp>
 
+#include <everest/database/sqlite/connection.hpp>
+
+#include <condition_variable>
 #include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace fs = std::filesystem;
 
 namespace module {
 
+///
+/// \brief ErrorDatabase that stores the errors in a sqlite database
+/// The database is kept open for the lifetime of the object. Added errors are queued and written by a writer thread,
+/// which commits all errors queued in the meantime in a single transaction. Reading, editing or removing errors first
+/// writes the queued errors, so the results always include all errors added before.
+///
 class ErrorDatabaseSqlite : public Everest::error::ErrorDatabase {
 public:
     explicit ErrorDatabaseSqlite(const fs::path& db_path_, const bool reset_ = false);
+    ~ErrorDatabaseSqlite() override;
 
     std::list<Everest::error::ErrorPtr>
     get_errors(const std::list<Everest::error::ErrorFilter>& filters) const override;
@@ -25,9 +38,10 @@ public:
     std::list<Everest::error::ErrorPtr> remove_errors(const std::list<Everest::error::ErrorFilter>& filters) override;
 
 private:
-    void add_error_without_mutex(Everest::error::ErrorPtr error);
-    std::list<Everest::error::ErrorPtr>
-    remove_errors_without_mutex(const std::list<Everest::error::ErrorFilter>& filters);
+    void open_database();
+    void write_queued_errors_without_mutex() const;
+    void bind_error(everest::db::sqlite::StatementInterface& stmt, const Everest::error::ErrorPtr& error) const;
+    void run_writer();
     std::list<Everest::error::ErrorPtr> get_errors(const std::optional<std::string>& condition) const;
     static std::string filter_to_sql_condition(const Everest::error::ErrorFilter& filter);
     static std::optional<std::string> filters_to_sql_condition(const std::list<Everest::error::ErrorFilter>& filters);
@@ -35,7 +49,18 @@ private:
     void reset_database();
     void check_database();
     const fs::path db_path;
+    // protects db and the prepared statements, queued errors are only taken out of the queue while holding it
     mutable std::mutex db_mutex;
+    std::unique_ptr<everest::db::sqlite::Connection> db;
+    std::unique_ptr<everest::db::sqlite::StatementInterface> insert_stmt;
+    std::unique_ptr<everest::db::sqlite::StatementInterface> update_stmt;
+
+    // errors that have been added but not yet written to the database
+    mutable std::mutex queue_mutex;
+    mutable std::vector<Everest::error::ErrorPtr> queued_errors;
+    std::condition_variable queue_cv;
+    bool stop_writer{false};
+    std::thread writer;
 };
 
 } // namespace module
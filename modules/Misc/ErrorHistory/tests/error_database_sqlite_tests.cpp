@@ -285,4 +285,30 @@ SCENARIO("Check ErrorDatabaseSqlite class", "[!throws]") {
             }
         }
     }
+    GIVEN("An error storm written to an ErrorDatabaseSqlite object") {
+        const std::string bin_dir = get_bin_dir().string() + "/";
+        const std::string db_path = bin_dir + "/databases/" + get_unique_db_name();
+        std::vector<Everest::error::ErrorPtr> test_errors;
+        for (int i = 0; i < 200; i++) {
+            test_errors.push_back(std::make_shared<Everest::error::Error>(
+                "test_type", "test_sub_type", "test_message_" + std::to_string(i), "test_description",
+                ImplementationIdentifier("test_origin_module", "test_origin_implementation"), "everest-test",
+                Everest::error::Severity::High, date::utc_clock::now(), Everest::error::UUID(),
+                i % 2 == 0 ? Everest::error::State::Active : Everest::error::State::ClearedByModule));
+        }
+        {
+            module::ErrorDatabaseSqlite writer_db(db_path, true);
+            for (Everest::error::ErrorPtr error : test_errors) {
+                writer_db.add_error(error);
+            }
+            // errors are written asynchronously, but must be visible immediately
+            check_expected_errors_in_list(test_errors, writer_db.get_errors(std::list<Everest::error::ErrorFilter>()));
+        }
+        WHEN("Opening the database again") {
+            TestDatabase db(db_path);
+            THEN("All errors should have been persisted") {
+                check_expected_errors_in_list(test_errors, db.get_errors(std::list<Everest::error::ErrorFilter>()));
+            }
+        }
+    }
 }
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include "Allowlist.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <everest/logging.hpp>
+
+namespace module {
+
+namespace {
+// Interval in which the modification time is checked, in case inotify is not available or missed a change
+constexpr std::chrono::milliseconds WATCH_INTERVAL{1000};
+
+std::optional<std::filesystem::file_time_type> get_last_write_time(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto last_write_time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return last_write_time;
+}
+} // namespace
+
+AllowlistIndex AllowlistIndex::load(const std::filesystem::path& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file");
+    }
+
+    AllowlistIndex index;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        index.add_entry(std::move(line));
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Could not read file");
+    }
+    return index;
+}
+
+void AllowlistIndex::add_entry(std::string entry) {
+    if (entry.empty()) {
+        return;
+    }
+
+    if (entry.back() == '*') {
+        entry.pop_back();
+        const auto length = entry.size();
+        if (this->prefixes_by_length[length].insert(std::move(entry)).second) {
+            this->number_of_prefixes++;
+        }
+        return;
+    }
+
+    this->tokens.insert(std::move(entry));
+}
+
+bool AllowlistIndex::contains(const std::string& token) const {
+    if (this->tokens.count(token) > 0) {
+        return true;
+    }
+
+    for (const auto& [length, prefixes] : this->prefixes_by_length) {
+        if (length > token.size()) {
+            break;
+        }
+        if (prefixes.count(token.substr(0, length)) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t AllowlistIndex::size() const {
+    return this->tokens.size() + this->number_of_prefixes;
+}
+
+Allowlist::Allowlist(const std::filesystem::path& path) : path(path) {
+    // Watch the directory before loading the file, so that no change is missed. Editors often replace the file
+    // instead of writing to it
+    const auto directory = this->path.has_parent_path() ? this->path.parent_path() : std::filesystem::path(".");
+    this->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (this->inotify_fd >= 0 &&
+        inotify_add_watch(this->inotify_fd, directory.c_str(),
+                          IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE) < 0) {
+        EVLOG_warning << "Could not watch " << directory.string() << ", only checking modification time of allowlist";
+        close(this->inotify_fd);
+        this->inotify_fd = -1;
+    }
+
+    this->reload();
+    this->watcher = std::thread([this]() { this->watch(); });
+}
+
+Allowlist::~Allowlist() {
+    this->running = false;
+    if (this->watcher.joinable()) {
+        this->watcher.join();
+    }
+    if (this->inotify_fd >= 0) {
+        close(this->inotify_fd);
+    }
+}
+
+bool Allowlist::is_allowed(const std::string& token) const {
+    const auto current_index = std::atomic_load(&this->index);
+    return current_index != nullptr && current_index->contains(token);
+}
+
+void Allowlist::reload() {
+    this->last_write_time = get_last_write_time(this->path);
+
+    std::shared_ptr<const AllowlistIndex> new_index;
+    try {
+        new_index = std::make_shared<const AllowlistIndex>(AllowlistIndex::load(this->path));
+        EVLOG_info << "Loaded " << new_index->size() << " allowlist entries from " << this->path.string();
+    } catch (const std::exception& e) {
+        EVLOG_error << "Error opening/reading file " << this->path.string() << ": " << e.what();
+        new_index = std::make_shared<const AllowlistIndex>();
+    }
+    std::atomic_store(&this->index, new_index);
+}
+
+void Allowlist::reload_if_modified() {
+    if (get_last_write_time(this->path) != this->last_write_time) {
+        this->reload();
+    }
+}
+
+void Allowlist::watch() {
+    alignas(inotify_event) char buffer[4096];
+    while (this->running) {
+        bool changed = false;
+        if (this->inotify_fd >= 0) {
+            pollfd poll_fd{this->inotify_fd, POLLIN, 0};
+            if (poll(&poll_fd, 1, WATCH_INTERVAL.count()) > 0) {
+                ssize_t length = 0;
+                while ((length = read(this->inotify_fd, buffer, sizeof(buffer))) > 0) {
+                    for (char* ptr = buffer; ptr < buffer + length;) {
+                        const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                        if (event->len > 0 && this->path.filename() == event->name) {
+                            changed = true;
+                        }
+                        ptr += sizeof(inotify_event) + event->len;
+                    }
+                }
+            }
+        } else {
+            std::this_thread::sleep_for(WATCH_INTERVAL);
+        }
+
+        if (changed) {
+            this->reload();
+        } else {
+            this->reload_if_modified();
+        }
+    }
+}
+
+} // namespace module
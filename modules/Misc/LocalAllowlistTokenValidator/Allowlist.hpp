@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef LOCAL_ALLOWLIST_TOKEN_VALIDATOR_ALLOWLIST_HPP
+#define LOCAL_ALLOWLIST_TOKEN_VALIDATOR_ALLOWLIST_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace module {
+
+/// \brief Hashed in-memory index of the entries of an allowlist file.
+///
+/// Every line of the file is one entry. A line ending with '*' is a prefix entry that allows every token starting with
+/// the part before the '*', e.g. to allow a whole group of fleet cards. A line with only '*' allows every token. Empty
+/// lines are ignored.
+class AllowlistIndex {
+public:
+    /// \brief Loads the index from the file at \p path, throws std::runtime_error if the file can not be read
+    static AllowlistIndex load(const std::filesystem::path& path);
+
+    /// \brief Adds the given \p entry to the index
+    void add_entry(std::string entry);
+
+    /// \brief Checks if \p token is allowed. The cost only depends on the number of distinct prefix lengths and not on
+    /// the number of entries.
+    bool contains(const std::string& token) const;
+
+    /// \brief Number of exact and prefix entries
+    std::size_t size() const;
+
+private:
+    std::unordered_set<std::string> tokens;
+    std::map<std::size_t, std::unordered_set<std::string>> prefixes_by_length;
+    std::size_t number_of_prefixes{0};
+};
+
+/// \brief Allowlist file that is held in memory and reloaded when the file changes.
+///
+/// A watcher thread reloads the file when inotify reports a change of it, or when its modification time changed. The
+/// new index is swapped in atomically, so validations never wait for a reload and never touch the file.
+class Allowlist {
+public:
+    explicit Allowlist(const std::filesystem::path& path);
+    ~Allowlist();
+
+    Allowlist(const Allowlist&) = delete;
+    Allowlist& operator=(const Allowlist&) = delete;
+
+    /// \brief Checks if \p token is allowed by the currently loaded allowlist
+    bool is_allowed(const std::string& token) const;
+
+private:
+    void reload();
+    void reload_if_modified();
+    void watch();
+
+    const std::filesystem::path path;
+    std::shared_ptr<const AllowlistIndex> index;
+    std::optional<std::filesystem::file_time_type> last_write_time;
+    int inotify_fd{-1};
+    std::atomic_bool running{true};
+    std::thread watcher;
+};
+
+} // namespace module
+
+#endif // LOCAL_ALLOWLIST_TOKEN_VALIDATOR_ALLOWLIST_HPP
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <catch2/catch_all.hpp>
+
+#include "../Allowlist.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+using namespace module;
+
+namespace {
+
+struct TempDirectory {
+    std::filesystem::path path;
+
+    TempDirectory() {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        path = std::filesystem::temp_directory_path() / ("allowlist_tests_" + std::to_string(now));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+void write_file(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+// waits until \p allowlist reports \p expected for \p token, at most \p timeout
+bool wait_for(const Allowlist& allowlist, const std::string& token, bool expected,
+              std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < end) {
+        if (allowlist.is_allowed(token) == expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+} // namespace
+
+SCENARIO("AllowlistIndex matches tokens", "[Allowlist]") {
+    GIVEN("An index with exact entries") {
+        AllowlistIndex index;
+        index.add_entry("ABC123");
+        index.add_entry("");
+
+        THEN("Only exactly matching tokens are allowed") {
+            CHECK(index.contains("ABC123"));
+            CHECK_FALSE(index.contains("ABC12"));
+            CHECK_FALSE(index.contains("ABC1234"));
+            CHECK_FALSE(index.contains("abc123"));
+            CHECK_FALSE(index.contains(""));
+            CHECK(index.size() == 1);
+        }
+    }
+
+    GIVEN("An index with prefix entries") {
+        AllowlistIndex index;
+        index.add_entry("FLEET*");
+        index.add_entry("04AB*");
+        index.add_entry("04AB*");
+
+        THEN("Tokens starting with a prefix are allowed") {
+            CHECK(index.contains("FLEET"));
+            CHECK(index.contains("FLEET0001"));
+            CHECK(index.contains("04ABCDEF"));
+            CHECK_FALSE(index.contains("FLEE"));
+            CHECK_FALSE(index.contains("XFLEET"));
+            CHECK_FALSE(index.contains("04A"));
+            CHECK(index.size() == 2);
+        }
+        THEN("Tokens shorter than every prefix are not allowed") {
+            CHECK_FALSE(index.contains("04"));
+            CHECK_FALSE(index.contains("F"));
+            CHECK_FALSE(index.contains(""));
+        }
+    }
+
+    GIVEN("An index with a bare '*' entry") {
+        AllowlistIndex index;
+        index.add_entry("ABC");
+        index.add_entry("*");
+
+        THEN("Every token is allowed") {
+            CHECK(index.contains("ABC"));
+            CHECK(index.contains("anything"));
+            CHECK(index.contains("X"));
+            CHECK(index.contains(""));
+        }
+    }
+}
+
+SCENARIO("AllowlistIndex loads files", "[Allowlist]") {
+    TempDirectory dir;
+    const auto path = dir.path / "allowlist.txt";
+
+    GIVEN("A file with CRLF line endings") {
+        write_file(path, "ABC123\r\nFLEET*\r\n\r\nDEF456\r\n");
+        const auto index = AllowlistIndex::load(path);
+
+        THEN("The carriage returns are not part of the entries") {
+            CHECK(index.size() == 3);
+            CHECK(index.contains("ABC123"));
+            CHECK(index.contains("DEF456"));
+            CHECK(index.contains("FLEET42"));
+            CHECK_FALSE(index.contains("ABC123\r"));
+        }
+    }
+
+    GIVEN("A file without a trailing newline") {
+        write_file(path, "ABC123\nDEF456");
+        const auto index = AllowlistIndex::load(path);
+
+        THEN("The last line is loaded") {
+            CHECK(index.contains("DEF456"));
+        }
+    }
+
+    GIVEN("A missing file") {
+        THEN("Loading fails") {
+            CHECK_THROWS_AS(AllowlistIndex::load(dir.path / "missing.txt"), std::runtime_error);
+        }
+    }
+}
+
+SCENARIO("Allowlist reloads changed files", "[Allowlist]") {
+    TempDirectory dir;
+    const auto path = dir.path / "allowlist.txt";
+    write_file(path, "OLD\n");
+
+    GIVEN("An allowlist") {
+        Allowlist allowlist(path);
+        REQUIRE(allowlist.is_allowed("OLD"));
+        REQUIRE_FALSE(allowlist.is_allowed("NEW"));
+
+        WHEN("The file is replaced by another one") {
+            const auto replacement = dir.path / "allowlist.txt.tmp";
+            write_file(replacement, "NEW\n");
+            std::filesystem::rename(replacement, path);
+
+            THEN("The new file is loaded") {
+                CHECK(wait_for(allowlist, "NEW", true));
+                CHECK_FALSE(allowlist.is_allowed("OLD"));
+            }
+        }
+
+        WHEN("The file is rewritten") {
+            write_file(path, "OLD\nFLEET*\n");
+
+            THEN("The new content is loaded") {
+                CHECK(wait_for(allowlist, "FLEET1", true));
+                CHECK(allowlist.is_allowed("OLD"));
+            }
+        }
+
+        WHEN("The file is removed") {
+            std::filesystem::remove(path);
+
+            THEN("No token is allowed anymore") {
+                CHECK(wait_for(allowlist, "OLD", false));
+            }
+        }
+    }
+
+    GIVEN("A missing file") {
+        Allowlist allowlist(dir.path / "missing.txt");
+
+        THEN("No token is allowed") {
+            CHECK_FALSE(allowlist.is_allowed("OLD"));
+        }
+        WHEN("The file is created") {
+            write_file(dir.path / "missing.txt", "*\n");
+
+            THEN("It is loaded") {
+                CHECK(wait_for(allowlist, "ANY", true));
+            }
+        }
+    }
+}
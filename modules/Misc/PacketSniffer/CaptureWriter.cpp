@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#include "CaptureWriter.hpp"
+
+#include <cstring>
+
+#include <everest/logging.hpp>
+#include <fmt/core.h>
+
+namespace module {
+
+namespace {
+const std::uint32_t PCAP_MAGIC = 0xa1b2c3d4; // microsecond timestamps, native byte order
+const std::uint16_t PCAP_VERSION_MAJOR = 2;
+const std::uint16_t PCAP_VERSION_MINOR = 4;
+
+struct PcapFileHeader {
+    std::uint32_t magic;
+    std::uint16_t version_major;
+    std::uint16_t version_minor;
+    std::int32_t thiszone;
+    std::uint32_t sigfigs;
+    std::uint32_t snaplen;
+    std::uint32_t link_type;
+};
+
+struct PcapRecordHeader {
+    std::uint32_t ts_sec;
+    std::uint32_t ts_usec;
+    std::uint32_t captured_length;
+    std::uint32_t original_length;
+};
+
+static_assert(sizeof(PcapFileHeader) == 24);
+static_assert(sizeof(PcapRecordHeader) == 16);
+
+const unsigned int FILE_BUFFER_SIZE = 128 * 1024;
+// favour a low CPU load on the charger over the compression ratio
+const char* const COMPRESSED_MODE = "wb1";
+// transparent mode, gzwrite writes the data as is
+const char* const UNCOMPRESSED_MODE = "wbT";
+} // namespace
+
+CaptureWriter::CaptureWriter(const CaptureWriterConfig& config) : config(config) {
+    thread = std::thread(&CaptureWriter::run, this);
+}
+
+CaptureWriter::~CaptureWriter() {
+    stop();
+}
+
+void CaptureWriter::push(std::uint32_t ts_sec, std::uint32_t ts_usec, std::uint32_t original_length,
+                         const std::uint8_t* data, std::uint32_t length) {
+    if (length > static_cast<std::uint32_t>(config.snaplen)) {
+        length = config.snaplen;
+    }
+    const PcapRecordHeader header{ts_sec, ts_usec, length, original_length};
+    const std::size_t record_size = sizeof(header) + length;
+
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (stopped || queue.size() + record_size > config.max_queued_bytes) {
+            queue_dropped++;
+            return;
+        }
+        notify = queue.empty();
+        const auto offset = queue.size();
+        queue.resize(offset + record_size);
+        std::memcpy(queue.data() + offset, &header, sizeof(header));
+        std::memcpy(queue.data() + offset + sizeof(header), data, length);
+    }
+    if (notify) {
+        queue_cv.notify_one();
+    }
+}
+
+void CaptureWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        stopped = true;
+    }
+    queue_cv.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+CaptureWriterStats CaptureWriter::get_stats() {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    auto result = published_stats;
+    result.packets_dropped += queue_dropped;
+    return result;
+}
+
+std::string CaptureWriter::file_name(std::uint32_t index) const {
+    return fmt::format("{}/{}{}.pcap{}", config.directory, config.base_name,
+                       index == 0 ? std::string() : fmt::format("-{}", index), config.compress ? ".gz" : "");
+}
+
+void CaptureWriter::run() {
+    open_next_file();
+
+    // the capture thread fills one buffer while this thread writes the other one
+    std::vector<std::uint8_t> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            published_stats = stats;
+            queue_cv.wait(lock, [this] { return stopped || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            std::swap(batch, queue);
+        }
+        write_batch(batch);
+        batch.clear();
+    }
+
+    close_file();
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    published_stats = stats;
+}
+
+void CaptureWriter::write_batch(const std::vector<std::uint8_t>& batch) {
+    const auto now = std::chrono::steady_clock::now();
+    std::size_t offset = 0;
+    std::size_t run_start = 0;
+    std::uint64_t run_packets = 0;
+
+    const auto write_run = [&]() {
+        const auto run_size = offset - run_start;
+        if (write(batch.data() + run_start, run_size)) {
+            stats.packets_written += run_packets;
+            stats.bytes_written += run_size;
+        } else {
+            stats.packets_dropped += run_packets;
+        }
+        run_start = offset;
+        run_packets = 0;
+    };
+
+    while (offset + sizeof(PcapRecordHeader) <= batch.size()) {
+        PcapRecordHeader header;
+        std::memcpy(&header, batch.data() + offset, sizeof(header));
+        const std::size_t record_size = sizeof(header) + header.captured_length;
+
+        // rotate between packets, but never leave a file without any packet
+        const auto size_with_run = file_size + (offset - run_start);
+        if (file != nullptr && size_with_run > sizeof(PcapFileHeader)) {
+            const bool size_exceeded = config.max_file_size > 0 && size_with_run + record_size > config.max_file_size;
+            const bool duration_exceeded =
+                config.max_file_duration.count() > 0 && now - file_opened >= config.max_file_duration;
+            if (size_exceeded || duration_exceeded) {
+                write_run();
+                open_next_file();
+            }
+        }
+
+        offset += record_size;
+        run_packets++;
+    }
+    write_run();
+}
+
+bool CaptureWriter::write(const std::uint8_t* data, std::size_t size) {
+    if (file == nullptr || write_failed) {
+        return false;
+    }
+    if (size == 0) {
+        return true;
+    }
+    if (gzwrite(file, data, size) != static_cast<int>(size)) {
+        int errnum = 0;
+        const char* message = gzerror(file, &errnum);
+        EVLOG_error << fmt::format("Error writing to {}: {}. Dropping packets.", file_name(stats.files - 1),
+                                   message != nullptr ? message : "unknown error");
+        write_failed = true;
+        return false;
+    }
+    file_size += size;
+    return true;
+}
+
+bool CaptureWriter::open_next_file() {
+    close_file();
+
+    const auto fn = file_name(stats.files);
+    file = gzopen(fn.c_str(), config.compress ? COMPRESSED_MODE : UNCOMPRESSED_MODE);
+    stats.files++;
+    if (file == nullptr) {
+        EVLOG_error << fmt::format("Error opening savefile {} for writing", fn);
+        return false;
+    }
+    gzbuffer(file, FILE_BUFFER_SIZE);
+    file_size = 0;
+    file_opened = std::chrono::steady_clock::now();
+    write_failed = false;
+
+    EVLOG_info << fmt::format("Capturing to {}", fn);
+
+    PcapFileHeader header{};
+    header.magic = PCAP_MAGIC;
+    header.version_major = PCAP_VERSION_MAJOR;
+    header.version_minor = PCAP_VERSION_MINOR;
+    header.snaplen = config.snaplen;
+    header.link_type = config.link_type;
+    return write(reinterpret_cast<const std::uint8_t*>(&header), sizeof(header));
+}
+
+void CaptureWriter::close_file() {
+    if (file == nullptr) {
+        return;
+    }
+    if (gzclose(file) != Z_OK) {
+        EVLOG_error << fmt::format("Error closing savefile {}", file_name(stats.files - 1));
+    }
+    file = nullptr;
+}
+
+} // namespace module
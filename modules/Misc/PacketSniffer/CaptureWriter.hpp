@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+#ifndef PACKET_SNIFFER_CAPTURE_WRITER_HPP
+#define PACKET_SNIFFER_CAPTURE_WRITER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+namespace module {
+
+struct CaptureWriterConfig {
+    std::string directory;
+    std::string base_name{"ethernet-traffic"};
+    int link_type{1}; // DLT_EN10MB
+    int snaplen{65535};
+    std::size_t max_file_size{0};              ///< uncompressed bytes per file, 0 disables size based rotation
+    std::chrono::seconds max_file_duration{0}; ///< 0 disables time based rotation
+    bool compress{false};                      ///< write gzip compressed .pcap.gz files
+    std::size_t max_queued_bytes{8 * 1024 * 1024};
+};
+
+struct CaptureWriterStats {
+    std::uint64_t packets_written{0};
+    std::uint64_t packets_dropped{0}; ///< packets that could not be queued or written
+    std::uint64_t bytes_written{0};   ///< uncompressed
+    std::uint32_t files{0};
+};
+
+/// \brief Writes packets to pcap files from its own thread, so slow storage never blocks the capture thread.
+/// Files are named <base_name>.pcap, <base_name>-1.pcap, ... (with .gz appended if compressed) and are rotated
+/// between packets once the configured size or duration is exceeded.
+class CaptureWriter {
+public:
+    explicit CaptureWriter(const CaptureWriterConfig& config);
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /// \brief Queues a packet. If the writer can't keep up the packet is dropped and counted, this never blocks
+    /// on file I/O
+    void push(std::uint32_t ts_sec, std::uint32_t ts_usec, std::uint32_t original_length, const std::uint8_t* data,
+              std::uint32_t length);
+
+    /// \brief Writes all queued packets, closes the current file and stops the writer thread
+    void stop();
+
+    CaptureWriterStats get_stats();
+
+    std::string file_name(std::uint32_t index) const;
+
+private:
+    void run();
+    void write_batch(const std::vector<std::uint8_t>& batch);
+    bool write(const std::uint8_t* data, std::size_t size);
+    bool open_next_file();
+    void close_file();
+
+    const CaptureWriterConfig config;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    std::vector<std::uint8_t> queue;
+    bool stopped{false};
+    std::uint64_t queue_dropped{0};
+
+    // only accessed by the writer thread until it is joined
+    gzFile file{nullptr};
+    std::size_t file_size{0};
+    std::chrono::steady_clock::time_point file_opened;
+    bool write_failed{false};
+    CaptureWriterStats stats;
+    // copy of stats for get_stats(), guarded by queue_mutex
+    CaptureWriterStats published_stats;
+
+    std::thread thread;
+};
+
+} // namespace module
+
+#endif // PACKET_SNIFFER_CAPTURE_WRITER_HPP
@@ -7,26 +7,17 @@
 namespace module {
 
 const bool PROMISC_MODE = true;
-const int PACKET_BUFFER_TIMEOUT_MS = 1000;
+// on Linux this is the timeout after which a block of the TPACKET_V3 ring is handed over even if it is not full
+const int PACKET_BUFFER_TIMEOUT_MS = 100;
 const int ALL_PACKETS_PROCESSED = -1;
-const int WAIT_FOR_MS = 10;
 const int BUFFERSIZE = 8192;
+const std::chrono::seconds STATS_INTERVAL{1};
+const std::chrono::seconds ERROR_RETRY_INTERVAL{1};
 
 void PacketSniffer::init() {
     invoke_init(*p_main);
 
-    p_handle = pcap_open_live(config.device.c_str(), BUFFERSIZE, PROMISC_MODE, PACKET_BUFFER_TIMEOUT_MS, errbuf);
-    std::string errb{errbuf};
-    if (p_handle == nullptr) {
-        EVLOG_error << fmt::format("Could not open device \"{}\", Sniffing disabled.{}", config.device,
-                                   errb.size() > 0 ? (std::string(" Error: ") + errb) : "");
-        return;
-    }
-
-    if (config.device != "any" && pcap_datalink(p_handle) != DLT_EN10MB) {
-        EVLOG_error << fmt::format("Device \"{}\" doesn't provide Ethernet headers - not supported. Sniffing disabled.",
-                                   config.device);
-        pcap_close(p_handle);
+    if (!open_device()) {
         return;
     }
 
@@ -34,59 +25,194 @@ void PacketSniffer::init() {
 
     r_evse_manager->subscribe_session_event([this](types::evse_manager::SessionEvent session_event) {
         if (session_event.event == types::evse_manager::SessionEventEnum::SessionStarted) {
-            if (!already_started) {
-
-                capturing_stopped = false;
-                if (session_event.session_started && session_event.session_started->logging_path) {
-                    std::thread(&PacketSniffer::capture, this, session_event.session_started->logging_path.value(),
-                                session_event.uuid)
-                        .detach();
-                }
-            } else {
-                EVLOG_warning << fmt::format("Capturing already started. Ignoring this SessionStarted event");
+            if (session_event.session_started && session_event.session_started->logging_path) {
+                start_session(session_event.uuid, session_event.session_started->logging_path.value());
             }
         } else if (session_event.event == types::evse_manager::SessionEventEnum::SessionFinished) {
-            capturing_stopped = true;
-            pcap_breakloop(p_handle);
+            stop_session(session_event.uuid);
         }
     });
 }
 
 void PacketSniffer::ready() {
     invoke_ready(*p_main);
+
+    if (p_handle != nullptr) {
+        capture_thread = std::thread(&PacketSniffer::capture_loop, this);
+    }
+}
+
+PacketSniffer::~PacketSniffer() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex);
+        stop_capturing = true;
+    }
+    stop_cv.notify_all();
+    if (p_handle != nullptr) {
+        pcap_breakloop(p_handle);
+    }
+    if (capture_thread.joinable()) {
+        capture_thread.join();
+    }
+    if (p_handle != nullptr) {
+        pcap_close(p_handle);
+    }
 }
 
-void PacketSniffer::capture(const std::string& logpath, const std::string& session_id) {
-    already_started = true;
-    const std::string fn = fmt::format("{}/ethernet-traffic.pcap", logpath);
+bool PacketSniffer::open_device() {
+    // pcap_create/pcap_activate instead of pcap_open_live to be able to size the kernel buffer. On Linux the
+    // activated handle captures into a memory-mapped TPACKET_V3 ring of that size.
+    p_handle = pcap_create(config.device.c_str(), errbuf);
+    if (p_handle == nullptr) {
+        std::string errb{errbuf};
+        EVLOG_error << fmt::format("Could not open device \"{}\", Sniffing disabled.{}", config.device,
+                                   errb.size() > 0 ? (std::string(" Error: ") + errb) : "");
+        return false;
+    }
 
-    EVLOG_info << fmt::format("Starting capturing to {}", fn);
+    pcap_set_snaplen(p_handle, BUFFERSIZE);
+    pcap_set_promisc(p_handle, PROMISC_MODE);
+    pcap_set_timeout(p_handle, PACKET_BUFFER_TIMEOUT_MS);
+    pcap_set_buffer_size(p_handle, config.capture_buffer_size_kb * 1024);
 
-    if ((pdumpfile = pcap_dump_open(p_handle, fn.c_str())) == nullptr) {
-        EVLOG_error << fmt::format("Error opening savefile {} for writing: {}", fn, pcap_geterr(p_handle));
-        return;
+    const int status = pcap_activate(p_handle);
+    if (status < 0) {
+        EVLOG_error << fmt::format("Could not activate device \"{}\", Sniffing disabled. Error: {}", config.device,
+                                   status == PCAP_ERROR ? pcap_geterr(p_handle) : pcap_statustostr(status));
+        pcap_close(p_handle);
+        p_handle = nullptr;
+        return false;
+    } else if (status > 0) {
+        EVLOG_warning << fmt::format("Device \"{}\" activated with warning: {}", config.device,
+                                     status == PCAP_WARNING ? pcap_geterr(p_handle) : pcap_statustostr(status));
     }
 
-    while (!capturing_stopped) {
-        const int ret =
-            pcap_dispatch(p_handle, ALL_PACKETS_PROCESSED, &pcap_dump, reinterpret_cast<u_char*>(pdumpfile));
-        if (ret <= PCAP_ERROR) {
-            const std::string base_msg = fmt::format("Error reading packets from interface \"{}\"", config.device);
-            if (ret == PCAP_ERROR) {
-                EVLOG_error << fmt::format("{}, error: {}", base_msg, pcap_geterr(p_handle));
-            } else if (ret == PCAP_ERROR_BREAK) {
-                EVLOG_warning << fmt::format("{}, interrupted but no packets received", base_msg);
-            } else {
-                EVLOG_error << fmt::format("{}, unexpected error: {}", base_msg, ret);
-            }
+    if (config.device != "any" && pcap_datalink(p_handle) != DLT_EN10MB) {
+        EVLOG_error << fmt::format("Device \"{}\" doesn't provide Ethernet headers - not supported. Sniffing disabled.",
+                                   config.device);
+        pcap_close(p_handle);
+        p_handle = nullptr;
+        return false;
+    }
+
+    if (!config.capture_filter.empty()) {
+        struct bpf_program program;
+        if (pcap_compile(p_handle, &program, config.capture_filter.c_str(), 1, PCAP_NETMASK_UNKNOWN) == PCAP_ERROR) {
+            EVLOG_error << fmt::format("Invalid capture filter \"{}\", Sniffing disabled. Error: {}",
+                                       config.capture_filter, pcap_geterr(p_handle));
+            pcap_close(p_handle);
+            p_handle = nullptr;
+            return false;
+        }
+        const int ret = pcap_setfilter(p_handle, &program);
+        pcap_freecode(&program);
+        if (ret == PCAP_ERROR) {
+            EVLOG_error << fmt::format("Could not set capture filter \"{}\", Sniffing disabled. Error: {}",
+                                       config.capture_filter, pcap_geterr(p_handle));
+            pcap_close(p_handle);
+            p_handle = nullptr;
+            return false;
+        }
+        EVLOG_info << fmt::format("Using capture filter \"{}\"", config.capture_filter);
+    }
+
+    return true;
+}
+
+void PacketSniffer::capture_loop() {
+    auto last_stats = std::chrono::steady_clock::now();
+    bool error_reported = false;
+
+    // packets are read continuously, also without active sessions, so a starting session never gets stale packets
+    // from the ring
+    while (!stop_capturing) {
+        const int ret = pcap_dispatch(p_handle, ALL_PACKETS_PROCESSED, &PacketSniffer::handle_packet,
+                                      reinterpret_cast<u_char*>(this));
+        if (ret == PCAP_ERROR_BREAK) {
+            // pcap_breakloop() from the destructor
             break;
+        } else if (ret < 0) {
+            if (!error_reported) {
+                EVLOG_error << fmt::format("Error reading packets from interface \"{}\", error: {}", config.device,
+                                           ret == PCAP_ERROR ? pcap_geterr(p_handle) : pcap_statustostr(ret));
+                error_reported = true;
+            }
+            std::unique_lock<std::mutex> lock(stop_mutex);
+            stop_cv.wait_for(lock, ERROR_RETRY_INTERVAL, [this] { return stop_capturing.load(); });
+        } else if (error_reported) {
+            EVLOG_info << fmt::format("Reading packets from interface \"{}\" again", config.device);
+            error_reported = false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_stats >= STATS_INTERVAL) {
+            update_kernel_drops();
+            last_stats = now;
+        }
+    }
+}
+
+void PacketSniffer::handle_packet(u_char* user, const struct pcap_pkthdr* header, const u_char* data) {
+    auto self = reinterpret_cast<PacketSniffer*>(user);
+    std::lock_guard<std::mutex> lock(self->sessions_mutex);
+    for (auto& [session_id, session] : self->sessions) {
+        session.writer->push(header->ts.tv_sec, header->ts.tv_usec, header->len, data, header->caplen);
+    }
+}
+
+void PacketSniffer::update_kernel_drops() {
+    // must be called from the capture thread, libpcap accumulates the kernel counters in the handle
+    struct pcap_stat stats;
+    if (pcap_stats(p_handle, &stats) == 0) {
+        kernel_drops = static_cast<std::uint64_t>(stats.ps_drop) + stats.ps_ifdrop;
+    }
+}
+
+void PacketSniffer::start_session(const std::string& session_id, const std::string& logpath) {
+    CaptureWriterConfig writer_config;
+    writer_config.directory = logpath;
+    writer_config.link_type = pcap_datalink(p_handle);
+    writer_config.snaplen = BUFFERSIZE;
+    writer_config.max_file_size = static_cast<std::size_t>(config.max_file_size_mb) * 1024 * 1024;
+    writer_config.max_file_duration = std::chrono::seconds(config.max_file_duration_s);
+    writer_config.compress = config.compress;
+
+    std::lock_guard<std::mutex> lock(sessions_mutex);
+    if (sessions.count(session_id) > 0) {
+        EVLOG_warning << fmt::format("Capturing for session {} already started. Ignoring this SessionStarted event",
+                                     session_id);
+        return;
+    }
+    EVLOG_info << fmt::format("Starting capturing of session {} to {}", session_id, logpath);
+    sessions.emplace(session_id, CaptureSession{std::make_unique<CaptureWriter>(writer_config), kernel_drops});
+}
+
+void PacketSniffer::stop_session(const std::string& session_id) {
+    CaptureSession session;
+    {
+        std::lock_guard<std::mutex> lock(sessions_mutex);
+        auto it = sessions.find(session_id);
+        if (it == sessions.end()) {
+            return;
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_FOR_MS));
+        session = std::move(it->second);
+        sessions.erase(it);
     }
 
-    pcap_dump_close(pdumpfile);
-    EVLOG_info << fmt::format("Stopped capturing to {}", fn);
-    already_started = false;
+    // kernel_drops is only updated once per STATS_INTERVAL, drops of the last moments are attributed to the next
+    // session
+    const std::uint64_t kernel_drops_in_session = kernel_drops - session.kernel_drops_at_start;
+
+    // writing the remaining queued packets may take a while on slow storage. The thread must not access the module,
+    // it may outlive it.
+    std::thread([session_id, kernel_drops_in_session, session = std::move(session)]() {
+        session.writer->stop();
+        const auto stats = session.writer->get_stats();
+        EVLOG_info << fmt::format("Stopped capturing of session {}: {} packets in {} file(s), {} dropped by the "
+                                  "writer, {} dropped by the kernel",
+                                  session_id, stats.packets_written, stats.files, stats.packets_dropped,
+                                  kernel_drops_in_session);
+    }).detach();
 }
 
 } // namespace module
@@ -18,6 +18,15 @@
 
 // ev@4bf81b14-a215-475c-a1d3-0a484ae48918:v1
 // insert your custom include headers here
+#include "CaptureWriter.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <pcap.h>
 // ev@4bf81b14-a215-475c-a1d3-0a484ae48918:v1
 
@@ -26,6 +35,11 @@ namespace module {
 struct Conf {
     std::string device;
     std::string session_logging_path;
+    std::string capture_filter;
+    int capture_buffer_size_kb;
+    int max_file_size_mb;
+    int max_file_duration_s;
+    bool compress;
 };
 
 class PacketSniffer : public Everest::ModuleBase {
@@ -41,6 +55,7 @@ public:
 
     // ev@1fce4c5e-0ab8-41bb-90f7-14277703d2ac:v1
     // insert your public definitions here
+    ~PacketSniffer();
     // ev@1fce4c5e-0ab8-41bb-90f7-14277703d2ac:v1
 
 protected:
@@ -55,12 +70,31 @@ private:
 
     // ev@211cfdbe-f69a-4cd6-a4ec-f8aaa3d1b6c8:v1
     // insert your private definitions here
-    void capture(const std::string& logpath, const std::string& session_id);
+    struct CaptureSession {
+        std::unique_ptr<CaptureWriter> writer;
+        std::uint64_t kernel_drops_at_start;
+    };
+
+    bool open_device();
+    void capture_loop();
+    static void handle_packet(u_char* user, const struct pcap_pkthdr* header, const u_char* data);
+    void update_kernel_drops();
+    void start_session(const std::string& session_id, const std::string& logpath);
+    void stop_session(const std::string& session_id);
+
     pcap_t* p_handle{nullptr};
-    pcap_dumper_t* pdumpfile{nullptr};
     char errbuf[PCAP_ERRBUF_SIZE]{""};
-    std::atomic_bool capturing_stopped{false};
-    std::atomic_bool already_started{false};
+    std::thread capture_thread;
+    // set on destruction, the capture thread is woken up by pcap_breakloop() or stop_cv
+    std::atomic_bool stop_capturing{false};
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    // packets dropped by the kernel or the interface since the device was opened
+    std::atomic<std::uint64_t> kernel_drops{0};
+
+    // all sessions get the packets of the single capture thread
+    std::mutex sessions_mutex;
+    std::map<std::string, CaptureSession> sessions;
     // ev@211cfdbe-f69a-4cd6-a4ec-f8aaa3d1b6c8:v1
 };
 
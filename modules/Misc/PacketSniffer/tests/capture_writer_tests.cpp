@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <catch2/catch_all.hpp>
+
+#include "../CaptureWriter.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+using namespace module;
+
+namespace {
+
+struct TempDirectory {
+    std::filesystem::path path;
+
+    TempDirectory() {
+        path = std::filesystem::temp_directory_path() /
+               ("packet_sniffer_tests_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::filesystem::remove_all(path);
+    }
+};
+
+// reads a (possibly compressed) file and returns its uncompressed content
+std::vector<std::uint8_t> read_file(const std::string& fn) {
+    std::vector<std::uint8_t> content;
+    gzFile file = gzopen(fn.c_str(), "rb");
+    REQUIRE(file != nullptr);
+    std::uint8_t buffer[4096];
+    int read = 0;
+    while ((read = gzread(file, buffer, sizeof(buffer))) > 0) {
+        content.insert(content.end(), buffer, buffer + read);
+    }
+    gzclose(file);
+    return content;
+}
+
+std::uint32_t read_u32(const std::vector<std::uint8_t>& data, std::size_t offset) {
+    std::uint32_t value;
+    std::memcpy(&value, data.data() + offset, sizeof(value));
+    return value;
+}
+
+struct Record {
+    std::uint32_t ts_sec;
+    std::uint32_t original_length;
+    std::vector<std::uint8_t> data;
+};
+
+std::vector<Record> parse_pcap(const std::vector<std::uint8_t>& content, int link_type = 1) {
+    REQUIRE(content.size() >= 24);
+    REQUIRE(read_u32(content, 0) == 0xa1b2c3d4);
+    REQUIRE(read_u32(content, 20) == static_cast<std::uint32_t>(link_type));
+
+    std::vector<Record> records;
+    std::size_t offset = 24;
+    while (offset < content.size()) {
+        REQUIRE(offset + 16 <= content.size());
+        const auto captured_length = read_u32(content, offset + 8);
+        REQUIRE(offset + 16 + captured_length <= content.size());
+        Record record{read_u32(content, offset), read_u32(content, offset + 12), {}};
+        record.data.assign(content.begin() + offset + 16, content.begin() + offset + 16 + captured_length);
+        records.push_back(record);
+        offset += 16 + captured_length;
+    }
+    return records;
+}
+
+std::vector<std::uint8_t> packet(std::uint8_t marker, std::size_t size = 100) {
+    std::vector<std::uint8_t> data(size);
+    data[0] = marker;
+    return data;
+}
+
+void push(CaptureWriter& writer, std::uint32_t ts_sec, const std::vector<std::uint8_t>& data) {
+    writer.push(ts_sec, 0, data.size(), data.data(), data.size());
+}
+
+} // namespace
+
+SCENARIO("CaptureWriter writes pcap files", "[CaptureWriter]") {
+    TempDirectory dir;
+    CaptureWriterConfig config;
+    config.directory = dir.path.string();
+
+    GIVEN("A writer without rotation") {
+        CaptureWriter writer(config);
+        WHEN("Packets are pushed") {
+            push(writer, 1, packet(1));
+            push(writer, 2, packet(2, 60));
+            push(writer, 3, packet(3, 1500));
+            writer.stop();
+            THEN("They are written in order to ethernet-traffic.pcap") {
+                const auto records = parse_pcap(read_file(config.directory + "/ethernet-traffic.pcap"));
+                REQUIRE(records.size() == 3);
+                CHECK(records[0].ts_sec == 1);
+                CHECK(records[0].data == packet(1));
+                CHECK(records[1].data == packet(2, 60));
+                CHECK(records[2].data == packet(3, 1500));
+
+                const auto stats = writer.get_stats();
+                CHECK(stats.packets_written == 3);
+                CHECK(stats.packets_dropped == 0);
+                CHECK(stats.files == 1);
+            }
+        }
+        WHEN("No packet is pushed") {
+            writer.stop();
+            THEN("The file only contains the header") {
+                CHECK(parse_pcap(read_file(config.directory + "/ethernet-traffic.pcap")).empty());
+            }
+        }
+    }
+
+    GIVEN("A writer with a snaplen") {
+        config.snaplen = 64;
+        config.link_type = 113; // DLT_LINUX_SLL
+        CaptureWriter writer(config);
+        WHEN("A larger packet is pushed") {
+            push(writer, 1, packet(1, 200));
+            writer.stop();
+            THEN("It is truncated but keeps its original length") {
+                const auto records = parse_pcap(read_file(config.directory + "/ethernet-traffic.pcap"), 113);
+                REQUIRE(records.size() == 1);
+                CHECK(records[0].data.size() == 64);
+                CHECK(records[0].original_length == 200);
+            }
+        }
+    }
+
+    GIVEN("A writer rotating by size") {
+        // header and two packets of 100 bytes
+        config.max_file_size = 24 + 2 * (16 + 100);
+        CaptureWriter writer(config);
+        WHEN("Five packets are pushed") {
+            for (std::uint8_t i = 0; i < 5; i++) {
+                push(writer, i, packet(i));
+            }
+            writer.stop();
+            THEN("They are split over three files") {
+                const auto first = parse_pcap(read_file(writer.file_name(0)));
+                const auto second = parse_pcap(read_file(writer.file_name(1)));
+                const auto third = parse_pcap(read_file(writer.file_name(2)));
+                REQUIRE(first.size() == 2);
+                REQUIRE(second.size() == 2);
+                REQUIRE(third.size() == 1);
+                CHECK(second[0].data == packet(2));
+                CHECK(third[0].data == packet(4));
+                CHECK(writer.file_name(1) == config.directory + "/ethernet-traffic-1.pcap");
+                CHECK(writer.get_stats().files == 3);
+            }
+        }
+        WHEN("A packet larger than the limit is pushed") {
+            push(writer, 1, packet(1, 500));
+            push(writer, 2, packet(2, 500));
+            writer.stop();
+            THEN("Each file gets one packet") {
+                CHECK(parse_pcap(read_file(writer.file_name(0))).size() == 1);
+                CHECK(parse_pcap(read_file(writer.file_name(1))).size() == 1);
+                CHECK(writer.get_stats().files == 2);
+            }
+        }
+    }
+
+    GIVEN("A writer rotating by time") {
+        config.max_file_duration = std::chrono::seconds(1);
+        CaptureWriter writer(config);
+        WHEN("Packets are pushed before and after the duration elapsed") {
+            push(writer, 1, packet(1));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+            push(writer, 2, packet(2));
+            writer.stop();
+            THEN("They are written to separate files") {
+                const auto first = parse_pcap(read_file(writer.file_name(0)));
+                const auto second = parse_pcap(read_file(writer.file_name(1)));
+                REQUIRE(first.size() == 1);
+                REQUIRE(second.size() == 1);
+                CHECK(second[0].data == packet(2));
+            }
+        }
+    }
+
+    GIVEN("A compressing writer") {
+        config.compress = true;
+        CaptureWriter writer(config);
+        WHEN("Packets are pushed") {
+            for (std::uint8_t i = 0; i < 100; i++) {
+                push(writer, i, packet(i, 1000));
+            }
+            writer.stop();
+            THEN("A smaller gzip file is written") {
+                const auto fn = config.directory + "/ethernet-traffic.pcap.gz";
+                REQUIRE(writer.file_name(0) == fn);
+                const auto records = parse_pcap(read_file(fn));
+                REQUIRE(records.size() == 100);
+                CHECK(records[99].data == packet(99, 1000));
+                CHECK(std::filesystem::file_size(fn) < 100 * 1000);
+            }
+        }
+    }
+
+    GIVEN("A writer with a small queue") {
+        config.max_queued_bytes = 2 * (16 + 100);
+        CaptureWriter writer(config);
+        WHEN("More packets are pushed than the queue can hold") {
+            const int count = 1000;
+            for (int i = 0; i < count; i++) {
+                push(writer, i, packet(i));
+            }
+            writer.stop();
+            THEN("Every packet is either written or counted as dropped") {
+                const auto stats = writer.get_stats();
+                CHECK(stats.packets_written + stats.packets_dropped == count);
+                CHECK(parse_pcap(read_file(writer.file_name(0))).size() == stats.packets_written);
+            }
+        }
+    }
+
+    GIVEN("A stopped writer") {
+        CaptureWriter writer(config);
+        writer.stop();
+        WHEN("A packet is pushed") {
+            push(writer, 1, packet(1));
+            THEN("It is dropped") {
+                CHECK(writer.get_stats().packets_dropped == 1);
+            }
+        }
+    }
+}
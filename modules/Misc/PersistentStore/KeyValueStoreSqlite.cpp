@@ -0,0 +1,409 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include "KeyValueStoreSqlite.hpp"
+
+#include <everest/logging.hpp>
+#include <fmt/core.h>
+
+#include <sstream>
+
+namespace module {
+
+namespace {
+
+/**
+ * Wrapper class around a sqlite3_stmt pointer to ensure it is always
+ * finalised via sqlite3_finalize()
+ */
+class Sqlite3_Stmt {
+private:
+    sqlite3_stmt* m_statement_ptr = nullptr;
+
+public:
+    void finalize(const char* error_message = nullptr) {
+        const auto res = sqlite3_finalize(m_statement_ptr);
+        m_statement_ptr = nullptr; // prevent double free
+        if (res != SQLITE_OK) {
+            if (error_message != nullptr) {
+                EVLOG_error << error_message;
+            }
+            throw std::runtime_error("PersistentStore db access error");
+        }
+    }
+
+    ~Sqlite3_Stmt() {
+        (void)sqlite3_finalize(m_statement_ptr);
+    }
+
+    constexpr operator sqlite3_stmt*() {
+        return m_statement_ptr;
+    }
+
+    constexpr operator sqlite3_stmt**() {
+        return &m_statement_ptr;
+    }
+
+    constexpr sqlite3_stmt** operator&() {
+        return &m_statement_ptr;
+    }
+};
+
+class TypeNameVisitor {
+public:
+    std::string operator()(std::nullptr_t t) const {
+        return "nullptr_t";
+    }
+
+    std::string operator()(const Array& t) const {
+        return "Array";
+    }
+
+    std::string operator()(const Object& t) const {
+        return "Object";
+    }
+
+    std::string operator()(const bool& t) const {
+        return "bool";
+    }
+
+    std::string operator()(const double& t) const {
+        return "double";
+    }
+
+    std::string operator()(const int& t) const {
+        return "int";
+    }
+
+    std::string operator()(const std::string& t) const {
+        return "std::string";
+    }
+};
+
+class StringValueVisitor {
+public:
+    std::string operator()(std::nullptr_t t) const {
+        return "";
+    }
+
+    std::string operator()(Array t) const {
+        json a = t;
+        return a.dump();
+    }
+
+    std::string operator()(Object t) const {
+        json o = t;
+        return o.dump();
+    }
+
+    std::string operator()(bool t) const {
+        if (t) {
+            return "true";
+        }
+        return "false";
+    }
+
+    std::string operator()(double t) const {
+        // shortest representation that parses back to the same value, values loaded after a restart have to match
+        // the cached ones
+        return fmt::format("{}", t);
+    }
+
+    std::string operator()(int t) const {
+        return std::to_string(t);
+    }
+
+    std::string operator()(std::string t) const {
+        return t;
+    }
+};
+
+KeyValueStoreSqlite::Value parse_value(const unsigned char* value_ptr, const unsigned char* type_ptr) {
+    KeyValueStoreSqlite::Value value;
+    if (value_ptr != nullptr) {
+        std::string value_str = std::string(reinterpret_cast<const char*>(value_ptr));
+        if (type_ptr != nullptr) {
+            std::string type_str = std::string(reinterpret_cast<const char*>(type_ptr));
+            if (type_str == "Array") {
+                Array value_array = json::parse(value_str);
+                value = value_array;
+            } else if (type_str == "Object") {
+                Object value_object = json::parse(value_str);
+                value = value_object;
+            } else if (type_str == "bool") {
+                if (value_str == "true") {
+                    value = true;
+                } else {
+                    value = false;
+                }
+            } else if (type_str == "double") {
+                value = std::stod(value_str);
+            } else if (type_str == "int") {
+                value = std::stoi(value_str);
+            } else if (type_str == "std::string") {
+                value = value_str;
+            }
+        }
+    }
+    return value;
+}
+
+void execute_statement(sqlite3* db, const char* sql) {
+    char* error_message = nullptr;
+    if (sqlite3_exec(db, sql, nullptr, nullptr, &error_message) != SQLITE_OK) {
+        EVLOG_error << "Could not execute '" << sql << "': " << (error_message != nullptr ? error_message : "");
+        sqlite3_free(error_message);
+        throw std::runtime_error("PersistentStore db access error");
+    }
+}
+
+} // namespace
+
+KeyValueStoreSqlite::KeyValueStoreSqlite(const fs::path& db_path,
+                                         const std::vector<std::string>& write_behind_key_prefixes,
+                                         std::chrono::milliseconds write_behind_max_delay) :
+    write_behind_key_prefixes(write_behind_key_prefixes), write_behind_max_delay(write_behind_max_delay) {
+    try {
+        this->open(db_path);
+    } catch (...) {
+        this->close();
+        throw;
+    }
+
+    if (!this->write_behind_key_prefixes.empty()) {
+        this->write_behind_thread = std::thread([this]() { this->write_behind(); });
+    }
+}
+
+void KeyValueStoreSqlite::open(const fs::path& db_path) {
+    // open and initialize database
+    fs::path sqlite_db_path = fs::absolute(db_path);
+    fs::path database_directory = sqlite_db_path.parent_path();
+    if (!fs::exists(database_directory)) {
+        fs::create_directories(database_directory);
+    }
+
+    int ret = sqlite3_open(sqlite_db_path.c_str(), &this->db);
+
+    if (ret != SQLITE_OK) {
+        EVLOG_error << "Error opening PersistentStore database '" << sqlite_db_path << "': " << sqlite3_errmsg(db);
+        throw std::runtime_error("Could not open PersistentStore database at provided path.");
+    }
+
+    EVLOG_debug << "Using SQLite version " << sqlite3_libversion();
+
+    // prepare the database
+    std::string create_sql = "CREATE TABLE IF NOT EXISTS KVS ("
+                             "KEY   TEXT UNIQUE,"
+                             "VALUE TEXT,"
+                             "TYPE  TEXT);";
+
+    Sqlite3_Stmt create_statement;
+    sqlite3_prepare_v2(this->db, create_sql.c_str(), create_sql.size(), &create_statement, NULL);
+    int res = sqlite3_step(create_statement);
+    if (res != SQLITE_DONE) {
+        EVLOG_error << "Could not create KVS table: " << res << sqlite3_errmsg(this->db);
+        throw std::runtime_error("PersistentStore db access error");
+    }
+
+    create_statement.finalize("Error creating KVS table");
+
+    std::string insert_sql_str = "INSERT OR REPLACE INTO KVS (KEY, VALUE, TYPE) VALUES "
+                                 "(@key, @value, @type)";
+    std::string delete_sql_str = "DELETE FROM KVS WHERE KEY = @key";
+    if (sqlite3_prepare_v2(this->db, insert_sql_str.c_str(), insert_sql_str.size(), &this->insert_statement, NULL) !=
+            SQLITE_OK or
+        sqlite3_prepare_v2(this->db, delete_sql_str.c_str(), delete_sql_str.size(), &this->delete_statement, NULL) !=
+            SQLITE_OK) {
+        EVLOG_error << "Could not prepare KVS statements: " << sqlite3_errmsg(this->db);
+        throw std::runtime_error("PersistentStore db access error");
+    }
+
+    // load all values into the cache, loads never access the database afterwards
+    std::string select_sql_str = "SELECT KEY, VALUE, TYPE FROM KVS";
+    Sqlite3_Stmt select_statement;
+    sqlite3_prepare_v2(this->db, select_sql_str.c_str(), select_sql_str.size(), &select_statement, NULL);
+    while ((res = sqlite3_step(select_statement)) == SQLITE_ROW) {
+        auto key_ptr = sqlite3_column_text(select_statement, 0);
+        if (key_ptr != nullptr) {
+            this->cache[reinterpret_cast<const char*>(key_ptr)] = parse_value(
+                sqlite3_column_text(select_statement, 1), sqlite3_column_text(select_statement, 2));
+        }
+    }
+    if (res != SQLITE_DONE) {
+        EVLOG_error << "Could not load KVS table: " << res << sqlite3_errmsg(this->db);
+        throw std::runtime_error("PersistentStore db access error");
+    }
+    select_statement.finalize("Error selecting from KVS table");
+    EVLOG_debug << "Loaded " << this->cache.size() << " values from PersistentStore database";
+}
+
+void KeyValueStoreSqlite::close() {
+    (void)sqlite3_finalize(this->insert_statement);
+    (void)sqlite3_finalize(this->delete_statement);
+    (void)sqlite3_close(this->db);
+    this->insert_statement = nullptr;
+    this->delete_statement = nullptr;
+    this->db = nullptr;
+}
+
+KeyValueStoreSqlite::~KeyValueStoreSqlite() {
+    {
+        std::lock_guard<std::mutex> lock(this->cache_mutex);
+        this->stop_write_behind = true;
+    }
+    this->pending_cv.notify_one();
+    if (this->write_behind_thread.joinable()) {
+        this->write_behind_thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(this->db_mutex);
+    try {
+        this->write_pending_keys();
+    } catch (const std::exception& e) {
+        EVLOG_error << "Could not write pending values to PersistentStore database: " << e.what();
+    }
+    this->close();
+}
+
+std::vector<std::string> KeyValueStoreSqlite::parse_key_prefixes(const std::string& prefixes) {
+    std::vector<std::string> result;
+    std::stringstream stream(prefixes);
+    std::string prefix;
+    while (std::getline(stream, prefix, ',')) {
+        prefix.erase(0, prefix.find_first_not_of(' '));
+        prefix.erase(prefix.find_last_not_of(' ') + 1);
+        if (!prefix.empty()) {
+            result.push_back(prefix);
+        }
+    }
+    return result;
+}
+
+bool KeyValueStoreSqlite::is_write_behind_key(const std::string& key) const {
+    for (const auto& prefix : this->write_behind_key_prefixes) {
+        if (key.rfind(prefix, 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KeyValueStoreSqlite::write_or_schedule(const std::string& key) {
+    if (this->is_write_behind_key(key)) {
+        this->pending_cv.notify_one();
+        return;
+    }
+    // writing all pending keys together with this one makes every write-through a sync point for the write-behind keys
+    std::lock_guard<std::mutex> lock(this->db_mutex);
+    this->write_pending_keys();
+}
+
+void KeyValueStoreSqlite::write_behind() {
+    std::unique_lock<std::mutex> lock(this->cache_mutex);
+    while (!this->stop_write_behind) {
+        this->pending_cv.wait(lock, [this]() { return this->stop_write_behind || !this->pending_keys.empty(); });
+        // collect further writes, repeated writes to the same key in the meantime are only written once
+        this->pending_cv.wait_for(lock, this->write_behind_max_delay, [this]() { return this->stop_write_behind; });
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> db_lock(this->db_mutex);
+            try {
+                this->write_pending_keys();
+            } catch (const std::exception& e) {
+                EVLOG_error << "Could not write pending values to PersistentStore database: " << e.what();
+            }
+        }
+        lock.lock();
+    }
+}
+
+void KeyValueStoreSqlite::write_pending_keys() {
+    struct PendingWrite {
+        std::string key;
+        bool deleted;
+        std::string value;
+        std::string type;
+    };
+    std::vector<PendingWrite> writes;
+    {
+        std::lock_guard<std::mutex> lock(this->cache_mutex);
+        writes.reserve(this->pending_keys.size());
+        for (const auto& key : this->pending_keys) {
+            const auto it = this->cache.find(key);
+            if (it == this->cache.end()) {
+                writes.push_back({key, true, {}, {}});
+            } else {
+                writes.push_back({key, false, std::visit(StringValueVisitor(), it->second),
+                                  std::visit(TypeNameVisitor(), it->second)});
+            }
+        }
+        this->pending_keys.clear();
+    }
+    if (writes.empty()) {
+        return;
+    }
+
+    try {
+        execute_statement(this->db, "BEGIN TRANSACTION");
+        for (const auto& write : writes) {
+            sqlite3_stmt* statement = write.deleted ? this->delete_statement : this->insert_statement;
+            sqlite3_bind_text(statement, 1, write.key.c_str(), -1, NULL);
+            if (!write.deleted) {
+                sqlite3_bind_text(statement, 2, write.value.c_str(), -1, NULL);
+                sqlite3_bind_text(statement, 3, write.type.c_str(), -1, NULL);
+            }
+            int res = sqlite3_step(statement);
+            if (res != SQLITE_DONE) {
+                EVLOG_error << "Could not write to KVS table: " << res << sqlite3_errmsg(db);
+                sqlite3_reset(statement);
+                throw std::runtime_error("PersistentStore db access error");
+            }
+            sqlite3_reset(statement);
+        }
+        execute_statement(this->db, "COMMIT TRANSACTION");
+    } catch (const std::exception& e) {
+        (void)sqlite3_exec(this->db, "ROLLBACK TRANSACTION", nullptr, nullptr, nullptr);
+        // keep the keys pending, so they are written with the next attempt
+        std::lock_guard<std::mutex> lock(this->cache_mutex);
+        for (const auto& write : writes) {
+            this->pending_keys.insert(write.key);
+        }
+        throw;
+    }
+}
+
+void KeyValueStoreSqlite::store(const std::string& key, const Value& value) {
+    {
+        std::lock_guard<std::mutex> lock(this->cache_mutex);
+        this->cache[key] = value;
+        this->pending_keys.insert(key);
+    }
+    this->write_or_schedule(key);
+}
+
+KeyValueStoreSqlite::Value KeyValueStoreSqlite::load(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->cache_mutex);
+    const auto it = this->cache.find(key);
+    if (it == this->cache.end()) {
+        // no key with that name exists in the database
+        return {};
+    }
+    return it->second;
+}
+
+void KeyValueStoreSqlite::remove(const std::string& key) {
+    {
+        std::lock_guard<std::mutex> lock(this->cache_mutex);
+        this->cache.erase(key);
+        this->pending_keys.insert(key);
+    }
+    this->write_or_schedule(key);
+}
+
+bool KeyValueStoreSqlite::exists(const std::string& key) {
+    std::lock_guard<std::mutex> lock(this->cache_mutex);
+    return this->cache.find(key) != this->cache.end();
+}
+
+} // namespace module
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#ifndef PERSISTENT_STORE_KEY_VALUE_STORE_SQLITE_HPP
+#define PERSISTENT_STORE_KEY_VALUE_STORE_SQLITE_HPP
+
+#include <utils/types.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace module {
+
+///
+/// \brief Key-value store backed by a sqlite database
+/// All values are kept in memory, loads never access the database. Values of keys matching one of the write-behind
+/// key prefixes are written by a writer thread after at most the write-behind delay, repeated writes to the same key
+/// in the meantime are only written once. All other values are written immediately, together with all pending ones.
+///
+class KeyValueStoreSqlite {
+public:
+    using Value = std::variant<std::nullptr_t, Array, Object, bool, double, int, std::string>;
+
+    ///
+    /// \brief Opens (and creates if needed) the database at \p db_path and loads all values
+    /// \throws std::runtime_error if the database cannot be opened or read
+    KeyValueStoreSqlite(const fs::path& db_path, const std::vector<std::string>& write_behind_key_prefixes,
+                        std::chrono::milliseconds write_behind_max_delay);
+    ///
+    /// \brief Writes all pending values and closes the database
+    ~KeyValueStoreSqlite();
+
+    KeyValueStoreSqlite(const KeyValueStoreSqlite&) = delete;
+    KeyValueStoreSqlite& operator=(const KeyValueStoreSqlite&) = delete;
+
+    ///
+    /// \brief Stores \p value for \p key
+    /// \throws std::runtime_error if the value should be written immediately and writing fails, the value is kept and
+    /// written with the next write
+    void store(const std::string& key, const Value& value);
+
+    /// \returns the value of \p key, nullptr if it does not exist
+    Value load(const std::string& key);
+
+    ///
+    /// \brief Deletes \p key
+    /// \throws std::runtime_error like store()
+    void remove(const std::string& key);
+
+    /// \returns true if \p key exists
+    bool exists(const std::string& key);
+
+    ///
+    /// \brief Splits the comma separated \p prefixes, surrounding spaces and empty items are removed
+    static std::vector<std::string> parse_key_prefixes(const std::string& prefixes);
+
+private:
+    void open(const fs::path& db_path);
+    void close();
+    bool is_write_behind_key(const std::string& key) const;
+    // writes the value of a changed key immediately or schedules it, depending on write_behind_key_prefixes
+    void write_or_schedule(const std::string& key);
+    void write_behind();
+    // writes the values of all pending keys to the database, must be called with db_mutex locked
+    void write_pending_keys();
+
+    sqlite3* db = nullptr;
+    sqlite3_stmt* insert_statement = nullptr;
+    sqlite3_stmt* delete_statement = nullptr;
+    // protects db and the prepared statements, pending keys are only taken while holding it
+    std::mutex db_mutex;
+
+    // all stored values, loads are served from here without accessing the database
+    std::unordered_map<std::string, Value> cache;
+    // keys whose value (or deletion) has not been written to the database yet
+    std::unordered_set<std::string> pending_keys;
+    std::mutex cache_mutex;
+    std::condition_variable pending_cv;
+    bool stop_write_behind = false;
+    std::thread write_behind_thread;
+
+    const std::vector<std::string> write_behind_key_prefixes;
+    const std::chrono::milliseconds write_behind_max_delay;
+};
+
+} // namespace module
+
+#endif // PERSISTENT_STORE_KEY_VALUE_STORE_SQLITE_HPP
@@ -21,6 +21,8 @@ namespace module {
 
 struct Conf {
     std::string sqlite_db_file_path;
+    std::string write_behind_key_prefixes;
+    int write_behind_max_delay_ms;
 };
 
 class PersistentStore : public Everest::ModuleBase {
@@ -0,0 +1,276 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Pionix GmbH and Contributors to EVerest
+
+#include <catch2/catch_all.hpp>
+
+#include "../KeyValueStoreSqlite.hpp"
+
+#include <optional>
+#include <thread>
+
+using namespace module;
+
+namespace {
+
+struct TempDirectory {
+    fs::path path;
+
+    TempDirectory() {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        path = fs::temp_directory_path() / ("persistent_store_tests_" + std::to_string(now));
+        fs::create_directories(path);
+    }
+    ~TempDirectory() {
+        fs::remove_all(path);
+    }
+};
+
+///
+/// \brief Second connection to the database of a store, used to check what has actually been written. Every insert
+/// into the KVS table is recorded in a WRITES table by a trigger.
+///
+class RawDatabase {
+public:
+    explicit RawDatabase(const fs::path& db_path) {
+        REQUIRE(sqlite3_open(db_path.c_str(), &db) == SQLITE_OK);
+        execute("CREATE TABLE IF NOT EXISTS KVS (KEY TEXT UNIQUE, VALUE TEXT, TYPE TEXT);"
+                "CREATE TABLE IF NOT EXISTS WRITES (KEY TEXT);"
+                "CREATE TRIGGER IF NOT EXISTS COUNT_WRITES AFTER INSERT ON KVS "
+                "BEGIN INSERT INTO WRITES VALUES (NEW.KEY); END;");
+    }
+    ~RawDatabase() {
+        (void)sqlite3_close(db);
+    }
+
+    void execute(const std::string& sql) {
+        REQUIRE(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+    }
+
+    int count_writes(const std::string& key) {
+        sqlite3_stmt* statement = nullptr;
+        REQUIRE(sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM WRITES WHERE KEY = ?", -1, &statement, nullptr) ==
+                SQLITE_OK);
+        sqlite3_bind_text(statement, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+        REQUIRE(sqlite3_step(statement) == SQLITE_ROW);
+        const int count = sqlite3_column_int(statement, 0);
+        sqlite3_finalize(statement);
+        return count;
+    }
+
+    std::optional<std::string> read_value(const std::string& key) {
+        sqlite3_stmt* statement = nullptr;
+        REQUIRE(sqlite3_prepare_v2(db, "SELECT VALUE FROM KVS WHERE KEY = ?", -1, &statement, nullptr) == SQLITE_OK);
+        sqlite3_bind_text(statement, 1, key.c_str(), -1, SQLITE_TRANSIENT);
+        std::optional<std::string> value;
+        if (sqlite3_step(statement) == SQLITE_ROW) {
+            value = reinterpret_cast<const char*>(sqlite3_column_text(statement, 0));
+        }
+        sqlite3_finalize(statement);
+        return value;
+    }
+
+private:
+    sqlite3* db = nullptr;
+};
+
+// waits until \p key has been written to the database, at most \p timeout
+bool wait_for_value(RawDatabase& raw, const std::string& key,
+                    std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    const auto end = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < end) {
+        if (raw.read_value(key).has_value()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+const std::chrono::milliseconds LONG_DELAY{60000};
+
+} // namespace
+
+SCENARIO("KeyValueStoreSqlite parses write-behind key prefixes", "[KeyValueStoreSqlite]") {
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes("").empty());
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes(" , ,,").empty());
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes("session") == std::vector<std::string>{"session"});
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes(" session , meter ") ==
+          std::vector<std::string>{"session", "meter"});
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes("a,,b, ,c,") == std::vector<std::string>{"a", "b", "c"});
+    CHECK(KeyValueStoreSqlite::parse_key_prefixes("with space,x") == std::vector<std::string>{"with space", "x"});
+}
+
+SCENARIO("KeyValueStoreSqlite stores values", "[KeyValueStoreSqlite]") {
+    TempDirectory dir;
+    const auto db_path = dir.path / "store.db";
+    RawDatabase raw(db_path);
+
+    GIVEN("A store without write-behind keys") {
+        {
+            KeyValueStoreSqlite store(db_path, {}, LONG_DELAY);
+            store.store("int", 42);
+            store.store("string", std::string("value"));
+            store.store("bool", true);
+            store.store("object", Object{{"a", 1}});
+            store.store("deleted", 1);
+            store.remove("deleted");
+
+            THEN("Values are written immediately") {
+                CHECK(raw.read_value("int") == "42");
+                CHECK(raw.read_value("string") == "value");
+                CHECK(raw.read_value("bool") == "true");
+                CHECK_FALSE(raw.read_value("deleted").has_value());
+            }
+            THEN("Values are loaded from the cache") {
+                CHECK(std::get<int>(store.load("int")) == 42);
+                CHECK(std::get<std::string>(store.load("string")) == "value");
+                CHECK(store.exists("bool"));
+                CHECK_FALSE(store.exists("deleted"));
+                CHECK(std::holds_alternative<std::nullptr_t>(store.load("deleted")));
+            }
+        }
+        WHEN("The database is reopened") {
+            KeyValueStoreSqlite store(db_path, {}, LONG_DELAY);
+            THEN("All values are loaded") {
+                CHECK(std::get<int>(store.load("int")) == 42);
+                CHECK(std::get<std::string>(store.load("string")) == "value");
+                CHECK(std::get<bool>(store.load("bool")));
+                CHECK(std::get<Object>(store.load("object")) == Object{{"a", 1}});
+                CHECK_FALSE(store.exists("deleted"));
+            }
+        }
+    }
+}
+
+SCENARIO("KeyValueStoreSqlite keeps doubles at full precision", "[KeyValueStoreSqlite]") {
+    TempDirectory dir;
+    const auto db_path = dir.path / "store.db";
+    const std::vector<double> values = {0.1 + 0.2, 1.0 / 3.0, 123456.7890123, 1e-9, -2.5e300, 42.0};
+
+    GIVEN("Doubles stored with and without write-behind") {
+        {
+            KeyValueStoreSqlite store(db_path, {"behind."}, LONG_DELAY);
+            for (std::size_t i = 0; i < values.size(); i++) {
+                store.store("through." + std::to_string(i), values.at(i));
+                store.store("behind." + std::to_string(i), values.at(i));
+            }
+            THEN("They are loaded unchanged from the cache") {
+                for (std::size_t i = 0; i < values.size(); i++) {
+                    CHECK(std::get<double>(store.load("through." + std::to_string(i))) == values.at(i));
+                    CHECK(std::get<double>(store.load("behind." + std::to_string(i))) == values.at(i));
+                }
+            }
+        }
+        WHEN("The database is reopened") {
+            KeyValueStoreSqlite store(db_path, {"behind."}, LONG_DELAY);
+            THEN("They are loaded unchanged from the database") {
+                for (std::size_t i = 0; i < values.size(); i++) {
+                    CHECK(std::get<double>(store.load("through." + std::to_string(i))) == values.at(i));
+                    CHECK(std::get<double>(store.load("behind." + std::to_string(i))) == values.at(i));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("KeyValueStoreSqlite writes selected keys behind", "[KeyValueStoreSqlite]") {
+    TempDirectory dir;
+    const auto db_path = dir.path / "store.db";
+    RawDatabase raw(db_path);
+
+    GIVEN("A store with a short write-behind delay") {
+        KeyValueStoreSqlite store(db_path, {"session."}, std::chrono::milliseconds(200));
+
+        WHEN("A write-behind key is written repeatedly") {
+            for (int i = 0; i < 10; i++) {
+                store.store("session.energy", i);
+            }
+            THEN("It is not written immediately") {
+                CHECK_FALSE(raw.read_value("session.energy").has_value());
+                CHECK(std::get<int>(store.load("session.energy")) == 9);
+            }
+            THEN("Only the last value is written once") {
+                REQUIRE(wait_for_value(raw, "session.energy"));
+                CHECK(raw.read_value("session.energy") == "9");
+                CHECK(raw.count_writes("session.energy") == 1);
+            }
+        }
+    }
+
+    GIVEN("A store with a long write-behind delay") {
+        KeyValueStoreSqlite store(db_path, {"session."}, LONG_DELAY);
+        store.store("session.energy", 1);
+        store.store("session.id", std::string("abc"));
+        REQUIRE_FALSE(raw.read_value("session.energy").has_value());
+
+        WHEN("A write-through key is stored") {
+            store.store("config", 5);
+            THEN("The pending write-behind keys are written with it") {
+                CHECK(raw.read_value("config") == "5");
+                CHECK(raw.read_value("session.energy") == "1");
+                CHECK(raw.read_value("session.id") == "abc");
+            }
+        }
+        WHEN("A write-through key is deleted") {
+            store.remove("config");
+            THEN("The pending write-behind keys are written") {
+                CHECK(raw.read_value("session.energy") == "1");
+            }
+        }
+        WHEN("A pending write-behind key is deleted") {
+            store.remove("session.id");
+            store.store("config", 5);
+            THEN("It is not written") {
+                CHECK_FALSE(raw.read_value("session.id").has_value());
+                CHECK(raw.count_writes("session.id") == 0);
+            }
+        }
+    }
+
+    GIVEN("A store that is destroyed with pending write-behind keys") {
+        {
+            KeyValueStoreSqlite store(db_path, {"session."}, LONG_DELAY);
+            store.store("session.energy", 7);
+            store.store("session.other", 8);
+            store.remove("session.other");
+            REQUIRE_FALSE(raw.read_value("session.energy").has_value());
+        }
+        THEN("They are written on destruction") {
+            CHECK(raw.read_value("session.energy") == "7");
+            CHECK_FALSE(raw.read_value("session.other").has_value());
+        }
+        WHEN("The database is reopened") {
+            KeyValueStoreSqlite store(db_path, {"session."}, LONG_DELAY);
+            THEN("The values are loaded") {
+                CHECK(std::get<int>(store.load("session.energy")) == 7);
+                CHECK_FALSE(store.exists("session.other"));
+            }
+        }
+    }
+}
+
+SCENARIO("KeyValueStoreSqlite keeps keys pending on failed writes", "[KeyValueStoreSqlite]") {
+    TempDirectory dir;
+    const auto db_path = dir.path / "store.db";
+    RawDatabase raw(db_path);
+
+    GIVEN("A store whose database is locked by another connection") {
+        KeyValueStoreSqlite store(db_path, {}, LONG_DELAY);
+        raw.execute("BEGIN EXCLUSIVE TRANSACTION");
+
+        WHEN("A value is stored") {
+            CHECK_THROWS_AS(store.store("first", 1), std::runtime_error);
+            raw.execute("COMMIT TRANSACTION");
+
+            THEN("It is kept in the cache") {
+                CHECK(std::get<int>(store.load("first")) == 1);
+                CHECK_FALSE(raw.read_value("first").has_value());
+            }
+            THEN("It is written with the next successful write") {
+                store.store("second", 2);
+                CHECK(raw.read_value("first") == "1");
+                CHECK(raw.read_value("second") == "2");
+            }
+        }
+    }
+}